@@ -0,0 +1,270 @@
+/**
+ * \file Banc.cpp
+ * \brief Banc d'essai des structures de recherche : l'AVL du Dictionnaire contre l'arbre B+ et les copies en lecture seule,
+ *        et placement des noeuds (grandes pages, répliques NUMA)
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ * Usage : TP3_bench [NB_MOTS] [NB_REQUETES]
+ * Les mesures n'ont de sens qu'avec une compilation optimisée (cmake -DCMAKE_BUILD_TYPE=Release).
+ *
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <thread>
+#include "Dictionnaire.h"
+#include "DictionnaireFige.h"
+#include "DictionnaireEytzinger.h"
+#include "DictionnaireCompact.h"
+#include "DictionnaireBPlus.h"
+#include "RepliquesNuma.h"
+
+// Valeurs par défaut des arguments
+#define NB_MOTS_DEFAUT 1000000
+#define NB_REQUETES_DEFAUT 200000
+// Graine fixe, pour que deux exécutions mesurent les mêmes mots
+#define GRAINE_BANC 2020
+
+using namespace std;
+using namespace TP3;
+
+/**
+ * \fn vector<string> genererMots(size_t nbMots, mt19937_64& generateur)
+ * \brief Génère des mots distincts de 3 à 14 lettres, dont un quart partage un long préfixe commun
+ * \param[in] size_t nbMots, le nombre de mots
+ * \param[in] mt19937_64& generateur, le générateur pseudo-aléatoire
+ * \return vector<string>, les mots, dans un ordre aléatoire
+ */
+vector<string> genererMots(size_t nbMots, mt19937_64& generateur)
+{
+	uniform_int_distribution<int> longueur(3, 14);
+	uniform_int_distribution<int> lettre('a', 'z');
+	vector<string> mots;
+	mots.reserve(nbMots + nbMots / 8);
+	while (mots.size() < nbMots + nbMots / 8)
+	{
+		string mot = (mots.size() % 4 == 0) ? "internation" : "";
+		for (int i = longueur(generateur); i > 0; i--)
+			mot += static_cast<char>(lettre(generateur));
+		mots.push_back(mot);
+	}
+	sort(mots.begin(), mots.end());
+	mots.erase(unique(mots.begin(), mots.end()), mots.end());
+	shuffle(mots.begin(), mots.end(), generateur);
+	mots.resize(min(mots.size(), nbMots));
+	return mots;
+}
+
+/**
+ * \fn template<typename Fonction> void mesurer(const string& nom, const vector<string>& requetes, Fonction fonction)
+ * \brief Chronomètre une fonction appliquée à chaque requête et affiche le temps moyen par requête
+ * \param[in] const string& nom, le nom affiché
+ * \param[in] const vector<string>& requetes, les requêtes
+ * \param[in] Fonction fonction, appelée avec chaque requête ; elle retourne un entier, cumulé pour que l'appel ne soit pas éliminé
+ */
+template<typename Fonction>
+void mesurer(const string& nom, const vector<string>& requetes, Fonction fonction)
+{
+	size_t cumul = 0;
+	const auto debut = chrono::steady_clock::now();
+	for (const string& requete : requetes)
+		cumul += fonction(requete);
+	const auto fin = chrono::steady_clock::now();
+
+	const double nanosecondes = chrono::duration<double, nano>(fin - debut).count() / requetes.size();
+	cout << "  " << left << setw(40) << nom << right << setw(10) << fixed << setprecision(1) << nanosecondes
+	     << " ns/requete  (controle " << cumul << ")" << endl;
+}
+
+/**
+ * \fn void comparerRecherches(const vector<string>& mots, size_t nbRequetes, mt19937_64& generateur)
+ * \brief Compare les recherches exactes et par borne inférieure de l'AVL, de DictionnaireEytzinger, de DictionnaireFige et de DictionnaireCompact
+ * \param[in] const vector<string>& mots, les mots du dictionnaire
+ * \param[in] size_t nbRequetes, le nombre de requêtes par mesure
+ * \param[in] mt19937_64& generateur, le générateur pseudo-aléatoire
+ */
+void comparerRecherches(const vector<string>& mots, size_t nbRequetes, mt19937_64& generateur)
+{
+	Dictionnaire dictionnaire;
+	for (const string& mot : mots)
+		dictionnaire.ajouteMot(mot, "traduction");
+	const DictionnaireEytzinger eytzinger(dictionnaire);
+	const DictionnaireFige fige(dictionnaire);
+	const DictionnaireCompact compact(dictionnaire);
+
+	cout << "Recherches sur " << mots.size() << " mots (memoire : AVL " << dictionnaire.statistiques().empreinteMemoire
+	     << " o, Eytzinger " << eytzinger.empreinteMemoire() << " o, fige " << fige.empreinteMemoire() << " o, compact "
+	     << compact.empreinteMemoire() << " o dont " << compact.empreinteMots() << " o de mots)" << endl;
+
+	uniform_int_distribution<size_t> choix(0, mots.size() - 1);
+	vector<string> presents, absents;
+	for (size_t i = 0; i < nbRequetes; i++)
+	{
+		presents.push_back(mots[choix(generateur)]);
+		absents.push_back(mots[choix(generateur)] + "q");
+	}
+
+	mesurer("AVL appartient (presents)", presents, [&](const string& mot) { return dictionnaire.appartient(mot); });
+	mesurer("Eytzinger appartient (presents)", presents, [&](const string& mot) { return eytzinger.appartient(mot); });
+	mesurer("Fige appartient (presents)", presents, [&](const string& mot) { return fige.appartient(mot); });
+	mesurer("Compact appartient (presents)", presents, [&](const string& mot) { return compact.appartient(mot); });
+	mesurer("AVL appartient (absents)", absents, [&](const string& mot) { return dictionnaire.appartient(mot); });
+	mesurer("Eytzinger appartient (absents)", absents, [&](const string& mot) { return eytzinger.appartient(mot); });
+	mesurer("Fige appartient (absents)", absents, [&](const string& mot) { return fige.appartient(mot); });
+	mesurer("Compact appartient (absents)", absents, [&](const string& mot) { return compact.appartient(mot); });
+	mesurer("AVL lower_bound (absents)", absents,
+	        [&](const string& mot) { return dictionnaire.lower_bound(mot) != dictionnaire.end(); });
+	mesurer("Eytzinger rangInferieur (absents)", absents, [&](const string& mot) { return eytzinger.rangInferieur(mot); });
+	mesurer("Fige rangInferieur (absents)", absents, [&](const string& mot) { return fige.rangInferieur(mot); });
+	mesurer("Compact rangInferieur (absents)", absents, [&](const string& mot) { return compact.rangInferieur(mot); });
+}
+
+/**
+ * \fn void comparerArbresModifiables(const vector<string>& mots, size_t nbRequetes, mt19937_64& generateur)
+ * \brief Compare les insertions, les recherches et les suppressions de l'AVL et de l'arbre B+
+ * \param[in] const vector<string>& mots, les mots insérés, dans un ordre aléatoire
+ * \param[in] size_t nbRequetes, le nombre de requêtes par mesure de recherche
+ * \param[in] mt19937_64& generateur, le générateur pseudo-aléatoire
+ *
+ * Dictionnaire::appartient calcule une similitude de Levenshtein à chaque noeud : lower_bound, qui ne fait que des
+ * comparaisons, mesure la descente de l'AVL elle-même.
+ *
+ */
+void comparerArbresModifiables(const vector<string>& mots, size_t nbRequetes, mt19937_64& generateur)
+{
+	Dictionnaire avl;
+	DictionnaireBPlus bplus;
+	cout << "Arbres modifiables, " << mots.size() << " mots" << endl;
+
+	mesurer("AVL ajouteMot", mots, [&](const string& mot) { avl.ajouteMot(mot, "traduction"); return 1; });
+	mesurer("B+ ajouteMot", mots, [&](const string& mot) { bplus.ajouteMot(mot, "traduction"); return 1; });
+	cout << "  hauteur : AVL " << avl.statistiques().hauteur + 1 << ", B+ " << bplus.hauteur()
+	     << " ; memoire : AVL " << avl.statistiques().empreinteMemoire << " o, B+ " << bplus.empreinteMemoire() << " o" << endl;
+
+	uniform_int_distribution<size_t> choix(0, mots.size() - 1);
+	vector<string> presents, absents;
+	for (size_t i = 0; i < nbRequetes; i++)
+	{
+		presents.push_back(mots[choix(generateur)]);
+		absents.push_back(mots[choix(generateur)] + "q");
+	}
+
+	mesurer("AVL appartient (presents)", presents, [&](const string& mot) { return avl.appartient(mot); });
+	mesurer("AVL lower_bound (presents)", presents, [&](const string& mot) { return avl.lower_bound(mot) != avl.end(); });
+	mesurer("B+ appartient (presents)", presents, [&](const string& mot) { return bplus.appartient(mot); });
+	mesurer("AVL lower_bound (absents)", absents, [&](const string& mot) { return avl.lower_bound(mot) != avl.end(); });
+	mesurer("B+ appartient (absents)", absents, [&](const string& mot) { return bplus.appartient(mot); });
+
+	const vector<string> aSupprimer(mots.begin(), mots.begin() + mots.size() / 2);
+	mesurer("AVL supprimeMot", aSupprimer, [&](const string& mot) { avl.supprimeMot(mot); return 1; });
+	mesurer("B+ supprimeMot", aSupprimer, [&](const string& mot) { bplus.supprimeMot(mot); return 1; });
+}
+
+/**
+ * \fn template<typename Choix> void mesurerDebit(const string& nom, unsigned int nbFils, const vector<string>& requetes, Choix choix)
+ * \brief Chronomètre 'nbFils' fils qui traduisent chacun toutes les requêtes, et affiche le débit total
+ * \param[in] const string& nom, le nom affiché
+ * \param[in] unsigned int nbFils, le nombre de fils
+ * \param[in] const vector<string>& requetes, les requêtes de chaque fil
+ * \param[in] Choix choix, appelée par chaque fil avec son numéro ; elle retourne le dictionnaire que le fil doit lire
+ */
+template<typename Choix>
+void mesurerDebit(const string& nom, unsigned int nbFils, const vector<string>& requetes, Choix choix)
+{
+	vector<size_t> cumuls(nbFils, 0);
+	vector<thread> fils;
+	const auto debut = chrono::steady_clock::now();
+	for (unsigned int i = 0; i < nbFils; i++)
+		fils.push_back(thread([&, i]() {
+			const Dictionnaire& dictionnaire = choix(i);
+			size_t cumul = 0;
+			for (const string& requete : requetes)
+				cumul += dictionnaire.traduit(requete).size();
+			cumuls[i] = cumul;
+		}));
+	for (auto & fil : fils)
+		fil.join();
+	const auto fin = chrono::steady_clock::now();
+
+	size_t cumul = 0;
+	for (size_t c : cumuls)
+		cumul += c;
+	const double secondes = chrono::duration<double>(fin - debut).count();
+	cout << "  " << left << setw(40) << nom << right << setw(10) << fixed << setprecision(2)
+	     << nbFils * requetes.size() / secondes / 1e6 << " Mrequetes/s  (controle " << cumul << ")" << endl;
+}
+
+/**
+ * \fn void comparerPlacements(const vector<string>& mots, size_t nbRequetes, mt19937_64& generateur)
+ * \brief Compare le débit de traduit selon le placement des noeuds : monceau, grandes pages, une réplique par noeud NUMA
+ * \param[in] const vector<string>& mots, les mots insérés, dans un ordre aléatoire (les noeuds sont éparpillés sur le monceau)
+ * \param[in] size_t nbRequetes, le nombre de requêtes par fil
+ * \param[in] mt19937_64& generateur, le générateur pseudo-aléatoire
+ *
+ * L'écart dépend de la machine : les grandes pages transparentes doivent être permises (madvise ou always dans
+ * /sys/kernel/mm/transparent_hugepage/enabled), et les répliques ne changent rien avec un seul noeud NUMA.
+ *
+ */
+void comparerPlacements(const vector<string>& mots, size_t nbRequetes, mt19937_64& generateur)
+{
+	Dictionnaire monceau;
+	for (const string& mot : mots)
+		monceau.ajouteMot(mot, "traduction");
+	Dictionnaire grandesPages(monceau);
+	grandesPages.activeGrandesPages();
+	const RepliquesNuma repliques(monceau, true);
+	const unsigned int nbFils = max(2u, thread::hardware_concurrency());
+
+	cout << "Placement des noeuds, " << mots.size() << " mots (" << grandesPages.octetsGrandesPages()
+	     << " o en grandes pages, " << repliques.nombreNoeuds() << " noeud(s) NUMA, " << nbFils << " fils)" << endl;
+
+	uniform_int_distribution<size_t> choix(0, mots.size() - 1);
+	vector<string> requetes;
+	for (size_t i = 0; i < nbRequetes; i++)
+		requetes.push_back(mots[choix(generateur)]);
+
+	mesurer("traduit (monceau)", requetes, [&](const string& mot) { return monceau.traduit(mot).size(); });
+	mesurer("traduit (grandes pages)", requetes, [&](const string& mot) { return grandesPages.traduit(mot).size(); });
+	mesurerDebit("traduit, fils (monceau partage)", nbFils, requetes,
+	             [&](unsigned int) -> const Dictionnaire& { return monceau; });
+	mesurerDebit("traduit, fils (grandes pages partagees)", nbFils, requetes,
+	             [&](unsigned int) -> const Dictionnaire& { return grandesPages; });
+	mesurerDebit("traduit, fils (repliques NUMA)", nbFils, requetes,
+	             [&](unsigned int i) -> const Dictionnaire& {
+		             repliques.epingle(i % repliques.nombreNoeuds());
+		             return repliques.locale();
+	             });
+}
+
+/**
+ * \fn int main(int argc, char* argv[])
+ * \brief Lance les mesures
+ */
+int main(int argc, char* argv[])
+{
+	const size_t nbMots = argc > 1 ? strtoul(argv[1], nullptr, 10) : NB_MOTS_DEFAUT;
+	const size_t nbRequetes = argc > 2 ? strtoul(argv[2], nullptr, 10) : NB_REQUETES_DEFAUT;
+	if (nbMots == 0 || nbRequetes == 0)
+	{
+		cerr << "Usage : " << argv[0] << " [NB_MOTS] [NB_REQUETES]" << endl;
+		return 2;
+	}
+#ifndef NDEBUG
+	cerr << "Attention : compilation sans NDEBUG ; utilisez -DCMAKE_BUILD_TYPE=Release pour des mesures representatives." << endl;
+#endif
+
+	mt19937_64 generateur(GRAINE_BANC);
+	const vector<string> mots = genererMots(nbMots, generateur);
+	comparerRecherches(mots, nbRequetes, generateur);
+	comparerArbresModifiables(mots, nbRequetes, generateur);
+	comparerPlacements(mots, nbRequetes, generateur);
+	return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * \file BancPolitiques.cpp
+ * \brief Banc d'essai des politiques d'équilibre : rotations et débit sous une charge mixte d'ajouts, de suppressions et de recherches
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ * Usage : TP3_bench_politique_<Politique> [NB_MOTS] [NB_OPERATIONS]
+ * Un exécutable est produit par politique (AVL, RougeNoir, WAVL, Treap), chacun compilé avec TP3_INSTRUMENTATION :
+ * les temps incluent donc le coût des compteurs, le même pour toutes les politiques.
+ *
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "Dictionnaire.h"
+
+// Valeurs par défaut des arguments
+#define NB_MOTS_DEFAUT 200000
+#define NB_OPERATIONS_DEFAUT 200000
+// Graine fixe, pour que toutes les politiques subissent la même suite d'opérations
+#define GRAINE_BANC 2020
+
+using namespace std;
+using namespace TP3;
+
+/**
+ * \fn string motAleatoire(mt19937_64& generateur)
+ * \brief Génère un mot de 4 à 14 lettres
+ * \param[in] mt19937_64& generateur, le générateur pseudo-aléatoire
+ * \return string, le mot
+ */
+string motAleatoire(mt19937_64& generateur)
+{
+	uniform_int_distribution<int> longueur(4, 14);
+	uniform_int_distribution<int> lettre('a', 'z');
+	string mot;
+	for (int i = longueur(generateur); i > 0; i--)
+		mot += static_cast<char>(lettre(generateur));
+	return mot;
+}
+
+/**
+ * \fn template<typename Fonction> void mesurer(const string& nom, size_t nbOperations, const Dictionnaire& dictionnaire, Fonction fonction)
+ * \brief Chronomètre une phase et affiche le temps moyen par opération, les rotations faites et la forme de l'arbre
+ * \param[in] const string& nom, le nom de la phase
+ * \param[in] size_t nbOperations, le nombre d'opérations de la phase
+ * \param[in] const Dictionnaire& dictionnaire, le dictionnaire modifié par la phase
+ * \param[in] Fonction fonction, la phase elle-même
+ */
+template<typename Fonction>
+void mesurer(const string& nom, size_t nbOperations, const Dictionnaire& dictionnaire, Fonction fonction)
+{
+	const CompteursOperations avant = dictionnaire.compteurs();
+	const auto debut = chrono::steady_clock::now();
+	fonction();
+	const auto fin = chrono::steady_clock::now();
+	const CompteursOperations& apres = dictionnaire.compteurs();
+	const StatistiquesArbre stats = dictionnaire.statistiques();
+
+	const double nanosecondes = chrono::duration<double, nano>(fin - debut).count() / nbOperations;
+	cout << "  " << left << setw(28) << nom << right << setw(10) << fixed << setprecision(1) << nanosecondes << " ns/op"
+	     << "  rotations g/d/doubles " << apres.rotationsGauche - avant.rotationsGauche << "/"
+	     << apres.rotationsDroite - avant.rotationsDroite << "/" << apres.rotationsDoubles - avant.rotationsDoubles
+	     << "  hauteur " << stats.hauteur << ", profondeur moyenne " << setprecision(2) << stats.profondeurMoyenne << endl;
+}
+
+/**
+ * \fn int main(int argc, char* argv[])
+ * \brief Lance les mesures : ajouts aléatoires, ajouts triés, puis charge mixte (50 % recherches, 25 % ajouts, 25 % suppressions)
+ */
+int main(int argc, char* argv[])
+{
+	const size_t nbMots = argc > 1 ? strtoul(argv[1], nullptr, 10) : NB_MOTS_DEFAUT;
+	const size_t nbOperations = argc > 2 ? strtoul(argv[2], nullptr, 10) : NB_OPERATIONS_DEFAUT;
+	if (nbMots == 0 || nbOperations == 0)
+	{
+		cerr << "Usage : " << argv[0] << " [NB_MOTS] [NB_OPERATIONS]" << endl;
+		return 2;
+	}
+#ifndef NDEBUG
+	cerr << "Attention : compilation sans NDEBUG ; utilisez -DCMAKE_BUILD_TYPE=Release pour des mesures representatives." << endl;
+#endif
+
+	mt19937_64 generateur(GRAINE_BANC);
+	vector<string> mots;
+	for (size_t i = 0; i < nbMots; i++)
+		mots.push_back(motAleatoire(generateur));
+	vector<string> motsTries;
+	for (size_t i = 0; i < nbMots; i++)
+		motsTries.push_back(to_string(1000000000 + i));
+
+	cout << "Politique d'equilibre : " << Dictionnaire::PolitiqueEquilibre::nom() << endl;
+
+	Dictionnaire trie;
+	mesurer("ajouts tries", nbMots, trie, [&]() {
+		for (const string& mot : motsTries)
+			trie.ajouteMot(mot, "traduction");
+	});
+	mesurer("suppressions triees", nbMots / 2, trie, [&]() {
+		for (size_t i = 0; i < nbMots / 2; i++)
+			trie.supprimeMot(motsTries[i]);
+	});
+
+	Dictionnaire dictionnaire;
+	mesurer("ajouts aleatoires", nbMots, dictionnaire, [&]() {
+		for (const string& mot : mots)
+			dictionnaire.ajouteMot(mot, "traduction");
+	});
+
+	//Les mots présents sont tenus dans un vecteur pour pouvoir en tirer un au hasard ; un mot supprimé est remplacé
+	//par le dernier
+	sort(mots.begin(), mots.end());
+	mots.erase(unique(mots.begin(), mots.end()), mots.end());
+	shuffle(mots.begin(), mots.end(), generateur);
+	size_t cumul = 0;
+	mesurer("charge mixte", nbOperations, dictionnaire, [&]() {
+		uniform_int_distribution<int> choixOperation(0, 3);
+		for (size_t i = 0; i < nbOperations; i++)
+		{
+			const int operation = choixOperation(generateur);
+			if (operation == 2)
+			{
+				const string mot = motAleatoire(generateur);
+				const Dictionnaire::Iterateur position = dictionnaire.lower_bound(mot);
+				if (position == dictionnaire.end() || *position != mot)
+					mots.push_back(mot);
+				dictionnaire.ajouteMot(mot, "traduction");
+			}
+			else if (operation == 3 && !mots.empty())
+			{
+				const size_t indice = generateur() % mots.size();
+				dictionnaire.supprimeMot(mots[indice]);
+				mots[indice] = mots.back();
+				mots.pop_back();
+			}
+			else if (!mots.empty())
+			{
+				cumul += dictionnaire.lower_bound(mots[generateur() % mots.size()]) != dictionnaire.end();
+			}
+		}
+	});
+	cout << "  (controle " << cumul << ")" << endl;
+	return 0;
+}
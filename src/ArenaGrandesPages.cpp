@@ -0,0 +1,185 @@
+/**
+ * \file ArenaGrandesPages.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe ArenaGrandesPages
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "ArenaGrandesPages.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <sys/mman.h>
+
+using namespace std;
+
+namespace TP3
+{
+
+    const std::size_t ArenaGrandesPages::TAILLE_GRANDE_PAGE;
+    const std::size_t ArenaGrandesPages::TAILLE_REGION;
+    const std::size_t ArenaGrandesPages::ALIGNEMENT;
+
+    /**
+     * \fn ArenaGrandesPages::ArenaGrandesPages(std::size_t p_tailleRegion)
+     * \brief Constructeur d'une arène vide
+     * \param[in] std::size_t p_tailleRegion, la taille d'une région, arrondie au multiple de TAILLE_GRANDE_PAGE supérieur
+     * \exception logic_error si la taille est 0
+     */
+    ArenaGrandesPages::ArenaGrandesPages(std::size_t p_tailleRegion) :
+            verrou(), tailleRegionMinimale((p_tailleRegion + TAILLE_GRANDE_PAGE - 1) / TAILLE_GRANDE_PAGE * TAILLE_GRANDE_PAGE),
+            regions(), courant(nullptr), fin(nullptr), libres(), utilises(0), grandesPages(true) {
+        if (p_tailleRegion == 0)
+            throw logic_error("la taille d'une region doit etre positive");
+    }
+
+    /**
+     * \fn ArenaGrandesPages::~ArenaGrandesPages()
+     * \brief Destructeur, rend les régions au système
+     */
+    ArenaGrandesPages::~ArenaGrandesPages() {
+        for (const Region& region : regions)
+            munmap(region.adresse, region.longueur);
+    }
+
+    /**
+     * \fn void* ArenaGrandesPages::allouer(std::size_t octets, std::size_t alignement)
+     * \brief Permet d'allouer un bloc
+     * \param[in] std::size_t octets, la taille du bloc
+     * \param[in] std::size_t alignement, l'alignement demandé
+     * \return void*, le bloc, aligné sur ALIGNEMENT
+     * \exception logic_error si l'alignement dépasse ALIGNEMENT
+     * \exception bad_alloc si le système refuse une nouvelle région
+     *
+     * Un bloc libéré de la même taille est réutilisé en premier ; sinon, le bloc est découpé à la suite de la région
+     * courante. La fin d'une région trop petite pour le bloc est abandonnée.
+     *
+     */
+    void* ArenaGrandesPages::allouer(std::size_t octets, std::size_t alignement) {
+        if (alignement > ALIGNEMENT)
+            throw logic_error("l'alignement demande depasse celui de l'arene");
+        const size_t classe = (max(octets, static_cast<size_t>(1)) + ALIGNEMENT - 1) / ALIGNEMENT;
+        const size_t taille = classe * ALIGNEMENT;
+
+        lock_guard<mutex> garde(verrou);
+        if (classe < libres.size() && libres[classe] != nullptr) {
+            void* bloc = libres[classe];
+            libres[classe] = *static_cast<void**>(bloc);
+            utilises += taille;
+            return bloc;
+        }
+        if (courant == nullptr || static_cast<size_t>(fin - courant) < taille)
+            _reserverRegion(taille);
+        void* bloc = courant;
+        courant += taille;
+        utilises += taille;
+        return bloc;
+    }
+
+    /**
+     * \fn void ArenaGrandesPages::liberer(void* bloc, std::size_t octets)
+     * \brief Permet de rendre un bloc à l'arène
+     * \param[in] void* bloc, le bloc, alloué par allouer (nullptr est ignoré)
+     * \param[in] std::size_t octets, la taille passée à allouer
+     *
+     * Le bloc devient la tête de la liste de sa taille : son premier mot désigne le bloc libre suivant.
+     *
+     */
+    void ArenaGrandesPages::liberer(void* bloc, std::size_t octets) {
+        if (bloc == nullptr)
+            return;
+        const size_t classe = (max(octets, static_cast<size_t>(1)) + ALIGNEMENT - 1) / ALIGNEMENT;
+
+        lock_guard<mutex> garde(verrou);
+        if (classe >= libres.size())
+            libres.resize(classe + 1, nullptr);
+        *static_cast<void**>(bloc) = libres[classe];
+        libres[classe] = bloc;
+        utilises -= classe * ALIGNEMENT;
+    }
+
+    /**
+     * \fn std::size_t ArenaGrandesPages::tailleRegion() const
+     * \brief Permet de connaître la taille d'une nouvelle région
+     * \return std::size_t, la taille, multiple de TAILLE_GRANDE_PAGE
+     */
+    std::size_t ArenaGrandesPages::tailleRegion() const {
+        return tailleRegionMinimale;
+    }
+
+    /**
+     * \fn std::size_t ArenaGrandesPages::octetsReserves() const
+     * \brief Permet de connaître la mémoire réservée auprès du système
+     * \return std::size_t, la somme des longueurs des régions
+     */
+    std::size_t ArenaGrandesPages::octetsReserves() const {
+        lock_guard<mutex> garde(verrou);
+        size_t total = 0;
+        for (const Region& region : regions)
+            total += region.longueur;
+        return total;
+    }
+
+    /**
+     * \fn std::size_t ArenaGrandesPages::octetsUtilises() const
+     * \brief Permet de connaître la mémoire allouée et pas encore libérée
+     * \return std::size_t, les octets, arrondis au multiple d'ALIGNEMENT de chaque bloc
+     */
+    std::size_t ArenaGrandesPages::octetsUtilises() const {
+        lock_guard<mutex> garde(verrou);
+        return utilises;
+    }
+
+    /**
+     * \fn bool ArenaGrandesPages::grandesPagesAccordees() const
+     * \brief Permet de savoir si le noyau a accepté les grandes pages transparentes
+     * \return bool, true si madvise(MADV_HUGEPAGE) a réussi sur toutes les régions (vrai tant qu'il n'y en a aucune)
+     */
+    bool ArenaGrandesPages::grandesPagesAccordees() const {
+        lock_guard<mutex> garde(verrou);
+        return grandesPages;
+    }
+
+    /**
+     * \fn void ArenaGrandesPages::_reserverRegion(std::size_t minimum)
+     * \brief Permet de réserver une nouvelle région, qui devient la région courante
+     * \param[in] std::size_t minimum, la taille du bloc à y allouer
+     * \exception bad_alloc si mmap échoue
+     *
+     * mmap n'aligne que sur une page ordinaire : on projette une grande page de plus, puis on rend au système ce qui
+     * précède et ce qui suit la partie alignée. Le verrou est déjà pris par l'appelant.
+     *
+     */
+    void ArenaGrandesPages::_reserverRegion(std::size_t minimum) {
+        const size_t longueur = max(tailleRegionMinimale,
+                                    (minimum + TAILLE_GRANDE_PAGE - 1) / TAILLE_GRANDE_PAGE * TAILLE_GRANDE_PAGE);
+        regions.reserve(regions.size() + 1);
+        void* projection = mmap(nullptr, longueur + TAILLE_GRANDE_PAGE, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (projection == MAP_FAILED)
+            throw bad_alloc();
+
+        char* debut = static_cast<char*>(projection);
+        char* aligne = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(debut) + TAILLE_GRANDE_PAGE - 1)
+                                               / TAILLE_GRANDE_PAGE * TAILLE_GRANDE_PAGE);
+        if (aligne != debut)
+            munmap(debut, static_cast<size_t>(aligne - debut));
+        if (aligne + longueur != debut + longueur + TAILLE_GRANDE_PAGE)
+            munmap(aligne + longueur, static_cast<size_t>(debut + TAILLE_GRANDE_PAGE - aligne));
+
+#ifdef MADV_HUGEPAGE
+        if (madvise(aligne, longueur, MADV_HUGEPAGE) != 0)
+            grandesPages = false;
+#else
+        grandesPages = false;
+#endif
+
+        regions.push_back(Region{ aligne, longueur });
+        courant = aligne;
+        fin = aligne + longueur;
+    }
+
+}//Fin du namespace
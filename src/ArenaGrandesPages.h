@@ -0,0 +1,184 @@
+/**
+ * \file ArenaGrandesPages.h
+ * \brief Ce fichier contient l'interface d'une arène de grandes régions contiguës, et de l'allocateur de noeuds qui y puise.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef ARENAGRANDESPAGES_H_
+#define ARENAGRANDESPAGES_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace TP3
+{
+
+/**
+ * \class ArenaGrandesPages
+ * \brief Réserve la mémoire par grandes régions alignées sur les grandes pages, et la découpe en petits blocs
+ *
+ *  Un arbre de plusieurs Go alloué bloc par bloc par malloc est éparpillé sur des millions de pages de 4 Kio : chaque
+ *  descente manque le TLB à presque chaque noeud. L'arène réserve des régions de plusieurs grandes pages (mmap), alignées
+ *  sur 2 Mio, et demande au noyau de les servir en grandes pages transparentes (madvise MADV_HUGEPAGE) : une entrée du
+ *  TLB couvre alors des milliers de noeuds. La demande peut être refusée (grandes pages transparentes désactivées) ; la
+ *  mémoire reste alors contiguë, en pages ordinaires.
+ *
+ *  Les blocs sont découpés à la suite dans la région courante. Un bloc libéré est gardé dans une liste par taille (par
+ *  multiple de ALIGNEMENT) et réutilisé par la prochaine allocation de même taille : la mémoire n'est rendue au système
+ *  qu'à la destruction de l'arène. Les pages d'une région sont placées, par le noyau, sur le noeud NUMA du fil qui les
+ *  touche en premier.
+ *
+ *  Les méthodes sont protégées par un verrou : une arène peut être partagée par des arbres modifiés par des fils différents.
+ *
+ *  Attributs:
+ *      - std::size_t tailleRegionMinimale, la taille d'une nouvelle région (multiple de TAILLE_GRANDE_PAGE)
+ *      - std::vector<Region> regions, les régions réservées
+ *      - char *courant, *fin, la partie encore jamais allouée de la dernière région
+ *      - std::vector<void*> libres, la tête de la liste des blocs libérés de chaque taille
+ *      - std::size_t utilises, les octets alloués et pas encore libérés
+ *      - bool grandesPages, true si toutes les régions ont été acceptées en grandes pages transparentes
+ *
+ */
+class ArenaGrandesPages
+{
+public:
+
+	//Taille d'une grande page (x86-64 et AArch64 avec des pages de 4 Kio)
+	static const std::size_t TAILLE_GRANDE_PAGE = 2 * 1024 * 1024;
+
+	//Taille d'une région, par défaut
+	static const std::size_t TAILLE_REGION = 16 * TAILLE_GRANDE_PAGE;
+
+	//Alignement de chaque bloc, et granularité des tailles
+	static const std::size_t ALIGNEMENT = 16;
+
+	//Constructeur, sans réserver de région. La taille est arrondie au multiple de TAILLE_GRANDE_PAGE supérieur.
+	//Exception logic_error si p_tailleRegion est 0
+	explicit ArenaGrandesPages(std::size_t p_tailleRegion = TAILLE_REGION);
+
+	ArenaGrandesPages(const ArenaGrandesPages&) = delete;
+	ArenaGrandesPages& operator=(const ArenaGrandesPages&) = delete;
+
+	//Destructeur, rend toutes les régions au système (les blocs encore alloués deviennent invalides)
+	~ArenaGrandesPages();
+
+	//Allouer un bloc (une région plus grande est réservée pour un bloc plus grand qu'une région)
+	//Exception logic_error si l'alignement dépasse ALIGNEMENT
+	//Exception bad_alloc si le système refuse une nouvelle région
+	void* allouer(std::size_t octets, std::size_t alignement = ALIGNEMENT);
+
+	//Rendre un bloc alloué par allouer, avec la même taille
+	void liberer(void* bloc, std::size_t octets);
+
+	//Taille d'une nouvelle région
+	std::size_t tailleRegion() const;
+
+	//Octets réservés auprès du système (toutes les régions)
+	std::size_t octetsReserves() const;
+
+	//Octets alloués et pas encore libérés
+	std::size_t octetsUtilises() const;
+
+	//true si le noyau a accepté de servir toutes les régions en grandes pages transparentes
+	bool grandesPagesAccordees() const;
+
+private:
+
+    /**
+     * \struct Region
+     * \brief Une projection anonyme alignée sur une grande page
+     */
+    struct Region
+    {
+        void* adresse;
+        std::size_t longueur;
+    };
+
+    mutable std::mutex verrou;
+    const std::size_t tailleRegionMinimale;
+    std::vector<Region> regions;
+    char* courant;
+    char* fin;
+    std::vector<void*> libres;
+    std::size_t utilises;
+    bool grandesPages;
+
+    //region private methods
+
+    void _reserverRegion(std::size_t minimum);
+
+    //endregion
+};
+
+/**
+ * \class AllocateurArene
+ * \brief Allocateur (au sens de la bibliothèque standard) qui puise dans une ArenaGrandesPages partagée
+ *
+ *  Sans arène (construction par défaut), il se comporte comme std::allocator : c'est le mode ordinaire du dictionnaire.
+ *  Les copies d'un allocateur (et ses copies reliées à un autre type) partagent la même arène, qui vit tant qu'un de
+ *  ses allocateurs existe : les noeuds partagés par AvlMap::copieDifferee ou passés d'un arbre à l'autre par scinder restent
+ *  valides. La copie d'un conteneur (select_on_container_copy_construction) reçoit par contre sa propre arène, de même
+ *  taille de région : ses pages sont touchées par le fil qui fait la copie, ce que RepliquesNuma utilise pour placer
+ *  chaque réplique sur son noeud NUMA.
+ *
+ *  Attributs:
+ *      - std::shared_ptr<ArenaGrandesPages> arene, l'arène (nullptr pour l'allocation ordinaire)
+ *
+ */
+template<typename T>
+class AllocateurArene
+{
+public:
+
+	typedef T value_type;
+
+	AllocateurArene() noexcept : arene() {}
+
+	explicit AllocateurArene(const std::shared_ptr<ArenaGrandesPages>& p_arene) noexcept : arene(p_arene) {}
+
+	template<typename U>
+	AllocateurArene(const AllocateurArene<U>& autre) noexcept : arene(autre.areneUtilisee()) {}
+
+	T* allocate(std::size_t n) {
+		if (!arene)
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		return static_cast<T*>(arene->allouer(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* p, std::size_t n) noexcept {
+		if (!arene)
+			::operator delete(p);
+		else
+			arene->liberer(p, n * sizeof(T));
+	}
+
+	AllocateurArene select_on_container_copy_construction() const {
+		if (!arene)
+			return AllocateurArene();
+		return AllocateurArene(std::make_shared<ArenaGrandesPages>(arene->tailleRegion()));
+	}
+
+	//L'arène utilisée (nullptr pour l'allocation ordinaire)
+	const std::shared_ptr<ArenaGrandesPages>& areneUtilisee() const noexcept { return arene; }
+
+private:
+
+    std::shared_ptr<ArenaGrandesPages> arene;
+};
+
+//2 allocateurs sont égaux s'ils partagent la même arène (ou n'en ont pas) : l'un peut libérer ce que l'autre a alloué
+template<typename T, typename U>
+bool operator==(const AllocateurArene<T>& a, const AllocateurArene<U>& b) { return a.areneUtilisee() == b.areneUtilisee(); }
+
+template<typename T, typename U>
+bool operator!=(const AllocateurArene<T>& a, const AllocateurArene<U>& b) { return !(a == b); }
+
+}
+
+#endif /* ARENAGRANDESPAGES_H_ */
@@ -0,0 +1,1357 @@
+/**
+ * \file AvlMap.h
+ * \brief Ce fichier contient l'interface et l'implantation d'un arbre de recherche équilibré générique (clé, valeur).
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ * C'est le moteur de l'arbre du Dictionnaire, extrait pour servir aussi à d'autres clés (identifiants entiers, chaînes
+ * internées) : la comparaison est un paramètre du patron, résolu et mis en ligne à la compilation.
+ *
+ */
+
+#ifndef AVLMAP_H_
+#define AVLMAP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Instrumentation.h"
+#include "PolitiquesEquilibre.h"
+
+namespace TP3
+{
+
+/**
+ * \struct NoeudAvlMap
+ * \brief Noeud par défaut d'un AvlMap : une paire (clé, valeur) et le chaînage de l'arbre
+ *
+ *  Un autre type de noeud peut être passé à AvlMap s'il offre la même interface : un constructeur (clé, valeur), un
+ *  constructeur de copie, cle(), valeur() et les champs gauche, droite, parent et hauteur. Les copies de l'arbre
+ *  copient les noeuds au complet : les champs propres à ce type de noeud suivent.
+ *
+ */
+template<typename Cle, typename Valeur>
+struct NoeudAvlMap
+{
+    std::pair<Cle, Valeur> contenu;
+    NoeudAvlMap *gauche, *droite, *parent;
+    int hauteur;
+
+    NoeudAvlMap(const Cle& p_cle, const Valeur& p_valeur) :
+            contenu(p_cle, p_valeur), gauche(nullptr), droite(nullptr), parent(nullptr), hauteur(0) {}
+
+    const Cle& cle() const { return contenu.first; }
+    Valeur& valeur() { return contenu.second; }
+    const Valeur& valeur() const { return contenu.second; }
+};
+
+/**
+ * \class AvlMap
+ * \brief Arbre de recherche équilibré associant une clé à une valeur
+ *
+ *  - Comparateur : ordre strict des clés (std::less par défaut) ; deux clés sont égales si aucune n'est plus petite.
+ *  - Allocateur : allocateur de l'utilisateur, relié (rebind) au type de noeud, par exemple un allocateur de bassin.
+ *  - Politique : politique d'équilibre de PolitiquesEquilibre.h (AVL par défaut).
+ *  - Noeud : type de noeud (NoeudAvlMap par défaut).
+ *
+ *  Les noeuds ne bougent jamais en mémoire et une suppression déplace des noeuds sans toucher à leur contenu : une
+ *  poignée de noeud reste valide tant que sa clé est dans l'arbre.
+ *
+ *  copieDifferee() est une copie complète remise à plus tard, et non un partage de structure : les 2 arbres lisent
+ *  les mêmes noeuds jusqu'à ce que l'un des 2 soit modifié, et ce premier écrivain copie alors tous les noeuds, en
+ *  O(n), à moins que l'autre ait déjà été détruit. Les noeuds partagés sont tenus par une Foret à compte de
+ *  références, libérée par le dernier arbre qui la quitte.
+ *
+ *  Attributs:
+ *      - Noeud * racine, la racine de l'arbre
+ *      - std::size_t nbNoeuds, le nombre de clés
+ *      - Comparateur comparateur, l'ordre des clés
+ *      - AllocateurNoeuds allocateur, l'allocateur des noeuds
+ *      - CompteursOperations compteursOperations, visites, rotations et allocations (avec TP3_INSTRUMENTATION)
+ *      - std::shared_ptr<Foret> foret, propriétaire des noeuds s'ils sont partagés avec une copie différée (nullptr sinon)
+ *
+ */
+template<typename Cle, typename Valeur, typename Comparateur = std::less<Cle>,
+         typename Allocateur = std::allocator<std::pair<const Cle, Valeur> >,
+         typename Politique = PolitiqueAVL, typename Noeud = NoeudAvlMap<Cle, Valeur> >
+class AvlMap
+{
+public:
+
+	typedef Noeud noeud_type;
+	typedef typename std::allocator_traits<Allocateur>::template rebind_alloc<Noeud> AllocateurNoeuds;
+
+	//Constructeur d'un arbre vide
+	explicit AvlMap(const Comparateur& p_comparateur = Comparateur(), const Allocateur& p_allocateur = Allocateur());
+
+	//Constructeur de copie : copie les noeuds, leur forme et leurs métadonnées d'équilibre
+	AvlMap(const AvlMap& source);
+
+	//Constructeur de copie dont les noeuds sont alloués par l'allocateur donné (par exemple pour changer d'arène)
+	AvlMap(const AvlMap& source, const Allocateur& p_allocateur);
+
+	//Constructeur de déplacement : reprend les noeuds de la source en O(1), la source devient vide
+	AvlMap(AvlMap&& source);
+
+	//Affectation par copie
+	AvlMap& operator=(const AvlMap& source);
+
+	//Affectation par déplacement, en O(1)
+	AvlMap& operator=(AvlMap&& source);
+
+	//Destructeur
+	~AvlMap();
+
+	//Échanger le contenu de 2 arbres en O(1)
+	void swap(AvlMap& autre);
+
+	//Copie complète différée : O(1) à l'appel, les noeuds sont partagés jusqu'à la première modification de l'un des 2
+	//arbres, qui copie alors tous les noeuds en O(n) (voir detacher)
+	//Ne doit pas être appelée en même temps qu'une modification ou un autre copieDifferee() du même arbre
+	AvlMap copieDifferee() const;
+
+	//Vérifier si les noeuds sont partagés avec une copie différée
+	bool estPartage() const;
+
+	//Reprendre la propriété exclusive des noeuds, en les copiant s'ils sont encore partagés. Appelée par toutes les
+	//modifications ; à appeler avant de modifier une valeur obtenue par trouver(). On retourne true si les noeuds ont été copiés.
+	bool detacher();
+
+	//Ajouter une clé et sa valeur. Si la clé est déjà présente, l'arbre n'est pas modifié.
+	//On retourne le noeud de la clé et true si elle a été ajoutée
+	std::pair<Noeud*, bool> inserer(const Cle& cle, const Valeur& valeur);
+
+	//Supprimer une clé. On retourne false si elle est absente. Les autres noeuds restent valides.
+	bool supprimer(const Cle& cle);
+
+	//Ajouter un lot de clés et leurs valeurs, triées par clé et sans doublon. Les clés déjà présentes ne sont pas modifiées.
+	//On retourne, pour chaque élément du lot, le noeud de sa clé et true si elle a été ajoutée. Un petit lot est ajouté
+	//clé par clé ; un gros lot est fusionné avec les noeuds existants et l'arbre est reconstruit une seule fois.
+	//Exception logic_error si les clés du lot ne sont pas strictement croissantes
+	std::vector<std::pair<Noeud*, bool> > insererLot(const std::vector<std::pair<Cle, Valeur> >& elements);
+
+	//Supprimer un lot de clés triées et sans doublon ; les clés absentes sont ignorées. Les autres noeuds restent valides.
+	//On retourne le nombre de clés supprimées. Un gros lot est retiré en un seul parcours suivi d'une reconstruction.
+	//Exception logic_error si les clés du lot ne sont pas strictement croissantes
+	std::size_t supprimerLot(const std::vector<Cle>& cles);
+
+	//Nombre minimal de clés (les 2 arbres ensemble) pour qu'une opération d'ensemble traite ses sous-arbres en parallèle
+	static const std::size_t SEUIL_PARALLELE = 1 << 14;
+
+	//Séparer l'arbre : les clés plus petites que 'cle' restent, les autres (la clé comprise) sont retournées dans un autre
+	//arbre. Les noeuds ne sont ni copiés ni déplacés. O(log n), plus le compte des clés de la plus petite partie.
+	AvlMap scinder(const Cle& cle);
+
+	//Ajouter à la suite les clés d'un arbre dont toutes les clés suivent celles-ci ; 'superieurs' devient vide. O(log n).
+	//Exception logic_error si une clé de 'superieurs' ne suit pas toutes celles de cet arbre, ou si les allocateurs diffèrent
+	void concatener(AvlMap& superieurs);
+
+	//Union : ajouter les clés de 'autre', qui devient vide. Pour une clé commune, fusion(valeur d'ici, valeur de 'autre')
+	//est appelée, puis le noeud de 'autre' est libéré. Sur de gros arbres, les sous-arbres sont traités en parallèle :
+	//fusion peut être appelée en même temps sur des noeuds différents et ne doit pas lancer d'exception.
+	//Exception logic_error si les allocateurs des 2 arbres diffèrent (les noeuds changent d'arbre)
+	template<typename Fusion>
+	void unir(AvlMap& autre, Fusion fusion);
+
+	//Intersection : garder seulement les clés aussi présentes dans 'autre' (avec leurs valeurs d'ici) ; 'autre' devient vide
+	//Exception logic_error si les allocateurs des 2 arbres diffèrent
+	void intersecter(AvlMap& autre);
+
+	//Différence : retirer les clés présentes dans 'autre' ; 'autre' devient vide
+	//Exception logic_error si les allocateurs des 2 arbres diffèrent
+	void retrancher(AvlMap& autre);
+
+	//Trouver le noeud d'une clé, nullptr si elle est absente
+	Noeud* trouver(const Cle& cle) const;
+
+	//Premier noeud dont la clé est plus grande ou égale à la clé donnée (nullptr s'il n'y en a pas)
+	Noeud* borneInferieure(const Cle& cle) const;
+
+	//Premier noeud dont la clé est strictement plus grande que la clé donnée (nullptr s'il n'y en a pas)
+	Noeud* borneSuperieure(const Cle& cle) const;
+
+	//Noeuds de la plus petite et de la plus grande clé (nullptr si l'arbre est vide)
+	Noeud* premier() const;
+	Noeud* dernier() const;
+
+	//Noeud suivant et précédent en ordre des clés (nullptr après le dernier ou avant le premier)
+	static Noeud* suivant(const Noeud* noeud);
+	static Noeud* precedent(const Noeud* noeud);
+
+	//Nombre de clés
+	std::size_t taille() const;
+
+	//Vérifier si l'arbre est vide
+	bool estVide() const;
+
+	//Retirer toutes les clés
+	void vider();
+
+	//Compteurs de visites, de rotations et d'allocations (à 0 sans TP3_INSTRUMENTATION)
+	const CompteursOperations& compteurs() const;
+
+protected:
+
+    Noeud* racine;
+    std::size_t nbNoeuds;
+    Comparateur comparateur;
+    AllocateurNoeuds allocateur;
+    mutable CompteursOperations compteursOperations;
+
+private:
+
+    typedef std::allocator_traits<AllocateurNoeuds> TraitsAllocateur;
+
+    /**
+     * \struct Foret
+     * \brief Noeuds partagés par un arbre et ses copies différées, libérés par le destructeur du dernier std::shared_ptr
+     */
+    struct Foret
+    {
+        Noeud* racine;
+        AllocateurNoeuds allocateur;
+
+        Foret(Noeud* p_racine, const AllocateurNoeuds& p_allocateur) : racine(p_racine), allocateur(p_allocateur) {}
+        ~Foret() { _detruireRecursif(allocateur, racine); }
+    };
+
+    mutable std::shared_ptr<Foret> foret;
+
+    /**
+     * \enum OperationEnsemble
+     * \brief Opération faite par _combinerRecursif
+     */
+    enum OperationEnsemble
+    {
+        OPERATION_UNION,
+        OPERATION_INTERSECTION,
+        OPERATION_DIFFERENCE
+    };
+
+    //region private methods
+
+    Noeud* _nouveauNoeud(const Cle& cle, const Valeur& valeur);
+    Noeud* _copierNoeud(const Noeud& source);
+    void _libererNoeud(Noeud* noeud);
+    static void _detruireRecursif(AllocateurNoeuds& allocateur, Noeud*& noeud);
+    Noeud* _copierRecursif(const Noeud* source, Noeud* parent);
+    void _insererRecursif(Noeud*& noeud, const Cle& cle, const Valeur& valeur, std::pair<Noeud*, bool>& resultat);
+    void _supprimerRecursif(Noeud*& noeud, const Cle& cle);
+    bool _reconstruirePourLot(std::size_t tailleLot) const;
+    std::vector<Noeud*> _noeudsEnOrdre() const;
+    void _reconstruire(const std::vector<Noeud*>& noeuds);
+    Noeud* _joindre(Noeud* gauche, Noeud* milieu, Noeud* droite);
+    Noeud* _joindreSansMilieu(Noeud* gauche, Noeud* droite);
+    Noeud* _retirerDernier(Noeud* noeud, Noeud*& dernier);
+    Noeud* _scinderRecursif(Noeud* noeud, const Cle& cle, Noeud*& gauche, Noeud*& droite);
+    template<typename Fusion>
+    void _combiner(AvlMap& autre, OperationEnsemble operation, Fusion& fusion);
+    template<typename Fusion>
+    Noeud* _combinerRecursif(Noeud* ici, Noeud* autre, OperationEnsemble operation, Fusion& fusion, int profondeurParallele,
+                             std::vector<Noeud*>& rejetes);
+    static void _collecterRecursif(Noeud* noeud, std::vector<Noeud*>& noeuds);
+    static std::size_t _compterPlusPetit(Noeud* premier, Noeud* second, std::size_t total);
+    static void _echangerPositions(Noeud*& lienAncetre, Noeud* descendant);
+
+    //endregion
+};
+
+    /**
+     * \fn AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::AvlMap(const Comparateur& p_comparateur, const Allocateur& p_allocateur)
+     * \brief Constructeur d'un arbre vide
+     * \param[in] const Comparateur& p_comparateur, l'ordre des clés
+     * \param[in] const Allocateur& p_allocateur, l'allocateur, relié au type de noeud
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::AvlMap(const Comparateur& p_comparateur, const Allocateur& p_allocateur) :
+            racine(nullptr), nbNoeuds(0), comparateur(p_comparateur), allocateur(p_allocateur), compteursOperations(), foret() {}
+
+    /**
+     * \fn AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::AvlMap(const AvlMap& source)
+     * \brief Constructeur de copie
+     * \param[in] const AvlMap& source, l'arbre copié
+     *
+     * La forme de l'arbre et la métadonnée de chaque noeud (hauteur, rang ou priorité) sont copiées telles quelles :
+     * la copie est équilibrée sans aucune rotation. Voir copieDifferee() pour remettre la copie à la première modification.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::AvlMap(const AvlMap& source) :
+            racine(nullptr), nbNoeuds(source.nbNoeuds), comparateur(source.comparateur),
+            allocateur(TraitsAllocateur::select_on_container_copy_construction(source.allocateur)), compteursOperations(),
+            foret() {
+        racine = _copierRecursif(source.racine, nullptr);
+    }
+
+    /**
+     * \fn AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::AvlMap(const AvlMap& source, const Allocateur& p_allocateur)
+     * \brief Constructeur de copie avec un autre allocateur
+     * \param[in] const AvlMap& source, l'arbre copié
+     * \param[in] const Allocateur& p_allocateur, l'allocateur des noeuds de la copie, relié au type de noeud
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::AvlMap(const AvlMap& source, const Allocateur& p_allocateur) :
+            racine(nullptr), nbNoeuds(source.nbNoeuds), comparateur(source.comparateur), allocateur(p_allocateur),
+            compteursOperations(), foret() {
+        racine = _copierRecursif(source.racine, nullptr);
+    }
+
+    /**
+     * \fn AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::AvlMap(AvlMap&& source)
+     * \brief Constructeur de déplacement
+     * \param[in] AvlMap&& source, l'arbre dont on reprend les noeuds ; il devient vide
+     *
+     * Seuls la racine, le nombre de clés et la forêt partagée changent de propriétaire : aucun noeud n'est copié ni
+     * alloué. L'allocateur est copié : la source reste utilisable.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::AvlMap(AvlMap&& source) :
+            racine(source.racine), nbNoeuds(source.nbNoeuds), comparateur(source.comparateur),
+            allocateur(source.allocateur), compteursOperations(), foret(std::move(source.foret)) {
+        source.racine = nullptr;
+        source.nbNoeuds = 0;
+    }
+
+    /**
+     * \fn AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>& AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::operator=(const AvlMap& source)
+     * \brief Affectation par copie
+     * \param[in] const AvlMap& source, l'arbre copié
+     * \return AvlMap&, l'arbre modifié
+     *
+     * La copie est construite avant de détruire l'ancien contenu : si elle échoue, l'arbre reste intact.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>&
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::operator=(const AvlMap& source) {
+        if (this != &source) {
+            AvlMap copie(source);
+            swap(copie);
+        }
+        return *this;
+    }
+
+    /**
+     * \fn AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>& AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::operator=(AvlMap&& source)
+     * \brief Affectation par déplacement
+     * \param[in] AvlMap&& source, l'arbre dont on reprend les noeuds ; il devient vide
+     * \return AvlMap&, l'arbre modifié
+     *
+     * L'ancien contenu passe par un arbre temporaire qui le libère en sortant de la méthode.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>&
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::operator=(AvlMap&& source) {
+        if (this != &source) {
+            AvlMap deplace(std::move(source));
+            swap(deplace);
+        }
+        return *this;
+    }
+
+    /**
+     * \fn AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::~AvlMap()
+     * \brief Destructeur : libère tous les noeuds, ou quitte la forêt s'ils sont partagés
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::~AvlMap() {
+        if (!foret)
+            _detruireRecursif(allocateur, racine);
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::swap(AvlMap& autre)
+     * \brief Permet d'échanger le contenu de 2 arbres sans copier ni déplacer de noeud
+     * \param[in] AvlMap& autre, l'autre arbre
+     *
+     * Les compteurs restent à leur arbre : ils mesurent le travail fait par chaque instance.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::swap(AvlMap& autre) {
+        std::swap(racine, autre.racine);
+        std::swap(nbNoeuds, autre.nbNoeuds);
+        std::swap(comparateur, autre.comparateur);
+        std::swap(allocateur, autre.allocateur);
+        foret.swap(autre.foret);
+    }
+
+    /**
+     * \fn AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud> AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::copieDifferee() const
+     * \brief Permet de copier l'arbre en remettant la copie des noeuds à la première modification
+     * \return AvlMap, la copie, qui partage les noeuds de cet arbre
+     *
+     * À la première copie, les noeuds passent sous la garde d'une Foret à compte de références, tenue par l'arbre et
+     * par toutes ses copies. Tant qu'aucun n'est modifié, les lectures se font sur les mêmes noeuds. La première
+     * modification d'un arbre partagé (detacher) lui donne sa propre copie de tous les noeuds, avec la même forme :
+     * l'appel est en O(1), mais la copie complète (clés et valeurs) est seulement déplacée vers ce premier écrivain.
+     *
+     * Ce n'est pas une copie par chemin : les noeuds ont des pointeurs vers leur parent (pour les itérateurs), un noeud
+     * ne peut donc pas appartenir à 2 arbres différents. On partage tout l'arbre ou rien.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::copieDifferee() const {
+        AvlMap copie(comparateur, allocateur);
+        if (racine == nullptr)
+            return copie;
+        if (!foret)
+            foret = std::make_shared<Foret>(racine, allocateur);
+        copie.racine = racine;
+        copie.nbNoeuds = nbNoeuds;
+        copie.foret = foret;
+        return copie;
+    }
+
+    /**
+     * \fn bool AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::estPartage() const
+     * \brief Permet de vérifier si les noeuds sont sous la garde d'une forêt partagée
+     * \return bool, true si les noeuds ont été partagés par copieDifferee() et pas encore détachés
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    bool AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::estPartage() const {
+        return static_cast<bool>(foret);
+    }
+
+    /**
+     * \fn bool AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::detacher()
+     * \brief Permet de reprendre la propriété exclusive des noeuds avant une modification
+     * \return bool, true si les noeuds ont été copiés (les anciennes poignées désignent alors ceux de la forêt)
+     *
+     * Si l'arbre est le dernier à tenir la forêt, il en reprend les noeuds sans copie. Sinon, il copie les noeuds et
+     * laisse la forêt aux autres. Un compte lu au moment où un autre arbre quitte la forêt peut causer une copie de trop,
+     * jamais une de moins.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    bool AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::detacher() {
+        if (!foret)
+            return false;
+        if (foret.use_count() == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            foret->racine = nullptr;
+            foret.reset();
+            return false;
+        }
+        racine = _copierRecursif(racine, nullptr);
+        foret.reset();
+        return true;
+    }
+
+    /**
+     * \fn std::pair<Noeud*, bool> AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::inserer(const Cle& cle, const Valeur& valeur)
+     * \brief Permet d'ajouter une clé et sa valeur
+     * \param[in] const Cle& cle, la clé
+     * \param[in] const Valeur& valeur, la valeur, ignorée si la clé est déjà présente
+     * \return std::pair<Noeud*, bool>, le noeud de la clé et true si elle vient d'être ajoutée
+     *
+     * Le nouveau noeud est une feuille ; la politique d'équilibre corrige ensuite chaque noeud du chemin en remontant.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    std::pair<Noeud*, bool> AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::inserer(const Cle& cle, const Valeur& valeur) {
+        detacher();
+        std::pair<Noeud*, bool> resultat(nullptr, false);
+        _insererRecursif(racine, cle, valeur, resultat);
+        racine->parent = nullptr;
+        return resultat;
+    }
+
+    /**
+     * \fn bool AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::supprimer(const Cle& cle)
+     * \brief Permet de supprimer une clé
+     * \param[in] const Cle& cle, la clé à supprimer
+     * \return bool, true si la clé était présente
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    bool AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::supprimer(const Cle& cle) {
+        if (trouver(cle) == nullptr)
+            return false;
+        detacher();
+        _supprimerRecursif(racine, cle);
+        if (racine != nullptr)
+            racine->parent = nullptr;
+        return true;
+    }
+
+    /**
+     * \fn std::vector<std::pair<Noeud*, bool> > AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::insererLot(const std::vector<std::pair<Cle, Valeur> >& elements)
+     * \brief Permet d'ajouter plusieurs clés avec un seul rééquilibrage
+     * \param[in] const std::vector<std::pair<Cle, Valeur> >& elements, les clés et leurs valeurs, en ordre strictement croissant
+     * \return std::vector<std::pair<Noeud*, bool> >, pour chaque élément, le noeud de sa clé et true si elle a été ajoutée
+     * \exception logic_error si les clés ne sont pas strictement croissantes
+     *
+     * Si le lot est gros par rapport à l'arbre, les noeuds existants sont parcourus en ordre et fusionnés avec le lot, puis
+     * la politique reconstruit l'arbre sur le tout : O(n + m), au lieu de m descentes et rééquilibrages. Les noeuds
+     * existants ne sont pas déplacés. Si une allocation échoue, les noeuds créés sont libérés et l'arbre est inchangé.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    std::vector<std::pair<Noeud*, bool> >
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::insererLot(const std::vector<std::pair<Cle, Valeur> >& elements) {
+        for (std::size_t i = 1; i < elements.size(); i++)
+            if (!comparateur(elements[i - 1].first, elements[i].first))
+                throw std::logic_error("insererLot: les clés du lot doivent être strictement croissantes");
+
+        std::vector<std::pair<Noeud*, bool> > resultats;
+        resultats.reserve(elements.size());
+        if (!_reconstruirePourLot(elements.size())) {
+            for (const std::pair<Cle, Valeur>& element : elements)
+                resultats.push_back(inserer(element.first, element.second));
+            return resultats;
+        }
+
+        detacher();
+        const std::vector<Noeud*> existants = _noeudsEnOrdre();
+        std::vector<Noeud*> fusion;
+        fusion.reserve(existants.size() + elements.size());
+        std::size_t nbAjouts = 0;
+        typename std::vector<Noeud*>::const_iterator existant = existants.begin();
+        try {
+            for (const std::pair<Cle, Valeur>& element : elements) {
+                while (existant != existants.end() && comparateur((*existant)->cle(), element.first))
+                    fusion.push_back(*existant++);
+                if (existant != existants.end() && !comparateur(element.first, (*existant)->cle())) {
+                    resultats.push_back(std::make_pair(*existant, false));
+                    fusion.push_back(*existant++);
+                } else {
+                    Noeud* noeud = _nouveauNoeud(element.first, element.second);
+                    Politique::initialiser(noeud);
+                    resultats.push_back(std::make_pair(noeud, true));
+                    fusion.push_back(noeud);
+                    nbAjouts++;
+                }
+            }
+        } catch (...) {
+            for (const std::pair<Noeud*, bool>& resultat : resultats)
+                if (resultat.second)
+                    _libererNoeud(resultat.first);
+            throw;
+        }
+        fusion.insert(fusion.end(), existant, existants.end());
+
+        _reconstruire(fusion);
+        nbNoeuds += nbAjouts;
+        return resultats;
+    }
+
+    /**
+     * \fn std::size_t AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::supprimerLot(const std::vector<Cle>& cles)
+     * \brief Permet de supprimer plusieurs clés avec un seul rééquilibrage
+     * \param[in] const std::vector<Cle>& cles, les clés à supprimer, en ordre strictement croissant
+     * \return std::size_t, le nombre de clés qui étaient présentes
+     * \exception logic_error si les clés ne sont pas strictement croissantes
+     *
+     * Un gros lot est retiré pendant un parcours en ordre de l'arbre (fusion avec le lot), puis l'arbre est reconstruit sur
+     * les noeuds restants, qui ne sont pas déplacés.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    std::size_t AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::supprimerLot(const std::vector<Cle>& cles) {
+        for (std::size_t i = 1; i < cles.size(); i++)
+            if (!comparateur(cles[i - 1], cles[i]))
+                throw std::logic_error("supprimerLot: les clés du lot doivent être strictement croissantes");
+
+        std::size_t nbSuppressions = 0;
+        if (!_reconstruirePourLot(cles.size())) {
+            for (const Cle& cle : cles)
+                if (supprimer(cle))
+                    nbSuppressions++;
+            return nbSuppressions;
+        }
+
+        detacher();
+        std::vector<Noeud*> restants = _noeudsEnOrdre();
+        std::vector<Noeud*> retires;
+        typename std::vector<Cle>::const_iterator cle = cles.begin();
+        std::size_t nbRestants = 0;
+        for (Noeud* noeud : restants) {
+            while (cle != cles.end() && comparateur(*cle, noeud->cle()))
+                ++cle;
+            if (cle != cles.end() && !comparateur(noeud->cle(), *cle))
+                retires.push_back(noeud);
+            else
+                restants[nbRestants++] = noeud;
+        }
+        if (retires.empty())
+            return 0;
+        restants.resize(nbRestants);
+
+        _reconstruire(restants);
+        for (Noeud* noeud : retires)
+            _libererNoeud(noeud);
+        nbNoeuds -= retires.size();
+        return retires.size();
+    }
+
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    const std::size_t AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::SEUIL_PARALLELE;
+
+    /**
+     * \fn AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud> AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::scinder(const Cle& cle)
+     * \brief Permet de séparer l'arbre en 2 à une clé, par scission et jonctions de sous-arbres
+     * \param[in] const Cle& cle, la première clé de la partie retournée
+     * \return AvlMap, les clés plus grandes ou égales à 'cle'
+     *
+     * Chaque noeud du chemin de recherche est rejoint (Politique::joindre) au sous-arbre resté du même côté que lui : le
+     * coût total est O(log n). Le nombre de clés de chaque partie est obtenu en parcourant les 2 en même temps jusqu'à
+     * la fin de la plus petite.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>
+    AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::scinder(const Cle& cle) {
+        detacher();
+        AvlMap superieurs(comparateur, allocateur);
+        Noeud* gauche;
+        Noeud* droite;
+        Noeud* egal = _scinderRecursif(racine, cle, gauche, droite);
+        if (egal != nullptr)
+            droite = _joindre(nullptr, egal, droite);
+
+        const std::size_t nbGauche = _compterPlusPetit(gauche, droite, nbNoeuds);
+        racine = gauche;
+        if (racine != nullptr)
+            racine->parent = nullptr;
+        superieurs.racine = droite;
+        if (droite != nullptr)
+            droite->parent = nullptr;
+        superieurs.nbNoeuds = nbNoeuds - nbGauche;
+        nbNoeuds = nbGauche;
+        return superieurs;
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::concatener(AvlMap& superieurs)
+     * \brief Permet de joindre à la suite de cet arbre un arbre dont toutes les clés sont plus grandes
+     * \param[in] AvlMap& superieurs, l'arbre ajouté, vidé par l'appel
+     * \exception logic_error si une clé de 'superieurs' ne suit pas toutes celles de cet arbre, ou si les allocateurs diffèrent
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::concatener(AvlMap& superieurs) {
+        if (&superieurs == this || superieurs.racine == nullptr)
+            return;
+        if (!(allocateur == superieurs.allocateur))
+            throw std::logic_error("concatener: les 2 arbres doivent avoir des allocateurs égaux");
+        if (racine != nullptr && !comparateur(dernier()->cle(), superieurs.premier()->cle()))
+            throw std::logic_error("concatener: les clés ajoutées doivent suivre toutes celles de l'arbre");
+
+        detacher();
+        superieurs.detacher();
+        racine = _joindreSansMilieu(racine, superieurs.racine);
+        racine->parent = nullptr;
+        nbNoeuds += superieurs.nbNoeuds;
+        superieurs.racine = nullptr;
+        superieurs.nbNoeuds = 0;
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::unir(AvlMap& autre, Fusion fusion)
+     * \brief Permet d'ajouter à cet arbre les clés d'un autre arbre
+     * \param[in] AvlMap& autre, l'arbre ajouté, vidé par l'appel
+     * \param[in] Fusion fusion, appelée avec (Valeur& ici, Valeur& autre) pour chaque clé commune
+     * \exception logic_error si les allocateurs des 2 arbres diffèrent
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    template<typename Fusion>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::unir(AvlMap& autre, Fusion fusion) {
+        _combiner(autre, OPERATION_UNION, fusion);
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::intersecter(AvlMap& autre)
+     * \brief Permet de garder seulement les clés présentes dans les 2 arbres
+     * \param[in] AvlMap& autre, l'autre arbre, vidé par l'appel
+     * \exception logic_error si les allocateurs des 2 arbres diffèrent
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::intersecter(AvlMap& autre) {
+        auto aucuneFusion = [](Valeur&, Valeur&) {};
+        _combiner(autre, OPERATION_INTERSECTION, aucuneFusion);
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::retrancher(AvlMap& autre)
+     * \brief Permet de retirer de cet arbre les clés d'un autre arbre
+     * \param[in] AvlMap& autre, l'autre arbre, vidé par l'appel
+     * \exception logic_error si les allocateurs des 2 arbres diffèrent
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::retrancher(AvlMap& autre) {
+        auto aucuneFusion = [](Valeur&, Valeur&) {};
+        _combiner(autre, OPERATION_DIFFERENCE, aucuneFusion);
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::trouver(const Cle& cle) const
+     * \brief Permet de trouver le noeud d'une clé
+     * \param[in] const Cle& cle, la clé cherchée
+     * \return Noeud*, le noeud de la clé, nullptr si elle est absente
+     *
+     * Une seule comparaison par niveau : on descend comme pour une borne inférieure et on vérifie l'égalité à la fin.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::trouver(const Cle& cle) const {
+        Noeud* candidat = borneInferieure(cle);
+        if (candidat == nullptr || comparateur(cle, candidat->cle()))
+            return nullptr;
+        return candidat;
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::borneInferieure(const Cle& cle) const
+     * \brief Permet de trouver le premier noeud dont la clé est plus grande ou égale à la clé donnée
+     * \param[in] const Cle& cle, la borne
+     * \return Noeud*, le noeud trouvé, nullptr s'il n'y en a pas
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::borneInferieure(const Cle& cle) const {
+        Noeud* candidat = nullptr;
+        for (Noeud* noeud = racine; noeud != nullptr; ) {
+            TP3_COMPTER(compteursOperations.visitesNoeuds, 1);
+            if (!comparateur(noeud->cle(), cle)) {
+                candidat = noeud;
+                noeud = noeud->gauche;
+            } else {
+                noeud = noeud->droite;
+            }
+        }
+        return candidat;
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::borneSuperieure(const Cle& cle) const
+     * \brief Permet de trouver le premier noeud dont la clé est strictement plus grande que la clé donnée
+     * \param[in] const Cle& cle, la borne
+     * \return Noeud*, le noeud trouvé, nullptr s'il n'y en a pas
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::borneSuperieure(const Cle& cle) const {
+        Noeud* candidat = nullptr;
+        for (Noeud* noeud = racine; noeud != nullptr; ) {
+            TP3_COMPTER(compteursOperations.visitesNoeuds, 1);
+            if (comparateur(cle, noeud->cle())) {
+                candidat = noeud;
+                noeud = noeud->gauche;
+            } else {
+                noeud = noeud->droite;
+            }
+        }
+        return candidat;
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::premier() const
+     * \brief Permet de trouver le noeud de la plus petite clé
+     * \return Noeud*, le noeud minimal, nullptr si l'arbre est vide
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::premier() const {
+        Noeud* noeud = racine;
+        while (noeud != nullptr && noeud->gauche != nullptr)
+            noeud = noeud->gauche;
+        return noeud;
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::dernier() const
+     * \brief Permet de trouver le noeud de la plus grande clé
+     * \return Noeud*, le noeud maximal, nullptr si l'arbre est vide
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::dernier() const {
+        Noeud* noeud = racine;
+        while (noeud != nullptr && noeud->droite != nullptr)
+            noeud = noeud->droite;
+        return noeud;
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::suivant(const Noeud* noeud)
+     * \brief Permet de trouver le noeud suivant en ordre des clés
+     * \param[in] const Noeud* noeud, le noeud courant
+     * \return Noeud*, le successeur, nullptr après le dernier noeud
+     *
+     * S'il y a un sous-arbre droit, le successeur en est le minimum. Sinon, on remonte tant qu'on vient de la droite ;
+     * le premier parent atteint par la gauche est le successeur. O(1) amorti sur un parcours complet.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::suivant(const Noeud* noeud) {
+        if (noeud->droite != nullptr) {
+            Noeud* minimum = noeud->droite;
+            while (minimum->gauche != nullptr)
+                minimum = minimum->gauche;
+            return minimum;
+        }
+        Noeud* parent = noeud->parent;
+        while (parent != nullptr && parent->droite == noeud) {
+            noeud = parent;
+            parent = parent->parent;
+        }
+        return parent;
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::precedent(const Noeud* noeud)
+     * \brief Permet de trouver le noeud précédent en ordre des clés (symétrique de suivant)
+     * \param[in] const Noeud* noeud, le noeud courant
+     * \return Noeud*, le prédécesseur, nullptr avant le premier noeud
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::precedent(const Noeud* noeud) {
+        if (noeud->gauche != nullptr) {
+            Noeud* maximum = noeud->gauche;
+            while (maximum->droite != nullptr)
+                maximum = maximum->droite;
+            return maximum;
+        }
+        Noeud* parent = noeud->parent;
+        while (parent != nullptr && parent->gauche == noeud) {
+            noeud = parent;
+            parent = parent->parent;
+        }
+        return parent;
+    }
+
+    /**
+     * \fn std::size_t AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::taille() const
+     * \brief Permet de connaître le nombre de clés
+     * \return std::size_t, le nombre de clés
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    std::size_t AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::taille() const {
+        return nbNoeuds;
+    }
+
+    /**
+     * \fn bool AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::estVide() const
+     * \brief Permet de vérifier si l'arbre est vide
+     * \return bool, true si l'arbre ne contient aucune clé
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    bool AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::estVide() const {
+        return racine == nullptr;
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::vider()
+     * \brief Permet de retirer toutes les clés et de libérer les noeuds (ceux d'une forêt partagée restent aux copies différées)
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::vider() {
+        if (foret) {
+            foret.reset();
+            racine = nullptr;
+        }
+        _detruireRecursif(allocateur, racine);
+        nbNoeuds = 0;
+    }
+
+    /**
+     * \fn const CompteursOperations& AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::compteurs() const
+     * \brief Permet de consulter les compteurs de l'arbre
+     * \return const CompteursOperations&, les compteurs
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    const CompteursOperations& AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::compteurs() const {
+        return compteursOperations;
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_nouveauNoeud(const Cle& cle, const Valeur& valeur)
+     * \brief Permet d'allouer et de construire un noeud avec l'allocateur
+     * \param[in] const Cle& cle, la clé
+     * \param[in] const Valeur& valeur, la valeur
+     * \return Noeud*, le nouveau noeud, sans enfant ni parent
+     *
+     * Si le constructeur du noeud lance une exception, la mémoire est rendue à l'allocateur avant de la relancer.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_nouveauNoeud(const Cle& cle, const Valeur& valeur) {
+        Noeud* noeud = TraitsAllocateur::allocate(allocateur, 1);
+        try {
+            TraitsAllocateur::construct(allocateur, noeud, cle, valeur);
+        } catch (...) {
+            TraitsAllocateur::deallocate(allocateur, noeud, 1);
+            throw;
+        }
+        TP3_COMPTER(compteursOperations.allocations, 1);
+        return noeud;
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_copierNoeud(const Noeud& source)
+     * \brief Permet d'allouer la copie d'un noeud avec l'allocateur, métadonnées comprises
+     * \param[in] const Noeud& source, le noeud copié
+     * \return Noeud*, la copie, sans enfant ni parent
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_copierNoeud(const Noeud& source) {
+        Noeud* noeud = TraitsAllocateur::allocate(allocateur, 1);
+        try {
+            TraitsAllocateur::construct(allocateur, noeud, source);
+        } catch (...) {
+            TraitsAllocateur::deallocate(allocateur, noeud, 1);
+            throw;
+        }
+        TP3_COMPTER(compteursOperations.allocations, 1);
+        noeud->gauche = nullptr;
+        noeud->droite = nullptr;
+        noeud->parent = nullptr;
+        return noeud;
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_libererNoeud(Noeud* noeud)
+     * \brief Permet de détruire un noeud et de rendre sa mémoire à l'allocateur
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_libererNoeud(Noeud* noeud) {
+        TraitsAllocateur::destroy(allocateur, noeud);
+        TraitsAllocateur::deallocate(allocateur, noeud, 1);
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_detruireRecursif(AllocateurNoeuds& allocateur, Noeud*& noeud)
+     * \brief Permet de libérer un sous-arbre, sans rééquilibrage
+     * \param[in] AllocateurNoeuds& allocateur, l'allocateur des noeuds (celui de l'arbre ou celui de sa forêt)
+     * \param[in] Noeud*& noeud, la racine du sous-arbre, remise à nullptr
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_detruireRecursif(AllocateurNoeuds& allocateur, Noeud*& noeud) {
+        if (noeud != nullptr) {
+            _detruireRecursif(allocateur, noeud->gauche);
+            _detruireRecursif(allocateur, noeud->droite);
+            TraitsAllocateur::destroy(allocateur, noeud);
+            TraitsAllocateur::deallocate(allocateur, noeud, 1);
+            noeud = nullptr;
+        }
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_copierRecursif(const Noeud* source, Noeud* parent)
+     * \brief Permet de copier un sous-arbre, forme et métadonnées comprises
+     * \param[in] const Noeud* source, la racine du sous-arbre à copier
+     * \param[in] Noeud* parent, le parent de la copie
+     * \return Noeud*, la racine de la copie
+     *
+     * Si une allocation échoue, la partie déjà copiée est libérée avant de relancer l'exception.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_copierRecursif(const Noeud* source, Noeud* parent) {
+        if (source == nullptr)
+            return nullptr;
+
+        Noeud* copie = _copierNoeud(*source);
+        copie->parent = parent;
+        try {
+            copie->gauche = _copierRecursif(source->gauche, copie);
+            copie->droite = _copierRecursif(source->droite, copie);
+        } catch (...) {
+            _detruireRecursif(allocateur, copie);
+            throw;
+        }
+        return copie;
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_insererRecursif(Noeud*& noeud, const Cle& cle, const Valeur& valeur, std::pair<Noeud*, bool>& resultat)
+     * \brief Permet d'ajouter une clé dans un sous-arbre et de le rééquilibrer en remontant
+     * \param[in] Noeud*& noeud, la racine du sous-arbre, remplacée si une rotation la change
+     * \param[in] const Cle& cle, la clé
+     * \param[in] const Valeur& valeur, la valeur
+     * \param[out] std::pair<Noeud*, bool>& resultat, le noeud de la clé et true si elle a été ajoutée
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_insererRecursif(Noeud*& noeud, const Cle& cle, const Valeur& valeur,
+                                                                                        std::pair<Noeud*, bool>& resultat) {
+        if (noeud == nullptr) {
+            noeud = _nouveauNoeud(cle, valeur);
+            Politique::initialiser(noeud);
+            nbNoeuds++;
+            resultat = std::make_pair(noeud, true);
+            return;
+        }
+
+        if (comparateur(cle, noeud->cle())) {
+            _insererRecursif(noeud->gauche, cle, valeur, resultat);
+        } else if (comparateur(noeud->cle(), cle)) {
+            _insererRecursif(noeud->droite, cle, valeur, resultat);
+        } else {
+            resultat = std::make_pair(noeud, false);
+            return;
+        }
+
+        Politique::apresInsertion(noeud, compteursOperations);
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_supprimerRecursif(Noeud*& noeud, const Cle& cle)
+     * \brief Permet de supprimer une clé présente dans un sous-arbre et de le rééquilibrer en remontant
+     * \param[in] Noeud*& noeud, la racine du sous-arbre, remplacée si une rotation la change
+     * \param[in] const Cle& cle, la clé à supprimer
+     *
+     * Le noeud de la clé échange sa position avec son prédécesseur ou son successeur jusqu'à ce qu'il soit une feuille,
+     * qui est retirée. Avec un seul enfant, on échange avec le prédécesseur ou le successeur plutôt qu'avec l'enfant, qui
+     * n'est pas forcément une feuille pour un treap. Seuls les liens changent : la clé et la valeur ne sont jamais copiées.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_supprimerRecursif(Noeud*& noeud, const Cle& cle) {
+        if (comparateur(noeud->cle(), cle)) {
+            _supprimerRecursif(noeud->droite, cle);
+        } else if (comparateur(cle, noeud->cle())) {
+            _supprimerRecursif(noeud->gauche, cle);
+        } else if (noeud->gauche == nullptr && noeud->droite == nullptr) {
+            _libererNoeud(noeud);
+            noeud = nullptr;
+            nbNoeuds--;
+        } else if (noeud->droite == nullptr) {
+            _echangerPositions(noeud, precedent(noeud));
+            _supprimerRecursif(noeud->gauche, cle);
+        } else {
+            _echangerPositions(noeud, suivant(noeud));
+            _supprimerRecursif(noeud->droite, cle);
+        }
+
+        Politique::apresSuppression(noeud, compteursOperations);
+    }
+
+    /**
+     * \fn bool AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_reconstruirePourLot(std::size_t tailleLot) const
+     * \brief Permet de choisir entre des modifications clé par clé et une reconstruction de l'arbre
+     * \param[in] std::size_t tailleLot, le nombre de clés du lot
+     * \return bool, true si m descentes de ~log n noeuds coûteraient plus qu'un parcours des n noeuds
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    bool AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_reconstruirePourLot(std::size_t tailleLot) const {
+        std::size_t profondeur = 1;
+        for (std::size_t n = nbNoeuds; n > 1; n >>= 1)
+            profondeur++;
+        return tailleLot > 1 && tailleLot * profondeur >= nbNoeuds;
+    }
+
+    /**
+     * \fn std::vector<Noeud*> AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_noeudsEnOrdre() const
+     * \brief Permet d'obtenir tous les noeuds en ordre des clés
+     * \return std::vector<Noeud*>, les noeuds, du plus petit au plus grand
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    std::vector<Noeud*> AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_noeudsEnOrdre() const {
+        std::vector<Noeud*> noeuds;
+        noeuds.reserve(nbNoeuds);
+        for (Noeud* noeud = premier(); noeud != nullptr; noeud = suivant(noeud)) {
+            TP3_COMPTER(compteursOperations.visitesNoeuds, 1);
+            noeuds.push_back(noeud);
+        }
+        return noeuds;
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_reconstruire(const std::vector<Noeud*>& noeuds)
+     * \brief Permet de remplacer l'arbre par celui que la politique construit sur des noeuds triés
+     * \param[in] const std::vector<Noeud*>& noeuds, tous les noeuds du nouvel arbre, en ordre des clés
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_reconstruire(const std::vector<Noeud*>& noeuds) {
+        racine = Politique::construireTrie(noeuds.data(), noeuds.size());
+        if (racine != nullptr)
+            racine->parent = nullptr;
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_joindre(Noeud* gauche, Noeud* milieu, Noeud* droite)
+     * \brief Permet de joindre 2 sous-arbres et un noeud dont la clé les sépare, selon la politique d'équilibre
+     * \return Noeud*, la racine du sous-arbre joint (son parent n'est pas ajusté)
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_joindre(Noeud* gauche, Noeud* milieu, Noeud* droite) {
+        return Politique::joindre(gauche, milieu, droite, compteursOperations);
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_joindreSansMilieu(Noeud* gauche, Noeud* droite)
+     * \brief Permet de joindre 2 sous-arbres dont les clés se suivent : le dernier noeud de gauche sert de milieu
+     * \return Noeud*, la racine du sous-arbre joint (son parent n'est pas ajusté)
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_joindreSansMilieu(Noeud* gauche, Noeud* droite) {
+        if (gauche == nullptr)
+            return droite;
+        if (droite == nullptr)
+            return gauche;
+        Noeud* dernier;
+        Noeud* reste = _retirerDernier(gauche, dernier);
+        return _joindre(reste, dernier, droite);
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_retirerDernier(Noeud* noeud, Noeud*& dernier)
+     * \brief Permet de détacher le noeud de la plus grande clé d'un sous-arbre non vide
+     * \param[in] Noeud* noeud, la racine du sous-arbre
+     * \param[out] Noeud*& dernier, le noeud détaché
+     * \return Noeud*, la racine du reste du sous-arbre, rééquilibré par jonctions en remontant la branche droite
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_retirerDernier(Noeud* noeud, Noeud*& dernier) {
+        if (noeud->droite == nullptr) {
+            dernier = noeud;
+            return noeud->gauche;
+        }
+        Noeud* reste = _retirerDernier(noeud->droite, dernier);
+        return _joindre(noeud->gauche, noeud, reste);
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_scinderRecursif(Noeud* noeud, const Cle& cle, Noeud*& gauche, Noeud*& droite)
+     * \brief Permet de séparer un sous-arbre en ses clés plus petites et plus grandes qu'une clé
+     * \param[in] Noeud* noeud, la racine du sous-arbre
+     * \param[in] const Cle& cle, la clé de séparation
+     * \param[out] Noeud*& gauche, la racine des clés plus petites
+     * \param[out] Noeud*& droite, la racine des clés plus grandes
+     * \return Noeud*, le noeud de la clé, détaché de ses enfants, nullptr si elle est absente
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_scinderRecursif(Noeud* noeud, const Cle& cle, Noeud*& gauche, Noeud*& droite) {
+        if (noeud == nullptr) {
+            gauche = nullptr;
+            droite = nullptr;
+            return nullptr;
+        }
+        TP3_COMPTER(compteursOperations.visitesNoeuds, 1);
+
+        Noeud* egal;
+        if (comparateur(cle, noeud->cle())) {
+            Noeud* milieuDroite;
+            egal = _scinderRecursif(noeud->gauche, cle, gauche, milieuDroite);
+            droite = _joindre(milieuDroite, noeud, noeud->droite);
+        } else if (comparateur(noeud->cle(), cle)) {
+            Noeud* milieuGauche;
+            egal = _scinderRecursif(noeud->droite, cle, milieuGauche, droite);
+            gauche = _joindre(noeud->gauche, noeud, milieuGauche);
+        } else {
+            gauche = noeud->gauche;
+            droite = noeud->droite;
+            noeud->gauche = nullptr;
+            noeud->droite = nullptr;
+            egal = noeud;
+        }
+        return egal;
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_combiner(AvlMap& autre, OperationEnsemble operation, Fusion& fusion)
+     * \brief Permet de faire une opération d'ensemble avec un autre arbre, puis de libérer les noeuds rejetés
+     * \param[in] AvlMap& autre, l'autre arbre, vidé par l'appel
+     * \param[in] OperationEnsemble operation, union, intersection ou différence
+     * \param[in] Fusion& fusion, la fusion des valeurs d'une clé commune (union seulement)
+     * \exception logic_error si les allocateurs des 2 arbres diffèrent
+     *
+     * Chaque noeud des 2 arbres finit dans le résultat ou parmi les rejetés : la taille du résultat s'en déduit. Les
+     * rejetés sont libérés à la fin, par ce fil, pour ne pas exiger un allocateur utilisable par plusieurs fils.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    template<typename Fusion>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_combiner(AvlMap& autre, OperationEnsemble operation, Fusion& fusion) {
+        if (&autre == this) {
+            if (operation == OPERATION_DIFFERENCE)
+                vider();
+            return;
+        }
+        if (!(allocateur == autre.allocateur))
+            throw std::logic_error("les 2 arbres d'une opération d'ensemble doivent avoir des allocateurs égaux");
+
+        detacher();
+        autre.detacher();
+        int profondeurParallele = 0;
+        if (nbNoeuds + autre.nbNoeuds >= SEUIL_PARALLELE) {
+            profondeurParallele = 1;
+            for (unsigned int fils = std::thread::hardware_concurrency(); fils > 1; fils >>= 1)
+                profondeurParallele++;
+        }
+
+        std::vector<Noeud*> rejetes;
+        const std::size_t total = nbNoeuds + autre.nbNoeuds;
+        racine = _combinerRecursif(racine, autre.racine, operation, fusion, profondeurParallele, rejetes);
+        if (racine != nullptr)
+            racine->parent = nullptr;
+        nbNoeuds = total - rejetes.size();
+        autre.racine = nullptr;
+        autre.nbNoeuds = 0;
+        for (Noeud* noeud : rejetes)
+            _libererNoeud(noeud);
+    }
+
+    /**
+     * \fn Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_combinerRecursif(Noeud* ici, Noeud* autre, OperationEnsemble operation, Fusion& fusion, int profondeurParallele, std::vector<Noeud*>& rejetes)
+     * \brief Permet de combiner 2 sous-arbres par scission et jonction
+     * \param[in] Noeud* ici, la racine du sous-arbre de cet arbre
+     * \param[in] Noeud* autre, la racine du sous-arbre de l'autre arbre
+     * \param[in] OperationEnsemble operation, union, intersection ou différence
+     * \param[in] Fusion& fusion, la fusion des valeurs d'une clé commune (union seulement)
+     * \param[in] int profondeurParallele, nombre de niveaux où le sous-arbre gauche est confié à un autre fil
+     * \param[out] std::vector<Noeud*>& rejetes, les noeuds qui ne font pas partie du résultat
+     * \return Noeud*, la racine du résultat (son parent n'est pas ajusté)
+     *
+     * L'autre sous-arbre est scindé à la clé de la racine d'ici ; les parties gauches et droites sont combinées
+     * indépendamment, puis jointes par la racine d'ici si elle reste. Le travail est O(m log(n/m + 1)) pour des arbres de
+     * n et m clés (m <= n), et la profondeur de récursion O(log n log m). Si un fil ne peut pas être créé, la partie
+     * gauche est faite par le fil courant.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    template<typename Fusion>
+    Noeud* AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_combinerRecursif(Noeud* ici, Noeud* autre, OperationEnsemble operation,
+                                                                                           Fusion& fusion, int profondeurParallele,
+                                                                                           std::vector<Noeud*>& rejetes) {
+        if (ici == nullptr) {
+            if (operation == OPERATION_UNION)
+                return autre;
+            _collecterRecursif(autre, rejetes);
+            return nullptr;
+        }
+        if (autre == nullptr) {
+            if (operation != OPERATION_INTERSECTION)
+                return ici;
+            _collecterRecursif(ici, rejetes);
+            return nullptr;
+        }
+
+        Noeud* autreGauche;
+        Noeud* autreDroite;
+        Noeud* egal = _scinderRecursif(autre, ici->cle(), autreGauche, autreDroite);
+        Noeud* iciGauche = ici->gauche;
+        Noeud* iciDroite = ici->droite;
+
+        Noeud* gauche = nullptr;
+        Noeud* droite;
+        std::vector<Noeud*> rejetesGauche;
+        std::thread filGauche;
+        if (profondeurParallele > 0) {
+            try {
+                filGauche = std::thread([&]() {
+                    gauche = _combinerRecursif(iciGauche, autreGauche, operation, fusion, profondeurParallele - 1, rejetesGauche);
+                });
+            } catch (const std::system_error&) {
+            }
+        }
+        if (!filGauche.joinable())
+            gauche = _combinerRecursif(iciGauche, autreGauche, operation, fusion, profondeurParallele - 1, rejetesGauche);
+        droite = _combinerRecursif(iciDroite, autreDroite, operation, fusion, profondeurParallele - 1, rejetes);
+        if (filGauche.joinable())
+            filGauche.join();
+        rejetes.insert(rejetes.end(), rejetesGauche.begin(), rejetesGauche.end());
+
+        const bool garderIci = egal != nullptr ? operation != OPERATION_DIFFERENCE : operation != OPERATION_INTERSECTION;
+        if (egal != nullptr) {
+            if (operation == OPERATION_UNION)
+                fusion(ici->valeur(), egal->valeur());
+            rejetes.push_back(egal);
+        }
+        if (garderIci)
+            return _joindre(gauche, ici, droite);
+        rejetes.push_back(ici);
+        return _joindreSansMilieu(gauche, droite);
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_collecterRecursif(Noeud* noeud, std::vector<Noeud*>& noeuds)
+     * \brief Permet d'ajouter tous les noeuds d'un sous-arbre à un vecteur
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_collecterRecursif(Noeud* noeud, std::vector<Noeud*>& noeuds) {
+        if (noeud == nullptr)
+            return;
+        _collecterRecursif(noeud->gauche, noeuds);
+        noeuds.push_back(noeud);
+        _collecterRecursif(noeud->droite, noeuds);
+    }
+
+    /**
+     * \fn std::size_t AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_compterPlusPetit(Noeud* premier, Noeud* second, std::size_t total)
+     * \brief Permet de compter les noeuds du premier de 2 sous-arbres qui en ont 'total' ensemble
+     * \return std::size_t, le nombre de noeuds du premier sous-arbre
+     *
+     * Les 2 sous-arbres sont parcourus en même temps : on s'arrête à la fin du plus petit, en O(min(n1, n2)).
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    std::size_t AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_compterPlusPetit(Noeud* premier, Noeud* second, std::size_t total) {
+        if (premier != nullptr)
+            premier->parent = nullptr;
+        if (second != nullptr)
+            second->parent = nullptr;
+        while (premier != nullptr && premier->gauche != nullptr)
+            premier = premier->gauche;
+        while (second != nullptr && second->gauche != nullptr)
+            second = second->gauche;
+
+        std::size_t compte = 0;
+        for (; premier != nullptr && second != nullptr; compte++) {
+            premier = suivant(premier);
+            second = suivant(second);
+        }
+        if (premier == nullptr)
+            return compte;
+        return total - compte;
+    }
+
+    /**
+     * \fn void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_echangerPositions(Noeud*& lienAncetre, Noeud* descendant)
+     * \brief Permet d'échanger la position de 2 noeuds dans l'arbre, sans toucher à leur contenu
+     * \param[in] Noeud*& lienAncetre, le lien (racine ou enfant de son parent) vers le noeud du haut ; il désignera le descendant
+     * \param[in] Noeud* descendant, un noeud du sous-arbre de l'ancêtre
+     *
+     * Chaque noeud prend les enfants, le parent et la métadonnée d'équilibre de l'autre : l'arbre a exactement la forme
+     * qu'il aurait eue si on avait échangé les contenus, ce que les politiques d'équilibre supposent.
+     *
+     */
+    template<typename Cle, typename Valeur, typename Comparateur, typename Allocateur, typename Politique, typename Noeud>
+    void AvlMap<Cle, Valeur, Comparateur, Allocateur, Politique, Noeud>::_echangerPositions(Noeud*& lienAncetre, Noeud* descendant) {
+        Noeud* ancetre = lienAncetre;
+        std::swap(ancetre->hauteur, descendant->hauteur);
+
+        if (descendant->parent == ancetre) {
+            const bool aGauche = ancetre->gauche == descendant;
+            Noeud* frere = aGauche ? ancetre->droite : ancetre->gauche;
+            ancetre->gauche = descendant->gauche;
+            ancetre->droite = descendant->droite;
+            descendant->gauche = aGauche ? ancetre : frere;
+            descendant->droite = aGauche ? frere : ancetre;
+            descendant->parent = ancetre->parent;
+        } else {
+            Noeud*& lienDescendant = descendant->parent->gauche == descendant ? descendant->parent->gauche : descendant->parent->droite;
+            lienDescendant = ancetre;
+            std::swap(ancetre->gauche, descendant->gauche);
+            std::swap(ancetre->droite, descendant->droite);
+            std::swap(ancetre->parent, descendant->parent);
+        }
+        lienAncetre = descendant;
+
+        for (Noeud* noeud : { ancetre, descendant }) {
+            if (noeud->gauche != nullptr)
+                noeud->gauche->parent = noeud;
+            if (noeud->droite != nullptr)
+                noeud->droite->parent = noeud;
+        }
+    }
+
+}
+
+#endif /* AVLMAP_H_ */
@@ -0,0 +1,83 @@
+/**
+ * \file BlocsFiges.cpp
+ * \brief Ce fichier contient une implantation des fonctions qui rangent les chaînes des dictionnaires figés
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "BlocsFiges.h"
+
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace TP3
+{
+
+    namespace
+    {
+        const uint64_t POSITION_MAX = numeric_limits<uint32_t>::max();
+    }
+
+    /**
+     * \fn void ajouterMotFige(const std::string &mot, std::string &bloc, std::vector<std::uint32_t> &debuts, const char *nomDictionnaire)
+     * \brief Permet d'ajouter un mot au bout du bloc des mots
+     * \param[in] const std::string &mot, le mot
+     * \param[in,out] std::string &bloc, les mots précédents, bout à bout
+     * \param[in,out] std::vector<std::uint32_t> &debuts, la fin de chaque mot dans le bloc
+     * \param[in] const char *nomDictionnaire, le dictionnaire en construction, pour le message d'erreur ("dictionnaire fige")
+     * \exception logic_error si le bloc dépasse 2^32 - 1 octets ou s'il y a plus de 2^32 - 1 mots
+     */
+    void ajouterMotFige(const std::string &mot, std::string &bloc, std::vector<std::uint32_t> &debuts,
+                        const char *nomDictionnaire) {
+        bloc += mot;
+        if (bloc.size() > POSITION_MAX || debuts.size() >= POSITION_MAX)
+            throw logic_error(string("les mots depassent la taille maximale d'un ") + nomDictionnaire);
+        debuts.push_back(static_cast<uint32_t>(bloc.size()));
+    }
+
+    /**
+     * \fn void ajouterTraductionsFigees(const std::vector<std::string> &traductions, std::string &bloc, std::vector<std::uint32_t> &debuts, std::vector<std::uint32_t> &premieres, const char *nomDictionnaire)
+     * \brief Permet d'ajouter les traductions d'un mot au bout du bloc des traductions
+     * \param[in] const std::vector<std::string> &traductions, les traductions du mot, dans l'ordre
+     * \param[in,out] std::string &bloc, les traductions des mots précédents, bout à bout
+     * \param[in,out] std::vector<std::uint32_t> &debuts, la fin de chaque traduction dans le bloc
+     * \param[in,out] std::vector<std::uint32_t> &premieres, l'indice de la première traduction de chaque mot
+     * \param[in] const char *nomDictionnaire, le dictionnaire en construction, pour le message d'erreur ("dictionnaire fige")
+     * \exception logic_error si le bloc dépasse 2^32 - 1 octets ou s'il y a plus de 2^32 - 1 traductions
+     */
+    void ajouterTraductionsFigees(const std::vector<std::string> &traductions, std::string &bloc,
+                                  std::vector<std::uint32_t> &debuts, std::vector<std::uint32_t> &premieres,
+                                  const char *nomDictionnaire) {
+        for (const auto & traduction : traductions) {
+            bloc += traduction;
+            if (bloc.size() > POSITION_MAX || debuts.size() > POSITION_MAX)
+                throw logic_error(string("les traductions depassent la taille maximale d'un ") + nomDictionnaire);
+            debuts.push_back(static_cast<uint32_t>(bloc.size()));
+        }
+        premieres.push_back(static_cast<uint32_t>(debuts.size() - 1));
+    }
+
+    /**
+     * \fn std::vector<std::string> lireTraductionsFigees(std::size_t i, const std::string &bloc, const std::vector<std::uint32_t> &debuts, const std::vector<std::uint32_t> &premieres)
+     * \brief Permet de recopier les traductions d'un mot
+     * \param[in] std::size_t i, le rang du mot
+     * \param[in] const std::string &bloc, les traductions, bout à bout
+     * \param[in] const std::vector<std::uint32_t> &debuts, la fin de chaque traduction dans le bloc
+     * \param[in] const std::vector<std::uint32_t> &premieres, l'indice de la première traduction de chaque mot
+     * \return std::vector<std::string>, les traductions du mot i
+     */
+    std::vector<std::string> lireTraductionsFigees(std::size_t i, const std::string &bloc,
+                                                   const std::vector<std::uint32_t> &debuts,
+                                                   const std::vector<std::uint32_t> &premieres) {
+        vector<string> traductions;
+        traductions.reserve(premieres[i + 1] - premieres[i]);
+        for (uint32_t j = premieres[i]; j < premieres[i + 1]; j++)
+            traductions.push_back(bloc.substr(debuts[j], debuts[j + 1] - debuts[j]));
+        return traductions;
+    }
+
+}//Fin du namespace
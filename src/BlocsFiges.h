@@ -0,0 +1,45 @@
+/**
+ * \file BlocsFiges.h
+ * \brief Ce fichier contient l'interface des fonctions qui rangent les chaînes des dictionnaires figés bout à bout.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ * DictionnaireFige, DictionnaireEytzinger et DictionnaireCompact gardent leurs chaînes dans un seul bloc (std::string),
+ * avec la position de fin de chaque chaîne sur 32 bits : le mot i va de debuts[i] à debuts[i + 1], et les traductions
+ * du mot i sont les chaînes premieres[i] à premieres[i + 1] - 1 du bloc des traductions. Les vecteurs de positions
+ * commencent par un 0. DictionnaireCompact n'y range que ses traductions : ses mots sont codés par préfixe commun.
+ *
+ */
+
+#ifndef BLOCSFIGES_H_
+#define BLOCSFIGES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TP3
+{
+
+	//Ajouter un mot au bout du bloc des mots et noter sa fin dans 'debuts'
+	//Exception logic_error si les positions ne tiennent pas sur 32 bits (le message nomme 'nomDictionnaire')
+	void ajouterMotFige(const std::string& mot, std::string& bloc, std::vector<std::uint32_t>& debuts,
+	                    const char* nomDictionnaire);
+
+	//Ajouter les traductions d'un mot au bout du bloc des traductions, noter la fin de chacune dans 'debuts' et
+	//l'indice de la première traduction du mot suivant dans 'premieres'
+	//Exception logic_error si les positions ne tiennent pas sur 32 bits (le message nomme 'nomDictionnaire')
+	void ajouterTraductionsFigees(const std::vector<std::string>& traductions, std::string& bloc,
+	                              std::vector<std::uint32_t>& debuts, std::vector<std::uint32_t>& premieres,
+	                              const char* nomDictionnaire);
+
+	//Les traductions du mot i, recopiées du bloc des traductions
+	std::vector<std::string> lireTraductionsFigees(std::size_t i, const std::string& bloc,
+	                                               const std::vector<std::uint32_t>& debuts,
+	                                               const std::vector<std::uint32_t>& premieres);
+
+}
+
+#endif /* BLOCSFIGES_H_ */
@@ -0,0 +1,228 @@
+/**
+ * \file CacheSuggestions.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe CacheSuggestions
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "CacheSuggestions.h"
+
+#include <functional>
+#include <stdexcept>
+
+using namespace std;
+
+namespace TP3
+{
+
+    /**
+     * \fn CacheSuggestions::CacheSuggestions(std::size_t capacite, std::size_t nbFragments)
+     * \brief Constructeur d'un cache vide
+     * \param[in] std::size_t capacite, le nombre maximal de mots
+     * \param[in] std::size_t nbFragments, le nombre de fragments souhaité
+     * \exception logic_error si la capacité ou le nombre de fragments est 0
+     *
+     * Le nombre de fragments est arrondi à la puissance de 2 inférieure et réduit au besoin pour que chaque fragment ait
+     * au moins une case. La capacité est répartie également ; le total peut donc être légèrement inférieur à 'capacite'.
+     *
+     */
+    CacheSuggestions::CacheSuggestions(std::size_t capacite, std::size_t nbFragments) :
+            fragments(), masqueFragments(0), capaciteTotale(0), nbSucces(0), nbEchecs(0) {
+        if (capacite == 0 || nbFragments == 0)
+            throw logic_error("le cache doit avoir au moins une case et un fragment");
+
+        size_t nbFragmentsReels = 1;
+        while (nbFragmentsReels * 2 <= nbFragments && nbFragmentsReels * 2 <= capacite)
+            nbFragmentsReels *= 2;
+
+        const size_t casesParFragment = capacite / nbFragmentsReels;
+        fragments = vector<Fragment>(nbFragmentsReels);
+        for (auto & fragment : fragments) {
+            Entree entreeLibre = { string(), vector<string>(), 0, false, false };
+            fragment.entrees.assign(casesParFragment, entreeLibre);
+            fragment.positions.reserve(casesParFragment);
+            fragment.aiguille = 0;
+        }
+        masqueFragments = nbFragmentsReels - 1;
+        capaciteTotale = casesParFragment * nbFragmentsReels;
+    }
+
+    /**
+     * \fn bool CacheSuggestions::trouver(const std::string &motMalEcrit, unsigned long long generation, std::vector<std::string> &suggestions)
+     * \brief Permet de chercher des suggestions dans le cache
+     * \param[in] const std::string &motMalEcrit, le mot cherché
+     * \param[in] unsigned long long generation, la génération courante du dictionnaire
+     * \param[out] std::vector<std::string> &suggestions, les suggestions trouvées
+     * \return bool, true si le mot est dans le cache avec la même génération
+     */
+    bool CacheSuggestions::trouver(const std::string &motMalEcrit, unsigned long long generation, std::vector<std::string> &suggestions) {
+        Fragment& fragment = _fragment(motMalEcrit);
+        {
+            lock_guard<mutex> verrouillage(fragment.verrou);
+            auto position = fragment.positions.find(motMalEcrit);
+            if (position != fragment.positions.end() && fragment.entrees[position->second].generation == generation) {
+                Entree& entree = fragment.entrees[position->second];
+                entree.reference = true;
+                suggestions = entree.suggestions;
+                nbSucces.fetch_add(1, memory_order_relaxed);
+                return true;
+            }
+        }
+        nbEchecs.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * \fn void CacheSuggestions::inserer(const std::string &motMalEcrit, unsigned long long generation, const std::vector<std::string> &suggestions)
+     * \brief Permet d'ajouter ou de remplacer les suggestions d'un mot
+     * \param[in] const std::string &motMalEcrit, le mot
+     * \param[in] unsigned long long generation, la génération du dictionnaire lors du calcul
+     * \param[in] const std::vector<std::string> &suggestions, les suggestions calculées
+     *
+     * Si le fragment est plein, l'aiguille avance en effaçant les bits de référence jusqu'à une case non référencée,
+     * qui est remplacée. Une nouvelle entrée n'est pas marquée référencée : elle doit être relue pour survivre à un tour.
+     *
+     */
+    void CacheSuggestions::inserer(const std::string &motMalEcrit, unsigned long long generation, const std::vector<std::string> &suggestions) {
+        Fragment& fragment = _fragment(motMalEcrit);
+        lock_guard<mutex> verrouillage(fragment.verrou);
+
+        auto position = fragment.positions.find(motMalEcrit);
+        if (position != fragment.positions.end()) {
+            Entree& entree = fragment.entrees[position->second];
+            entree.suggestions = suggestions;
+            entree.generation = generation;
+            return;
+        }
+
+        const size_t nbCases = fragment.entrees.size();
+        while (fragment.entrees[fragment.aiguille].occupee && fragment.entrees[fragment.aiguille].reference) {
+            fragment.entrees[fragment.aiguille].reference = false;
+            fragment.aiguille = (fragment.aiguille + 1) % nbCases;
+        }
+
+        const size_t victime = fragment.aiguille;
+        Entree& entree = fragment.entrees[victime];
+        if (entree.occupee)
+            fragment.positions.erase(entree.motMalEcrit);
+
+        entree.motMalEcrit = motMalEcrit;
+        entree.suggestions = suggestions;
+        entree.generation = generation;
+        entree.reference = false;
+        entree.occupee = true;
+        fragment.positions[motMalEcrit] = victime;
+        fragment.aiguille = (victime + 1) % nbCases;
+    }
+
+    /**
+     * \fn void CacheSuggestions::vider()
+     * \brief Permet de retirer toutes les entrées du cache
+     */
+    void CacheSuggestions::vider() {
+        for (auto & fragment : fragments) {
+            lock_guard<mutex> verrouillage(fragment.verrou);
+            for (auto & entree : fragment.entrees) {
+                entree.motMalEcrit.clear();
+                entree.suggestions.clear();
+                entree.reference = false;
+                entree.occupee = false;
+            }
+            fragment.positions.clear();
+            fragment.aiguille = 0;
+        }
+    }
+
+    /**
+     * \fn std::size_t CacheSuggestions::taille() const
+     * \brief Permet de connaître le nombre de mots dans le cache
+     * \return std::size_t, le nombre d'entrées occupées
+     */
+    std::size_t CacheSuggestions::taille() const {
+        size_t total = 0;
+        for (const auto & fragment : fragments) {
+            lock_guard<mutex> verrouillage(fragment.verrou);
+            total += fragment.positions.size();
+        }
+        return total;
+    }
+
+    /**
+     * \fn std::size_t CacheSuggestions::capacite() const
+     * \brief Permet de connaître le nombre maximal de mots
+     * \return std::size_t, la capacité totale des fragments
+     */
+    std::size_t CacheSuggestions::capacite() const {
+        return capaciteTotale;
+    }
+
+    /**
+     * \fn std::size_t CacheSuggestions::empreinteMemoire() const
+     * \brief Permet de connaître la mémoire occupée par le cache
+     * \return std::size_t, le nombre d'octets alloués
+     *
+     * Les cases sont allouées à la construction ; ce qui grossit avec le remplissage est compté selon son contenu actuel :
+     * les chaînes qui dépassent le tampon interne de std::string, les tableaux de suggestions et les noeuds des tables de
+     * positions (une paire et un pointeur de chaînage, sans le surcoût de l'allocateur).
+     *
+     */
+    std::size_t CacheSuggestions::empreinteMemoire() const {
+        const size_t capaciteInterne = std::string().capacity(); //au-delà, le contenu d'une chaîne est alloué sur le monceau
+        size_t octets = fragments.capacity() * sizeof(Fragment);
+        for (const auto & fragment : fragments) {
+            lock_guard<mutex> verrouillage(fragment.verrou);
+            octets += fragment.entrees.capacity() * sizeof(Entree);
+            for (const auto & entree : fragment.entrees) {
+                if (entree.motMalEcrit.capacity() > capaciteInterne)
+                    octets += entree.motMalEcrit.capacity() + 1;
+                octets += entree.suggestions.capacity() * sizeof(std::string);
+                for (const auto & suggestion : entree.suggestions)
+                    if (suggestion.capacity() > capaciteInterne)
+                        octets += suggestion.capacity() + 1;
+            }
+            octets += fragment.positions.bucket_count() * sizeof(void*);
+            for (const auto & position : fragment.positions) {
+                octets += sizeof(position) + sizeof(void*);
+                if (position.first.capacity() > capaciteInterne)
+                    octets += position.first.capacity() + 1;
+            }
+        }
+        return octets;
+    }
+
+    /**
+     * \fn unsigned long long CacheSuggestions::succes() const
+     * \brief Permet de connaître le nombre de consultations réussies
+     * \return unsigned long long, le nombre de succès
+     */
+    unsigned long long CacheSuggestions::succes() const {
+        return nbSucces.load(memory_order_relaxed);
+    }
+
+    /**
+     * \fn unsigned long long CacheSuggestions::echecs() const
+     * \brief Permet de connaître le nombre de consultations ratées
+     * \return unsigned long long, le nombre d'échecs
+     */
+    unsigned long long CacheSuggestions::echecs() const {
+        return nbEchecs.load(memory_order_relaxed);
+    }
+
+    /**
+     * \fn CacheSuggestions::Fragment& CacheSuggestions::_fragment(const std::string &motMalEcrit)
+     * \brief Permet de trouver le fragment responsable d'un mot
+     * \param[in] const std::string &motMalEcrit, le mot
+     * \return CacheSuggestions::Fragment&, le fragment choisi par les bits de poids fort du hachage
+     *
+     * On prend les bits de poids fort pour ne pas corréler le choix du fragment avec les positions de la table de hachage
+     * du fragment, qui utilise les bits de poids faible.
+     *
+     */
+    CacheSuggestions::Fragment& CacheSuggestions::_fragment(const std::string &motMalEcrit) {
+        const size_t hachage = hash<string>()(motMalEcrit);
+        return fragments[(hachage >> (sizeof(size_t) * 8 - 16)) & masqueFragments];
+    }
+
+}//Fin du namespace
@@ -0,0 +1,116 @@
+/**
+ * \file CacheSuggestions.h
+ * \brief Ce fichier contient l'interface d'un cache borné, fragmenté et à remplacement CLOCK des suggestions de correction.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef CACHESUGGESTIONS_H_
+#define CACHESUGGESTIONS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TP3
+{
+
+/**
+ * \class CacheSuggestions
+ * \brief Cache mot mal écrit -> suggestions, sûr entre plusieurs fils, de capacité fixe
+ *
+ *  Les entrées sont réparties entre plusieurs fragments selon le hachage du mot ; chaque fragment a son propre verrou,
+ *  ce qui limite la contention entre fils. Dans un fragment, le remplacement suit l'algorithme CLOCK : une aiguille
+ *  parcourt les cases et donne une seconde chance à celles qui ont été lues depuis son dernier passage.
+ *
+ *  Chaque entrée garde la génération du dictionnaire au moment du calcul. Une entrée dont la génération diffère de
+ *  celle demandée est périmée : elle compte comme un échec et sera remplacée par le prochain ajout.
+ *
+ *  Attributs:
+ *      - std::vector<Fragment> fragments, les fragments (puissance de 2)
+ *      - std::atomic<unsigned long long> succes, echecs, les compteurs de consultations
+ *
+ */
+class CacheSuggestions
+{
+public:
+
+	//Constructeur d'un cache vide d'au plus 'capacite' mots. Le nombre de fragments est arrondi à une puissance de 2.
+	//Exception logic_error si la capacité ou le nombre de fragments est 0
+	explicit CacheSuggestions(std::size_t capacite, std::size_t nbFragments = 16);
+
+	CacheSuggestions(const CacheSuggestions&) = delete;
+	CacheSuggestions& operator=(const CacheSuggestions&) = delete;
+
+	//Chercher les suggestions d'un mot calculées à la génération donnée. On retourne false si elles ne sont pas dans le cache.
+	bool trouver(const std::string& motMalEcrit, unsigned long long generation, std::vector<std::string>& suggestions);
+
+	//Ajouter (ou remplacer) les suggestions d'un mot calculées à la génération donnée
+	void inserer(const std::string& motMalEcrit, unsigned long long generation, const std::vector<std::string>& suggestions);
+
+	//Vider le cache (les compteurs de consultations sont conservés)
+	void vider();
+
+	//Nombre de mots dans le cache, entrées périmées comprises
+	std::size_t taille() const;
+
+	//Nombre maximal de mots dans le cache
+	std::size_t capacite() const;
+
+	//Octets occupés par les cases, les mots et suggestions qu'elles gardent, et les tables de positions
+	std::size_t empreinteMemoire() const;
+
+	//Nombre de consultations réussies
+	unsigned long long succes() const;
+
+	//Nombre de consultations ratées (mot absent ou entrée périmée)
+	unsigned long long echecs() const;
+
+private:
+
+    /**
+     * \struct Entree
+     * \brief Une case d'un fragment : le mot, ses suggestions, leur génération et le bit de référence de CLOCK
+     */
+    struct Entree
+    {
+        std::string motMalEcrit;
+        std::vector<std::string> suggestions;
+        unsigned long long generation;
+        bool reference;
+        bool occupee;
+    };
+
+    /**
+     * \struct Fragment
+     * \brief Une partie indépendante du cache, avec son verrou, ses cases, son index et son aiguille
+     */
+    struct Fragment
+    {
+        mutable std::mutex verrou;
+        std::vector<Entree> entrees;
+        std::unordered_map<std::string, std::size_t> positions;
+        std::size_t aiguille;
+    };
+
+    std::vector<Fragment> fragments;
+    std::size_t masqueFragments;
+    std::size_t capaciteTotale;
+    std::atomic<unsigned long long> nbSucces;
+    std::atomic<unsigned long long> nbEchecs;
+
+    //region private methods
+
+    Fragment& _fragment(const std::string& motMalEcrit);
+
+    //endregion
+};
+
+}
+
+#endif /* CACHESUGGESTIONS_H_ */
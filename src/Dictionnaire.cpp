@@ -8,12 +8,20 @@
  */
 
 #include "Dictionnaire.h"
+#include "DictionnaireFige.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
 
 using namespace std;
 
 // Limite du nombre de suggestions
 #define LIMITE_SUGGESTIONS 5
 
+// Capacité en dessous de laquelle le budget mémoire désactive le cache de suggestions au lieu de le réduire
+#define CAPACITE_MINIMALE_CACHE_BUDGET 16
+
 namespace TP3
 {
        
@@ -23,64 +31,18 @@ namespace TP3
      * \note le stream de fichier doit être ouvert et fermé par l'appelant
      * \param[in] std::ifstream &fichier, Le fichier à partir duquel on construit le dictionnaire
      */
-	Dictionnaire::Dictionnaire(std::ifstream &fichier): racine(nullptr), cpt(0)
+	Dictionnaire::Dictionnaire(std::ifstream &fichier): indexHachage(), indexActif(false),
+	        cacheSuggestions(nullptr), generation(0), filtreBloom(), filtreActif(false), motsSupprimesDuFiltre(0),
+	        suppressionDifferee(false), proportionMaximalePierresTombales(0.25), nbPierresTombales(0),
+	        budgetOctets(0), prochaineVerificationBudget(0), nbDegradationsBudget(0)
     {
         if (fichier)
         {
+            std::string motAnglais, motTraduit;
             for( std::string ligneDico; getline( fichier, ligneDico); )
             {
-                if (ligneDico[0] != '#') //Élimine les lignes d'en-tête
+                if (_analyserLigne(ligneDico, motAnglais, motTraduit))
                 {
-                    // Le mot anglais est avant la tabulation (\t).
-                    std::string motAnglais = ligneDico.substr(0,ligneDico.find_first_of('\t'));
-                    
-                    // Le reste (définition) est après la tabulation (\t).
-                    std::string motTraduit = ligneDico.substr(motAnglais.length()+1, ligneDico.length()-1);
-
-                    //On élimine tout ce qui est entre crochets [] (possibilité de 2 ou plus)
-                    std::size_t pos = motTraduit.find_first_of('[');
-                    while (pos!=std::string::npos)
-                    {
-                        std::size_t longueur_crochet = motTraduit.find_first_of(']')-pos+1;
-                        motTraduit.replace(pos, longueur_crochet, "");
-                        pos = motTraduit.find_first_of('[');
-                    }
-                    
-                    //On élimine tout ce qui est entre deux parenthèses () (possibilité de 2 ou plus)
-                    pos = motTraduit.find_first_of('(');
-                    while (pos!=std::string::npos)
-                    {
-                        std::size_t longueur_crochet = motTraduit.find_first_of(')')-pos+1;
-                        motTraduit.replace(pos, longueur_crochet, "");
-                        pos = motTraduit.find_first_of('(');
-                    }
-
-                    //Position d'un tilde, s'il y a lieu
-                    std::size_t posT = motTraduit.find_first_of('~');
-                    
-                    //Position d'un tilde, s'il y a lieu
-                    std::size_t posD = motTraduit.find_first_of(':');
-                    
-                    if (posD < posT)
-                    {
-                        //Quand le ':' est avant le '~', le mot français précède le ':'
-                        motTraduit = motTraduit.substr(0, posD);
-                    }
-                    
-                    else
-                    {
-                        //Quand le ':' est après le '~', le mot français suit le ':'
-                        if (posT < posD)
-                        {
-                            motTraduit = motTraduit.substr(posD, motTraduit.find_first_of("([,;\n", posD));
-                        }
-                        else
-                        {
-                            //Quand il n'y a ni ':' ni '~', on extrait simplement ce qu'il y a avant un caractère de limite
-                            motTraduit = motTraduit.substr(0, motTraduit.find_first_of("([,;\n"));
-                        }
-                    }
-                    
                     //On ajoute le mot au dictionnaire
                     ajouteMot(motAnglais, motTraduit);
                     //std::cout<<motAnglais << " - " << motTraduit<<std::endl;
@@ -93,21 +55,123 @@ namespace TP3
      * \fn Dictionnaire::Dictionnaire()
      * \brief Constructeur sans paramètre d'un dictionnaire. Initialize un dictionnaire vide
      *
-     * L'attribut 'racine' est initialisé avec un pointeur null, i.e. ne pointe vers rien sur le monceau.
+     * L'arbre (AvlMap) est construit vide : l'attribut 'racine' est un pointeur null, i.e. ne pointe vers rien sur le monceau.
      *
      */
-    Dictionnaire::Dictionnaire() : cpt(0), racine(nullptr) {}
+    Dictionnaire::Dictionnaire() : indexHachage(), indexActif(false), cacheSuggestions(nullptr), generation(0),
+                                       filtreBloom(), filtreActif(false), motsSupprimesDuFiltre(0),
+                                       suppressionDifferee(false), proportionMaximalePierresTombales(0.25), nbPierresTombales(0),
+                                       budgetOctets(0), prochaineVerificationBudget(0), nbDegradationsBudget(0) {}
 
     /**
      * \fn Dictionnaire::~Dictionnaire()
      * \brief Destructeur d'un dictionnaire
-     * \note On utilise pas la méthode 'supprimeMot' ici car celle-ci balance l'arbre AVL à chaque appel, ce qui est inutile pour la destruction
      *
-     * Le destructeur appel la méthode récursive '_detruireRecursif' qui libère la mémoire allouée sur le monceau pour chaque noeud.
+     * Les noeuds sont libérés par le destructeur d'AvlMap, sans rééquilibrage.
      *
      */
     Dictionnaire::~Dictionnaire() {
-        _detruireRecursif(racine);
+        delete cacheSuggestions;
+    }
+
+    /**
+     * \fn Dictionnaire::Dictionnaire(const Dictionnaire& source)
+     * \brief Constructeur de copie
+     * \param[in] const Dictionnaire& source, le dictionnaire copié
+     *
+     * L'AvlMap copie les noeuds et leur forme, pierres tombales comprises. L'index de hachage désigne des noeuds : il est
+     * reconstruit sur ceux de la copie. Le filtre de Bloom ne dépend que des mots et est copié tel quel. Le cache repart vide, avec la même capacité.
+     * En mode grandes pages, la copie a sa propre arène (AllocateurArene::select_on_container_copy_construction).
+     *
+     */
+    Dictionnaire::Dictionnaire(const Dictionnaire& source) : ArbreMots(source), indexHachage(), indexActif(false),
+            cacheSuggestions(nullptr), generation(source.generation), filtreBloom(source.filtreBloom),
+            filtreActif(source.filtreActif), motsSupprimesDuFiltre(source.motsSupprimesDuFiltre),
+            suppressionDifferee(source.suppressionDifferee),
+            proportionMaximalePierresTombales(source.proportionMaximalePierresTombales),
+            nbPierresTombales(source.nbPierresTombales), budgetOctets(source.budgetOctets),
+            prochaineVerificationBudget(source.prochaineVerificationBudget), nbDegradationsBudget(0) {
+        if (source.indexActif)
+            activeIndexHachage();
+        if (source.cacheSuggestions != nullptr)
+            activeCacheSuggestions(source.cacheSuggestions->capacite());
+    }
+
+    /**
+     * \fn Dictionnaire::Dictionnaire(Dictionnaire&& source)
+     * \brief Constructeur de déplacement
+     * \param[in] Dictionnaire&& source, le dictionnaire déplacé ; il devient vide
+     */
+    Dictionnaire::Dictionnaire(Dictionnaire&& source) : Dictionnaire() {
+        swap(source);
+    }
+
+    /**
+     * \fn Dictionnaire& Dictionnaire::operator=(Dictionnaire source)
+     * \brief Affectation par copie ou par déplacement
+     * \param[in] Dictionnaire source, la copie (ou le dictionnaire déplacé) qui prend la place de celui-ci
+     * \return Dictionnaire&, le dictionnaire modifié
+     *
+     * L'ancien contenu part avec 'source' et est libéré à la sortie de la méthode.
+     *
+     */
+    Dictionnaire& Dictionnaire::operator=(Dictionnaire source) {
+        swap(source);
+        return *this;
+    }
+
+    /**
+     * \fn void Dictionnaire::swap(Dictionnaire& autre)
+     * \brief Permet d'échanger le contenu de 2 dictionnaires sans copier de mot
+     * \param[in] Dictionnaire& autre, l'autre dictionnaire
+     *
+     * Le cache suit sa génération : ses entrées restent valides pour l'arbre avec lequel elles sont échangées.
+     *
+     */
+    void Dictionnaire::swap(Dictionnaire& autre) {
+        ArbreMots::swap(autre);
+        std::swap(indexHachage, autre.indexHachage);
+        std::swap(indexActif, autre.indexActif);
+        std::swap(cacheSuggestions, autre.cacheSuggestions);
+        std::swap(generation, autre.generation);
+        filtreBloom.swap(autre.filtreBloom);
+        std::swap(filtreActif, autre.filtreActif);
+        std::swap(motsSupprimesDuFiltre, autre.motsSupprimesDuFiltre);
+        std::swap(suppressionDifferee, autre.suppressionDifferee);
+        std::swap(proportionMaximalePierresTombales, autre.proportionMaximalePierresTombales);
+        std::swap(nbPierresTombales, autre.nbPierresTombales);
+        std::swap(budgetOctets, autre.budgetOctets);
+        std::swap(prochaineVerificationBudget, autre.prochaineVerificationBudget);
+        std::swap(nbDegradationsBudget, autre.nbDegradationsBudget);
+    }
+
+    /**
+     * \fn Dictionnaire Dictionnaire::copieDifferee() const
+     * \brief Permet de copier le dictionnaire en remettant la copie des mots à la première modification
+     * \return Dictionnaire, la copie
+     *
+     * Les noeuds sont partagés (AvlMap::copieDifferee) : l'index de hachage de la copie peut donc désigner les mêmes
+     * noeuds. Le premier des 2 dictionnaires qui est modifié copie tous les noeuds et reconstruit son index
+     * (_detacherArbre), en O(n) : c'est une copie complète, seulement retardée.
+     *
+     */
+    Dictionnaire Dictionnaire::copieDifferee() const {
+        Dictionnaire copie;
+        copie.ArbreMots::operator=(ArbreMots::copieDifferee());
+        copie.indexHachage = indexHachage;
+        copie.indexActif = indexActif;
+        copie.generation = generation;
+        copie.filtreBloom = filtreBloom;
+        copie.filtreActif = filtreActif;
+        copie.motsSupprimesDuFiltre = motsSupprimesDuFiltre;
+        copie.suppressionDifferee = suppressionDifferee;
+        copie.proportionMaximalePierresTombales = proportionMaximalePierresTombales;
+        copie.nbPierresTombales = nbPierresTombales;
+        if (cacheSuggestions != nullptr)
+            copie.activeCacheSuggestions(cacheSuggestions->capacite());
+        copie.budgetOctets = budgetOctets;
+        copie.prochaineVerificationBudget = prochaineVerificationBudget;
+        return copie;
     }
 
     /**
@@ -117,13 +181,34 @@ namespace TP3
      * \param[in] const std::string &motTraduit, la traduction du mot à ajouter
      * \post le dictionnaire aura : un mot de plus || une traduction de plus || rien de plus
      *
-     * Appel la fonction récursive '_ajouterRecursif' qui fait tout le travail. Si le mot est déjà dans le dictionnaire,
-     * seulement la traduction sera ajoutée aux traductions du mot si elle n'est pas déjà là.
+     * L'AvlMap ajoute le mot comme feuille, puis la politique d'équilibre (AVL par défaut, voir PolitiquesEquilibre.h)
+     * corrige chaque noeud du chemin en remontant. Si le mot est déjà dans le dictionnaire, seulement la traduction sera
+     * ajoutée aux traductions du mot si elle n'est pas déjà là. Un mot dont le noeud est une pierre tombale est ranimé sur
+     * place, avec cette seule traduction.
+     * Les suggestions ne dépendent que des mots et de la forme de l'arbre : la génération n'avance que si un mot est ajouté.
      *
      */
     void Dictionnaire::ajouteMot(const std::string &motOriginal, const std::string &motTraduit) {
+        TP3_CHRONOMETRER(latences[OPERATION_AJOUTE_MOT]);
+
+        _detacherArbre();
+        const pair<NoeudDictionnaire*, bool> ajout = inserer(motOriginal, vector<string>(1, motTraduit));
+        if (!ajout.second && ajout.first->supprime) {
+            _ranimer(ajout.first, vector<string>(1, motTraduit));
+        } else if (!ajout.second) {
+            if (!_vecteurContient(ajout.first->traductions, motTraduit))
+                ajout.first->traductions.push_back(motTraduit);
+            return;
+        }
 
-        _ajouterRecursif(racine, motOriginal, motTraduit);
+        if (indexActif)
+            indexHachage.inserer(ajout.first);
+        if (filtreActif)
+            filtreBloom.ajouter(motOriginal);
+        generation++;
+        if (filtreActif && _nombreMotsVivants() > 2 * filtreBloom.capacitePrevue())
+            _reconstruireFiltreBloom();
+        _verifierBudget();
     }
 
     /**
@@ -134,20 +219,237 @@ namespace TP3
      * \post le dictionnaire avec un noeud en moins, toujours balancé
      * \exception logic_error si l'arbre est vide ou si le mot à enlever n'appartient pas à l'arbre
      *
-     * Appel la fonction récursive '_supprimerMotRecursif' à partir de la racine.
+     * L'AvlMap déplace le noeud du mot jusqu'à une feuille en échangeant des liens, sans toucher aux autres mots : les
+     * poignées de l'index restent valides et seul le mot supprimé en est retiré.
+     * En mode suppression différée, le noeud est seulement marqué (aucune rotation) ; l'arbre est compacté si la proportion
+     * de pierres tombales dépasse la borne choisie.
      *
      */
     void Dictionnaire::supprimeMot(const std::string &motOriginal) {
+        TP3_CHRONOMETRER(latences[OPERATION_SUPPRIME_MOT]);
 
 	    if (estVide())
 	        throw logic_error("arbre est vide");
 	    if (!appartient(motOriginal))
 	        throw logic_error("Impossible de supprimer un mot qui n'appartien pas au dictionnaire");
-        _supprimerMotRecursif(racine, motOriginal);
+        _detacherArbre();
+        if (indexActif)
+            indexHachage.retirer(motOriginal);
+        if (suppressionDifferee)
+            _marquerSupprime(trouver(motOriginal));
+        else
+            supprimer(motOriginal);
+        generation++;
+        if (filtreActif && static_cast<size_t>(++motsSupprimesDuFiltre) > _nombreMotsVivants() / 4)
+            _reconstruireFiltreBloom();
+        _compacterSiNecessaire();
+    }
+
+    /**
+     * \fn void Dictionnaire::ajouteMots(const std::vector<std::pair<std::string, std::string> > &motsTraduits)
+     * \brief Permet d'ajouter un lot de mots et de traductions, avec le même résultat que ajouteMot sur chaque paire
+     * \param[in] const std::vector<std::pair<std::string, std::string> > &motsTraduits, les paires (mot, traduction), dans n'importe quel ordre
+     *
+     * Le lot est trié et regroupé par mot, puis passé à insererLot : un gros lot est fusionné avec les mots existants et
+     * l'arbre est reconstruit une seule fois. Les traductions des mots déjà présents sont ensuite complétées. Les index
+     * sont maintenus comme par ajouteMot ; la génération du cache n'avance qu'une fois.
+     *
+     */
+    void Dictionnaire::ajouteMots(const std::vector<std::pair<std::string, std::string> > &motsTraduits) {
+        vector<pair<string, string> > paires(motsTraduits);
+        const vector<EntreeFichier> lot = _regrouperParMot(paires);
+
+        _detacherArbre();
+        const vector<pair<NoeudDictionnaire*, bool> > resultats = insererLot(lot);
+        size_t nbAjouts = 0;
+        for (size_t i = 0; i < lot.size(); i++) {
+            NoeudDictionnaire* noeud = resultats[i].first;
+            if (!resultats[i].second && noeud->supprime) {
+                _ranimer(noeud, lot[i].second);
+            } else if (!resultats[i].second) {
+                for (const string& traduction : lot[i].second)
+                    if (!_vecteurContient(noeud->traductions, traduction))
+                        noeud->traductions.push_back(traduction);
+                continue;
+            }
+            if (indexActif)
+                indexHachage.inserer(noeud);
+            if (filtreActif)
+                filtreBloom.ajouter(noeud->mot);
+            nbAjouts++;
+        }
+
+        if (nbAjouts == 0)
+            return;
+        generation++;
+        if (filtreActif && _nombreMotsVivants() > 2 * filtreBloom.capacitePrevue())
+            _reconstruireFiltreBloom();
+        _verifierBudget();
+    }
+
+    /**
+     * \fn std::size_t Dictionnaire::supprimeMots(const std::vector<std::string> &mots)
+     * \brief Permet de supprimer un lot de mots avec un seul rééquilibrage
+     * \param[in] const std::vector<std::string> &mots, les mots à retirer, dans n'importe quel ordre
+     * \return std::size_t, le nombre de mots qui étaient dans le dictionnaire (les autres sont ignorés)
+     *
+     * Contrairement à supprimeMot, on ne vérifie pas chaque mot avant de le retirer : le lot trié est fusionné avec l'arbre
+     * par supprimerLot (ou retiré mot par mot s'il est petit). En mode suppression différée, les mots présents sont
+     * seulement marqués.
+     *
+     */
+    std::size_t Dictionnaire::supprimeMots(const std::vector<std::string> &mots) {
+        vector<string> lot(mots);
+        sort(lot.begin(), lot.end());
+        lot.erase(unique(lot.begin(), lot.end()), lot.end());
+
+        _detacherArbre();
+        if (indexActif)
+            for (const string& mot : lot)
+                indexHachage.retirer(mot);
+        size_t nbSuppressions = 0;
+        if (suppressionDifferee) {
+            for (const string& mot : lot) {
+                NoeudDictionnaire* noeud = trouver(mot);
+                if (noeud != nullptr && !noeud->supprime) {
+                    _marquerSupprime(noeud);
+                    nbSuppressions++;
+                }
+            }
+        } else {
+            nbSuppressions = supprimerLot(lot);
+        }
+
+        if (nbSuppressions == 0)
+            return 0;
+        generation++;
+        if (filtreActif) {
+            motsSupprimesDuFiltre += static_cast<int>(nbSuppressions);
+            if (static_cast<size_t>(motsSupprimesDuFiltre) > _nombreMotsVivants() / 4)
+                _reconstruireFiltreBloom();
+        }
+        _compacterSiNecessaire();
+        return nbSuppressions;
     }
 
     /**
-     * \fn double Dictionnaire::similitude(const std::string &mot1, const std::string &mot2)
+     * \fn Dictionnaire Dictionnaire::scinde(const std::string &mot)
+     * \brief Permet de séparer le dictionnaire en 2 à un mot
+     * \param[in] const std::string &mot, le premier mot de la partie retournée
+     * \return Dictionnaire, les mots plus grands ou égaux à 'mot'
+     *
+     * Les mots partis sont retirés de l'index de hachage un à un ; ils restent dans le filtre de Bloom, comme des mots
+     * supprimés. Les pierres tombales sont d'abord compactées : les 2 parties n'en ont pas.
+     *
+     */
+    Dictionnaire Dictionnaire::scinde(const std::string &mot) {
+        compacte();
+        _detacherArbre();
+        ArbreMots partie = scinder(mot);
+        Dictionnaire superieurs;
+        superieurs.ArbreMots::swap(partie);
+        if (superieurs.estVide())
+            return superieurs;
+
+        if (indexActif)
+            for (const NoeudDictionnaire* noeud = superieurs.premier(); noeud != nullptr; noeud = suivant(noeud))
+                indexHachage.retirer(noeud->mot);
+        generation++;
+        if (filtreActif) {
+            motsSupprimesDuFiltre += static_cast<int>(superieurs.taille());
+            if (static_cast<size_t>(motsSupprimesDuFiltre) > _nombreMotsVivants() / 4)
+                _reconstruireFiltreBloom();
+        }
+        return superieurs;
+    }
+
+    /**
+     * \fn void Dictionnaire::concatene(Dictionnaire superieurs)
+     * \brief Permet d'ajouter à la suite les mots d'un dictionnaire dont tous les mots suivent ceux de celui-ci
+     * \param[in] Dictionnaire superieurs, le dictionnaire ajouté
+     * \exception logic_error si un mot de 'superieurs' ne suit pas tous les mots de ce dictionnaire
+     *
+     * L'arbre de 'superieurs' est joint en O(log n) ; ses mots sont ensuite ajoutés un à un à l'index et au filtre actifs.
+     * Les pierres tombales des 2 dictionnaires sont d'abord compactées.
+     *
+     */
+    void Dictionnaire::concatene(Dictionnaire superieurs) {
+        compacte();
+        superieurs.compacte();
+        _partagerAllocateur(superieurs);
+        _detacherArbre();
+        superieurs.detacher();
+        NoeudDictionnaire* ajout = superieurs.premier();
+        concatener(superieurs);
+        if (ajout == nullptr)
+            return;
+
+        for (; ajout != nullptr; ajout = suivant(ajout)) {
+            if (indexActif)
+                indexHachage.inserer(ajout);
+            if (filtreActif)
+                filtreBloom.ajouter(ajout->mot);
+        }
+        generation++;
+        if (filtreActif && _nombreMotsVivants() > 2 * filtreBloom.capacitePrevue())
+            _reconstruireFiltreBloom();
+        _verifierBudget();
+    }
+
+    /**
+     * \fn void Dictionnaire::fusionne(Dictionnaire autre)
+     * \brief Permet d'ajouter les mots et les traductions d'un autre dictionnaire (union)
+     * \param[in] Dictionnaire autre, le dictionnaire ajouté
+     *
+     * Les traductions d'un mot commun sont comparées directement (==) : la fusion peut se faire en parallèle et ne doit
+     * pas passer par similitude. Comme pour intersecte et retranche, les pierres tombales des 2 dictionnaires sont
+     * d'abord compactées : l'AvlMap ne les distingue pas des autres noeuds.
+     *
+     */
+    void Dictionnaire::fusionne(Dictionnaire autre) {
+        compacte();
+        autre.compacte();
+        _partagerAllocateur(autre);
+        _detacherArbre();
+        unir(autre, [](vector<string>& traductions, vector<string>& ajouts) {
+            for (string& traduction : ajouts)
+                if (find(traductions.begin(), traductions.end(), traduction) == traductions.end())
+                    traductions.push_back(std::move(traduction));
+        });
+        _apresOperationEnsemble();
+        _verifierBudget();
+    }
+
+    /**
+     * \fn void Dictionnaire::intersecte(Dictionnaire autre)
+     * \brief Permet de garder seulement les mots aussi présents dans un autre dictionnaire (intersection)
+     * \param[in] Dictionnaire autre, l'autre dictionnaire
+     */
+    void Dictionnaire::intersecte(Dictionnaire autre) {
+        compacte();
+        autre.compacte();
+        _partagerAllocateur(autre);
+        _detacherArbre();
+        intersecter(autre);
+        _apresOperationEnsemble();
+    }
+
+    /**
+     * \fn void Dictionnaire::retranche(Dictionnaire autre)
+     * \brief Permet de retirer les mots présents dans un autre dictionnaire (différence)
+     * \param[in] Dictionnaire autre, les mots à retirer
+     */
+    void Dictionnaire::retranche(Dictionnaire autre) {
+        compacte();
+        autre.compacte();
+        _partagerAllocateur(autre);
+        _detacherArbre();
+        retrancher(autre);
+        _apresOperationEnsemble();
+    }
+
+    /**
+     * \fn double Dictionnaire::similitude(const std::string &mot1, const std::string &mot2) const
      * \brief Permet de mesurer la similitude entre deux mots en utilisant la distance de Levenshtein
      * \param[in] const std::string &mot1, le premier mot dans la comparaison
      * \param[in] const std::string &mot2, le second mot dans la comparaison
@@ -161,7 +463,7 @@ namespace TP3
      * à la fraction du mot qu'il faut changer. On retourne ensuite la similitude, soit 1 - fraction.
      *
      */
-    double Dictionnaire::similitude(const std::string &mot1, const std::string &mot2) {
+    double Dictionnaire::similitude(const std::string &mot1, const std::string &mot2) const {
 	    if (mot1 == mot2)
 	        return SIMILITUDE_MAX;
 
@@ -175,15 +477,17 @@ namespace TP3
 	}
 
     /**
-     * \fn unsigned int Dictionnaire::_distanceLevenshtein(const std::string &mot1, const std::string &mot2)
+     * \fn unsigned int Dictionnaire::_distanceLevenshtein(const std::string &mot1, const std::string &mot2) const
      * \brief Permet de calculer la distance de Levenshtein entre 2 mots
      * \param[in] const std::string &mot1, le premier mot dans le calcul de la distance
      * \param[in] const std::string &mot2, le second mot dans le calcul de la distance
      * \return unsigned int, un entier positif qui représente la distance de Levenshtein entre les 2 mots
      */
-    unsigned int Dictionnaire::_distanceLevenshtein(const std::string &mot1, const std::string &mot2) {
+    unsigned int Dictionnaire::_distanceLevenshtein(const std::string &mot1, const std::string &mot2) const {
         const size_t lengthMot1 = mot1.size();
         const size_t lengthMot2 = mot2.size();
+        TP3_COMPTER(compteursOperations.appelsLevenshtein, 1);
+        TP3_COMPTER(compteursOperations.cellulesLevenshtein, lengthMot1 * lengthMot2);
 
         vector<vector<unsigned int>> distanceTable(lengthMot1 + 1, vector<unsigned int>(lengthMot2 + 1));
         distanceTable[0][0] = 0;
@@ -205,150 +509,673 @@ namespace TP3
     }
 
     /**
-     * \fn std::vector<std::string> Dictionnaire::suggereCorrections(const std::string &motMalEcrit)
+     * \fn std::vector<std::string> Dictionnaire::suggereCorrections(const std::string &motMalEcrit) const
      * \brief Permet de trouver des suggestions pour un mot mal orthographié
      * \param[in] const std::string &motMalEcrit, le mot mal écrit pour lequel il faut des suggestions
      * \return std::vector<std::string>, un vecteur qui contient les suggestions.
      * \exception logic_error si le dictionnaire est vide
      *
-     * La stratégie est d'utiliser une file d'attente pour le traitement des noeuds. Jusqu'à ce qu'on ne trouve plus de noeud qui respecte le critère de
-     * similitude minimale (SIMILITUDE_MIN_POUR_SUGGESTION) ou bien que le vecteur des suggestions soit plein (LIMITE_SUGGESTIONS), on parcours l'arbre pour trouver
-     * des mots qui sont similaires. On commence par la racine, ensuite dès qu'un noeud est similaire, on l'ajoute au suggestions, puis on met ses enfants dans la file des prochains
-     * noeud à traiter. On recommence ensuite la boucle en prenant le premier noeud à traiter dans la file d'attente.
+     * Si le cache de suggestions est actif, on le consulte avec la génération courante ; en cas d'échec, les suggestions
+     * sont calculées par '_calculerSuggestions' puis ajoutées au cache. Le résultat est le même avec ou sans cache.
      *
      */
-    std::vector<std::string> Dictionnaire::suggereCorrections(const std::string &motMalEcrit) {
+    std::vector<std::string> Dictionnaire::suggereCorrections(const std::string &motMalEcrit) const {
+        TP3_CHRONOMETRER(latences[OPERATION_SUGGERE_CORRECTIONS]);
 
         if (estVide())
             throw logic_error("arbre est vide");
 
-        vector<string> suggestions;
-        queue<Dictionnaire::NoeudDictionnaire*> noeudAtraite; //file d'attente des noeuds à traiter
-        noeudAtraite.push(racine); //on commence par la racine
-
-        while (suggestions.size() < LIMITE_SUGGESTIONS && !noeudAtraite.empty()) {
-            Dictionnaire::NoeudDictionnaire* suggestion = _trouverRecursif(noeudAtraite.front(), motMalEcrit, SIMILITUDE_MIN_POUR_SUGGESTION);
-            if (suggestion != nullptr && !_vecteurContient(suggestions, suggestion->mot)) {
-                //ce mot n'a pas encore été mis dans le vecteur de suggestions
-                suggestions.push_back(suggestion->mot);
-            }
-
-            if (suggestion != nullptr) {
-                //on ajoute ses enfants comme prochains noeuds à traiter
-                if (suggestion->droite != nullptr)
-                    noeudAtraite.push(suggestion->droite);
-                if (suggestion->gauche != nullptr)
-                    noeudAtraite.push(suggestion->gauche);
-
-            }
+        if (cacheSuggestions == nullptr)
+            return _calculerSuggestions(motMalEcrit);
 
-            noeudAtraite.pop(); //on retire le noeud qui vient d'être traité
+        vector<string> suggestions;
+        if (!cacheSuggestions->trouver(motMalEcrit, generation, suggestions)) {
+            suggestions = _calculerSuggestions(motMalEcrit);
+            cacheSuggestions->inserer(motMalEcrit, generation, suggestions);
         }
-
         return suggestions;
     }
 
     /**
-     * \fn std::vector<std::string> Dictionnaire::traduit(const std::string &mot)
+     * \fn std::vector<std::string> Dictionnaire::traduit(const std::string &mot) const
      * \brief Permet de retourner les traductions d'un mot passé en paramètre
      * \param[in] const std::string &mot, le mot à traduire
      * \return std::vector<std::string>, un vecteur qui contient les traductions possibles du mot à traduire. Si le mot n'est pas dans l'arbre, on retourne un vecteur vide.
      */
-    std::vector<std::string> Dictionnaire::traduit(const std::string &mot) {
-        Dictionnaire::NoeudDictionnaire* noeud = _trouverRecursif(racine, mot, SIMILITUDE_MAX);
+    std::vector<std::string> Dictionnaire::traduit(const std::string &mot) const {
+        TP3_CHRONOMETRER(latences[OPERATION_TRADUIT]);
+        NoeudDictionnaire* noeud = _trouverExact(mot);
         if (noeud == nullptr)
             return vector<std::string>();
         return noeud->traductions;
     }
 
     /**
-     * \fn bool Dictionnaire::appartient(const std::string &mot)
+     * \fn bool Dictionnaire::appartient(const std::string &mot) const
      * \brief Permet de vérifier si un mot appartient au dictionnaire
      * \param[in] const std::string &mot, le mot à vérifier l'appartenance
      * \return bool, true si le mot appartient, false sinon.
      *
-     * Cette méthode fait appel à '_trouverRecursif' avec le critère de similitude maximale, soit 1. Ainsi, seul le noeud identique sera retourné.
+     * Cette méthode fait appel à '_trouverExact', soit l'index de hachage s'il est actif, soit une descente de l'arbre qui
+     * compare les mots. Ainsi, seul le noeud identique sera retourné.
      *
      */
-    bool Dictionnaire::appartient(const std::string &mot) {
-        return _trouverRecursif(racine, mot, SIMILITUDE_MAX) != nullptr;
+    bool Dictionnaire::appartient(const std::string &mot) const {
+        TP3_CHRONOMETRER(latences[OPERATION_APPARTIENT]);
+        return _trouverExact(mot) != nullptr;
     }
 
     /**
      * \fn bool Dictionnaire::estVide() const
      * \brief Permet de vérifier si le dictionnaire est vide
-     * \return bool, true si le mot dictionnaire est vide, false sinon
+     * \return bool, true si le mot dictionnaire est vide (ou n'a plus que des pierres tombales), false sinon
      */
     bool Dictionnaire::estVide() const {
-        return racine == nullptr;
+        return taille() == nbPierresTombales;
     }
 
     /**
-     * \fn void Dictionnaire::_detruireRecursif(Dictionnaire::NoeudDictionnaire *&arbre)
-     * \brief Permet de libérer récusivement la mémoire du allouée sur le monceau du dictionnaire.
-     * \param[in] Dictionnaire::NoeudDictionnaire *&arbre, le noeud à détruire
+     * \fn std::vector<std::string> Dictionnaire::motsAvecPrefixe(const std::string &prefixe, std::size_t limite) const
+     * \brief Permet de trouver les mots qui commencent par un préfixe, en ordre alphabétique
+     * \param[in] const std::string &prefixe, le préfixe recherché
+     * \param[in] std::size_t limite, le nombre maximal de mots retournés
+     * \return std::vector<std::string>, les mots trouvés en ordre alphabétique
+     */
+    std::vector<std::string> Dictionnaire::motsAvecPrefixe(const std::string &prefixe, std::size_t limite) const {
+        vector<string> mots;
+        if (limite == 0)
+            return mots;
+
+        parcoursPrefixe(prefixe, [&mots, limite](const string& mot, const vector<string>&) {
+            mots.push_back(mot);
+            return mots.size() < limite;
+        });
+        return mots;
+    }
+
+    /**
+     * \fn std::vector<std::string> Dictionnaire::motsEntre(const std::string &motDebut, const std::string &motFin, std::size_t limite) const
+     * \brief Permet de trouver les mots compris entre 2 bornes incluses, en ordre alphabétique
+     * \param[in] const std::string &motDebut, la borne inférieure
+     * \param[in] const std::string &motFin, la borne supérieure
+     * \param[in] std::size_t limite, le nombre maximal de mots retournés
+     * \return std::vector<std::string>, les mots trouvés en ordre alphabétique. Vide si motDebut est après motFin.
+     */
+    std::vector<std::string> Dictionnaire::motsEntre(const std::string &motDebut, const std::string &motFin, std::size_t limite) const {
+        vector<string> mots;
+        if (limite == 0)
+            return mots;
+
+        parcoursEntre(motDebut, motFin, [&mots, limite](const string& mot, const vector<string>&) {
+            mots.push_back(mot);
+            return mots.size() < limite;
+        });
+        return mots;
+    }
+
+    /**
+     * \fn const CompteursOperations& Dictionnaire::compteurs() const
+     * \brief Permet de consulter les compteurs d'opérations
+     * \return const CompteursOperations&, les compteurs cumulés depuis la construction ou la dernière réinitialisation
+     * \note sans TP3_INSTRUMENTATION, tous les compteurs restent à 0
+     */
+    const CompteursOperations& Dictionnaire::compteurs() const {
+        return compteursOperations;
+    }
+
+    /**
+     * \fn void Dictionnaire::reinitialiseCompteurs()
+     * \brief Permet de remettre tous les compteurs d'opérations à 0
+     */
+    void Dictionnaire::reinitialiseCompteurs() {
+        compteursOperations.reinitialiser();
+    }
+
+    /**
+     * \fn StatistiquesArbre Dictionnaire::statistiques() const
+     * \brief Permet de calculer un portrait de l'arbre : hauteur, nombre de mots, profondeur moyenne et empreinte mémoire
+     * \return StatistiquesArbre, les statistiques calculées
+     *
+     * L'arbre est parcouru au complet (O(n)). La hauteur, la profondeur moyenne et l'empreinte mémoire comptent les pierres
+     * tombales, qui sont encore des noeuds de l'arbre ; le nombre de mots ne les compte pas. L'empreinte mémoire est le
+     * total d'empreinteMemoire().
+     *
+     */
+    StatistiquesArbre Dictionnaire::statistiques() const {
+        StatistiquesArbre stats;
+        long long sommeProfondeurs = 0;
+
+        int profondeurMax = -1;
+        _statistiquesRecursif(racine, 0, sommeProfondeurs, profondeurMax);
+
+        stats.hauteur = profondeurMax;
+        stats.nombreMots = static_cast<int>(_nombreMotsVivants());
+        stats.profondeurMoyenne = estVide() ? 0 : static_cast<double>(sommeProfondeurs) / taille();
+        stats.empreinteMemoire = empreinteMemoire().total;
+        return stats;
+    }
+
+    /**
+     * \fn EmpreinteMemoire Dictionnaire::empreinteMemoire() const
+     * \brief Permet de détailler la mémoire utilisée par le dictionnaire
+     * \return EmpreinteMemoire, les octets des noeuds, des mots, des traductions et de chaque structure facultative
+     *
+     * L'arbre est parcouru au complet (O(n)). Les structures facultatives donnent leur propre empreinte : la table de
+     * l'index de hachage, les blocs du filtre de Bloom et les cases du cache de suggestions avec leur contenu actuel.
+     *
+     */
+    EmpreinteMemoire Dictionnaire::empreinteMemoire() const {
+        EmpreinteMemoire empreinte = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        _empreinteRecursif(racine, empreinte);
+        empreinte.indexHachage = indexHachage.empreinteMemoire();
+        empreinte.filtreBloom = filtreBloom.empreinteMemoire();
+        empreinte.cacheSuggestions = cacheSuggestions == nullptr ? 0 : cacheSuggestions->empreinteMemoire();
+        empreinte.total = empreinte.noeuds + empreinte.octetsMots + empreinte.octetsTraductions + empreinte.indexHachage
+                          + empreinte.filtreBloom + empreinte.cacheSuggestions;
+        return empreinte;
+    }
+
+    /**
+     * \fn void Dictionnaire::fixeBudgetMemoire(std::size_t octets)
+     * \brief Permet de borner la mémoire du dictionnaire en dégradant ses structures facultatives
+     * \param[in] std::size_t octets, le budget, 0 pour n'en avoir aucun
+     * \post l'empreinte respecte le budget, ou il ne reste plus de structure facultative à dégrader
+     */
+    void Dictionnaire::fixeBudgetMemoire(std::size_t octets) {
+        budgetOctets = octets;
+        _respecterBudget();
+    }
+
+    /**
+     * \fn std::size_t Dictionnaire::budgetMemoire() const
+     * \brief Permet de connaître le budget mémoire
+     * \return std::size_t, le budget en octets, 0 s'il n'y en a pas
+     */
+    std::size_t Dictionnaire::budgetMemoire() const {
+        return budgetOctets;
+    }
+
+    /**
+     * \fn unsigned long long Dictionnaire::degradationsBudgetMemoire() const
+     * \brief Permet de savoir combien de fois le budget mémoire a forcé une dégradation
+     * \return unsigned long long, le nombre de réductions du cache et de désactivations de structures facultatives
+     */
+    unsigned long long Dictionnaire::degradationsBudgetMemoire() const {
+        return nbDegradationsBudget;
+    }
+
+    /**
+     * \fn const HistogrammeLatence& Dictionnaire::latence(OperationDictionnaire operation) const
+     * \brief Permet de consulter l'histogramme des latences d'une opération
+     * \param[in] OperationDictionnaire operation, l'opération voulue
+     * \return const HistogrammeLatence&, l'histogramme de l'opération
      *
-     * Tant qu'on est pas sur une feuille, cette méthode sera appellée récusivement. Quand on est sur une feuille, celle-ci est retirée de l'arbre.
-     * Ainsi de suite jusqu'à ce qu'on ait remonté au noeud premier noeud avec lequel cette méthode a été appellée, typiquement la racine de l'arnre AVL.
+     * Sans TP3_INSTRUMENTATION, les histogrammes ne sont pas des attributs : aucun emplacement n'est pris à la
+     * construction d'un dictionnaire. Un seul histogramme vide, créé au premier appel, sert alors pour toutes les opérations.
      *
      */
-    void Dictionnaire::_detruireRecursif(Dictionnaire::NoeudDictionnaire *&arbre) {
+    const HistogrammeLatence& Dictionnaire::latence(OperationDictionnaire operation) const {
+#ifdef TP3_INSTRUMENTATION
+        return latences[operation];
+#else
+        (void)operation;
+        static const HistogrammeLatence vide;
+        return vide;
+#endif
+    }
 
-        if (arbre != nullptr) {
-            _detruireRecursif(arbre->gauche);
-            _detruireRecursif(arbre->droite);
-            delete arbre;
-            arbre = nullptr;
+    /**
+     * \fn void Dictionnaire::exporteMetriquesPrometheus(std::ostream &sortie) const
+     * \brief Permet d'écrire les métriques du dictionnaire au format d'exposition texte Prometheus
+     * \param[in] std::ostream &sortie, le flux où écrire
+     *
+     * On écrit 5 familles : tp3_dictionnaire_latence_secondes (histogramme, étiquette operation), tp3_dictionnaire_operations_total
+     * (compteur, étiquette type), tp3_dictionnaire_cache_suggestions_total (compteur, étiquette resultat), tp3_dictionnaire_mots
+     * et tp3_dictionnaire_pierres_tombales (jauges). Les histogrammes et compteurs sont à 0 sans TP3_INSTRUMENTATION.
+     *
+     */
+    void Dictionnaire::exporteMetriquesPrometheus(std::ostream &sortie) const {
+        static const char* const NOMS_OPERATIONS[NB_OPERATIONS] = {
+                "traduit", "appartient", "suggereCorrections", "ajouteMot", "supprimeMot" };
+
+        sortie << "# HELP tp3_dictionnaire_latence_secondes Latence des operations du dictionnaire.\n";
+        sortie << "# TYPE tp3_dictionnaire_latence_secondes histogram\n";
+        for (int operation = 0; operation < NB_OPERATIONS; operation++) {
+            latence(static_cast<OperationDictionnaire>(operation)).exportePrometheus(
+                    sortie, "tp3_dictionnaire_latence_secondes", string("operation=\"") + NOMS_OPERATIONS[operation] + "\"");
         }
+
+        const pair<const char*, unsigned long long> compteursExportes[] = {
+                make_pair("recherches", compteursOperations.recherches.load()),
+                make_pair("visites_noeuds", compteursOperations.visitesNoeuds.load()),
+                make_pair("appels_levenshtein", compteursOperations.appelsLevenshtein.load()),
+                make_pair("cellules_levenshtein", compteursOperations.cellulesLevenshtein.load()),
+                make_pair("rotations_gauche", compteursOperations.rotationsGauche.load()),
+                make_pair("rotations_droite", compteursOperations.rotationsDroite.load()),
+                make_pair("rotations_doubles", compteursOperations.rotationsDoubles.load()),
+                make_pair("allocations", compteursOperations.allocations.load()),
+                make_pair("candidats_suggestion", compteursOperations.candidatsSuggestion.load()),
+                make_pair("rejets_filtre_bloom", compteursOperations.rejetsFiltreBloom.load()) };
+        sortie << "# HELP tp3_dictionnaire_operations_total Operations internes du dictionnaire.\n";
+        sortie << "# TYPE tp3_dictionnaire_operations_total counter\n";
+        for (const auto & compteur : compteursExportes)
+            sortie << "tp3_dictionnaire_operations_total{type=\"" << compteur.first << "\"} " << compteur.second << '\n';
+
+        sortie << "# HELP tp3_dictionnaire_cache_suggestions_total Consultations du cache de suggestions.\n";
+        sortie << "# TYPE tp3_dictionnaire_cache_suggestions_total counter\n";
+        sortie << "tp3_dictionnaire_cache_suggestions_total{resultat=\"succes\"} " << succesCacheSuggestions() << '\n';
+        sortie << "tp3_dictionnaire_cache_suggestions_total{resultat=\"echec\"} " << echecsCacheSuggestions() << '\n';
+
+        sortie << "# HELP tp3_dictionnaire_mots Nombre de mots dans le dictionnaire.\n";
+        sortie << "# TYPE tp3_dictionnaire_mots gauge\n";
+        sortie << "tp3_dictionnaire_mots " << _nombreMotsVivants() << '\n';
+
+        sortie << "# HELP tp3_dictionnaire_pierres_tombales Mots supprimes en attente de compaction.\n";
+        sortie << "# TYPE tp3_dictionnaire_pierres_tombales gauge\n";
+        sortie << "tp3_dictionnaire_pierres_tombales " << nbPierresTombales << '\n';
     }
 
     /**
-     * \fn void Dictionnaire::_ajouterRecursif(NoeudDictionnaire*& node, const std::string &motOriginal, const std::string &motTraduit)
-     * \brief Permet d'ajouter un mot à un dictionnaire (arbre AVL), à partir d'un noeud de départ, typiquement appellée de la racine.
-     * \param[in] NoeudDictionnaire*& node, noeud de départ
-     * \param[in] const std::string &motOriginal, mot à ajouter
-     * \param[in] const std::string &motTraduit, traduction correspondante
+     * \fn void Dictionnaire::exporteMetriquesPrometheus(const std::string &cheminFichier) const
+     * \brief Permet d'écrire les métriques au format texte Prometheus dans un fichier
+     * \param[in] const std::string &cheminFichier, le fichier à remplacer
+     * \exception runtime_error si le fichier temporaire ne peut pas être écrit ou renommé
      *
-     * Si le mot est déjà présent dans l'arbre, on ajoute simplement sa traduction si elle n'est pas déjà présente. Sinon, on ajoute un nouveau noeud comme feuille,
-     * on ajuste les hauteurs des noeuds et on balance l'arbre.
+     * On écrit d'abord dans cheminFichier + ".tmp", puis on renomme. Un collecteur qui lit le fichier (par exemple le
+     * textfile collector de node_exporter) ne voit donc jamais un fichier à moitié écrit.
      *
      */
-    void Dictionnaire::_ajouterRecursif(NoeudDictionnaire*& node, const std::string &motOriginal, const std::string &motTraduit) {
+    void Dictionnaire::exporteMetriquesPrometheus(const std::string &cheminFichier) const {
+        const string cheminTemporaire = cheminFichier + ".tmp";
+        {
+            ofstream fichier(cheminTemporaire.c_str());
+            if (!fichier)
+                throw runtime_error("Impossible d'ouvrir le fichier de metriques " + cheminTemporaire);
+            exporteMetriquesPrometheus(fichier);
+            if (!fichier.flush())
+                throw runtime_error("Impossible d'ecrire le fichier de metriques " + cheminTemporaire);
+        }
+        if (rename(cheminTemporaire.c_str(), cheminFichier.c_str()) != 0)
+            throw runtime_error("Impossible de remplacer le fichier de metriques " + cheminFichier);
+    }
+
+    /**
+     * \fn Dictionnaire::Iterateur Dictionnaire::begin() const
+     * \brief Permet d'obtenir un itérateur sur le premier mot en ordre alphabétique
+     * \return Dictionnaire::Iterateur, sur le mot minimal, ou end() si le dictionnaire est vide
+     */
+    Dictionnaire::Iterateur Dictionnaire::begin() const {
+        return Iterateur(this, _premierVivant(premier()));
+    }
 
-        if (node == nullptr) {
-            node = new NoeudDictionnaire(motOriginal, motTraduit);
-            cpt++;
-            return;
-        } else if (similitude(node->mot, motOriginal) == 1) {
-            if (!_vecteurContient(node->traductions, motTraduit)) {
-                node->traductions.push_back(motTraduit);
+    /**
+     * \fn Dictionnaire::Iterateur Dictionnaire::end() const
+     * \brief Permet d'obtenir l'itérateur qui suit le dernier mot
+     * \return Dictionnaire::Iterateur, l'itérateur de fin
+     */
+    Dictionnaire::Iterateur Dictionnaire::end() const {
+        return Iterateur(this, nullptr);
+    }
+
+    /**
+     * \fn Dictionnaire::Iterateur Dictionnaire::lower_bound(const std::string &mot) const
+     * \brief Permet de trouver le premier mot plus grand ou égal au mot donné
+     * \param[in] const std::string &mot, la borne
+     * \return Dictionnaire::Iterateur, sur le mot trouvé, end() s'il n'y en a pas
+     */
+    Dictionnaire::Iterateur Dictionnaire::lower_bound(const std::string &mot) const {
+        return Iterateur(this, _premierVivant(borneInferieure(mot)));
+    }
+
+    /**
+     * \fn Dictionnaire::Iterateur Dictionnaire::upper_bound(const std::string &mot) const
+     * \brief Permet de trouver le premier mot strictement plus grand que le mot donné
+     * \param[in] const std::string &mot, la borne
+     * \return Dictionnaire::Iterateur, sur le mot trouvé, end() s'il n'y en a pas
+     */
+    Dictionnaire::Iterateur Dictionnaire::upper_bound(const std::string &mot) const {
+        return Iterateur(this, _premierVivant(borneSuperieure(mot)));
+    }
+
+    /**
+     * \fn RapportDiff Dictionnaire::appliquerDiff(std::istream &ancienFichier, std::istream &nouveauFichier)
+     * \brief Permet de passer de l'ancienne à la nouvelle version d'un fichier en ne modifiant que les mots qui ont changé
+     *
+     * Les 2 fichiers sont entièrement lus avant la première modification : une ligne invalide laisse le dictionnaire intact.
+     * Les entrées triées sont fusionnées en O(n + m) ; seuls les mots ajoutés, supprimés ou modifiés passent par
+     * ajouteMot et supprimeMot, qui maintiennent l'index de hachage, le filtre de Bloom et le cache.
+     *
+     * \param[in] std::istream &ancienFichier, la version du fichier que reflète le dictionnaire
+     * \param[in] std::istream &nouveauFichier, la version à atteindre
+     * \return RapportDiff, le nombre de mots et de traductions changés et la durée de l'opération
+     * \exception out_of_range si une ligne de l'un des fichiers est invalide (comme le constructeur)
+     */
+    RapportDiff Dictionnaire::appliquerDiff(std::istream &ancienFichier, std::istream &nouveauFichier) {
+        const chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+        RapportDiff rapport = RapportDiff();
+
+        const vector<EntreeFichier> anciennes = _lireEntreesTriees(ancienFichier);
+        const vector<EntreeFichier> nouvelles = _lireEntreesTriees(nouveauFichier);
+
+        vector<EntreeFichier>::const_iterator ancienne = anciennes.begin();
+        vector<EntreeFichier>::const_iterator nouvelle = nouvelles.begin();
+        while (ancienne != anciennes.end() || nouvelle != nouvelles.end()) {
+            if (nouvelle == nouvelles.end() || (ancienne != anciennes.end() && ancienne->first < nouvelle->first)) {
+                //Mot disparu : il n'est compté que s'il était encore dans le dictionnaire
+                if (appartient(ancienne->first)) {
+                    supprimeMot(ancienne->first);
+                    ++rapport.motsSupprimes;
+                    rapport.traductionsRetirees += ancienne->second.size();
+                }
+                ++ancienne;
+            } else if (ancienne == anciennes.end() || nouvelle->first < ancienne->first) {
+                //Mot nouveau
+                for (const string& traduction : nouvelle->second) {
+                    ajouteMot(nouvelle->first, traduction);
+                }
+                ++rapport.motsAjoutes;
+                rapport.traductionsAjoutees += nouvelle->second.size();
+                ++nouvelle;
+            } else if (ancienne->second == nouvelle->second) {
+                ++rapport.motsInchanges;
+                ++ancienne;
+                ++nouvelle;
+            } else {
+                const vector<string>& avant = ancienne->second;
+                const vector<string>& apres = nouvelle->second;
+                for (const string& traduction : apres) {
+                    if (find(avant.begin(), avant.end(), traduction) == avant.end()) ++rapport.traductionsAjoutees;
+                }
+                for (const string& traduction : avant) {
+                    if (find(apres.begin(), apres.end(), traduction) == apres.end()) ++rapport.traductionsRetirees;
+                }
+
+                //Si les anciennes traductions débutent la nouvelle liste, il suffit d'ajouter les suivantes. Sinon, le
+                //mot est remplacé pour garder l'ordre du fichier, comme après un chargement complet.
+                vector<string>::size_type premiereAjoutee = 0;
+                if (avant.size() < apres.size() && equal(avant.begin(), avant.end(), apres.begin())) {
+                    premiereAjoutee = avant.size();
+                } else if (appartient(nouvelle->first)) {
+                    supprimeMot(nouvelle->first);
+                }
+                for (vector<string>::size_type i = premiereAjoutee; i < apres.size(); ++i) {
+                    ajouteMot(nouvelle->first, apres[i]);
+                }
+                ++rapport.motsModifies;
+                ++ancienne;
+                ++nouvelle;
             }
-        } else if (_baseEstPlustPetitQue(node->mot, motOriginal)) {
-            _ajouterRecursif(node->droite, motOriginal, motTraduit);
-        } else {
-            _ajouterRecursif(node->gauche, motOriginal, motTraduit);
         }
 
-        _updateHauteurNoeud(node);
-        _balancerUnNoeud(node);
+        rapport.dureeNanosecondes = static_cast<uint64_t>(
+                chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - debut).count());
+        return rapport;
+    }
+
+    /**
+     * \fn DictionnaireFige Dictionnaire::fige() const
+     * \brief Permet de construire une copie figée du dictionnaire, pour les recherches en lecture seule
+     * \return DictionnaireFige, la copie figée
+     */
+    DictionnaireFige Dictionnaire::fige() const {
+        return DictionnaireFige(*this);
+    }
+
+    /**
+     * \fn void Dictionnaire::activeIndexHachage()
+     * \brief Permet d'activer l'index de hachage pour les recherches exactes
+     * \post appartient et traduit consultent l'index au lieu de descendre l'arbre
+     *
+     * L'index est construit en parcourant l'arbre une fois. Si l'index est déjà actif, on ne fait rien. Avec un budget
+     * mémoire, l'index peut être désactivé aussitôt si rien d'autre ne peut être dégradé pour lui faire de la place.
+     *
+     */
+    void Dictionnaire::activeIndexHachage() {
+        if (indexActif)
+            return;
+        _indexerRecursif(racine);
+        indexActif = true;
+        _respecterBudget();
+    }
+
+    /**
+     * \fn void Dictionnaire::desactiveIndexHachage()
+     * \brief Permet de désactiver l'index de hachage et de libérer sa mémoire
+     */
+    void Dictionnaire::desactiveIndexHachage() {
+        indexHachage.vider();
+        indexActif = false;
+    }
+
+    /**
+     * \fn bool Dictionnaire::indexHachageEstActif() const
+     * \brief Permet de vérifier si l'index de hachage est actif
+     * \return bool, true si l'index est actif, false sinon
+     */
+    bool Dictionnaire::indexHachageEstActif() const {
+        return indexActif;
+    }
+
+    /**
+     * \fn void Dictionnaire::activeFiltreBloom()
+     * \brief Permet d'activer le filtre de Bloom pour les recherches exactes
+     * \post appartient et traduit rejettent sans recherche les mots absents du filtre
+     *
+     * Le filtre est construit en parcourant l'arbre une fois. Si le filtre est déjà actif, on ne fait rien. Comme l'index,
+     * il est soumis au budget mémoire.
+     *
+     */
+    void Dictionnaire::activeFiltreBloom() {
+        if (filtreActif)
+            return;
+        filtreActif = true;
+        _reconstruireFiltreBloom();
+        _respecterBudget();
+    }
+
+    /**
+     * \fn void Dictionnaire::desactiveFiltreBloom()
+     * \brief Permet de désactiver le filtre de Bloom et de libérer sa mémoire
+     */
+    void Dictionnaire::desactiveFiltreBloom() {
+        FiltreBloom().swap(filtreBloom);
+        filtreActif = false;
+        motsSupprimesDuFiltre = 0;
+    }
+
+    /**
+     * \fn bool Dictionnaire::filtreBloomEstActif() const
+     * \brief Permet de vérifier si le filtre de Bloom est actif
+     * \return bool, true si le filtre est actif, false sinon
+     */
+    bool Dictionnaire::filtreBloomEstActif() const {
+        return filtreActif;
+    }
+
+    /**
+     * \fn void Dictionnaire::activeSuppressionDifferee(double proportionMaximale)
+     * \brief Permet de remplacer les suppressions avec rééquilibrage par des pierres tombales
+     * \param[in] double proportionMaximale, la proportion des noeuds de l'arbre au-delà de laquelle on compacte
+     * \exception logic_error si proportionMaximale n'est pas dans ]0, 1]
+     * \post supprimeMot marque le noeud du mot au lieu de le retirer de l'arbre
+     *
+     * Une petite proportion garde l'arbre près de sa hauteur optimale ; une grande espace les compactions, chacune en O(n).
+     * Avec la proportion p, au moins p * n suppressions séparent 2 compactions : leur coût amorti est O(1 / p) par
+     * suppression. Si la nouvelle proportion est déjà dépassée, l'arbre est compacté tout de suite.
+     *
+     */
+    void Dictionnaire::activeSuppressionDifferee(double proportionMaximale) {
+        if (!(proportionMaximale > 0 && proportionMaximale <= 1))
+            throw logic_error("activeSuppressionDifferee: la proportion maximale doit être dans ]0, 1]");
+        suppressionDifferee = true;
+        proportionMaximalePierresTombales = proportionMaximale;
+        _compacterSiNecessaire();
+    }
+
+    /**
+     * \fn void Dictionnaire::desactiveSuppressionDifferee()
+     * \brief Permet de revenir aux suppressions avec rééquilibrage, après avoir retiré les pierres tombales de l'arbre
+     */
+    void Dictionnaire::desactiveSuppressionDifferee() {
+        compacte();
+        suppressionDifferee = false;
+    }
+
+    /**
+     * \fn bool Dictionnaire::suppressionDiffereeEstActive() const
+     * \brief Permet de vérifier si la suppression différée est active
+     * \return bool, true si supprimeMot laisse des pierres tombales, false sinon
+     */
+    bool Dictionnaire::suppressionDiffereeEstActive() const {
+        return suppressionDifferee;
     }
 
     /**
-     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_trouverRecursif(Dictionnaire::NoeudDictionnaire* const &node, const std::string &motAtrouver, const double similitudeMinimum)
+     * \fn std::size_t Dictionnaire::nombrePierresTombales() const
+     * \brief Permet de connaître le nombre de mots supprimés dont le noeud est encore dans l'arbre
+     * \return std::size_t, le nombre de pierres tombales
+     */
+    std::size_t Dictionnaire::nombrePierresTombales() const {
+        return nbPierresTombales;
+    }
+
+    /**
+     * \fn void Dictionnaire::compacte()
+     * \brief Permet de retirer de l'arbre toutes les pierres tombales
+     * \post l'arbre ne contient plus que des mots du dictionnaire
+     *
+     * Les mots des pierres tombales sont relevés en ordre, puis passés à supprimerLot : si elles sont nombreuses, l'arbre
+     * est reconstruit une seule fois sur les noeuds restants, qui ne bougent pas en mémoire. L'index de hachage (qui ne
+     * désigne pas les pierres tombales) reste donc valide, et le filtre de Bloom a déjà compté ces mots comme supprimés.
+     * La forme de l'arbre change : la génération du cache avance.
+     *
+     */
+    void Dictionnaire::compacte() {
+        if (nbPierresTombales == 0)
+            return;
+
+        _detacherArbre();
+        vector<string> morts;
+        morts.reserve(nbPierresTombales);
+        for (const NoeudDictionnaire* noeud = premier(); noeud != nullptr; noeud = suivant(noeud))
+            if (noeud->supprime)
+                morts.push_back(noeud->mot);
+        supprimerLot(morts);
+        nbPierresTombales = 0;
+        generation++;
+    }
+
+    /**
+     * \fn void Dictionnaire::activeGrandesPages(std::size_t tailleRegion)
+     * \brief Permet d'allouer les noeuds dans une nouvelle arène de grandes pages
+     * \param[in] std::size_t tailleRegion, la taille des régions réservées par l'arène
+     * \exception logic_error si la taille est 0
+     * \post les noeuds sont contigus, dans l'ordre où une descente les visite (racine, sous-arbre gauche, sous-arbre droit)
+     */
+    void Dictionnaire::activeGrandesPages(std::size_t tailleRegion) {
+        _changerAllocateur(AllocateurArene<NoeudDictionnaire>(make_shared<ArenaGrandesPages>(tailleRegion)));
+    }
+
+    /**
+     * \fn void Dictionnaire::desactiveGrandesPages()
+     * \brief Permet de ramener les noeuds sur le monceau ordinaire
+     */
+    void Dictionnaire::desactiveGrandesPages() {
+        if (grandesPagesSontActives())
+            _changerAllocateur(AllocateurArene<NoeudDictionnaire>());
+    }
+
+    /**
+     * \fn bool Dictionnaire::grandesPagesSontActives() const
+     * \brief Permet de savoir si les noeuds sont alloués dans une arène de grandes pages
+     * \return bool, true si le mode grandes pages est actif
+     */
+    bool Dictionnaire::grandesPagesSontActives() const {
+        return allocateur.areneUtilisee() != nullptr;
+    }
+
+    /**
+     * \fn std::size_t Dictionnaire::octetsGrandesPages() const
+     * \brief Permet de connaître la mémoire réservée par l'arène des noeuds
+     * \return std::size_t, les octets réservés, 0 si le mode grandes pages est inactif
+     *
+     * L'arène est partagée avec les copies différées et les parties scindées : ce sont les octets de toute l'arène.
+     *
+     */
+    std::size_t Dictionnaire::octetsGrandesPages() const {
+        return grandesPagesSontActives() ? allocateur.areneUtilisee()->octetsReserves() : 0;
+    }
+
+    /**
+     * \fn void Dictionnaire::activeCacheSuggestions(std::size_t capacite)
+     * \brief Permet d'activer le cache de suggestions
+     * \param[in] std::size_t capacite, le nombre maximal de mots gardés en cache
+     * \exception logic_error si la capacité est 0
+     *
+     * Un cache déjà actif est remplacé par un cache vide, avec des compteurs de consultations remis à 0. Avec un budget
+     * mémoire, la capacité obtenue peut être plus petite que celle demandée, ou le cache désactivé.
+     *
+     */
+    void Dictionnaire::activeCacheSuggestions(std::size_t capacite) {
+        CacheSuggestions* nouveauCache = new CacheSuggestions(capacite);
+        delete cacheSuggestions;
+        cacheSuggestions = nouveauCache;
+        _respecterBudget();
+    }
+
+    /**
+     * \fn void Dictionnaire::desactiveCacheSuggestions()
+     * \brief Permet de désactiver le cache de suggestions et de libérer sa mémoire
+     */
+    void Dictionnaire::desactiveCacheSuggestions() {
+        delete cacheSuggestions;
+        cacheSuggestions = nullptr;
+    }
+
+    /**
+     * \fn bool Dictionnaire::cacheSuggestionsEstActif() const
+     * \brief Permet de vérifier si le cache de suggestions est actif
+     * \return bool, true si le cache est actif, false sinon
+     */
+    bool Dictionnaire::cacheSuggestionsEstActif() const {
+        return cacheSuggestions != nullptr;
+    }
+
+    /**
+     * \fn unsigned long long Dictionnaire::succesCacheSuggestions() const
+     * \brief Permet de connaître le nombre de consultations réussies du cache de suggestions
+     * \return unsigned long long, le nombre de succès, 0 si le cache est inactif
+     */
+    unsigned long long Dictionnaire::succesCacheSuggestions() const {
+        return cacheSuggestions == nullptr ? 0 : cacheSuggestions->succes();
+    }
+
+    /**
+     * \fn unsigned long long Dictionnaire::echecsCacheSuggestions() const
+     * \brief Permet de connaître le nombre de consultations ratées du cache de suggestions
+     * \return unsigned long long, le nombre d'échecs, 0 si le cache est inactif
+     */
+    unsigned long long Dictionnaire::echecsCacheSuggestions() const {
+        return cacheSuggestions == nullptr ? 0 : cacheSuggestions->echecs();
+    }
+
+    /**
+     * \fn NoeudDictionnaire* Dictionnaire::_trouverRecursif(NoeudDictionnaire* const &node, const std::string &motAtrouver, const double similitudeMinimum) const
      * \brief Permet de trouver le noeud d'un mot dans un dictionnaire (arbre AVL) à partir d'un noeud de base avec un critère de similitude minimale.
-     * \param[in] Dictionnaire::NoeudDictionnaire* const &node, noeud de départ
+     * \param[in] NoeudDictionnaire* const &node, noeud de départ
      * \param[in] const std::string &motAtrouver, mot à trouver dans le dictionnaire
      * \param[in] const double similitudeMinimum, critère de similitude
-     * \return Dictionnaire::NoeudDictionnaire*, un pointeur vers le noeud trouvé, nullptr si noeud pas trouvé.
+     * \return NoeudDictionnaire*, un pointeur vers le noeud trouvé, nullptr si noeud pas trouvé.
      *
-     *  Cette méthode peut être appellée avec similitudeMinimum = 1 pour trouver un mot spécifique dans le dictionnaire. Elle peut aussi
-     *  être appellée avec des critères de similitude plus petits afin de trouver des mots ressemblants.
+     *  Cette méthode est appellée avec des critères de similitude plus petits que 1 afin de trouver des mots ressemblants. Un mot
+     *  spécifique est plutôt cherché par '_trouverExact', qui compare les mots sans calculer de similitude.
      *
      */
-    Dictionnaire::NoeudDictionnaire *
-    Dictionnaire::_trouverRecursif(Dictionnaire::NoeudDictionnaire* const &node, const std::string &motAtrouver, const double similitudeMinimum) {
+    NoeudDictionnaire *
+    Dictionnaire::_trouverRecursif(NoeudDictionnaire* const &node, const std::string &motAtrouver, const double similitudeMinimum) const {
 	    if (node == nullptr)
             return nullptr;
+        TP3_COMPTER(compteursOperations.visitesNoeuds, 1);
 	    if (similitude(node->mot, motAtrouver) >= similitudeMinimum)
 	        return node;  //si ici similitudeMinimum est 1 (valeur max), alors les 2 mots sont le même mot.
 
@@ -360,13 +1187,126 @@ namespace TP3
     }
 
     /**
-     * \fn bool Dictionnaire::_vecteurContient(const std::vector<std::string> &vecteur, const std::string& element)
+     * \fn bool Dictionnaire::_analyserLigne(const std::string &ligne, std::string &motAnglais, std::string &motTraduit)
+     * \brief Permet d'extraire le mot anglais et sa traduction d'une ligne du fichier de dictionnaire
+     * \param[in] const std::string &ligne, la ligne lue dans le fichier
+     * \param[out] std::string &motAnglais, le mot, avant la tabulation
+     * \param[out] std::string &motTraduit, la traduction, sans les parties entre crochets ou parenthèses
+     * \return bool, false pour une ligne d'en-tête (qui commence par '#'), true sinon
+     * \exception out_of_range si la ligne n'a pas de tabulation
+     */
+    bool Dictionnaire::_analyserLigne(const std::string &ligne, std::string &motAnglais, std::string &motTraduit) {
+        if (ligne[0] == '#') //Élimine les lignes d'en-tête
+            return false;
+
+        // Le mot anglais est avant la tabulation (\t).
+        motAnglais = ligne.substr(0,ligne.find_first_of('\t'));
+
+        // Le reste (définition) est après la tabulation (\t).
+        motTraduit = ligne.substr(motAnglais.length()+1, ligne.length()-1);
+
+        //On élimine tout ce qui est entre crochets [] (possibilité de 2 ou plus)
+        std::size_t pos = motTraduit.find_first_of('[');
+        while (pos!=std::string::npos)
+        {
+            std::size_t longueur_crochet = motTraduit.find_first_of(']')-pos+1;
+            motTraduit.replace(pos, longueur_crochet, "");
+            pos = motTraduit.find_first_of('[');
+        }
+
+        //On élimine tout ce qui est entre deux parenthèses () (possibilité de 2 ou plus)
+        pos = motTraduit.find_first_of('(');
+        while (pos!=std::string::npos)
+        {
+            std::size_t longueur_crochet = motTraduit.find_first_of(')')-pos+1;
+            motTraduit.replace(pos, longueur_crochet, "");
+            pos = motTraduit.find_first_of('(');
+        }
+
+        //Position d'un tilde, s'il y a lieu
+        std::size_t posT = motTraduit.find_first_of('~');
+
+        //Position d'un tilde, s'il y a lieu
+        std::size_t posD = motTraduit.find_first_of(':');
+
+        if (posD < posT)
+        {
+            //Quand le ':' est avant le '~', le mot français précède le ':'
+            motTraduit = motTraduit.substr(0, posD);
+        }
+
+        else
+        {
+            //Quand le ':' est après le '~', le mot français suit le ':'
+            if (posT < posD)
+            {
+                motTraduit = motTraduit.substr(posD, motTraduit.find_first_of("([,;\n", posD));
+            }
+            else
+            {
+                //Quand il n'y a ni ':' ni '~', on extrait simplement ce qu'il y a avant un caractère de limite
+                motTraduit = motTraduit.substr(0, motTraduit.find_first_of("([,;\n"));
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * \fn std::vector<Dictionnaire::EntreeFichier> Dictionnaire::_lireEntreesTriees(std::istream &fichier)
+     * \brief Permet de lire un fichier de dictionnaire en entrées triées par mot, une par mot
+     *
+     * Les lignes d'un même mot sont regroupées, ses traductions gardent l'ordre du fichier et chacune n'apparaît qu'une
+     * fois, comme dans l'arbre après le chargement par le constructeur. Un fichier déjà trié n'est pas retrié.
+     *
+     * \param[in] std::istream &fichier, le fichier à lire
+     * \return std::vector<EntreeFichier>, les entrées en ordre alphabétique
+     * \exception out_of_range si une ligne est invalide
+     */
+    std::vector<Dictionnaire::EntreeFichier> Dictionnaire::_lireEntreesTriees(std::istream &fichier) {
+        vector<pair<string, string> > lignes;
+        string motAnglais, motTraduit;
+        for (string ligne; getline(fichier, ligne); ) {
+            if (_analyserLigne(ligne, motAnglais, motTraduit)) {
+                lignes.emplace_back(motAnglais, motTraduit);
+            }
+        }
+        return _regrouperParMot(lignes);
+    }
+
+    /**
+     * \fn std::vector<Dictionnaire::EntreeFichier> Dictionnaire::_regrouperParMot(std::vector<std::pair<std::string, std::string> > &lignes)
+     * \brief Permet de regrouper des paires (mot, traduction) en une entrée triée par mot
+     * \param[in] std::vector<std::pair<std::string, std::string> > &lignes, les paires, vidées de leurs chaînes
+     * \return std::vector<EntreeFichier>, les entrées en ordre alphabétique, chaque traduction une seule fois, dans l'ordre des paires
+     */
+    std::vector<Dictionnaire::EntreeFichier> Dictionnaire::_regrouperParMot(std::vector<std::pair<std::string, std::string> > &lignes) {
+        auto parMot = [](const pair<string, string>& a, const pair<string, string>& b) { return a.first < b.first; };
+        if (!is_sorted(lignes.begin(), lignes.end(), parMot)) {
+            stable_sort(lignes.begin(), lignes.end(), parMot);
+        }
+
+        vector<EntreeFichier> entrees;
+        for (pair<string, string>& ligne : lignes) {
+            if (entrees.empty() || entrees.back().first != ligne.first) {
+                entrees.emplace_back(std::move(ligne.first), vector<string>());
+            }
+            vector<string>& traductions = entrees.back().second;
+            if (find(traductions.begin(), traductions.end(), ligne.second) == traductions.end()) {
+                traductions.push_back(std::move(ligne.second));
+            }
+        }
+        return entrees;
+    }
+
+    /**
+     * \fn bool Dictionnaire::_vecteurContient(const std::vector<std::string> &vecteur, const std::string& element) const
      * \brief Permet de vérifier si un vecteur de std::string contient un element.
      * \param[in] const std::vector<std::string> &vecteur, le vecteur à parcourir.
      * \param[in] const std::string& element, élément à trouver dans le vecteur.
      * \return bool, true si l'élément est dans le vecteur, false sinon
      */
-    bool Dictionnaire::_vecteurContient(const std::vector<std::string> &vecteur, const std::string& element) {
+    bool Dictionnaire::_vecteurContient(const std::vector<std::string> &vecteur, const std::string& element) const {
         for (const auto & mot : vecteur) {
             if (similitude(mot, element) == SIMILITUDE_MAX) {
                 return true;
@@ -377,309 +1317,432 @@ namespace TP3
     }
 
     /**
-     * \fn void Dictionnaire::_updateHauteurNoeud(Dictionnaire::NoeudDictionnaire *&node)
-     * \brief Permet d'ajuster la hauteur d'un noeud dans l'arbre.
-     * \param[in] Dictionnaire::NoeudDictionnaire *&node, le noeud qu'il faut ajuster la hauteur
-     * \pre le noeud a une valeur de son champ hauteur mauvaise
-     * \post le noeud a une valeur de son champ hauteur ajustée
+     * \fn void Dictionnaire::_apresOperationEnsemble()
+     * \brief Permet de remettre à jour l'index de hachage, le filtre de Bloom et la génération après une opération d'ensemble
+     *
+     * Les noeuds gardés et reçus ne sont pas connus un à un : l'index et le filtre actifs sont reconstruits en O(n).
+     *
      */
-    void Dictionnaire::_updateHauteurNoeud(Dictionnaire::NoeudDictionnaire *&node) {
-        if (node != nullptr) {
-            node->hauteur = 1 + max(_hauteur(node->gauche), _hauteur(node->droite));
+    void Dictionnaire::_apresOperationEnsemble() {
+        if (indexActif) {
+            indexHachage.vider();
+            _indexerRecursif(racine);
         }
+        if (filtreActif)
+            _reconstruireFiltreBloom();
+        generation++;
     }
 
     /**
-     * \fn int Dictionnaire::_hauteur(Dictionnaire::NoeudDictionnaire *&node)
-     * \brief Permet de retourner la hauteur d'un noeud du dictionnaire (arbre AVL)
-     * \param[in] Dictionnaire::NoeudDictionnaire *&node, le noeud qu'il faut trouver la hauteur
-     * \return int, la hauteur du noeud
-     *
-     * Si le noeud est vide, i.e. inexistant (nullptr), on retourne -1
-     *
+     * \fn void Dictionnaire::_ranimer(NoeudDictionnaire* noeud, const std::vector<std::string>& traductions)
+     * \brief Permet de remettre dans le dictionnaire le mot d'une pierre tombale, sans toucher à l'arbre
+     * \param[in] NoeudDictionnaire* noeud, la pierre tombale
+     * \param[in] const std::vector<std::string>& traductions, les nouvelles traductions du mot
      */
-    int Dictionnaire::_hauteur(Dictionnaire::NoeudDictionnaire *&node) {
-        if (node == nullptr)
-            return -1;
-        return node->hauteur;
+    void Dictionnaire::_ranimer(NoeudDictionnaire* noeud, const std::vector<std::string>& traductions) {
+        noeud->supprime = false;
+        noeud->traductions = traductions;
+        nbPierresTombales--;
     }
 
     /**
-     * \fn void Dictionnaire::_balancerUnNoeud(NoeudDictionnaire*& node)
-     * \brief Permet de balancer l'AVL à partir d'un noeud
-     * \param[in] NoeudDictionnaire*& node, un pointeur passé par référence vers le noeud à balancer
-     *
-     * Si le noeud est vide, i.e. inexistant (nullptr), on ne fait rien.
-     * Si débalancement gauche -> ZigZag ou ZigZig gauche, selon déséquilibre secondaire
-     * Si débalancement droite -> ZigZag ou ZigZig droite, selon déséquilibre secondaire
-     *
+     * \fn void Dictionnaire::_marquerSupprime(NoeudDictionnaire* noeud)
+     * \brief Permet de faire d'un noeud une pierre tombale : son mot reste la clé du noeud, ses traductions sont libérées
+     * \param[in] NoeudDictionnaire* noeud, le noeud d'un mot du dictionnaire (déjà retiré de l'index de hachage)
      */
-    void Dictionnaire::_balancerUnNoeud(NoeudDictionnaire*& node) {
+    void Dictionnaire::_marquerSupprime(NoeudDictionnaire* noeud) {
+        noeud->supprime = true;
+        vector<string>().swap(noeud->traductions);
+        nbPierresTombales++;
+    }
 
-        if (node == nullptr)
-            return;
+    /**
+     * \fn std::size_t Dictionnaire::_nombreMotsVivants() const
+     * \brief Permet de connaître le nombre de mots du dictionnaire, sans les pierres tombales
+     * \return std::size_t, le nombre de noeuds de l'arbre moins le nombre de pierres tombales
+     */
+    std::size_t Dictionnaire::_nombreMotsVivants() const {
+        return taille() - nbPierresTombales;
+    }
 
-        if (_debalancementAGauche(node)) {
-            if (_desequilibreSecondaireADroite(node->gauche)) {
-                _zigZagGauche(node); //double rotation nécessaire
-            } else {
-                _zigZigGauche(node); //simple rotation nécessaire
-            }
-        } else if (_debalancementADroite(node)) {
-            if (_desequilibreSecondaireAGauche(node->droite)) {
-                _zigZagDroite(node); //double rotation nécessaire
-            } else {
-                _zigZigDroite(node); //simple rotation nécessaire
-            }
-        }
+    /**
+     * \fn void Dictionnaire::_compacterSiNecessaire()
+     * \brief Permet de compacter l'arbre si la proportion de pierres tombales dépasse la borne de la suppression différée
+     */
+    void Dictionnaire::_compacterSiNecessaire() {
+        if (nbPierresTombales > proportionMaximalePierresTombales * taille())
+            compacte();
     }
 
     /**
-     * \fn bool Dictionnaire::_debalancementAGauche(Dictionnaire::NoeudDictionnaire *&node)
-     * \brief Détermine si un arbre AVL est débalancé à gauche
-     * \param[in] NoeudDictionnaire*& node, un pointeur passé par référence vers le noeud à vérifier le débalancement
-     * \return true si le neoud est débalancé à gauche, false sinon.
-     *
-     * Si le noeud est vide, i.e. inexistant (nullptr), on retourne false.
-     *
+     * \fn const NoeudDictionnaire* Dictionnaire::_premierVivant(const NoeudDictionnaire* noeud)
+     * \brief Permet de sauter les pierres tombales vers l'avant
+     * \param[in] const NoeudDictionnaire* noeud, le noeud de départ (nullptr permis)
+     * \return const NoeudDictionnaire*, le premier noeud qui n'est pas une pierre tombale à partir de noeud, nullptr s'il n'y en a pas
      */
-    bool Dictionnaire::_debalancementAGauche(Dictionnaire::NoeudDictionnaire *&node) {
-	    if (node == nullptr)
-            return false;
+    const NoeudDictionnaire* Dictionnaire::_premierVivant(const NoeudDictionnaire* noeud) {
+        while (noeud != nullptr && noeud->supprime)
+            noeud = ArbreMots::suivant(noeud);
+        return noeud;
+    }
 
-	    return _hauteur(node->gauche) - _hauteur(node->droite) >= 2;
+    /**
+     * \fn const NoeudDictionnaire* Dictionnaire::_dernierVivant(const NoeudDictionnaire* noeud)
+     * \brief Permet de sauter les pierres tombales vers l'arrière
+     * \param[in] const NoeudDictionnaire* noeud, le noeud de départ (nullptr permis)
+     * \return const NoeudDictionnaire*, le dernier noeud qui n'est pas une pierre tombale jusqu'à noeud, nullptr s'il n'y en a pas
+     */
+    const NoeudDictionnaire* Dictionnaire::_dernierVivant(const NoeudDictionnaire* noeud) {
+        while (noeud != nullptr && noeud->supprime)
+            noeud = ArbreMots::precedent(noeud);
+        return noeud;
     }
 
     /**
-     * \fn bool Dictionnaire::_debalancementADroite(Dictionnaire::NoeudDictionnaire *&node)
-     * \brief Détermine si un arbre AVL est débalancé à droite
-     * \param[in] NoeudDictionnaire*& node, un pointeur passé par référence vers le noeud à vérifier le débalancement
-     * \return true si le neoud est débalancé à droite, false sinon.
+     * \fn void Dictionnaire::_detacherArbre()
+     * \brief Permet de reprendre la propriété exclusive des noeuds avant une modification
      *
-     * Si le noeud est vide, i.e. inexistant (nullptr), on retourne false.
+     * Si les noeuds étaient partagés avec une copie différée et ont dû être copiés, l'index de hachage désigne encore ceux de la copie :
+     * il est reconstruit sur les nouveaux noeuds.
      *
      */
-    bool Dictionnaire::_debalancementADroite(Dictionnaire::NoeudDictionnaire *&node) {
-        if (node == nullptr)
-            return false;
-
-        return _hauteur(node->droite) - _hauteur(node->gauche) >= 2;
+    void Dictionnaire::_detacherArbre() {
+        if (detacher() && indexActif) {
+            indexHachage.vider();
+            _indexerRecursif(racine);
+        }
     }
 
     /**
-     * \fn bool Dictionnaire::_desequilibreSecondaireAGauche(Dictionnaire::NoeudDictionnaire *&node)
-     * \brief Détermine si un arbre AVL débalancé a un déséquilibre secondaire à gauche (s'il penche à gauche)
-     * \param[in] NoeudDictionnaire*& node, un pointeur passé par référence vers le noeud à vérifier le déséquilibre secondaire
-     * \return true le sous-arbre penche à gauche, false sinon.
+     * \fn void Dictionnaire::_changerAllocateur(const AllocateurArene<NoeudDictionnaire>& nouvelAllocateur)
+     * \brief Permet de recopier les noeuds avec un autre allocateur
+     * \param[in] const AllocateurArene<NoeudDictionnaire>& nouvelAllocateur, l'allocateur des nouveaux noeuds
      *
-     * Si le noeud est vide, i.e. inexistant (nullptr), on retourne false.
+     * La copie garde la forme de l'arbre et les pierres tombales ; les anciens noeuds (ou la part de ce dictionnaire
+     * dans une forêt partagée avec une copie différée) sont libérés. L'index de hachage est reconstruit sur les nouveaux noeuds.
      *
      */
-    bool Dictionnaire::_desequilibreSecondaireAGauche(Dictionnaire::NoeudDictionnaire *&node) {
-        if (node == nullptr)
-            return false;
+    void Dictionnaire::_changerAllocateur(const AllocateurArene<NoeudDictionnaire>& nouvelAllocateur) {
+        ArbreMots copie(*this, nouvelAllocateur);
+        ArbreMots::swap(copie);
+        if (indexActif) {
+            indexHachage.vider();
+            _indexerRecursif(racine);
+        }
+    }
 
-        return _hauteur(node->gauche) > _hauteur(node->droite);
+    /**
+     * \fn void Dictionnaire::_partagerAllocateur(Dictionnaire& autre) const
+     * \brief Permet de donner à un autre dictionnaire l'allocateur de celui-ci, avant de lui prendre des noeuds
+     * \param[in] Dictionnaire& autre, le dictionnaire dont les noeuds sont recopiés si son allocateur est différent
+     */
+    void Dictionnaire::_partagerAllocateur(Dictionnaire& autre) const {
+        if (autre.allocateur != allocateur)
+            autre._changerAllocateur(allocateur);
     }
 
     /**
-     * \fn bool Dictionnaire::_desequilibreSecondaireADroite(Dictionnaire::NoeudDictionnaire *&node)
-     * \brief Détermine si un arbre AVL débalancé a un déséquilibre secondaire à droie (s'il penche à droie)
-     * \param[in] NoeudDictionnaire*& node, un pointeur passé par référence vers le noeud à vérifier le déséquilibre secondaire
-     * \return true le sous-arbre penche à droie, false sinon.
+     * \fn NoeudDictionnaire* Dictionnaire::_trouverExact(const std::string &motAtrouver) const
+     * \brief Permet de trouver le noeud qui contient exactement un mot
+     * \param[in] const std::string &motAtrouver, mot à trouver dans le dictionnaire
+     * \return NoeudDictionnaire*, un pointeur vers le noeud trouvé, nullptr si noeud pas trouvé.
      *
-     * Si le noeud est vide, i.e. inexistant (nullptr), on retourne false.
+     * Si le filtre de Bloom est actif, un mot qu'il rejette est absent, sans autre recherche. Sinon, si l'index de hachage
+     * est actif, une seule sonde dans la table suffit (les pierres tombales n'y sont pas). Sinon, on descend l'arbre en
+     * comparant les mots (AvlMap::trouver), sans calcul de similitude, et une pierre tombale vaut un mot absent.
      *
      */
-    bool Dictionnaire::_desequilibreSecondaireADroite(Dictionnaire::NoeudDictionnaire *&node) {
-        if (node == nullptr)
-            return false;
-
-        return _hauteur(node->droite) > _hauteur(node->gauche);
+    NoeudDictionnaire* Dictionnaire::_trouverExact(const std::string &motAtrouver) const {
+        TP3_COMPTER(compteursOperations.recherches, 1);
+        if (filtreActif && !filtreBloom.peutContenir(motAtrouver)) {
+            TP3_COMPTER(compteursOperations.rejetsFiltreBloom, 1);
+            return nullptr;
+        }
+        if (indexActif)
+            return indexHachage.trouver(motAtrouver);
+        NoeudDictionnaire* noeud = trouver(motAtrouver);
+        return (noeud != nullptr && noeud->supprime) ? nullptr : noeud;
     }
 
     /**
-     * \fn void Dictionnaire::_zigZagGauche(Dictionnaire::NoeudDictionnaire *&noeudCritique)
-     * \brief Double rotation du sous-arbre AVL à partir d'un noeud critique
-     * \param[in] Dictionnaire::NoeudDictionnaire *&noeudCritique, le noeud critique à partir du quel on effectue les rotations.
+     * \fn std::vector<std::string> Dictionnaire::_calculerSuggestions(const std::string &motMalEcrit) const
+     * \brief Permet de calculer, sans cache, des suggestions pour un mot mal orthographié
+     * \param[in] const std::string &motMalEcrit, le mot mal écrit pour lequel il faut des suggestions
+     * \return std::vector<std::string>, un vecteur qui contient les suggestions.
+     * \pre le dictionnaire n'est pas vide
      *
-     * ZigZig droite sur enfant gauche suivit de ZigZig gauche, ordre est important.
+     * La stratégie est d'utiliser une file d'attente pour le traitement des noeuds. Jusqu'à ce qu'on ne trouve plus de noeud qui respecte le critère de
+     * similitude minimale (SIMILITUDE_MIN_POUR_SUGGESTION) ou bien que le vecteur des suggestions soit plein (LIMITE_SUGGESTIONS), on parcours l'arbre pour trouver
+     * des mots qui sont similaires. On commence par la racine, ensuite dès qu'un noeud est similaire, on l'ajoute au suggestions, puis on met ses enfants dans la file des prochains
+     * noeud à traiter. On recommence ensuite la boucle en prenant le premier noeud à traiter dans la file d'attente.
+     * Une pierre tombale similaire n'est pas suggérée, mais ses enfants sont traités comme si elle l'avait été.
      *
      */
-    void Dictionnaire::_zigZagGauche(Dictionnaire::NoeudDictionnaire *&noeudCritique) {
-        _zigZigDroite(noeudCritique->gauche);
-        _zigZigGauche(noeudCritique);
+    std::vector<std::string> Dictionnaire::_calculerSuggestions(const std::string &motMalEcrit) const {
+        vector<string> suggestions;
+        queue<NoeudDictionnaire*> noeudAtraite; //file d'attente des noeuds à traiter
+        noeudAtraite.push(racine); //on commence par la racine
+
+        while (suggestions.size() < LIMITE_SUGGESTIONS && !noeudAtraite.empty()) {
+            NoeudDictionnaire* suggestion = _trouverRecursif(noeudAtraite.front(), motMalEcrit, SIMILITUDE_MIN_POUR_SUGGESTION);
+            if (suggestion != nullptr)
+                TP3_COMPTER(compteursOperations.candidatsSuggestion, 1);
+            if (suggestion != nullptr && !suggestion->supprime && !_vecteurContient(suggestions, suggestion->mot)) {
+                //ce mot n'a pas encore été mis dans le vecteur de suggestions
+                suggestions.push_back(suggestion->mot);
+            }
+
+            if (suggestion != nullptr) {
+                //on ajoute ses enfants comme prochains noeuds à traiter
+                if (suggestion->droite != nullptr)
+                    noeudAtraite.push(suggestion->droite);
+                if (suggestion->gauche != nullptr)
+                    noeudAtraite.push(suggestion->gauche);
+
+            }
+
+            noeudAtraite.pop(); //on retire le noeud qui vient d'être traité
+        }
+
+        return suggestions;
     }
 
     /**
-     * \fn void Dictionnaire::_zigZagDroite(Dictionnaire::NoeudDictionnaire *&noeudCritique)
-     * \brief Double rotation du sous-arbre AVL à partir d'un noeud critique
-     * \param[in] Dictionnaire::NoeudDictionnaire *&noeudCritique, le noeud critique à partir du quel on effectue les rotations.
-     *
-     * ZigZig gauche sur enfant droite suivit de ZigZig droite, ordre est important.
-     *
+     * \fn void Dictionnaire::_indexerRecursif(NoeudDictionnaire* const & node)
+     * \brief Permet d'ajouter à l'index de hachage tous les noeuds d'un sous-arbre, sauf les pierres tombales
+     * \param[in] NoeudDictionnaire* const & node, la racine du sous-arbre à indexer
      */
-    void Dictionnaire::_zigZagDroite(Dictionnaire::NoeudDictionnaire *&noeudCritique) {
-        _zigZigGauche(noeudCritique->droite);
-        _zigZigDroite(noeudCritique);
+    void Dictionnaire::_indexerRecursif(NoeudDictionnaire* const & node) {
+        if (node == nullptr)
+            return;
+        if (!node->supprime)
+            indexHachage.inserer(node);
+        _indexerRecursif(node->gauche);
+        _indexerRecursif(node->droite);
     }
 
     /**
-     * \fn void Dictionnaire::_zigZigGauche(Dictionnaire::NoeudDictionnaire *&noeudCritique)
-     * \brief Simple rotation du sous-arbre AVL à partir d'un noeud critique
-     * \param[in] Dictionnaire::NoeudDictionnaire *&noeudCritique, le noeud critique à partir du quel on effectue la rotation
+     * \fn void Dictionnaire::_reconstruireFiltreBloom()
+     * \brief Permet de reconstruire le filtre de Bloom à partir des mots de l'arbre
      *
-     * La hauteur des noeuds est ajustée à la fin de la méthode.
+     * Le filtre est dimensionné pour le double du nombre de mots vivants (sans les pierres tombales, qui n'y sont pas
+     * ajoutées) : ajouteMot peut y ajouter autant de mots avant la prochaine reconstruction sans dépasser le taux de faux
+     * positifs visé. Les reconstructions déclenchées par la croissance sont donc espacées géométriquement, et celles
+     * déclenchées par les suppressions le sont d'au moins un quart des mots vivants.
      *
      */
-    void Dictionnaire::_zigZigGauche(Dictionnaire::NoeudDictionnaire *&noeudCritique) {
+    void Dictionnaire::_reconstruireFiltreBloom() {
+        filtreBloom.reinitialiser(2 * _nombreMotsVivants());
+        for (Iterateur mot = begin(); mot != end(); ++mot)
+            filtreBloom.ajouter(*mot);
+        motsSupprimesDuFiltre = 0;
+    }
 
-	    Dictionnaire::NoeudDictionnaire* noeudCritiqueSecondaire = noeudCritique->gauche;
-        noeudCritique->gauche = noeudCritiqueSecondaire->droite;
-        noeudCritiqueSecondaire->droite = noeudCritique;
+    /**
+     * \fn void Dictionnaire::_statistiquesRecursif(const NoeudDictionnaire* node, int profondeur, long long& sommeProfondeurs, int& profondeurMax) const
+     * \brief Permet d'accumuler la profondeur des noeuds d'un sous-arbre
+     * \param[in] const NoeudDictionnaire* node, la racine du sous-arbre
+     * \param[in] int profondeur, la profondeur de node dans l'arbre
+     * \param[out] long long& sommeProfondeurs, la somme des profondeurs accumulée
+     * \param[out] int& profondeurMax, la plus grande profondeur rencontrée, soit la hauteur de l'arbre quelle que soit la politique d'équilibre
+     */
+    void Dictionnaire::_statistiquesRecursif(const NoeudDictionnaire* node, int profondeur, long long& sommeProfondeurs, int& profondeurMax) const {
+        if (node == nullptr)
+            return;
 
-        _updateHauteurNoeud(noeudCritique);
-        _updateHauteurNoeud(noeudCritiqueSecondaire);
+        sommeProfondeurs += profondeur;
+        profondeurMax = max(profondeurMax, profondeur);
 
-        noeudCritique = noeudCritiqueSecondaire;
+        _statistiquesRecursif(node->gauche, profondeur + 1, sommeProfondeurs, profondeurMax);
+        _statistiquesRecursif(node->droite, profondeur + 1, sommeProfondeurs, profondeurMax);
     }
 
     /**
-     * \fn void Dictionnaire::_zigZigDroite(Dictionnaire::NoeudDictionnaire *&noeudCritique)
-     * \brief Simple rotation du sous-arbre AVL à partir d'un noeud critique
-     * \param[in] Dictionnaire::NoeudDictionnaire *&noeudCritique, le noeud critique à partir du quel on effectue la rotation
-     *
-     * La hauteur des noeuds est ajustée à la fin de la méthode.
-     *
+     * \fn void Dictionnaire::_empreinteRecursif(const NoeudDictionnaire* node, EmpreinteMemoire& empreinte) const
+     * \brief Permet d'accumuler l'empreinte mémoire des noeuds d'un sous-arbre, de leurs mots et de leurs traductions
+     * \param[in] const NoeudDictionnaire* node, la racine du sous-arbre
+     * \param[out] EmpreinteMemoire& empreinte, les compteurs de noeuds, de mots et de traductions accumulés
      */
-    void Dictionnaire::_zigZigDroite(Dictionnaire::NoeudDictionnaire *&noeudCritique) {
+    void Dictionnaire::_empreinteRecursif(const NoeudDictionnaire* node, EmpreinteMemoire& empreinte) const {
+        if (node == nullptr)
+            return;
 
-        Dictionnaire::NoeudDictionnaire* noeudCritiqueSecondaire = noeudCritique->droite;
-        noeudCritique->droite = noeudCritiqueSecondaire->gauche;
-        noeudCritiqueSecondaire->gauche = noeudCritique;
+        const size_t capaciteInterne = std::string().capacity(); //au-delà, le contenu d'une chaîne est alloué sur le monceau
+        empreinte.noeuds += sizeof(NoeudDictionnaire);
+        if (node->mot.capacity() > capaciteInterne) {
+            empreinte.motsSurMonceau++;
+            empreinte.octetsMots += node->mot.capacity() + 1;
+        } else {
+            empreinte.motsEnLigne++;
+        }
+        empreinte.octetsTraductions += node->traductions.capacity() * sizeof(std::string);
+        for (const auto & traduction : node->traductions) {
+            if (traduction.capacity() > capaciteInterne)
+                empreinte.octetsTraductions += traduction.capacity() + 1;
+        }
 
-        _updateHauteurNoeud(noeudCritique);
-        _updateHauteurNoeud(noeudCritiqueSecondaire);
+        _empreinteRecursif(node->gauche, empreinte);
+        _empreinteRecursif(node->droite, empreinte);
+    }
 
-        noeudCritique = noeudCritiqueSecondaire;
+    /**
+     * \fn void Dictionnaire::_verifierBudget()
+     * \brief Permet de vérifier le budget mémoire après une croissance du dictionnaire, si elle est assez grande
+     *
+     * Le calcul de l'empreinte est en O(n) : on ne le refait que quand le nombre de noeuds a augmenté d'un huitième
+     * depuis la dernière vérification, soit O(1) amorti par mot ajouté.
+     *
+     */
+    void Dictionnaire::_verifierBudget() {
+        if (budgetOctets != 0 && taille() >= prochaineVerificationBudget)
+            _respecterBudget();
     }
 
     /**
-     * \fn void Dictionnaire::_supprimerMotRecursif(Dictionnaire::NoeudDictionnaire *&node, const std::string &motAenlever)
-     * \brief Permet de supprimer un mot dans le dictionnaire en utilisant la récursion et en gardant l'arbre AVL balancé.
-     * \param[in] Dictionnaire::NoeudDictionnaire *&node, noeud de départ.
-     * \param[in] const std::string &motAenlever, le mot du noeud à enlever
+     * \fn void Dictionnaire::_respecterBudget()
+     * \brief Permet de dégrader les structures facultatives jusqu'à ce que l'empreinte respecte le budget mémoire
      *
-     * Après avoir retiré le noeud de l'arbre AVL, les hauteurs des noeuds sont ajustés et l'arbre est rebalancé.
+     * Les structures sont dégradées de la moins coûteuse à perdre à la plus coûteuse : le cache de suggestions (dont la
+     * capacité est réduite de moitié à chaque pas, puis qui est désactivé sous CAPACITE_MINIMALE_CACHE_BUDGET), le filtre
+     * de Bloom, puis l'index de hachage. L'empreinte est calculée une fois, puis corrigée de ce que chaque pas libère.
      *
      */
-    void Dictionnaire::_supprimerMotRecursif(Dictionnaire::NoeudDictionnaire *&node, const std::string &motAenlever) {
+    void Dictionnaire::_respecterBudget() {
+        prochaineVerificationBudget = taille() + taille() / 8 + 1;
+        if (budgetOctets == 0)
+            return;
 
-	    if (_baseEstPlustPetitQue(node->mot, motAenlever)) {
-            _supprimerMotRecursif(node->droite, motAenlever);
-	    } else if (_baseEstPlustGrandQue(node->mot, motAenlever)) {
-            _supprimerMotRecursif(node->gauche, motAenlever);
-        } else {
-	        //on est sur le noeud avec le mot à supprimer
-            if (_hauteur(node) == 0) {
-                //feuille
-                delete node;
-                node = nullptr;
-                cpt--;
-            } else if (_possedeEnfantUnique(node)) {
-                if (node->gauche != nullptr) {
-                    _swapNodes(node, node->gauche);
-                    _supprimerMotRecursif(node->gauche, motAenlever);
-                } else {
-                    _swapNodes(node, node->droite);
-                    _supprimerMotRecursif(node->droite, motAenlever);
+        size_t total = empreinteMemoire().total;
+        while (total > budgetOctets) {
+            if (cacheSuggestions != nullptr) {
+                const size_t capacite = cacheSuggestions->capacite() / 2;
+                total -= cacheSuggestions->empreinteMemoire();
+                desactiveCacheSuggestions();
+                if (capacite >= CAPACITE_MINIMALE_CACHE_BUDGET) {
+                    cacheSuggestions = new CacheSuggestions(capacite);
+                    total += cacheSuggestions->empreinteMemoire();
                 }
+            } else if (filtreActif) {
+                total -= filtreBloom.empreinteMemoire();
+                desactiveFiltreBloom();
+            } else if (indexActif) {
+                total -= indexHachage.empreinteMemoire();
+                desactiveIndexHachage();
             } else {
-                //2 enfants
-                Dictionnaire::NoeudDictionnaire* noeudMinSousArbreDroite = _noeudMinimalRecusrif(node->droite);
-                _swapNodes(node, noeudMinSousArbreDroite);
+                break;
             }
+            nbDegradationsBudget++;
         }
+    }
 
-        _updateHauteurNoeud(node);
-        _balancerUnNoeud(node);
+    /**
+     * \fn Dictionnaire::Iterateur::Iterateur()
+     * \brief Constructeur d'un itérateur qui ne pointe sur aucun dictionnaire
+     */
+    Dictionnaire::Iterateur::Iterateur() : dictionnaire(nullptr), noeud(nullptr) {}
+
+    /**
+     * \fn Dictionnaire::Iterateur::Iterateur(const Dictionnaire* p_dictionnaire, const NoeudDictionnaire* p_noeud)
+     * \brief Constructeur d'un itérateur sur un noeud d'un dictionnaire
+     * \param[in] const Dictionnaire* p_dictionnaire, le dictionnaire parcouru
+     * \param[in] const NoeudDictionnaire* p_noeud, le noeud courant, nullptr pour end()
+     */
+    Dictionnaire::Iterateur::Iterateur(const Dictionnaire* p_dictionnaire, const NoeudDictionnaire* p_noeud) :
+            dictionnaire(p_dictionnaire), noeud(p_noeud) {}
+
+    /**
+     * \fn Dictionnaire::Iterateur::reference Dictionnaire::Iterateur::operator*() const
+     * \brief Permet d'accéder au mot courant
+     * \return const std::string&, le mot courant
+     */
+    Dictionnaire::Iterateur::reference Dictionnaire::Iterateur::operator*() const {
+        return noeud->mot;
     }
 
     /**
-     * \fn bool Dictionnaire::_baseEstPlustPetitQue(const std::string &base, const std::string &compare)
-     * \brief Permet de comparer 2 mots pour savoir sit la base est plus petit que le mot comparé
-     * \param[in] const std::string &base, la base de la comparaison
-     * \param[in] const std::string &compare, le mot comparé à la base
-     * \return bool, true si la base est plus petite, false sinon
-     *
-     * Selon la théorie des arbres AVL, l'enfant gauche d'un noeud est toujours plus petit que le noeud et l'enfant droit est
-     * toujours plus grand que le noeud. Bien que ce principe s'applique bien aux chiffres, il faut l'appliquer aux mots. Pour ce faire,
-     * la comparaison lexicale et utilisée. Ainsi, un mot est plus petit si sa première lettre est en premier dans l'alphabet. Tant que les lettres sont
-     * identiques entre les 2 mots, la prochaine lettre est comparé. La comparaison est encapsulée dans une méthode pour mieu exprimer l'intention du programmeur.
-     *
+     * \fn Dictionnaire::Iterateur::pointer Dictionnaire::Iterateur::operator->() const
+     * \brief Permet d'accéder aux membres du mot courant
+     * \return const std::string*, le mot courant
+     */
+    Dictionnaire::Iterateur::pointer Dictionnaire::Iterateur::operator->() const {
+        return &noeud->mot;
+    }
+
+    /**
+     * \fn const std::vector<std::string>& Dictionnaire::Iterateur::traductions() const
+     * \brief Permet d'accéder aux traductions du mot courant
+     * \return const std::vector<std::string>&, les traductions du mot courant
      */
-    bool Dictionnaire::_baseEstPlustPetitQue(const std::string &base, const std::string &compare) {
-        return base.compare(compare) < 0;
+    const std::vector<std::string>& Dictionnaire::Iterateur::traductions() const {
+        return noeud->traductions;
     }
 
     /**
-     * \fn bool Dictionnaire::_baseEstPlustGrandQue(const std::string &base, const std::string &compare)
-     * \brief Permet de comparer 2 mots pour savoir sit la base est plus grande que le mot comparé
-     * \param[in] const std::string &base, la base de la comparaison
-     * \param[in] const std::string &compare, le mot comparé à la base
-     * \return bool, true si la base est plus grande, false sinon
+     * \fn Dictionnaire::Iterateur& Dictionnaire::Iterateur::operator++()
+     * \brief Permet d'avancer au mot suivant en ordre alphabétique
+     * \return Dictionnaire::Iterateur&, l'itérateur avancé
      *
-     * Selon la théorie des arbres AVL, l'enfant gauche d'un noeud est toujours plus petit que le noeud et l'enfant droit est
-     * toujours plus grand que le noeud. Bien que ce principe s'applique bien aux chiffres, il faut l'appliquer aux mots. Pour ce faire,
-     * la comparaison lexicale et utilisée. Ainsi, un mot est plus petit si sa première lettre est en premier dans l'alphabet. Tant que les lettres sont
-     * identiques entre les 2 mots, la prochaine lettre est comparé. La comparaison est encapsulée dans une méthode pour mieu exprimer l'intention du programmeur.
+     * Le successeur est trouvé par AvlMap::suivant, en suivant les pointeurs enfant/parent (nullptr, soit end(), si on
+     * dépasse la racine). Les pierres tombales sont sautées.
      *
      */
-    bool Dictionnaire::_baseEstPlustGrandQue(const std::string &base, const std::string &compare) {
-        return base.compare(compare) > 0;
+    Dictionnaire::Iterateur& Dictionnaire::Iterateur::operator++() {
+        noeud = _premierVivant(ArbreMots::suivant(noeud));
+        return *this;
     }
 
     /**
-     * \fn bool Dictionnaire::_possedeEnfantUnique(NoeudDictionnaire* const & node)
-     * \brief Permet de vérifier si un noeud a un seul enfant, gauche ou droite
-     * \param[in] NoeudDictionnaire* const & node, le noeud qu'il faut vérifier le nombre d'enfants
-     * \return bool, true si le noeud a un seul enfant, false sinon
+     * \fn Dictionnaire::Iterateur Dictionnaire::Iterateur::operator++(int)
+     * \brief Post-incrémentation
+     * \return Dictionnaire::Iterateur, l'itérateur avant l'incrémentation
      */
-    bool Dictionnaire::_possedeEnfantUnique(NoeudDictionnaire* const & node) {
-	    bool enfantGauche = node->gauche != nullptr;
-	    bool enfantDroite = node->droite != nullptr;
-
-        return enfantGauche ^ enfantDroite; //XOR
+    Dictionnaire::Iterateur Dictionnaire::Iterateur::operator++(int) {
+        Iterateur copie = *this;
+        ++(*this);
+        return copie;
     }
 
     /**
-     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_noeudMinimalRecusrif(NoeudDictionnaire* const & node)
-     * \brief Permet de trouver le noeud minimal dans un arbre AVL à partir d'un noeud de base.
-     * \param[in] NoeudDictionnaire* const & node, le noeud de départ
-     * \return Dictionnaire::NoeudDictionnaire*, un pointeur vers le noeud minimal trouvé
+     * \fn Dictionnaire::Iterateur& Dictionnaire::Iterateur::operator--()
+     * \brief Permet de reculer au mot précédent en ordre alphabétique
+     * \return Dictionnaire::Iterateur&, l'itérateur reculé
      *
-     * La récusion est utilisée. Le noeud minimal sera la première feuille gauche rencontrée.
+     * Décrémenter end() donne le mot maximal du dictionnaire. Sinon, c'est le symétrique de l'incrémentation.
      *
      */
-    Dictionnaire::NoeudDictionnaire* Dictionnaire::_noeudMinimalRecusrif(NoeudDictionnaire* const & node) {
-        if (node->gauche == nullptr) {
-            return node;
-        }
-        return _noeudMinimalRecusrif(node->gauche);
+    Dictionnaire::Iterateur& Dictionnaire::Iterateur::operator--() {
+        if (noeud == nullptr)
+            noeud = _dernierVivant(dictionnaire->dernier());
+        else
+            noeud = _dernierVivant(ArbreMots::precedent(noeud));
+        return *this;
     }
 
     /**
-     * \fn void Dictionnaire::_swapNodes(Dictionnaire::NoeudDictionnaire *&nodeBase, Dictionnaire::NoeudDictionnaire *&nodeToSwapTo)
-     * \brief Permet d'échanger 2 noeud dans l'arbre AVL.
-     * \param[in] Dictionnaire::NoeudDictionnaire *&nodeBase, le noeud de base dans le swap
-     * \param[in] Dictionnaire::NoeudDictionnaire *&nodeToSwapTo, le second noeud dans le swap
-     *
-     * Le swap change la donnée du noeud, i.e. le mot, ainsi que ses traductions.
-     *
+     * \fn Dictionnaire::Iterateur Dictionnaire::Iterateur::operator--(int)
+     * \brief Post-décrémentation
+     * \return Dictionnaire::Iterateur, l'itérateur avant la décrémentation
+     */
+    Dictionnaire::Iterateur Dictionnaire::Iterateur::operator--(int) {
+        Iterateur copie = *this;
+        --(*this);
+        return copie;
+    }
+
+    /**
+     * \fn bool Dictionnaire::Iterateur::operator==(const Iterateur &autre) const
+     * \brief Deux itérateurs sont égaux s'ils pointent sur le même noeud
+     */
+    bool Dictionnaire::Iterateur::operator==(const Iterateur &autre) const {
+        return noeud == autre.noeud;
+    }
+
+    /**
+     * \fn bool Dictionnaire::Iterateur::operator!=(const Iterateur &autre) const
+     * \brief Deux itérateurs sont différents s'ils pointent sur des noeuds différents
      */
-    void Dictionnaire::_swapNodes(Dictionnaire::NoeudDictionnaire *&nodeBase, Dictionnaire::NoeudDictionnaire *&nodeToSwapTo) {
-        swap(nodeBase->mot, nodeToSwapTo->mot);
-        nodeBase->traductions.swap(nodeToSwapTo->traductions);
+    bool Dictionnaire::Iterateur::operator!=(const Iterateur &autre) const {
+        return noeud != autre.noeud;
     }
 
 }//Fin du namespace
@@ -13,9 +13,29 @@
 
 #include <iostream>
 #include <fstream> // pour les fichiers
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <queue>
+#include <iterator>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include "AvlMap.h"
+#include "IndexHachage.h"
+#include "Instrumentation.h"
+#include "HistogrammeLatence.h"
+#include "CacheSuggestions.h"
+#include "FiltreBloom.h"
+#include "PolitiquesEquilibre.h"
+#include "ArenaGrandesPages.h"
+
+//Politique d'équilibre de l'arbre, choisie à la compilation (option CMake TP3_POLITIQUE_EQUILIBRE)
+//PolitiqueAVL, PolitiqueRougeNoir, PolitiqueWAVL ou PolitiqueTreap
+#ifndef TP3_POLITIQUE_EQUILIBRE
+#define TP3_POLITIQUE_EQUILIBRE PolitiqueAVL
+#endif
 
 
 /**
@@ -25,20 +45,150 @@
 namespace TP3
 {
 
+class DictionnaireFige;
+
+/**
+ * \class NoeudDictionnaire
+ * \brief Classe représentant un noeud dans l'arbre AVL constituant le dictionnaire de traduction.
+ *
+ *  C'est le type de noeud de l'AvlMap dont hérite Dictionnaire : cle() et valeur() sont l'interface attendue par
+ *  AvlMap, les champs mot et traductions celle du reste du dictionnaire.
+ *
+ *  Propriétés (accessible par dictionnaire):
+ * 	- mot : le mot contenus dans le noeud
+ * 	- traductions : les traductions possibles du mot
+ * 	- gauche : pointeur vers le noeud enfant gauche
+ * 	- droite : pointeur vers le noeud enfant droite
+ * 	- parent : pointeur vers le noeud parent (nullptr pour la racine), utilisé par les itérateurs
+ * 	- hauteur : hauteur du noeud dans l'arbre (rang ou priorité selon la politique d'équilibre)
+ * 	- supprime : pierre tombale, le mot a été supprimé en mode suppression différée et attend la compaction
+ *
+ */
+class NoeudDictionnaire
+{
+public:
+
+	std::string mot;						// Un mot (en anglais)
+
+	std::vector<std::string> traductions;	// Les différentes traductions possibles en français du mot en anglais
+											// Par exemple, la liste française { "contempler", "envisager" et "prévoir" }
+											// pourrait servir de traduction du mot anglais "contemplate".
+
+    NoeudDictionnaire *gauche, *droite;		// Les enfants du noeud
+
+    NoeudDictionnaire *parent;				// Le parent du noeud (nullptr pour la racine)
+
+    int hauteur;							// La hauteur de ce noeud (afin de maintenir l'équilibre de l'arbre AVL), ou la métadonnée de PolitiqueEquilibre
+
+    bool supprime;							// Pierre tombale : le noeud reste dans l'arbre, mais le mot n'est plus dans le dictionnaire
+
+    NoeudDictionnaire(const std::string& p_mot, const std::vector<std::string>& p_traductions) :
+            mot(p_mot), traductions(p_traductions), gauche(nullptr), droite(nullptr), parent(nullptr), hauteur(0), supprime(false) {}
+
+    const std::string& cle() const { return mot; }
+    std::vector<std::string>& valeur() { return traductions; }
+    const std::vector<std::string>& valeur() const { return traductions; }
+};
+
+//Arbre des mots du dictionnaire : mot -> traductions, en ordre lexicographique
+//Les noeuds sont alloués sur le monceau ordinaire, ou dans une ArenaGrandesPages (Dictionnaire::activeGrandesPages)
+typedef AvlMap<std::string, std::vector<std::string>, std::less<std::string>, AllocateurArene<NoeudDictionnaire>,
+               TP3_POLITIQUE_EQUILIBRE, NoeudDictionnaire> ArbreMots;
+
+/**
+ * \struct RapportDiff
+ * \brief Résultat de Dictionnaire::appliquerDiff : ce qui a changé entre les 2 versions du fichier, et le temps pris
+ *
+ *  Attributs:
+ *      - motsAjoutes, motsSupprimes : mots présents dans une seule des 2 versions (un mot disparu qui n'était déjà plus
+ *        dans le dictionnaire n'est pas compté)
+ *      - motsModifies : mots présents dans les 2 versions avec des traductions différentes
+ *      - motsInchanges : mots identiques dans les 2 versions, auxquels on n'a pas touché
+ *      - traductionsAjoutees, traductionsRetirees : traductions gagnées ou perdues (mots ajoutés et supprimés compris)
+ *      - dureeNanosecondes : durée de la lecture des 2 fichiers, de la fusion et des modifications
+ *
+ */
+struct RapportDiff
+{
+    std::size_t motsAjoutes;
+    std::size_t motsSupprimes;
+    std::size_t motsModifies;
+    std::size_t motsInchanges;
+    std::size_t traductionsAjoutees;
+    std::size_t traductionsRetirees;
+    std::uint64_t dureeNanosecondes;
+};
+
+/**
+ * \struct EmpreinteMemoire
+ * \brief Résultat de Dictionnaire::empreinteMemoire : les octets utilisés par un dictionnaire, partie par partie
+ *
+ *  Les tailles sont celles demandées aux allocateurs, sans leur surcoût par bloc. Un mot ou une traduction qui tient
+ *  dans le tampon interne de std::string (SSO) n'occupe que son objet std::string, déjà compté dans son noeud ou son
+ *  vecteur.
+ *
+ *  Attributs:
+ *      - noeuds : les noeuds de l'arbre, pierres tombales comprises
+ *      - motsEnLigne, motsSurMonceau : nombre de mots gardés dans le tampon interne ou alloués à part
+ *      - octetsMots : contenu des mots alloués à part
+ *      - octetsTraductions : tableaux des vecteurs de traductions et contenu des traductions allouées à part
+ *      - indexHachage, filtreBloom, cacheSuggestions : les structures facultatives (0 si elles sont inactives)
+ *      - total : noeuds, mots, traductions et structures facultatives
+ *
+ */
+struct EmpreinteMemoire
+{
+    std::size_t noeuds;
+    std::size_t motsEnLigne;
+    std::size_t motsSurMonceau;
+    std::size_t octetsMots;
+    std::size_t octetsTraductions;
+    std::size_t indexHachage;
+    std::size_t filtreBloom;
+    std::size_t cacheSuggestions;
+    std::size_t total;
+};
+
 /**
  * \class Dictionnaire
  * \brief classe représentant un dictionnaire de traductions sous forme d'un arbre AVL
  *
- *  Attributs:
+ *  L'arbre est un AvlMap (mot -> traductions) ordonné par std::less<std::string> : les recherches exactes comparent les
+ *  mots directement, sans passer par similitude. L'équilibre est délégué à PolitiqueEquilibre (AVL par défaut) : les
+ *  autres politiques de PolitiquesEquilibre.h réutilisent le champ hauteur des noeuds pour leur rang ou leur priorité.
+ *
+ *  Un déplacement ou un swap transfère l'arbre, les index et le cache en O(1). copieDifferee() est une copie complète
+ *  remise à plus tard : elle est en O(1), mais la première modification de l'un des 2 dictionnaires copie tous les
+ *  mots et toutes les traductions, et reconstruit son index de hachage, en O(n). Préparer une nouvelle version à partir
+ *  du dictionnaire en service coûte donc une copie complète, payée par le premier des 2 qui est modifié.
+ *
+ *  En mode suppression différée, supprimeMot ne fait que marquer le noeud du mot (pierre tombale) : l'arbre n'est pas
+ *  restructuré. Tout ce qui lit les mots (recherches, suggestions, parcours, itérateurs) saute les pierres tombales.
+ *  Elles sont retirées en bloc par compacte(), appelée aussi dès que leur proportion dans l'arbre dépasse la borne
+ *  choisie, et avant les opérations qui déplacent des sous-arbres (scinde, concatene, opérations d'ensemble).
+ *
+ *  En mode grandes pages, les noeuds sont alloués dans une ArenaGrandesPages plutôt que sur le monceau. Les 2
+ *  dictionnaires d'une opération qui déplace des noeuds de l'un à l'autre doivent partager leur allocateur : les noeuds
+ *  de l'autre dictionnaire y sont d'abord recopiés au besoin.
+ *
+ *  Attributs (hérités d'AvlMap):
  *      - NoeudDictionnaire * racine, racine de l'arbre AVL
-        - int cpt, nombre de mot
+ *      - std::size_t nbNoeuds, nombre de noeuds (taille()), pierres tombales comprises
  *
  */
 
-class Dictionnaire
+class Dictionnaire : private ArbreMots
 {
 public:
 
+	//Itérateur bidirectionnel (lecture seule) qui parcourt les mots en ordre alphabétique
+	class Iterateur;
+	typedef Iterateur iterator;
+	typedef Iterateur const_iterator;
+
+	//Politique d'équilibre de l'arbre (voir PolitiquesEquilibre.h)
+	typedef TP3_POLITIQUE_EQUILIBRE PolitiqueEquilibre;
+
 	//Constructeur
 	Dictionnaire();
 
@@ -46,43 +196,238 @@ public:
 	//Le fichier doit être ouvert au préalable
 	explicit Dictionnaire(std::ifstream &fichier);
 
+	//Constructeur de copie : copie les mots et reconstruit l'index de hachage et le cache (vide) de la source
+	Dictionnaire(const Dictionnaire& source);
+
+	//Constructeur de déplacement, en O(1) : la source devient un dictionnaire vide, sans index, filtre ni cache
+	Dictionnaire(Dictionnaire&& source);
+
+	//Affectation par copie ou par déplacement (copie, ou déplacement en O(1), puis swap)
+	Dictionnaire& operator=(Dictionnaire source);
+
 	//Destructeur.
 	~Dictionnaire();
 
+	//Échanger le contenu de 2 dictionnaires en O(1). Les histogrammes de latence restent à leur instance.
+	void swap(Dictionnaire& autre);
+
+	//Copie complète différée : O(1) à l'appel, les mots sont partagés avec ce dictionnaire jusqu'à la première
+	//modification de l'un des 2, qui copie alors tous les noeuds et reconstruit son index de hachage en O(n).
+	//L'index de hachage et le filtre de Bloom sont copiés, le cache de suggestions repart vide avec la même capacité.
+	//Ne doit pas être appelée en même temps qu'une modification de ce dictionnaire.
+	Dictionnaire copieDifferee() const;
+
 	//Ajouter un mot au dictionnaire et l'une de ses traductions en équilibrant l'arbre AVL
 	void ajouteMot(const std ::string& motOriginal, const std ::string& motTraduit);
 
 	//Supprimer un mot et équilibrer l'arbre AVL
 	//Si le mot appartient au dictionnaire, on l'enlève et on équilibre. Sinon, on ne fait rien.
+	//En mode suppression différée, le mot est seulement marqué comme supprimé, sans rééquilibrage.
 	//Exception	logic_error si l'arbre est vide
 	//Exception	logic_error si le mot n'appartient pas au dictionnaire
 	void supprimeMot(const std ::string& motOriginal);
 
+	//Ajouter un lot de paires (mot, traduction), comme autant d'appels à ajouteMot
+	//Un gros lot est fusionné avec l'arbre, reconstruit une seule fois au lieu d'un rééquilibrage par mot.
+	void ajouteMots(const std::vector<std::pair<std::string, std::string> >& motsTraduits);
+
+	//Supprimer un lot de mots. Les mots absents sont ignorés ; on retourne le nombre de mots supprimés.
+	//Un gros lot est retiré en un seul parcours de l'arbre, reconstruit une seule fois.
+	std::size_t supprimeMots(const std::vector<std::string>& mots);
+
+	//Séparer le dictionnaire : les mots plus petits que 'mot' restent, les autres (le mot compris) sont retournés dans un
+	//nouveau dictionnaire, sans index, filtre ni cache. Les noeuds ne sont pas copiés : O(log n) pour l'arbre.
+	Dictionnaire scinde(const std::string& mot);
+
+	//Ajouter à la suite les mots d'un dictionnaire dont tous les mots suivent ceux-ci, sans copier ses noeuds
+	//Exception logic_error si un mot de 'superieurs' ne suit pas tous les mots de ce dictionnaire
+	void concatene(Dictionnaire superieurs);
+
+	//Opérations d'ensemble avec un autre dictionnaire, dont les noeuds sont repris sans copie (passer std::move(autre),
+	//ou autre.copieDifferee() pour le garder). Les sous-arbres sont traités en parallèle sur de gros dictionnaires. L'index de
+	//hachage et le filtre de Bloom sont reconstruits s'ils sont actifs.
+	//Union : un mot commun reçoit les traductions de l'autre dictionnaire qui lui manquent
+	void fusionne(Dictionnaire autre);
+	//Intersection : garder seulement les mots aussi présents dans l'autre dictionnaire, avec leurs traductions d'ici
+	void intersecte(Dictionnaire autre);
+	//Différence : retirer les mots présents dans l'autre dictionnaire
+	void retranche(Dictionnaire autre);
+
 	//Quantifier la similitude entre 2 mots (dans le dictionnaire ou pas)
 	//Ici, 1 représente le fait que les 2 mots sont identiques, 0 représente le fait que les 2 mots sont complètements différents
 	//On retourne une valeur entre 0 et 1 quantifiant la similarité entre les 2 mots donnés
 	//Vous pouvez utiliser par exemple la distance de Levenshtein, mais ce n'est pas obligatoire !
-	double similitude(const std ::string& mot1, const std ::string& mot2);
+	double similitude(const std ::string& mot1, const std ::string& mot2) const;
 
 
 	//Suggère des corrections pour le mot motMalEcrit sous forme d'une liste de mots, dans un vector, à partir du dictionnaire
 	//S'il y a suffisament de mots, on redonne 5 corrections possibles au mot donné. Sinon, on en donne le plus possible
 	//Exception	logic_error si le dictionnaire est vide
-	std::vector<std::string> suggereCorrections(const std ::string& motMalEcrit);
+	std::vector<std::string> suggereCorrections(const std ::string& motMalEcrit) const;
 
 	//Trouver les traductions possibles d'un mot
 	//Si le mot appartient au dictionnaire, on retourne le vecteur des traductions du mot donné.
 	//Sinon, on retourne un vecteur vide
-	std::vector<std::string> traduit(const std ::string& mot);
+	std::vector<std::string> traduit(const std ::string& mot) const;
 
 	//Vérifier si le mot donné appartient au dictionnaire
 	//On retourne true si le mot est dans le dictionnaire. Sinon, on retourne false.
-	bool appartient(const std::string &mot);
+	bool appartient(const std::string &mot) const;
 
 	//Vérifier si le dictionnaire est vide
 	bool estVide() const;
 
+	//Activer l'index de hachage utilisé par appartient et traduit pour les recherches exactes
+	//L'index est construit à partir de l'arbre puis maintenu par ajouteMot et supprimeMot. L'arbre AVL reste la structure de référence.
+	void activeIndexHachage();
+
+	//Désactiver l'index de hachage et libérer sa mémoire
+	void desactiveIndexHachage();
+
+	//Vérifier si l'index de hachage est actif
+	bool indexHachageEstActif() const;
+
+	//Activer un cache d'au plus 'capacite' mots devant suggereCorrections, partagé sans risque entre plusieurs fils lecteurs
+	//Les entrées sont invalidées dès que ajouteMot ou supprimeMot change l'ensemble des mots. Remplace un cache déjà actif.
+	//Exception logic_error si la capacité est 0
+	void activeCacheSuggestions(std::size_t capacite);
+
+	//Désactiver le cache de suggestions et libérer sa mémoire
+	void desactiveCacheSuggestions();
+
+	//Vérifier si le cache de suggestions est actif
+	bool cacheSuggestionsEstActif() const;
+
+	//Activer un filtre de Bloom sur tous les mots, consulté par appartient et traduit avant la descente dans l'arbre
+	//Un mot absent du filtre est rejeté sans parcourir l'arbre. Le filtre est reconstruit par ajouteMot et supprimeMot
+	//quand les suppressions ou la croissance du dictionnaire ont trop dégradé son taux de faux positifs.
+	void activeFiltreBloom();
+
+	//Désactiver le filtre de Bloom et libérer sa mémoire
+	void desactiveFiltreBloom();
+
+	//Vérifier si le filtre de Bloom est actif
+	bool filtreBloomEstActif() const;
+
+	//Activer la suppression différée : supprimeMot et supprimeMots marquent les noeuds des mots (pierres tombales) en
+	//O(log n) par mot, sans restructurer l'arbre. L'arbre est compacté dès que la proportion de pierres tombales parmi ses
+	//noeuds dépasse proportionMaximale. Remplace la proportion d'un mode déjà actif.
+	//Exception logic_error si proportionMaximale n'est pas dans ]0, 1]
+	void activeSuppressionDifferee(double proportionMaximale = 0.25);
+
+	//Désactiver la suppression différée, après avoir compacté l'arbre
+	void desactiveSuppressionDifferee();
+
+	//Vérifier si la suppression différée est active
+	bool suppressionDiffereeEstActive() const;
+
+	//Nombre de mots supprimés dont le noeud est encore dans l'arbre
+	std::size_t nombrePierresTombales() const;
+
+	//Reconstruire l'arbre sans ses pierres tombales, en un seul passage (sans effet s'il n'y en a pas)
+	//Un service peut l'appeler hors du chemin critique, par exemple d'un fil de maintenance qui tient le verrou d'écriture.
+	void compacte();
+
+	//Recopier les noeuds, en ordre préfixe, dans des régions contiguës servies en grandes pages transparentes (voir
+	//ArenaGrandesPages.h) : une descente touche moins de pages et manque moins souvent le TLB. En O(n).
+	//Les mots courts sont gardés dans leur noeud (std::string sans allocation) et le suivent dans l'arène ; les mots plus
+	//longs et les traductions restent sur le monceau. Une copie du dictionnaire reçoit sa propre arène, une copie différée partage
+	//la sienne. Remplace l'arène d'un mode déjà actif.
+	//Exception logic_error si tailleRegion est 0
+	void activeGrandesPages(std::size_t tailleRegion = ArenaGrandesPages::TAILLE_REGION);
+
+	//Recopier les noeuds sur le monceau ordinaire ; l'arène est libérée avec le dernier noeud qui y est (sans effet si le mode est inactif)
+	void desactiveGrandesPages();
+
+	//Vérifier si les noeuds sont alloués dans une arène de grandes pages
+	bool grandesPagesSontActives() const;
+
+	//Octets réservés par l'arène des noeuds (0 si le mode grandes pages est inactif)
+	std::size_t octetsGrandesPages() const;
+
+	//Nombre de consultations réussies et ratées du cache de suggestions depuis son activation (0 s'il est inactif)
+	unsigned long long succesCacheSuggestions() const;
+	unsigned long long echecsCacheSuggestions() const;
+
+	//Trouver, en ordre alphabétique, au plus 'limite' mots qui commencent par le préfixe donné
+	std::vector<std::string> motsAvecPrefixe(const std::string& prefixe, std::size_t limite) const;
+
+	//Trouver, en ordre alphabétique, au plus 'limite' mots compris entre motDebut et motFin inclusivement
+	std::vector<std::string> motsEntre(const std::string& motDebut, const std::string& motFin, std::size_t limite) const;
+
+	//Visiter en ordre alphabétique, sans allocation, les mots qui commencent par le préfixe donné
+	//Le visiteur est appelé avec (mot, traductions) et retourne false pour arrêter le parcours
+	template<typename Visiteur>
+	void parcoursPrefixe(const std::string& prefixe, Visiteur visiteur) const;
+
+	//Visiter en ordre alphabétique, sans allocation, les mots compris entre motDebut et motFin inclusivement
+	//Le visiteur est appelé avec (mot, traductions) et retourne false pour arrêter le parcours
+	template<typename Visiteur>
+	void parcoursEntre(const std::string& motDebut, const std::string& motFin, Visiteur visiteur) const;
+
+	//Compteurs d'opérations (visites, Levenshtein, rotations, allocations, candidats de suggestion)
+	//Les compteurs restent à 0 si le projet n'est pas compilé avec TP3_INSTRUMENTATION
+	const CompteursOperations& compteurs() const;
+
+	//Remettre les compteurs d'opérations à 0
+	void reinitialiseCompteurs();
+
+	//Calculer la hauteur, le nombre de mots, la profondeur moyenne et l'empreinte mémoire de l'arbre
+	StatistiquesArbre statistiques() const;
+
+	//Détailler les octets utilisés par les noeuds, les mots, les traductions et les structures facultatives (en O(n))
+	//Les noeuds partagés avec une copie différée sont comptés par chacun des 2 dictionnaires.
+	EmpreinteMemoire empreinteMemoire() const;
+
+	//Fixer un budget mémoire en octets (0 pour aucun budget). Quand l'empreinte le dépasse, les structures facultatives
+	//se dégradent au lieu de le dépasser : le cache de suggestions est réduit de moitié (puis désactivé), puis le filtre
+	//de Bloom et enfin l'index de hachage sont désactivés. Les mots ne sont jamais retirés.
+	//Le budget est vérifié tout de suite, à chaque activation d'une structure facultative, et quand le nombre de mots a
+	//augmenté d'un huitième depuis la dernière vérification.
+	void fixeBudgetMemoire(std::size_t octets);
+
+	//Le budget mémoire en octets (0 s'il n'y en a pas)
+	std::size_t budgetMemoire() const;
+
+	//Nombre de réductions ou de désactivations de structures facultatives faites pour respecter le budget
+	unsigned long long degradationsBudgetMemoire() const;
+
+	//Histogramme des latences d'une opération (traduit, appartient, suggereCorrections, ajouteMot, supprimeMot)
+	//Sans TP3_INSTRUMENTATION, le dictionnaire n'a pas d'histogrammes : on retourne un histogramme vide partagé
+	const HistogrammeLatence& latence(OperationDictionnaire operation) const;
+
+	//Écrire les histogrammes de latence, les compteurs d'opérations et le nombre de mots au format texte Prometheus
+	void exporteMetriquesPrometheus(std::ostream& sortie) const;
+
+	//Écrire les métriques au format texte Prometheus dans un fichier, remplacé de façon atomique (fichier temporaire puis renommage)
+	//Exception runtime_error si le fichier ne peut pas être écrit
+	void exporteMetriquesPrometheus(const std::string& cheminFichier) const;
+
+	//Itérateur sur le premier mot en ordre alphabétique
+	Iterateur begin() const;
+
+	//Itérateur après le dernier mot
+	Iterateur end() const;
+
+	//Itérateur sur le premier mot plus grand ou égal au mot donné (end() s'il n'y en a pas)
+	Iterateur lower_bound(const std::string& mot) const;
+
+	//Itérateur sur le premier mot strictement plus grand que le mot donné (end() s'il n'y en a pas)
+	Iterateur upper_bound(const std::string& mot) const;
+
+	//Appliquer seulement les différences entre 2 versions d'un fichier de dictionnaire (même format que le constructeur)
+	//Le dictionnaire doit refléter l'ancienne version. Les 2 fichiers sont lus et triés par mot, puis fusionnés en un
+	//seul passage : un mot disparu est supprimé, un mot nouveau est ajouté, un mot dont les traductions ont changé est
+	//complété (nouvelles traductions à la fin) ou remplacé (traduction retirée ou ordre changé). Les autres mots ne sont
+	//pas touchés. On retourne le nombre de changements et la durée de l'opération.
+	RapportDiff appliquerDiff(std::istream& ancienFichier, std::istream& nouveauFichier);
+
+	//Construire une copie immuable et compacte du dictionnaire (hachage parfait minimal, mots triés, traductions contiguës)
+	//Le dictionnaire n'est pas modifié. Voir DictionnaireFige.h.
+	DictionnaireFige fige() const;
+
 	//Affiche à l'écran l'arbre niveau par niveau de façon à voir si l'arbre est bien balancé.
+	//Les pierres tombales (mots supprimés en attente de compaction) ne sont pas affichées.
 	//Ne touchez pas s.v.p. à cette méthode !
     friend std::ostream& operator<<(std::ostream& out, const Dictionnaire& d)
     {
@@ -102,12 +447,15 @@ public:
   		  {
   			  noeudDicotemp = file.front();
   			  niveauTemp = fileNiveau.front();
-  			  out << noeudDicotemp->mot;
-  			  if (noeudDicotemp->gauche == 0) hg = -1; else hg = noeudDicotemp->gauche->hauteur;
-  			  if (noeudDicotemp->droite == 0) hd = -1; else hd = noeudDicotemp->droite->hauteur;
-  			  out << ", " << hg - hd;
-  			  out << ", " << niveauTemp;
-  			  out << std::endl;
+  			  if (!noeudDicotemp->supprime)
+  			  {
+  				  out << noeudDicotemp->mot;
+  				  if (noeudDicotemp->gauche == 0) hg = -1; else hg = noeudDicotemp->gauche->hauteur;
+  				  if (noeudDicotemp->droite == 0) hd = -1; else hd = noeudDicotemp->droite->hauteur;
+  				  out << ", " << hg - hd;
+  				  out << ", " << niveauTemp;
+  				  out << std::endl;
+  			  }
   			  file.pop();
   			  fileNiveau.pop();
   			  if (noeudDicotemp->gauche != 0)
@@ -129,82 +477,224 @@ public:
 private:
 
     /**
-     * \class NoeudDictionnaire
-     * \brief Classe interne représentant un noeud dans l'arbre AVL constituant le dictionnaire de traduction.
-     *
-     *  Propriétés (accessible par dictionnaire):
-     * 	- mot : le mot contenus dans le noeud
-     * 	- traductions : les traductions possibles du mot
-     * 	- gauche : pointeur vers le noeud enfant gauche
-     * 	- droite : pointeur vers le noeud enfant droite
-     * 	- hauteur : hauteur du noeud dans l'arbre
+     * \var indexHachage
+     * \brief Index optionnel mot -> noeud pour les recherches exactes, maintenu seulement si indexActif
+     */
+    IndexHachage<NoeudDictionnaire> indexHachage;
+    bool indexActif;
+    /**
+     * \var cacheSuggestions
+     * \brief Cache optionnel des suggestions (nullptr s'il est inactif)
+     */
+    CacheSuggestions* cacheSuggestions;
+    /**
+     * \var generation
+     * \brief Incrémenté chaque fois que l'ensemble des mots change ; les suggestions en cache d'une autre génération sont périmées
+     */
+    unsigned long long generation;
+    /**
+     * \var filtreBloom
+     * \brief Filtre optionnel des mots présents, maintenu seulement si filtreActif
      *
+     * motsSupprimesDuFiltre compte les mots supprimés depuis la dernière reconstruction : ils sont encore dans le filtre.
      */
-	class NoeudDictionnaire
-	{
-	public:
-
-		std::string mot;						// Un mot (en anglais)
-
-		std::vector<std::string> traductions;	// Les différentes traductions possibles en français du mot en anglais
-												// Par exemple, la liste française { "contempler", "envisager" et "prévoir" }
-												// pourrait servir de traduction du mot anglais "contemplate".
-
-	    NoeudDictionnaire *gauche, *droite;		// Les enfants du noeud
-
-	    int hauteur;							// La hauteur de ce noeud (afin de maintenir l'équilibre de l'arbre AVL)
-
-        explicit NoeudDictionnaire(const std::string& p_mot, const std::string& traduction) :
-                mot(p_mot), gauche(nullptr), droite(nullptr), hauteur(0), traductions() {
-            traductions.push_back(traduction);
-        }
-	};
-
+    FiltreBloom filtreBloom;
+    bool filtreActif;
+    int motsSupprimesDuFiltre;
+    /**
+     * \var suppressionDifferee
+     * \brief Mode suppression différée ; nbPierresTombales noeuds de l'arbre sont marqués supprimés (0 hors de ce mode)
+     */
+    bool suppressionDifferee;
+    double proportionMaximalePierresTombales;
+    std::size_t nbPierresTombales;
     /**
-     * \var racine
-     * \brief La racine de l'arbre des mots contenus dans une instance de la classe privée NoeudDictionnaire
+     * \var budgetOctets
+     * \brief Budget mémoire (0 pour aucun) ; vérifié de nouveau quand taille() atteint prochaineVerificationBudget
      */
-	NoeudDictionnaire * racine;
+    std::size_t budgetOctets;
+    std::size_t prochaineVerificationBudget;
+    unsigned long long nbDegradationsBudget;
+#ifdef TP3_INSTRUMENTATION
     /**
-     * \var cpt
-     * \brief Le nombre de mots dans le dictionnaire
+     * \var latences
+     * \brief Histogrammes de latence par opération, qui n'existent qu'avec TP3_INSTRUMENTATION
      */
-    int cpt;
+    mutable HistogrammeLatence latences[NB_OPERATIONS];
+#endif
     const unsigned int SIMILITUDE_MAX = 1; //plus grande valeur de similutude possible
     const double SIMILITUDE_MIN_POUR_SUGGESTION = 0.2; //similitude minimale acceptable
 
+    /**
+     * \struct FinIntervalle
+     * \brief Critère d'arrêt d'un parcours ordonné : le mot dépasse la borne supérieure (incluse)
+     */
+    struct FinIntervalle
+    {
+        const std::string& motFin;
+        bool operator()(const std::string& mot) const { return mot.compare(motFin) > 0; }
+    };
+
+    /**
+     * \struct FinPrefixe
+     * \brief Critère d'arrêt d'un parcours ordonné qui débute au préfixe : le mot ne commence plus par le préfixe
+     */
+    struct FinPrefixe
+    {
+        const std::string& prefixe;
+        bool operator()(const std::string& mot) const { return mot.compare(0, prefixe.size(), prefixe) != 0; }
+    };
+
+
+    //Un mot et ses traductions distinctes, dans l'ordre du fichier
+    typedef std::pair<std::string, std::vector<std::string> > EntreeFichier;
 
     //region private methods
 
-    void _detruireRecursif(NoeudDictionnaire*& arbre);
-    void _ajouterRecursif(NoeudDictionnaire*& node, const std::string &motOriginal, const std::string &motTraduit);
-    NoeudDictionnaire* _trouverRecursif(NoeudDictionnaire* const & node, const std::string &motAtrouver, double similitudeMinimum);
-    void _supprimerMotRecursif(NoeudDictionnaire*& node, const std::string &motAenlever);
-    NoeudDictionnaire* _noeudMinimalRecusrif(NoeudDictionnaire* const & node);
-
-    bool _vecteurContient(const std::vector<std::string> &vecteur, const std::string& element);
-    void _updateHauteurNoeud(NoeudDictionnaire*& node);
-    int _hauteur(NoeudDictionnaire*& node);
-    void _balancerUnNoeud(NoeudDictionnaire*& node);
-    bool _baseEstPlustPetitQue(const std::string& base, const std::string& compare);
-    bool _baseEstPlustGrandQue(const std::string& base, const std::string& compare);
-    bool _possedeEnfantUnique(NoeudDictionnaire* const & node);
-    void _swapNodes(NoeudDictionnaire*& nodeBase, NoeudDictionnaire*& nodeToSwapTo);
-    unsigned int _distanceLevenshtein(const std::string &mot1, const std::string &mot2);
-
-    bool _debalancementAGauche(NoeudDictionnaire*& node);
-    bool _debalancementADroite(NoeudDictionnaire*& node);
-    bool _desequilibreSecondaireAGauche(NoeudDictionnaire*& node);
-    bool _desequilibreSecondaireADroite(NoeudDictionnaire*& node);
-
-    void _zigZagGauche(NoeudDictionnaire*& noeudCritique);
-    void _zigZigGauche(NoeudDictionnaire*& noeudCritique);
-    void _zigZagDroite(NoeudDictionnaire*& noeudCritique);
-    void _zigZigDroite(NoeudDictionnaire*& noeudCritique);
+    static bool _analyserLigne(const std::string& ligne, std::string& motAnglais, std::string& motTraduit);
+    static std::vector<EntreeFichier> _lireEntreesTriees(std::istream& fichier);
+    static std::vector<EntreeFichier> _regrouperParMot(std::vector<std::pair<std::string, std::string> >& lignes);
+    NoeudDictionnaire* _trouverRecursif(NoeudDictionnaire* const & node, const std::string &motAtrouver, double similitudeMinimum) const;
+    NoeudDictionnaire* _trouverExact(const std::string &motAtrouver) const;
+    std::vector<std::string> _calculerSuggestions(const std::string &motMalEcrit) const;
+    void _indexerRecursif(NoeudDictionnaire* const & node);
+    void _reconstruireFiltreBloom();
+    void _ranimer(NoeudDictionnaire* noeud, const std::vector<std::string>& traductions);
+    void _marquerSupprime(NoeudDictionnaire* noeud);
+    void _compacterSiNecessaire();
+    std::size_t _nombreMotsVivants() const;
+    static const NoeudDictionnaire* _premierVivant(const NoeudDictionnaire* noeud);
+    static const NoeudDictionnaire* _dernierVivant(const NoeudDictionnaire* noeud);
+    void _statistiquesRecursif(const NoeudDictionnaire* node, int profondeur, long long& sommeProfondeurs, int& profondeurMax) const;
+    void _empreinteRecursif(const NoeudDictionnaire* node, EmpreinteMemoire& empreinte) const;
+    void _verifierBudget();
+    void _respecterBudget();
+
+    bool _vecteurContient(const std::vector<std::string> &vecteur, const std::string& element) const;
+    void _detacherArbre();
+    void _changerAllocateur(const AllocateurArene<NoeudDictionnaire>& nouvelAllocateur);
+    void _partagerAllocateur(Dictionnaire& autre) const;
+    void _apresOperationEnsemble();
+    unsigned int _distanceLevenshtein(const std::string &mot1, const std::string &mot2) const;
+
+    template<typename Fin, typename Visiteur>
+    bool _parcourirIntervalleRecursif(const NoeudDictionnaire* node, const std::string& motDebut, const Fin& fin, Visiteur& visiteur) const;
 
     //endregion
 };
-    
+
+/**
+ * \class Dictionnaire::Iterateur
+ * \brief Itérateur bidirectionnel qui parcourt les mots du dictionnaire en ordre alphabétique
+ *
+ *  Chaque pas suit les pointeurs enfant/parent des noeuds, sans pile ni vecteur intermédiaire (O(1) amorti par noeud).
+ *  Les pierres tombales sont sautées : un pas coûte donc aussi les pierres tombales qui séparent 2 mots. Un itérateur est invalidé par ajouteMot et supprimeMot.
+ *
+ *  Attributs:
+ *      - const Dictionnaire * dictionnaire, le dictionnaire parcouru (pour décrémenter end())
+ *      - const NoeudDictionnaire * noeud, le noeud courant, nullptr pour end()
+ *
+ */
+class Dictionnaire::Iterateur
+{
+public:
+
+	typedef std::bidirectional_iterator_tag iterator_category;
+	typedef std::string value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const std::string* pointer;
+	typedef const std::string& reference;
+
+	//Constructeur d'un itérateur qui ne pointe sur rien
+	Iterateur();
+
+	//Le mot courant
+	reference operator*() const;
+	pointer operator->() const;
+
+	//Les traductions du mot courant
+	const std::vector<std::string>& traductions() const;
+
+	//Avancer ou reculer d'un mot en ordre alphabétique
+	Iterateur& operator++();
+	Iterateur operator++(int);
+	Iterateur& operator--();
+	Iterateur operator--(int);
+
+	bool operator==(const Iterateur& autre) const;
+	bool operator!=(const Iterateur& autre) const;
+
+private:
+
+    friend class Dictionnaire;
+
+    Iterateur(const Dictionnaire* p_dictionnaire, const NoeudDictionnaire* p_noeud);
+
+    const Dictionnaire* dictionnaire;
+    const NoeudDictionnaire* noeud;
+};
+
+    /**
+     * \fn void Dictionnaire::parcoursPrefixe(const std::string& prefixe, Visiteur visiteur) const
+     * \brief Permet de visiter en ordre alphabétique les mots qui commencent par un préfixe
+     * \param[in] const std::string& prefixe, le préfixe recherché
+     * \param[in] Visiteur visiteur, appelé avec (mot, traductions), retourne false pour arrêter le parcours
+     *
+     * Tous les mots qui commencent par le préfixe sont contigus en ordre alphabétique et le premier est plus grand ou égal au préfixe.
+     * On parcourt donc l'intervalle qui débute au préfixe et on s'arrête au premier mot qui ne le partage plus.
+     *
+     */
+    template<typename Visiteur>
+    void Dictionnaire::parcoursPrefixe(const std::string& prefixe, Visiteur visiteur) const {
+        FinPrefixe fin = { prefixe };
+        _parcourirIntervalleRecursif(racine, prefixe, fin, visiteur);
+    }
+
+    /**
+     * \fn void Dictionnaire::parcoursEntre(const std::string& motDebut, const std::string& motFin, Visiteur visiteur) const
+     * \brief Permet de visiter en ordre alphabétique les mots compris entre 2 bornes incluses
+     * \param[in] const std::string& motDebut, la borne inférieure
+     * \param[in] const std::string& motFin, la borne supérieure
+     * \param[in] Visiteur visiteur, appelé avec (mot, traductions), retourne false pour arrêter le parcours
+     */
+    template<typename Visiteur>
+    void Dictionnaire::parcoursEntre(const std::string& motDebut, const std::string& motFin, Visiteur visiteur) const {
+        FinIntervalle fin = { motFin };
+        _parcourirIntervalleRecursif(racine, motDebut, fin, visiteur);
+    }
+
+    /**
+     * \fn bool Dictionnaire::_parcourirIntervalleRecursif(const NoeudDictionnaire* node, const std::string& motDebut, const Fin& fin, Visiteur& visiteur) const
+     * \brief Parcours en ordre d'un sous-arbre, limité aux mots plus grands ou égaux à motDebut et qui ne satisfont pas le critère de fin
+     * \param[in] const NoeudDictionnaire* node, la racine du sous-arbre
+     * \param[in] const std::string& motDebut, la borne inférieure (incluse)
+     * \param[in] const Fin& fin, le critère d'arrêt, vrai pour le premier mot au-delà de l'intervalle
+     * \param[in] Visiteur& visiteur, appelé pour chaque mot de l'intervalle
+     * \return bool, false si le parcours doit s'arrêter (fin de l'intervalle atteinte ou visiteur rassasié)
+     *
+     * Le sous-arbre gauche d'un noeud plus petit que motDebut est ignoré au complet. Dès qu'un mot dépasse l'intervalle, tous les
+     * mots suivants le dépassent aussi et on arrête. Les pierres tombales de l'intervalle sont visitées sans être retournées :
+     * on visite donc O(log n + k + t) noeuds pour k mots retournés et t pierres tombales dans l'intervalle. La compaction
+     * automatique (voir activeSuppressionDifferee) borne t par une fraction des noeuds de l'arbre, pas de l'intervalle.
+     *
+     */
+    template<typename Fin, typename Visiteur>
+    bool Dictionnaire::_parcourirIntervalleRecursif(const NoeudDictionnaire* node, const std::string& motDebut, const Fin& fin, Visiteur& visiteur) const {
+        if (node == nullptr)
+            return true;
+
+        if (node->mot.compare(motDebut) >= 0) {
+            if (!_parcourirIntervalleRecursif(node->gauche, motDebut, fin, visiteur))
+                return false;
+            if (fin(node->mot))
+                return false;
+            if (!node->supprime && !visiteur(node->mot, node->traductions))
+                return false;
+        }
+
+        return _parcourirIntervalleRecursif(node->droite, motDebut, fin, visiteur);
+    }
+
 }
 
 #endif /* DICO_H_ */
@@ -0,0 +1,583 @@
+/**
+ * \file DictionnaireBPlus.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe DictionnaireBPlus
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "DictionnaireBPlus.h"
+#include "DictionnaireEytzinger.h"
+
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+namespace TP3
+{
+
+    const int DictionnaireBPlus::CLES_PAR_NOEUD;
+    const int DictionnaireBPlus::CLES_MIN;
+
+    /**
+     * \fn DictionnaireBPlus::DictionnaireBPlus()
+     * \brief Constructeur d'un dictionnaire vide : une seule feuille, vide
+     */
+    DictionnaireBPlus::DictionnaireBPlus() : racine(new FeuilleBPlus()), cpt(0) {}
+
+    /**
+     * \fn DictionnaireBPlus::~DictionnaireBPlus()
+     * \brief Destructeur, libère tous les noeuds
+     */
+    DictionnaireBPlus::~DictionnaireBPlus() {
+        _detruire(racine);
+    }
+
+    /**
+     * \fn void DictionnaireBPlus::ajouteMot(const std::string &motOriginal, const std::string &motTraduit)
+     * \brief Permet d'ajouter un mot et l'une de ses traductions
+     * \param[in] const std::string &motOriginal, le mot à ajouter
+     * \param[in] const std::string &motTraduit, la traduction du mot à ajouter
+     * \post le dictionnaire aura : un mot de plus || une traduction de plus || rien de plus
+     *
+     * Si la racine a été divisée, l'arbre grandit d'un niveau : la nouvelle racine n'a qu'un séparateur.
+     *
+     */
+    void DictionnaireBPlus::ajouteMot(const std::string &motOriginal, const std::string &motTraduit) {
+        string separateur;
+        NoeudBPlus* nouveauNoeud = nullptr;
+        if (!_ajouterRecursif(racine, motOriginal, motTraduit, separateur, nouveauNoeud))
+            return;
+
+        NoeudInterneBPlus* nouvelleRacine = new NoeudInterneBPlus();
+        nouvelleRacine->enfants[0] = racine;
+        nouvelleRacine->enfants[1] = nouveauNoeud;
+        _insererCle(nouvelleRacine, 0, separateur);
+        racine = nouvelleRacine;
+    }
+
+    /**
+     * \fn void DictionnaireBPlus::supprimeMot(const std::string &motOriginal)
+     * \brief Permet de supprimer un mot et ses traductions
+     * \param[in] const std::string &motOriginal, le mot à retirer du dictionnaire
+     * \exception logic_error si le dictionnaire est vide ou si le mot n'y appartient pas
+     *
+     * Si la racine interne n'a plus de séparateur après une fusion, son seul enfant devient la racine.
+     *
+     */
+    void DictionnaireBPlus::supprimeMot(const std::string &motOriginal) {
+        if (estVide())
+            throw logic_error("arbre est vide");
+        if (!appartient(motOriginal))
+            throw logic_error("Impossible de supprimer un mot qui n'appartien pas au dictionnaire");
+
+        _supprimerRecursif(racine, motOriginal);
+        if (!racine->feuille && racine->nbCles == 0) {
+            NoeudInterneBPlus* ancienneRacine = static_cast<NoeudInterneBPlus*>(racine);
+            racine = ancienneRacine->enfants[0];
+            delete ancienneRacine;
+        }
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireBPlus::traduit(const std::string &mot) const
+     * \brief Permet de retourner les traductions d'un mot
+     * \param[in] const std::string &mot, le mot à traduire
+     * \return std::vector<std::string>, les traductions du mot, vide si le mot est absent
+     */
+    std::vector<std::string> DictionnaireBPlus::traduit(const std::string &mot) const {
+        const uint64_t cle = DictionnaireEytzinger::prefixe(mot);
+        const FeuilleBPlus* feuille = _trouverFeuille(mot);
+        const int i = _rangInferieur(feuille, cle, mot);
+        if (i < feuille->nbCles && feuille->prefixes[i] == cle && feuille->cles[i] == mot)
+            return feuille->traductions[i];
+        return vector<string>();
+    }
+
+    /**
+     * \fn bool DictionnaireBPlus::appartient(const std::string &mot) const
+     * \brief Permet de vérifier si un mot appartient au dictionnaire
+     * \param[in] const std::string &mot, le mot à vérifier
+     * \return bool, true si le mot appartient, false sinon
+     */
+    bool DictionnaireBPlus::appartient(const std::string &mot) const {
+        const uint64_t cle = DictionnaireEytzinger::prefixe(mot);
+        const FeuilleBPlus* feuille = _trouverFeuille(mot);
+        const int i = _rangInferieur(feuille, cle, mot);
+        return i < feuille->nbCles && feuille->prefixes[i] == cle && feuille->cles[i] == mot;
+    }
+
+    /**
+     * \fn bool DictionnaireBPlus::estVide() const
+     * \brief Permet de vérifier si le dictionnaire est vide
+     * \return bool, true si le dictionnaire est vide, false sinon
+     */
+    bool DictionnaireBPlus::estVide() const {
+        return cpt == 0;
+    }
+
+    /**
+     * \fn std::size_t DictionnaireBPlus::taille() const
+     * \brief Permet de connaître le nombre de mots
+     * \return std::size_t, le nombre de mots
+     */
+    std::size_t DictionnaireBPlus::taille() const {
+        return cpt;
+    }
+
+    /**
+     * \fn int DictionnaireBPlus::hauteur() const
+     * \brief Permet de connaître le nombre de niveaux de l'arbre
+     * \return int, le nombre de niveaux, toutes les feuilles étant à la même profondeur
+     */
+    int DictionnaireBPlus::hauteur() const {
+        int niveaux = 1;
+        for (const NoeudBPlus* noeud = racine; !noeud->feuille; noeud = static_cast<const NoeudInterneBPlus*>(noeud)->enfants[0])
+            niveaux++;
+        return niveaux;
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireBPlus::motsAvecPrefixe(const std::string &prefixe, std::size_t limite) const
+     * \brief Permet de trouver les mots qui commencent par un préfixe, en ordre alphabétique
+     * \param[in] const std::string &prefixe, le préfixe recherché
+     * \param[in] std::size_t limite, le nombre maximal de mots retournés
+     * \return std::vector<std::string>, les mots trouvés en ordre alphabétique
+     *
+     * On descend une seule fois jusqu'à la feuille du préfixe, puis on suit le chaînage des feuilles.
+     *
+     */
+    std::vector<std::string> DictionnaireBPlus::motsAvecPrefixe(const std::string &prefixe, std::size_t limite) const {
+        vector<string> mots;
+        const FeuilleBPlus* feuille = _trouverFeuille(prefixe);
+        int i = _rangInferieur(feuille, DictionnaireEytzinger::prefixe(prefixe), prefixe);
+
+        while (mots.size() < limite && feuille != nullptr) {
+            if (i == feuille->nbCles) {
+                feuille = feuille->suivante;
+                i = 0;
+                continue;
+            }
+            if (feuille->cles[i].compare(0, prefixe.size(), prefixe) != 0)
+                break;
+            mots.push_back(feuille->cles[i++]);
+        }
+        return mots;
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireBPlus::motsEntre(const std::string &motDebut, const std::string &motFin, std::size_t limite) const
+     * \brief Permet de trouver les mots compris entre 2 bornes incluses, en ordre alphabétique
+     * \param[in] const std::string &motDebut, la borne inférieure
+     * \param[in] const std::string &motFin, la borne supérieure
+     * \param[in] std::size_t limite, le nombre maximal de mots retournés
+     * \return std::vector<std::string>, les mots trouvés en ordre alphabétique. Vide si motDebut est après motFin.
+     */
+    std::vector<std::string> DictionnaireBPlus::motsEntre(const std::string &motDebut, const std::string &motFin, std::size_t limite) const {
+        vector<string> mots;
+        if (motFin < motDebut)
+            return mots;
+
+        const FeuilleBPlus* feuille = _trouverFeuille(motDebut);
+        int i = _rangInferieur(feuille, DictionnaireEytzinger::prefixe(motDebut), motDebut);
+
+        while (mots.size() < limite && feuille != nullptr) {
+            if (i == feuille->nbCles) {
+                feuille = feuille->suivante;
+                i = 0;
+                continue;
+            }
+            if (feuille->cles[i] > motFin)
+                break;
+            mots.push_back(feuille->cles[i++]);
+        }
+        return mots;
+    }
+
+    /**
+     * \fn std::size_t DictionnaireBPlus::empreinteMemoire() const
+     * \brief Permet de connaître la mémoire occupée par l'arbre
+     * \return std::size_t, les octets des noeuds, plus ceux des mots et des traductions alloués sur le monceau
+     */
+    std::size_t DictionnaireBPlus::empreinteMemoire() const {
+        return sizeof(*this) + _empreinteRecursive(racine);
+    }
+
+    /**
+     * \fn int DictionnaireBPlus::_rangInferieur(const NoeudBPlus *noeud, std::uint64_t cle, const std::string &mot)
+     * \brief Permet de compter les mots d'un noeud strictement plus petits qu'un mot
+     * \param[in] const NoeudBPlus *noeud, le noeud
+     * \param[in] std::uint64_t cle, le préfixe du mot
+     * \param[in] const std::string &mot, le mot
+     * \return int, la position du premier mot plus grand ou égal
+     *
+     * Les préfixes sont triés comme les mots : ceux qui sont plus petits que la clé sont comptés sans branchement (la boucle
+     * se vectorise), puis on départage par les mots complets ceux dont le préfixe est égal à la clé.
+     *
+     */
+    int DictionnaireBPlus::_rangInferieur(const NoeudBPlus *noeud, std::uint64_t cle, const std::string &mot) {
+        const int n = noeud->nbCles;
+        int i = 0;
+        for (int k = 0; k < n; k++)
+            i += noeud->prefixes[k] < cle;
+        while (i < n && noeud->prefixes[i] == cle && noeud->cles[i] < mot)
+            i++;
+        return i;
+    }
+
+    /**
+     * \fn int DictionnaireBPlus::_rangSuperieur(const NoeudBPlus *noeud, std::uint64_t cle, const std::string &mot)
+     * \brief Permet de compter les mots d'un noeud plus petits ou égaux à un mot
+     * \param[in] const NoeudBPlus *noeud, le noeud
+     * \param[in] std::uint64_t cle, le préfixe du mot
+     * \param[in] const std::string &mot, le mot
+     * \return int, la position du premier mot strictement plus grand, c'est-à-dire l'enfant à suivre dans un noeud interne
+     */
+    int DictionnaireBPlus::_rangSuperieur(const NoeudBPlus *noeud, std::uint64_t cle, const std::string &mot) {
+        const int n = noeud->nbCles;
+        int i = 0;
+        for (int k = 0; k < n; k++)
+            i += noeud->prefixes[k] < cle;
+        while (i < n && noeud->prefixes[i] == cle && noeud->cles[i] <= mot)
+            i++;
+        return i;
+    }
+
+    /**
+     * \fn const DictionnaireBPlus::FeuilleBPlus* DictionnaireBPlus::_trouverFeuille(const std::string &mot) const
+     * \brief Permet de trouver la feuille où un mot est, ou serait inséré
+     * \param[in] const std::string &mot, le mot cherché
+     * \return const FeuilleBPlus*, la feuille
+     */
+    const DictionnaireBPlus::FeuilleBPlus* DictionnaireBPlus::_trouverFeuille(const std::string &mot) const {
+        const uint64_t cle = DictionnaireEytzinger::prefixe(mot);
+        const NoeudBPlus* noeud = racine;
+        while (!noeud->feuille) {
+            const NoeudInterneBPlus* interne = static_cast<const NoeudInterneBPlus*>(noeud);
+            noeud = interne->enfants[_rangSuperieur(interne, cle, mot)];
+        }
+        return static_cast<const FeuilleBPlus*>(noeud);
+    }
+
+    /**
+     * \fn void DictionnaireBPlus::_insererCle(NoeudBPlus *noeud, int position, const std::string &mot)
+     * \brief Permet d'insérer un mot et son préfixe à une position, en décalant les suivants
+     * \param[in] NoeudBPlus *noeud, le noeud, qui n'est pas plein
+     * \param[in] int position, la position du nouveau mot
+     * \param[in] const std::string &mot, le mot à insérer
+     * \post les traductions ou les enfants doivent être décalés par l'appelant
+     */
+    void DictionnaireBPlus::_insererCle(NoeudBPlus *noeud, int position, const std::string &mot) {
+        for (int k = noeud->nbCles; k > position; k--) {
+            noeud->prefixes[k] = noeud->prefixes[k - 1];
+            noeud->cles[k] = std::move(noeud->cles[k - 1]);
+        }
+        noeud->prefixes[position] = DictionnaireEytzinger::prefixe(mot);
+        noeud->cles[position] = mot;
+        noeud->nbCles++;
+    }
+
+    /**
+     * \fn void DictionnaireBPlus::_retirerCle(NoeudBPlus *noeud, int position)
+     * \brief Permet de retirer le mot d'une position, en décalant les suivants
+     * \param[in] NoeudBPlus *noeud, le noeud
+     * \param[in] int position, la position du mot à retirer
+     * \post les traductions ou les enfants doivent être décalés par l'appelant
+     */
+    void DictionnaireBPlus::_retirerCle(NoeudBPlus *noeud, int position) {
+        for (int k = position; k < noeud->nbCles - 1; k++) {
+            noeud->prefixes[k] = noeud->prefixes[k + 1];
+            noeud->cles[k] = std::move(noeud->cles[k + 1]);
+        }
+        noeud->nbCles--;
+        string().swap(noeud->cles[noeud->nbCles]);
+    }
+
+    /**
+     * \fn bool DictionnaireBPlus::_ajouterRecursif(NoeudBPlus *noeud, const std::string &mot, const std::string &traduction, std::string &separateur, NoeudBPlus *&nouveauNoeud)
+     * \brief Permet d'ajouter un mot dans un sous-arbre, en divisant les noeuds qui deviennent pleins
+     * \param[in] NoeudBPlus *noeud, la racine du sous-arbre
+     * \param[in] const std::string &mot, le mot à ajouter
+     * \param[in] const std::string &traduction, sa traduction
+     * \param[out] std::string &separateur, le premier mot du nouveau noeud, si le noeud a été divisé
+     * \param[out] NoeudBPlus *&nouveauNoeud, le frère droit créé, si le noeud a été divisé
+     * \return bool, true si le noeud a été divisé (le parent doit alors insérer separateur et nouveauNoeud)
+     */
+    bool DictionnaireBPlus::_ajouterRecursif(NoeudBPlus *noeud, const std::string &mot, const std::string &traduction,
+                                             std::string &separateur, NoeudBPlus *&nouveauNoeud) {
+        const uint64_t cle = DictionnaireEytzinger::prefixe(mot);
+
+        if (noeud->feuille) {
+            FeuilleBPlus* feuille = static_cast<FeuilleBPlus*>(noeud);
+            const int i = _rangInferieur(feuille, cle, mot);
+            if (i < feuille->nbCles && feuille->prefixes[i] == cle && feuille->cles[i] == mot) {
+                for (const auto & existante : feuille->traductions[i]) {
+                    if (existante == traduction)
+                        return false;
+                }
+                feuille->traductions[i].push_back(traduction);
+                return false;
+            }
+
+            for (int k = feuille->nbCles; k > i; k--)
+                feuille->traductions[k] = std::move(feuille->traductions[k - 1]);
+            feuille->traductions[i] = vector<string>(1, traduction);
+            _insererCle(feuille, i, mot);
+            cpt++;
+        } else {
+            NoeudInterneBPlus* interne = static_cast<NoeudInterneBPlus*>(noeud);
+            const int i = _rangSuperieur(interne, cle, mot);
+            string separateurEnfant;
+            NoeudBPlus* nouvelEnfant = nullptr;
+            if (!_ajouterRecursif(interne->enfants[i], mot, traduction, separateurEnfant, nouvelEnfant))
+                return false;
+
+            for (int k = interne->nbCles + 1; k > i + 1; k--)
+                interne->enfants[k] = interne->enfants[k - 1];
+            interne->enfants[i + 1] = nouvelEnfant;
+            _insererCle(interne, i, separateurEnfant);
+        }
+
+        if (noeud->nbCles < CLES_PAR_NOEUD)
+            return false;
+        nouveauNoeud = _diviser(noeud, separateur);
+        return true;
+    }
+
+    /**
+     * \fn DictionnaireBPlus::NoeudBPlus* DictionnaireBPlus::_diviser(NoeudBPlus *noeud, std::string &separateur)
+     * \brief Permet de diviser un noeud plein en deux
+     * \param[in] NoeudBPlus *noeud, le noeud plein, qui garde la première moitié
+     * \param[out] std::string &separateur, le séparateur à insérer dans le parent
+     * \return NoeudBPlus*, le nouveau noeud, qui reçoit la seconde moitié
+     *
+     * Une feuille garde une copie de son séparateur (son premier mot). Un noeud interne, lui, fait monter son séparateur du
+     * milieu vers le parent.
+     *
+     */
+    DictionnaireBPlus::NoeudBPlus* DictionnaireBPlus::_diviser(NoeudBPlus *noeud, std::string &separateur) {
+        const int milieu = CLES_PAR_NOEUD / 2;
+
+        if (noeud->feuille) {
+            FeuilleBPlus* gauche = static_cast<FeuilleBPlus*>(noeud);
+            FeuilleBPlus* droite = new FeuilleBPlus();
+            for (int k = milieu; k < gauche->nbCles; k++) {
+                droite->prefixes[k - milieu] = gauche->prefixes[k];
+                droite->cles[k - milieu] = std::move(gauche->cles[k]);
+                droite->traductions[k - milieu] = std::move(gauche->traductions[k]);
+            }
+            droite->nbCles = gauche->nbCles - milieu;
+            gauche->nbCles = milieu;
+            droite->suivante = gauche->suivante;
+            gauche->suivante = droite;
+            separateur = droite->cles[0];
+            return droite;
+        }
+
+        NoeudInterneBPlus* gauche = static_cast<NoeudInterneBPlus*>(noeud);
+        NoeudInterneBPlus* droite = new NoeudInterneBPlus();
+        separateur = std::move(gauche->cles[milieu]);
+        for (int k = milieu + 1; k < gauche->nbCles; k++) {
+            droite->prefixes[k - milieu - 1] = gauche->prefixes[k];
+            droite->cles[k - milieu - 1] = std::move(gauche->cles[k]);
+        }
+        for (int k = milieu + 1; k <= gauche->nbCles; k++)
+            droite->enfants[k - milieu - 1] = gauche->enfants[k];
+        droite->nbCles = gauche->nbCles - milieu - 1;
+        gauche->nbCles = milieu;
+        return droite;
+    }
+
+    /**
+     * \fn void DictionnaireBPlus::_supprimerRecursif(NoeudBPlus *noeud, const std::string &mot)
+     * \brief Permet de supprimer un mot d'un sous-arbre, en rééquilibrant les enfants qui ont trop peu de mots
+     * \param[in] NoeudBPlus *noeud, la racine du sous-arbre
+     * \param[in] const std::string &mot, le mot à supprimer
+     * \pre le mot appartient au sous-arbre
+     *
+     * Les séparateurs ne sont pas mis à jour : un séparateur égal à un mot supprimé oriente toujours correctement la recherche.
+     *
+     */
+    void DictionnaireBPlus::_supprimerRecursif(NoeudBPlus *noeud, const std::string &mot) {
+        const uint64_t cle = DictionnaireEytzinger::prefixe(mot);
+
+        if (noeud->feuille) {
+            FeuilleBPlus* feuille = static_cast<FeuilleBPlus*>(noeud);
+            const int i = _rangInferieur(feuille, cle, mot);
+            for (int k = i; k < feuille->nbCles - 1; k++)
+                feuille->traductions[k] = std::move(feuille->traductions[k + 1]);
+            vector<string>().swap(feuille->traductions[feuille->nbCles - 1]);
+            _retirerCle(feuille, i);
+            cpt--;
+            return;
+        }
+
+        NoeudInterneBPlus* interne = static_cast<NoeudInterneBPlus*>(noeud);
+        const int i = _rangSuperieur(interne, cle, mot);
+        _supprimerRecursif(interne->enfants[i], mot);
+        if (interne->enfants[i]->nbCles < CLES_MIN)
+            _reequilibrer(interne, i);
+    }
+
+    /**
+     * \fn void DictionnaireBPlus::_reequilibrer(NoeudInterneBPlus *parent, int i)
+     * \brief Permet de redonner assez de mots à un enfant, en empruntant à un voisin ou en le fusionnant avec lui
+     * \param[in] NoeudInterneBPlus *parent, le parent
+     * \param[in] int i, la position de l'enfant qui a moins de CLES_MIN mots
+     *
+     * On emprunte d'abord au voisin gauche, puis au voisin droit, s'ils ont des mots en trop. Sinon, les deux voisins
+     * tiennent ensemble dans un seul noeud et on les fusionne.
+     *
+     */
+    void DictionnaireBPlus::_reequilibrer(NoeudInterneBPlus *parent, int i) {
+        NoeudBPlus* enfant = parent->enfants[i];
+        NoeudBPlus* gauche = i > 0 ? parent->enfants[i - 1] : nullptr;
+        NoeudBPlus* droite = i < parent->nbCles ? parent->enfants[i + 1] : nullptr;
+
+        if (gauche != nullptr && gauche->nbCles > CLES_MIN) {
+            const int dernier = gauche->nbCles - 1;
+            if (enfant->feuille) {
+                FeuilleBPlus* feuille = static_cast<FeuilleBPlus*>(enfant);
+                FeuilleBPlus* feuilleGauche = static_cast<FeuilleBPlus*>(gauche);
+                for (int k = feuille->nbCles; k > 0; k--)
+                    feuille->traductions[k] = std::move(feuille->traductions[k - 1]);
+                feuille->traductions[0] = std::move(feuilleGauche->traductions[dernier]);
+                _insererCle(feuille, 0, feuilleGauche->cles[dernier]);
+                _retirerCle(feuilleGauche, dernier);
+                parent->cles[i - 1] = feuille->cles[0];
+            } else {
+                NoeudInterneBPlus* interne = static_cast<NoeudInterneBPlus*>(enfant);
+                NoeudInterneBPlus* interneGauche = static_cast<NoeudInterneBPlus*>(gauche);
+                for (int k = interne->nbCles + 1; k > 0; k--)
+                    interne->enfants[k] = interne->enfants[k - 1];
+                interne->enfants[0] = interneGauche->enfants[dernier + 1];
+                _insererCle(interne, 0, parent->cles[i - 1]);
+                parent->cles[i - 1] = interneGauche->cles[dernier];
+                _retirerCle(interneGauche, dernier);
+            }
+            parent->prefixes[i - 1] = DictionnaireEytzinger::prefixe(parent->cles[i - 1]);
+        } else if (droite != nullptr && droite->nbCles > CLES_MIN) {
+            if (enfant->feuille) {
+                FeuilleBPlus* feuille = static_cast<FeuilleBPlus*>(enfant);
+                FeuilleBPlus* feuilleDroite = static_cast<FeuilleBPlus*>(droite);
+                feuille->traductions[feuille->nbCles] = std::move(feuilleDroite->traductions[0]);
+                _insererCle(feuille, feuille->nbCles, feuilleDroite->cles[0]);
+                for (int k = 0; k < feuilleDroite->nbCles - 1; k++)
+                    feuilleDroite->traductions[k] = std::move(feuilleDroite->traductions[k + 1]);
+                _retirerCle(feuilleDroite, 0);
+                parent->cles[i] = feuilleDroite->cles[0];
+            } else {
+                NoeudInterneBPlus* interne = static_cast<NoeudInterneBPlus*>(enfant);
+                NoeudInterneBPlus* interneDroite = static_cast<NoeudInterneBPlus*>(droite);
+                interne->enfants[interne->nbCles + 1] = interneDroite->enfants[0];
+                _insererCle(interne, interne->nbCles, parent->cles[i]);
+                parent->cles[i] = interneDroite->cles[0];
+                for (int k = 0; k < interneDroite->nbCles; k++)
+                    interneDroite->enfants[k] = interneDroite->enfants[k + 1];
+                _retirerCle(interneDroite, 0);
+            }
+            parent->prefixes[i] = DictionnaireEytzinger::prefixe(parent->cles[i]);
+        } else if (gauche != nullptr) {
+            _fusionner(parent, i - 1);
+        } else {
+            _fusionner(parent, i);
+        }
+    }
+
+    /**
+     * \fn void DictionnaireBPlus::_fusionner(NoeudInterneBPlus *parent, int i)
+     * \brief Permet de fusionner l'enfant i + 1 dans l'enfant i et de retirer leur séparateur du parent
+     * \param[in] NoeudInterneBPlus *parent, le parent
+     * \param[in] int i, la position du séparateur entre les deux enfants
+     * \pre les deux enfants ont ensemble moins de CLES_PAR_NOEUD mots
+     */
+    void DictionnaireBPlus::_fusionner(NoeudInterneBPlus *parent, int i) {
+        NoeudBPlus* gauche = parent->enfants[i];
+        NoeudBPlus* droite = parent->enfants[i + 1];
+        const int n = gauche->nbCles;
+
+        if (gauche->feuille) {
+            FeuilleBPlus* feuilleGauche = static_cast<FeuilleBPlus*>(gauche);
+            FeuilleBPlus* feuilleDroite = static_cast<FeuilleBPlus*>(droite);
+            for (int k = 0; k < feuilleDroite->nbCles; k++) {
+                feuilleGauche->prefixes[n + k] = feuilleDroite->prefixes[k];
+                feuilleGauche->cles[n + k] = std::move(feuilleDroite->cles[k]);
+                feuilleGauche->traductions[n + k] = std::move(feuilleDroite->traductions[k]);
+            }
+            feuilleGauche->nbCles += feuilleDroite->nbCles;
+            feuilleGauche->suivante = feuilleDroite->suivante;
+            delete feuilleDroite;
+        } else {
+            NoeudInterneBPlus* interneGauche = static_cast<NoeudInterneBPlus*>(gauche);
+            NoeudInterneBPlus* interneDroite = static_cast<NoeudInterneBPlus*>(droite);
+            interneGauche->prefixes[n] = parent->prefixes[i];
+            interneGauche->cles[n] = parent->cles[i];
+            for (int k = 0; k < interneDroite->nbCles; k++) {
+                interneGauche->prefixes[n + 1 + k] = interneDroite->prefixes[k];
+                interneGauche->cles[n + 1 + k] = std::move(interneDroite->cles[k]);
+            }
+            for (int k = 0; k <= interneDroite->nbCles; k++)
+                interneGauche->enfants[n + 1 + k] = interneDroite->enfants[k];
+            interneGauche->nbCles += interneDroite->nbCles + 1;
+            delete interneDroite;
+        }
+
+        for (int k = i + 1; k < parent->nbCles; k++)
+            parent->enfants[k] = parent->enfants[k + 1];
+        _retirerCle(parent, i);
+    }
+
+    /**
+     * \fn void DictionnaireBPlus::_detruire(NoeudBPlus *noeud)
+     * \brief Permet de libérer un sous-arbre
+     * \param[in] NoeudBPlus *noeud, la racine du sous-arbre
+     */
+    void DictionnaireBPlus::_detruire(NoeudBPlus *noeud) {
+        if (noeud->feuille) {
+            delete static_cast<FeuilleBPlus*>(noeud);
+            return;
+        }
+
+        NoeudInterneBPlus* interne = static_cast<NoeudInterneBPlus*>(noeud);
+        for (int k = 0; k <= interne->nbCles; k++)
+            _detruire(interne->enfants[k]);
+        delete interne;
+    }
+
+    /**
+     * \fn std::size_t DictionnaireBPlus::_empreinteRecursive(const NoeudBPlus *noeud) const
+     * \brief Permet de calculer la mémoire occupée par un sous-arbre
+     * \param[in] const NoeudBPlus *noeud, la racine du sous-arbre
+     * \return std::size_t, le nombre d'octets
+     */
+    std::size_t DictionnaireBPlus::_empreinteRecursive(const NoeudBPlus *noeud) const {
+        const size_t capaciteInterne = std::string().capacity(); //au-delà, le contenu d'une chaîne est alloué sur le monceau
+        size_t octets = 0;
+        for (int k = 0; k < noeud->nbCles; k++) {
+            if (noeud->cles[k].capacity() > capaciteInterne)
+                octets += noeud->cles[k].capacity() + 1;
+        }
+
+        if (noeud->feuille) {
+            const FeuilleBPlus* feuille = static_cast<const FeuilleBPlus*>(noeud);
+            octets += sizeof(FeuilleBPlus);
+            for (int k = 0; k < feuille->nbCles; k++) {
+                octets += feuille->traductions[k].capacity() * sizeof(std::string);
+                for (const auto & traduction : feuille->traductions[k]) {
+                    if (traduction.capacity() > capaciteInterne)
+                        octets += traduction.capacity() + 1;
+                }
+            }
+            return octets;
+        }
+
+        const NoeudInterneBPlus* interne = static_cast<const NoeudInterneBPlus*>(noeud);
+        octets += sizeof(NoeudInterneBPlus);
+        for (int k = 0; k <= interne->nbCles; k++)
+            octets += _empreinteRecursive(interne->enfants[k]);
+        return octets;
+    }
+
+}//Fin du namespace
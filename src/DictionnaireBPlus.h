@@ -0,0 +1,158 @@
+/**
+ * \file DictionnaireBPlus.h
+ * \brief Ce fichier contient l'interface d'un dictionnaire sous forme d'arbre B+.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef DICTIONNAIREBPLUS_H_
+#define DICTIONNAIREBPLUS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TP3
+{
+
+/**
+ * \class DictionnaireBPlus
+ * \brief Dictionnaire de traductions modifiable sous forme d'arbre B+, offrant les mêmes opérations que Dictionnaire
+ *
+ *  Un AVL de quelques millions de mots a plus de 20 niveaux, et chaque niveau est un défaut de cache probable.
+ *  Ici, chaque noeud contient jusqu'à CLES_PAR_NOEUD - 1 mots : l'arbre n'a que 4 ou 5 niveaux pour un million de mots.
+ *  Dans un noeud, les 8 premiers octets de chaque mot sont rangés côte à côte (en gros-boutiste, comparables comme des
+ *  entiers) : une recherche les parcourt séquentiellement, sans branchement, et ne compare les mots complets que si un
+ *  préfixe est égal à celui du mot cherché.
+ *
+ *  Les mots et leurs traductions sont dans les feuilles, chaînées en ordre alphabétique pour les requêtes d'intervalle.
+ *  Les noeuds internes ne contiennent que des séparateurs : le sous-arbre i contient les mots m tels que
+ *  cles[i - 1] <= m < cles[i].
+ *
+ *  Attributs:
+ *      - NoeudBPlus * racine, racine de l'arbre (une feuille vide si le dictionnaire est vide)
+ *      - std::size_t cpt, nombre de mots
+ *
+ */
+class DictionnaireBPlus
+{
+public:
+
+	//Capacité des tableaux d'un noeud ; un noeud est divisé dès qu'il est plein, il contient donc au plus CLES_PAR_NOEUD - 1 mots
+	//Les 32 préfixes d'un noeud occupent 4 lignes de cache
+	static const int CLES_PAR_NOEUD = 32;
+
+	//Nombre minimal de mots d'un noeud autre que la racine, sous lequel on emprunte à un voisin ou on fusionne
+	static const int CLES_MIN = CLES_PAR_NOEUD / 2 - 1;
+
+	//Constructeur d'un dictionnaire vide
+	DictionnaireBPlus();
+
+	//Destructeur
+	~DictionnaireBPlus();
+
+	DictionnaireBPlus(const DictionnaireBPlus&) = delete;
+	DictionnaireBPlus& operator=(const DictionnaireBPlus&) = delete;
+
+	//Ajouter un mot au dictionnaire et l'une de ses traductions (la traduction n'est pas dupliquée si elle y est déjà)
+	void ajouteMot(const std::string& motOriginal, const std::string& motTraduit);
+
+	//Supprimer un mot et ses traductions
+	//Exception	logic_error si le dictionnaire est vide
+	//Exception	logic_error si le mot n'appartient pas au dictionnaire
+	void supprimeMot(const std::string& motOriginal);
+
+	//Trouver les traductions possibles d'un mot (vecteur vide si le mot est absent)
+	std::vector<std::string> traduit(const std::string& mot) const;
+
+	//Vérifier si le mot donné appartient au dictionnaire
+	bool appartient(const std::string& mot) const;
+
+	//Vérifier si le dictionnaire est vide
+	bool estVide() const;
+
+	//Nombre de mots
+	std::size_t taille() const;
+
+	//Nombre de niveaux de l'arbre (1 pour une feuille seule)
+	int hauteur() const;
+
+	//Trouver, en ordre alphabétique, au plus 'limite' mots qui commencent par le préfixe donné
+	std::vector<std::string> motsAvecPrefixe(const std::string& prefixe, std::size_t limite) const;
+
+	//Trouver, en ordre alphabétique, au plus 'limite' mots compris entre motDebut et motFin inclusivement
+	std::vector<std::string> motsEntre(const std::string& motDebut, const std::string& motFin, std::size_t limite) const;
+
+	//Octets occupés par les noeuds, les mots et les traductions
+	std::size_t empreinteMemoire() const;
+
+private:
+
+    /**
+     * \class NoeudBPlus
+     * \brief Partie commune des feuilles et des noeuds internes : les mots, précédés de leurs préfixes contigus
+     */
+    class NoeudBPlus
+    {
+    public:
+        std::uint64_t prefixes[CLES_PAR_NOEUD];     // Les 8 premiers octets de chaque mot, parcourus en premier
+        int nbCles;
+        bool feuille;
+        std::string cles[CLES_PAR_NOEUD];           // Les mots complets (séparateurs dans un noeud interne)
+
+        explicit NoeudBPlus(bool p_feuille) : nbCles(0), feuille(p_feuille) {}
+    };
+
+    /**
+     * \class FeuilleBPlus
+     * \brief Feuille : les mots, leurs traductions et la feuille suivante en ordre alphabétique
+     */
+    class FeuilleBPlus : public NoeudBPlus
+    {
+    public:
+        std::vector<std::string> traductions[CLES_PAR_NOEUD];
+        FeuilleBPlus* suivante;
+
+        FeuilleBPlus() : NoeudBPlus(true), suivante(nullptr) {}
+    };
+
+    /**
+     * \class NoeudInterneBPlus
+     * \brief Noeud interne : nbCles séparateurs et nbCles + 1 enfants
+     */
+    class NoeudInterneBPlus : public NoeudBPlus
+    {
+    public:
+        NoeudBPlus* enfants[CLES_PAR_NOEUD + 1];
+
+        NoeudInterneBPlus() : NoeudBPlus(false) {}
+    };
+
+    NoeudBPlus* racine;
+    std::size_t cpt;
+
+    //region private methods
+
+    static int _rangInferieur(const NoeudBPlus* noeud, std::uint64_t cle, const std::string& mot);
+    static int _rangSuperieur(const NoeudBPlus* noeud, std::uint64_t cle, const std::string& mot);
+    const FeuilleBPlus* _trouverFeuille(const std::string& mot) const;
+    static void _insererCle(NoeudBPlus* noeud, int position, const std::string& mot);
+    static void _retirerCle(NoeudBPlus* noeud, int position);
+    bool _ajouterRecursif(NoeudBPlus* noeud, const std::string& mot, const std::string& traduction,
+                          std::string& separateur, NoeudBPlus*& nouveauNoeud);
+    NoeudBPlus* _diviser(NoeudBPlus* noeud, std::string& separateur);
+    void _supprimerRecursif(NoeudBPlus* noeud, const std::string& mot);
+    void _reequilibrer(NoeudInterneBPlus* parent, int i);
+    void _fusionner(NoeudInterneBPlus* parent, int i);
+    void _detruire(NoeudBPlus* noeud);
+    std::size_t _empreinteRecursive(const NoeudBPlus* noeud) const;
+
+    //endregion
+};
+
+}
+
+#endif /* DICTIONNAIREBPLUS_H_ */
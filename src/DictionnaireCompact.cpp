@@ -0,0 +1,323 @@
+/**
+ * \file DictionnaireCompact.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe DictionnaireCompact
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "DictionnaireCompact.h"
+#include "DictionnaireEytzinger.h"
+#include "BlocsFiges.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace TP3
+{
+
+    const std::size_t DictionnaireCompact::INTERVALLE_REDEMARRAGE;
+
+    /**
+     * \fn DictionnaireCompact::DictionnaireCompact()
+     * \brief Constructeur d'un dictionnaire compact vide
+     */
+    DictionnaireCompact::DictionnaireCompact() : blocMots(), redemarrages(), prefixesRedemarrages(), nbMots(0),
+                                                 intervalle(INTERVALLE_REDEMARRAGE), blocTraductions(),
+                                                 debutsTraductions(1, 0), premieresTraductions(1, 0) {}
+
+    /**
+     * \fn DictionnaireCompact::DictionnaireCompact(const Dictionnaire &dictionnaire, std::size_t p_intervalle)
+     * \brief Constructeur qui code les mots d'un dictionnaire par préfixe commun
+     * \param[in] const Dictionnaire &dictionnaire, le dictionnaire à copier
+     * \param[in] std::size_t p_intervalle, le nombre de mots par point de redémarrage
+     * \exception logic_error si l'intervalle est 0 ou si les positions ne tiennent pas sur 32 bits
+     *
+     * Le dictionnaire est parcouru une seule fois en ordre alphabétique : chaque mot n'est comparé qu'à son prédécesseur.
+     *
+     */
+    DictionnaireCompact::DictionnaireCompact(const Dictionnaire &dictionnaire, std::size_t p_intervalle) : DictionnaireCompact() {
+        if (p_intervalle == 0)
+            throw logic_error("l'intervalle entre les points de redemarrage doit etre positif");
+        intervalle = p_intervalle;
+        const uint64_t POSITION_MAX = numeric_limits<uint32_t>::max();
+
+        string precedent;
+        for (Dictionnaire::Iterateur mot = dictionnaire.begin(); mot != dictionnaire.end(); ++mot) {
+            size_t partage = 0;
+            if (nbMots % intervalle == 0) {
+                if (blocMots.size() > POSITION_MAX)
+                    throw logic_error("les mots depassent la taille maximale d'un dictionnaire compact");
+                redemarrages.push_back(static_cast<uint32_t>(blocMots.size()));
+                prefixesRedemarrages.push_back(DictionnaireEytzinger::prefixe(*mot));
+            } else {
+                const size_t partageMax = min(precedent.size(), mot->size());
+                while (partage < partageMax && precedent[partage] == (*mot)[partage])
+                    partage++;
+            }
+            _ecrireEntier(partage);
+            _ecrireEntier(mot->size() - partage);
+            blocMots.append(*mot, partage, string::npos);
+            precedent = *mot;
+
+            ajouterTraductionsFigees(mot.traductions(), blocTraductions, debutsTraductions, premieresTraductions,
+                                     "dictionnaire compact");
+            nbMots++;
+        }
+
+        blocMots.shrink_to_fit();
+        redemarrages.shrink_to_fit();
+        prefixesRedemarrages.shrink_to_fit();
+        blocTraductions.shrink_to_fit();
+        debutsTraductions.shrink_to_fit();
+        premieresTraductions.shrink_to_fit();
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireCompact::traduit(const std::string &mot) const
+     * \brief Permet de retourner les traductions d'un mot
+     * \param[in] const std::string &mot, le mot à traduire
+     * \return std::vector<std::string>, les traductions du mot, vide si le mot est absent
+     */
+    std::vector<std::string> DictionnaireCompact::traduit(const std::string &mot) const {
+        vector<string> traductions;
+        size_t position = 0;
+        string courant;
+        const size_t i = _positionner(mot, position, courant);
+        if (i == nbMots || courant != mot)
+            return traductions;
+
+        return lireTraductionsFigees(i, blocTraductions, debutsTraductions, premieresTraductions);
+    }
+
+    /**
+     * \fn bool DictionnaireCompact::appartient(const std::string &mot) const
+     * \brief Permet de vérifier si un mot appartient au dictionnaire
+     * \param[in] const std::string &mot, le mot à vérifier
+     * \return bool, true si le mot appartient, false sinon
+     */
+    bool DictionnaireCompact::appartient(const std::string &mot) const {
+        size_t position = 0;
+        string courant;
+        return _positionner(mot, position, courant) != nbMots && courant == mot;
+    }
+
+    /**
+     * \fn bool DictionnaireCompact::estVide() const
+     * \brief Permet de vérifier si le dictionnaire est vide
+     * \return bool, true s'il n'y a aucun mot
+     */
+    bool DictionnaireCompact::estVide() const {
+        return nbMots == 0;
+    }
+
+    /**
+     * \fn std::size_t DictionnaireCompact::taille() const
+     * \brief Permet de connaître le nombre de mots
+     * \return std::size_t, le nombre de mots
+     */
+    std::size_t DictionnaireCompact::taille() const {
+        return nbMots;
+    }
+
+    /**
+     * \fn std::string DictionnaireCompact::mot(std::size_t i) const
+     * \brief Permet d'obtenir un mot par son rang alphabétique
+     * \param[in] std::size_t i, le rang du mot
+     * \return std::string, le mot, décodé à partir du point de redémarrage qui le précède
+     * \exception logic_error si le rang est hors des bornes
+     */
+    std::string DictionnaireCompact::mot(std::size_t i) const {
+        if (i >= nbMots)
+            throw logic_error("rang de mot hors des bornes");
+        size_t position = redemarrages[i / intervalle];
+        string courant;
+        for (size_t k = i - i % intervalle; k <= i; k++)
+            _lire(position, courant);
+        return courant;
+    }
+
+    /**
+     * \fn std::size_t DictionnaireCompact::rangInferieur(const std::string &mot) const
+     * \brief Permet de trouver le rang du premier mot plus grand ou égal à un mot
+     * \param[in] const std::string &mot, le mot de référence
+     * \return std::size_t, le rang trouvé, taille() s'il n'y en a pas
+     */
+    std::size_t DictionnaireCompact::rangInferieur(const std::string &mot) const {
+        size_t position = 0;
+        string courant;
+        return _positionner(mot, position, courant);
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireCompact::motsAvecPrefixe(const std::string &prefixe, std::size_t limite) const
+     * \brief Permet de trouver, en ordre alphabétique, les mots qui commencent par un préfixe
+     * \param[in] const std::string &prefixe, le préfixe
+     * \param[in] std::size_t limite, le nombre maximal de mots retournés
+     * \return std::vector<std::string>, les mots trouvés
+     *
+     * Les mots qui commencent par le préfixe sont contigus à partir de rangInferieur(prefixe) : ils sont décodés l'un
+     * après l'autre, sans revenir au point de redémarrage.
+     *
+     */
+    std::vector<std::string> DictionnaireCompact::motsAvecPrefixe(const std::string &prefixe, std::size_t limite) const {
+        vector<string> mots;
+        size_t position = 0;
+        string courant;
+        for (size_t i = _positionner(prefixe, position, courant); i < nbMots && mots.size() < limite; i++) {
+            if (courant.compare(0, prefixe.size(), prefixe) != 0)
+                break;
+            mots.push_back(courant);
+            if (i + 1 < nbMots)
+                _lire(position, courant);
+        }
+        return mots;
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireCompact::motsEntre(const std::string &motDebut, const std::string &motFin, std::size_t limite) const
+     * \brief Permet de trouver, en ordre alphabétique, les mots compris entre deux bornes incluses
+     * \param[in] const std::string &motDebut, la borne inférieure
+     * \param[in] const std::string &motFin, la borne supérieure
+     * \param[in] std::size_t limite, le nombre maximal de mots retournés
+     * \return std::vector<std::string>, les mots trouvés
+     */
+    std::vector<std::string> DictionnaireCompact::motsEntre(const std::string &motDebut, const std::string &motFin, std::size_t limite) const {
+        vector<string> mots;
+        size_t position = 0;
+        string courant;
+        for (size_t i = _positionner(motDebut, position, courant); i < nbMots && mots.size() < limite; i++) {
+            if (courant.compare(motFin) > 0)
+                break;
+            mots.push_back(courant);
+            if (i + 1 < nbMots)
+                _lire(position, courant);
+        }
+        return mots;
+    }
+
+    /**
+     * \fn std::size_t DictionnaireCompact::empreinteMots() const
+     * \brief Permet de connaître la mémoire occupée par les mots
+     * \return std::size_t, les octets alloués pour le bloc des mots et les points de redémarrage
+     */
+    std::size_t DictionnaireCompact::empreinteMots() const {
+        return blocMots.capacity() + redemarrages.capacity() * sizeof(uint32_t)
+               + prefixesRedemarrages.capacity() * sizeof(uint64_t);
+    }
+
+    /**
+     * \fn std::size_t DictionnaireCompact::empreinteMemoire() const
+     * \brief Permet de connaître la mémoire occupée
+     * \return std::size_t, les octets alloués pour les blocs et les tableaux
+     */
+    std::size_t DictionnaireCompact::empreinteMemoire() const {
+        return sizeof(*this) + empreinteMots() + blocTraductions.capacity()
+               + (debutsTraductions.capacity() + premieresTraductions.capacity()) * sizeof(uint32_t);
+    }
+
+    /**
+     * \fn std::size_t DictionnaireCompact::_positionner(const std::string &mot, std::size_t &position, std::string &courant) const
+     * \brief Permet de trouver le premier mot plus grand ou égal à un mot, et de s'y arrêter pour continuer le décodage
+     * \param[in] const std::string &mot, le mot de référence
+     * \param[out] std::size_t &position, la position dans blocMots qui suit le mot trouvé
+     * \param[out] std::string &courant, le mot trouvé (indéfini s'il n'y en a pas)
+     * \return std::size_t, le rang du mot trouvé, taille() s'il n'y en a pas
+     *
+     * La recherche dichotomique trouve le dernier point de redémarrage qui n'est pas après 'mot' ; le mot cherché est dans
+     * son bloc, ou est le point de redémarrage suivant. On décode donc au plus intervalle + 1 mots contigus.
+     *
+     */
+    std::size_t DictionnaireCompact::_positionner(const std::string &mot, std::size_t &position, std::string &courant) const {
+        const uint64_t prefixeMot = DictionnaireEytzinger::prefixe(mot);
+        size_t debut = 0;
+        size_t fin = redemarrages.size();
+        while (debut < fin) {
+            const size_t milieu = debut + (fin - debut) / 2;
+            if (_comparerRedemarrage(milieu, mot, prefixeMot) <= 0)
+                debut = milieu + 1;
+            else
+                fin = milieu;
+        }
+
+        const size_t bloc = debut == 0 ? 0 : debut - 1;
+        size_t rang = bloc * intervalle;
+        position = redemarrages.empty() ? 0 : redemarrages[bloc];
+        for (; rang < nbMots; rang++) {
+            _lire(position, courant);
+            if (courant.compare(mot) >= 0)
+                break;
+        }
+        return rang;
+    }
+
+    /**
+     * \fn void DictionnaireCompact::_lire(std::size_t &position, std::string &courant) const
+     * \brief Permet de décoder le mot qui suit, à partir du mot précédent
+     * \param[in,out] std::size_t &position, la position du mot dans blocMots, avancée après lui
+     * \param[in,out] std::string &courant, le mot précédent, remplacé par le mot décodé (ignoré à un point de redémarrage)
+     */
+    void DictionnaireCompact::_lire(std::size_t &position, std::string &courant) const {
+        const size_t partage = _lireEntier(position);
+        const size_t longueur = _lireEntier(position);
+        courant.resize(partage);
+        courant.append(blocMots, position, longueur);
+        position += longueur;
+    }
+
+    /**
+     * \fn int DictionnaireCompact::_comparerRedemarrage(std::size_t r, const std::string &mot, std::uint64_t prefixeMot) const
+     * \brief Permet de comparer le mot d'un point de redémarrage à un mot, sans copie
+     * \param[in] std::size_t r, l'indice du point de redémarrage
+     * \param[in] const std::string &mot, le mot à comparer
+     * \param[in] std::uint64_t prefixeMot, DictionnaireEytzinger::prefixe(mot)
+     * \return int, négatif, nul ou positif selon que le mot du point de redémarrage est avant, égal ou après 'mot'
+     *
+     * Des préfixes différents suffisent à ordonner les 2 mots ; le bloc des mots n'est lu que si les préfixes sont égaux.
+     *
+     */
+    int DictionnaireCompact::_comparerRedemarrage(std::size_t r, const std::string &mot, std::uint64_t prefixeMot) const {
+        if (prefixesRedemarrages[r] != prefixeMot)
+            return prefixesRedemarrages[r] < prefixeMot ? -1 : 1;
+        size_t position = redemarrages[r];
+        _lireEntier(position); //0 : un point de redémarrage ne partage rien avec son prédécesseur
+        const size_t longueur = _lireEntier(position);
+        return blocMots.compare(position, longueur, mot);
+    }
+
+    /**
+     * \fn void DictionnaireCompact::_ecrireEntier(std::size_t valeur)
+     * \brief Permet d'ajouter un entier de longueur variable à blocMots : 7 bits par octet, le bit de poids fort indique une suite
+     * \param[in] std::size_t valeur, l'entier à ajouter
+     */
+    void DictionnaireCompact::_ecrireEntier(std::size_t valeur) {
+        while (valeur >= 0x80) {
+            blocMots += static_cast<char>((valeur & 0x7F) | 0x80);
+            valeur >>= 7;
+        }
+        blocMots += static_cast<char>(valeur);
+    }
+
+    /**
+     * \fn std::size_t DictionnaireCompact::_lireEntier(std::size_t &position) const
+     * \brief Permet de lire un entier de longueur variable de blocMots
+     * \param[in,out] std::size_t &position, la position de l'entier, avancée après lui
+     * \return std::size_t, l'entier lu
+     */
+    std::size_t DictionnaireCompact::_lireEntier(std::size_t &position) const {
+        size_t valeur = 0;
+        unsigned int decalage = 0;
+        unsigned char octet;
+        do {
+            octet = static_cast<unsigned char>(blocMots[position++]);
+            valeur |= static_cast<size_t>(octet & 0x7F) << decalage;
+            decalage += 7;
+        } while (octet & 0x80);
+        return valeur;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,113 @@
+/**
+ * \file DictionnaireCompact.h
+ * \brief Ce fichier contient l'interface d'un dictionnaire en lecture seule dont les mots triés sont codés par préfixe commun.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef DICTIONNAIRECOMPACT_H_
+#define DICTIONNAIRECOMPACT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Dictionnaire.h"
+
+namespace TP3
+{
+
+/**
+ * \class DictionnaireCompact
+ * \brief Copie en lecture seule d'un Dictionnaire dont les mots triés sont gardés en blocs codés par préfixe commun
+ *
+ *  Les mots d'un dictionnaire partagent souvent de longs préfixes avec leur prédécesseur alphabétique (aback, abacterial,
+ *  abaft...). Chaque mot est donc gardé comme la longueur du préfixe qu'il partage avec le mot précédent, suivie du reste
+ *  du mot (les 2 longueurs en entiers de longueur variable, un octet sous 128). Un mot sur 'intervalle' est un point de
+ *  redémarrage, gardé au complet : on peut y commencer le décodage sans rien lire avant lui.
+ *
+ *  Une recherche fait une recherche dichotomique sur les points de redémarrage (dont les 8 premiers octets sont gardés à
+ *  part, comme dans DictionnaireEytzinger, pour ne lire le bloc des mots qu'en cas d'égalité), puis décode au plus
+ *  'intervalle' mots contigus du bloc. Les traductions sont gardées comme dans DictionnaireFige.
+ *
+ *  Attributs:
+ *      - std::string blocMots, les mots triés, codés par préfixe commun, bout à bout
+ *      - std::vector<std::uint32_t> redemarrages, position de chaque point de redémarrage dans blocMots
+ *      - std::vector<std::uint64_t> prefixesRedemarrages, les 8 premiers octets du mot de chaque point de redémarrage
+ *      - std::size_t nbMots, intervalle, le nombre de mots et le nombre de mots par point de redémarrage
+ *      - std::string blocTraductions, std::vector<std::uint32_t> debutsTraductions, premieresTraductions, les traductions
+ *
+ */
+class DictionnaireCompact
+{
+public:
+
+	//Nombre de mots par point de redémarrage, par défaut
+	static const std::size_t INTERVALLE_REDEMARRAGE = 16;
+
+	//Constructeur d'un dictionnaire compact vide
+	DictionnaireCompact();
+
+	//Constructeur à partir d'un dictionnaire, qui n'est pas modifié, avec un point de redémarrage tous les 'intervalle' mots
+	//Un grand intervalle compresse mieux les mots, un petit décode moins de mots par recherche.
+	//Exception logic_error si l'intervalle est 0, ou si le dictionnaire dépasse 4 Gio de texte ou 2^32 mots
+	explicit DictionnaireCompact(const Dictionnaire& dictionnaire, std::size_t p_intervalle = INTERVALLE_REDEMARRAGE);
+
+	//Trouver les traductions possibles d'un mot (vecteur vide si le mot est absent)
+	std::vector<std::string> traduit(const std::string& mot) const;
+
+	//Vérifier si le mot donné appartient au dictionnaire
+	bool appartient(const std::string& mot) const;
+
+	//Vérifier si le dictionnaire est vide
+	bool estVide() const;
+
+	//Nombre de mots
+	std::size_t taille() const;
+
+	//Le mot de rang i en ordre alphabétique
+	//Exception logic_error si i >= taille()
+	std::string mot(std::size_t i) const;
+
+	//Rang du premier mot plus grand ou égal au mot donné (taille() s'il n'y en a pas)
+	std::size_t rangInferieur(const std::string& mot) const;
+
+	//Trouver, en ordre alphabétique, au plus 'limite' mots qui commencent par le préfixe donné
+	std::vector<std::string> motsAvecPrefixe(const std::string& prefixe, std::size_t limite) const;
+
+	//Trouver, en ordre alphabétique, au plus 'limite' mots compris entre motDebut et motFin inclusivement
+	std::vector<std::string> motsEntre(const std::string& motDebut, const std::string& motFin, std::size_t limite) const;
+
+	//Octets occupés par les mots : le bloc codé et les tableaux des points de redémarrage
+	std::size_t empreinteMots() const;
+
+	//Octets occupés par les blocs et les tableaux, traductions comprises
+	std::size_t empreinteMemoire() const;
+
+private:
+
+    std::string blocMots;
+    std::vector<std::uint32_t> redemarrages;
+    std::vector<std::uint64_t> prefixesRedemarrages;
+    std::size_t nbMots;
+    std::size_t intervalle;
+    std::string blocTraductions;
+    std::vector<std::uint32_t> debutsTraductions;
+    std::vector<std::uint32_t> premieresTraductions;
+
+    //region private methods
+
+    std::size_t _positionner(const std::string& mot, std::size_t& position, std::string& courant) const;
+    void _lire(std::size_t& position, std::string& courant) const;
+    int _comparerRedemarrage(std::size_t r, const std::string& mot, std::uint64_t prefixeMot) const;
+    void _ecrireEntier(std::size_t valeur);
+    std::size_t _lireEntier(std::size_t& position) const;
+
+    //endregion
+};
+
+}
+
+#endif /* DICTIONNAIRECOMPACT_H_ */
@@ -0,0 +1,205 @@
+/**
+ * \file DictionnaireEytzinger.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe DictionnaireEytzinger
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "DictionnaireEytzinger.h"
+#include "BlocsFiges.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+// Nombre de niveaux entre une case et les descendants qu'on précharge : 2^4 préfixes de 8 octets = 2 lignes de cache
+#define NIVEAUX_PRECHARGEMENT 4
+
+namespace TP3
+{
+
+    /**
+     * \fn DictionnaireEytzinger::DictionnaireEytzinger()
+     * \brief Constructeur d'un arbre vide
+     */
+    DictionnaireEytzinger::DictionnaireEytzinger() : prefixes(1, 0), rangs(1, 0), blocMots(), debutsMots(1, 0),
+                                                     blocTraductions(), debutsTraductions(1, 0), premieresTraductions(1, 0) {}
+
+    /**
+     * \fn DictionnaireEytzinger::DictionnaireEytzinger(const Dictionnaire &dictionnaire)
+     * \brief Constructeur qui copie un dictionnaire dans la disposition d'Eytzinger
+     * \param[in] const Dictionnaire &dictionnaire, le dictionnaire à copier
+     * \exception logic_error si les positions ne tiennent pas sur 32 bits
+     *
+     * Les mots sont d'abord copiés en ordre alphabétique, puis un parcours en ordre du tableau implicite leur attribue
+     * leur case : le k-ième nœud visité en ordre reçoit le k-ième mot.
+     *
+     */
+    DictionnaireEytzinger::DictionnaireEytzinger(const Dictionnaire &dictionnaire) : DictionnaireEytzinger() {
+        for (Dictionnaire::Iterateur mot = dictionnaire.begin(); mot != dictionnaire.end(); ++mot) {
+            ajouterMotFige(*mot, blocMots, debutsMots, "dictionnaire d'Eytzinger");
+            ajouterTraductionsFigees(mot.traductions(), blocTraductions, debutsTraductions, premieresTraductions,
+                                     "dictionnaire d'Eytzinger");
+        }
+
+        prefixes.assign(taille() + 1, 0);
+        rangs.assign(taille() + 1, 0);
+        size_t rang = 0;
+        _disposer(rang, 1);
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireEytzinger::traduit(const std::string &mot) const
+     * \brief Permet de retourner les traductions d'un mot
+     * \param[in] const std::string &mot, le mot à traduire
+     * \return std::vector<std::string>, les traductions du mot, vide si le mot est absent
+     */
+    std::vector<std::string> DictionnaireEytzinger::traduit(const std::string &mot) const {
+        vector<string> traductions;
+        const size_t position = _descendre(mot);
+        if (position == 0 || prefixes[position] != prefixe(mot) || _comparer(rangs[position], mot) != 0)
+            return traductions;
+
+        const size_t i = rangs[position];
+
+        return lireTraductionsFigees(i, blocTraductions, debutsTraductions, premieresTraductions);
+    }
+
+    /**
+     * \fn bool DictionnaireEytzinger::appartient(const std::string &mot) const
+     * \brief Permet de vérifier si un mot appartient au dictionnaire
+     * \param[in] const std::string &mot, le mot à vérifier
+     * \return bool, true si le mot appartient, false sinon
+     */
+    bool DictionnaireEytzinger::appartient(const std::string &mot) const {
+        const size_t i = _descendre(mot);
+        return i != 0 && prefixes[i] == prefixe(mot) && _comparer(rangs[i], mot) == 0;
+    }
+
+    /**
+     * \fn std::size_t DictionnaireEytzinger::rangInferieur(const std::string &mot) const
+     * \brief Permet de trouver le rang du premier mot plus grand ou égal à un mot
+     * \param[in] const std::string &mot, le mot de référence
+     * \return std::size_t, le rang trouvé, taille() s'il n'y en a pas
+     */
+    std::size_t DictionnaireEytzinger::rangInferieur(const std::string &mot) const {
+        const size_t i = _descendre(mot);
+        return i == 0 ? taille() : rangs[i];
+    }
+
+    /**
+     * \fn std::string DictionnaireEytzinger::mot(std::size_t i) const
+     * \brief Permet d'obtenir un mot par son rang alphabétique
+     * \param[in] std::size_t i, le rang du mot
+     * \return std::string, le mot
+     * \exception logic_error si le rang est hors des bornes
+     */
+    std::string DictionnaireEytzinger::mot(std::size_t i) const {
+        if (i >= taille())
+            throw logic_error("rang de mot hors des bornes");
+        return blocMots.substr(debutsMots[i], debutsMots[i + 1] - debutsMots[i]);
+    }
+
+    /**
+     * \fn std::size_t DictionnaireEytzinger::taille() const
+     * \brief Permet de connaître le nombre de mots
+     * \return std::size_t, le nombre de mots
+     */
+    std::size_t DictionnaireEytzinger::taille() const {
+        return debutsMots.size() - 1;
+    }
+
+    /**
+     * \fn std::size_t DictionnaireEytzinger::empreinteMemoire() const
+     * \brief Permet de connaître la mémoire occupée
+     * \return std::size_t, les octets alloués pour les tableaux et les blocs
+     */
+    std::size_t DictionnaireEytzinger::empreinteMemoire() const {
+        return sizeof(*this) + prefixes.capacity() * sizeof(uint64_t) + blocMots.capacity() + blocTraductions.capacity()
+               + (rangs.capacity() + debutsMots.capacity() + debutsTraductions.capacity() + premieresTraductions.capacity()) * sizeof(uint32_t);
+    }
+
+    /**
+     * \fn std::uint64_t DictionnaireEytzinger::prefixe(const std::string &mot)
+     * \brief Permet de calculer le préfixe comparable d'un mot
+     * \param[in] const std::string &mot, le mot
+     * \return std::uint64_t, les 8 premiers octets du mot en gros-boutiste, complétés par des 0
+     *
+     * Comme std::string compare les caractères comme des unsigned char, l'ordre des préfixes est celui des mots, sauf
+     * quand les préfixes sont égaux (mots identiques sur 8 octets, ou mot plus court complété par des 0).
+     *
+     */
+    std::uint64_t DictionnaireEytzinger::prefixe(const std::string &mot) {
+        uint64_t resultat = 0;
+        const size_t longueur = mot.size();
+        for (size_t k = 0; k < 8; k++)
+            resultat = (resultat << 8) | (k < longueur ? static_cast<unsigned char>(mot[k]) : 0);
+        return resultat;
+    }
+
+    /**
+     * \fn void DictionnaireEytzinger::_disposer(std::size_t &rang, std::size_t position)
+     * \brief Permet de remplir les cases du sous-arbre implicite d'une position, par un parcours en ordre
+     * \param[in] std::size_t &rang, le rang alphabétique du prochain mot à placer, avancé à chaque case remplie
+     * \param[in] std::size_t position, la case racine du sous-arbre
+     */
+    void DictionnaireEytzinger::_disposer(std::size_t &rang, std::size_t position) {
+        if (position > taille())
+            return;
+        _disposer(rang, 2 * position);
+        prefixes[position] = prefixe(mot(rang));
+        rangs[position] = static_cast<uint32_t>(rang);
+        rang++;
+        _disposer(rang, 2 * position + 1);
+    }
+
+    /**
+     * \fn std::size_t DictionnaireEytzinger::_descendre(const std::string &mot) const
+     * \brief Permet de trouver la case du premier mot plus grand ou égal à un mot
+     * \param[in] const std::string &mot, le mot de référence
+     * \return std::size_t, la case trouvée, 0 s'il n'y en a pas
+     *
+     * On descend toujours jusqu'à sortir du tableau : à chaque niveau, on va à droite si le mot de la case est plus petit
+     * que la clé. Le dernier virage à gauche désigne le premier mot plus grand ou égal ; on le retrouve en retirant de i
+     * les virages à droite (les 1 de poids faible) puis ce virage à gauche. Si on n'a jamais tourné à gauche, i devient 0.
+     *
+     * Si la clé est absente, le préfixe de la case trouvée diffère presque toujours du sien : appartient et traduit le
+     * vérifient avant de lire le mot complet, qui est ailleurs en mémoire.
+     *
+     * L'adresse préchargée est calculée en entier : elle peut dépasser la fin du tableau, ce qui est sans effet pour une
+     * instruction de préchargement.
+     *
+     */
+    std::size_t DictionnaireEytzinger::_descendre(const std::string &mot) const {
+        const uint64_t cle = prefixe(mot);
+        const size_t n = taille();
+        const uint64_t* const cases = prefixes.data();
+        const uintptr_t adresseCases = reinterpret_cast<uintptr_t>(cases);
+
+        size_t i = 1;
+        while (i <= n) {
+            __builtin_prefetch(reinterpret_cast<const void*>(adresseCases + (i << NIVEAUX_PRECHARGEMENT) * sizeof(uint64_t)));
+            const uint64_t prefixeCase = cases[i];
+            size_t plusPetit = prefixeCase < cle;
+            if (prefixeCase == cle)
+                plusPetit = _comparer(rangs[i], mot) < 0; //rare : même préfixe de 8 octets
+            i = 2 * i + plusPetit;
+        }
+
+        return i >> (__builtin_ctzll(~static_cast<unsigned long long>(i)) + 1);
+    }
+
+    /**
+     * \fn int DictionnaireEytzinger::_comparer(std::size_t rang, const std::string &mot) const
+     * \brief Permet de comparer le mot d'un rang à un mot, sans copie
+     * \param[in] std::size_t rang, le rang du mot du dictionnaire
+     * \param[in] const std::string &mot, le mot à comparer
+     * \return int, négatif, nul ou positif selon que le mot du dictionnaire est avant, égal ou après 'mot'
+     */
+    int DictionnaireEytzinger::_comparer(std::size_t rang, const std::string &mot) const {
+        return blocMots.compare(debutsMots[rang], debutsMots[rang + 1] - debutsMots[rang], mot);
+    }
+
+}//Fin du namespace
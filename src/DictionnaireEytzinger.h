@@ -0,0 +1,95 @@
+/**
+ * \file DictionnaireEytzinger.h
+ * \brief Ce fichier contient l'interface d'un arbre de recherche en lecture seule disposé en ordre d'Eytzinger (largeur d'abord).
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef DICTIONNAIREEYTZINGER_H_
+#define DICTIONNAIREEYTZINGER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Dictionnaire.h"
+
+namespace TP3
+{
+
+/**
+ * \class DictionnaireEytzinger
+ * \brief Copie en lecture seule d'un Dictionnaire dont les mots forment un arbre binaire implicite, rangé dans un tableau
+ *
+ *  La case 1 du tableau est la racine et les enfants de la case i sont les cases 2i et 2i+1 (ordre d'Eytzinger, comme un
+ *  monceau). Chaque case ne contient que les 8 premiers octets du mot, en gros-boutiste : comparer deux préfixes revient
+ *  alors à comparer deux entiers. Le mot complet n'est consulté que si les préfixes sont égaux.
+ *
+ *  La descente n'a de branchement dépendant des données que pour les préfixes égaux (i = 2i + (préfixe < clé)), et les
+ *  16 descendants situés 4 niveaux plus bas, contigus, sont préchargés pendant qu'on descend les niveaux intermédiaires.
+ *  On remplace ainsi la poursuite de pointeurs de _trouverRecursif par un accès mémoire prévisible.
+ *
+ *  Attributs:
+ *      - std::vector<std::uint64_t> prefixes, les préfixes en ordre d'Eytzinger (case 0 inutilisée)
+ *      - std::vector<std::uint32_t> rangs, le rang alphabétique du mot de chaque case
+ *      - std::string blocMots, std::vector<std::uint32_t> debutsMots, les mots triés, bout à bout
+ *      - std::string blocTraductions, std::vector<std::uint32_t> debutsTraductions, premieresTraductions, les traductions
+ *
+ */
+class DictionnaireEytzinger
+{
+public:
+
+	//Constructeur d'un arbre vide
+	DictionnaireEytzinger();
+
+	//Constructeur à partir d'un dictionnaire, qui n'est pas modifié
+	//Exception logic_error si le dictionnaire dépasse 4 Gio de texte ou 2^32 mots
+	explicit DictionnaireEytzinger(const Dictionnaire& dictionnaire);
+
+	//Trouver les traductions possibles d'un mot (vecteur vide si le mot est absent)
+	std::vector<std::string> traduit(const std::string& mot) const;
+
+	//Vérifier si le mot donné appartient au dictionnaire
+	bool appartient(const std::string& mot) const;
+
+	//Rang du premier mot plus grand ou égal au mot donné (taille() s'il n'y en a pas)
+	std::size_t rangInferieur(const std::string& mot) const;
+
+	//Le mot de rang i en ordre alphabétique
+	//Exception logic_error si i >= taille()
+	std::string mot(std::size_t i) const;
+
+	//Nombre de mots
+	std::size_t taille() const;
+
+	//Octets occupés par les tableaux et les blocs
+	std::size_t empreinteMemoire() const;
+
+	//Les 8 premiers octets d'un mot, en gros-boutiste, complétés par des 0
+	static std::uint64_t prefixe(const std::string& mot);
+
+private:
+
+    std::vector<std::uint64_t> prefixes;
+    std::vector<std::uint32_t> rangs;
+    std::string blocMots;
+    std::vector<std::uint32_t> debutsMots;
+    std::string blocTraductions;
+    std::vector<std::uint32_t> debutsTraductions;
+    std::vector<std::uint32_t> premieresTraductions;
+
+    //region private methods
+
+    void _disposer(std::size_t& rang, std::size_t position);
+    std::size_t _descendre(const std::string& mot) const;
+    int _comparer(std::size_t rang, const std::string& mot) const;
+
+    //endregion
+};
+
+}
+
+#endif /* DICTIONNAIREEYTZINGER_H_ */
@@ -0,0 +1,306 @@
+/**
+ * \file DictionnaireFige.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe DictionnaireFige
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "DictionnaireFige.h"
+#include "BlocsFiges.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+using namespace std;
+
+// Nombre maximal de pilotes essayés pour un seau avant de conclure à une collision complète de hachage
+#define PILOTE_MAX (1u << 30)
+
+namespace TP3
+{
+
+    namespace
+    {
+        /**
+         * \fn std::uint64_t melanger(std::uint64_t x)
+         * \brief Fonction de mélange de splitmix64 : chaque bit du résultat dépend de tous les bits de x
+         */
+        inline std::uint64_t melanger(std::uint64_t x) {
+            x += 0x9E3779B97F4A7C15ULL;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+    }
+
+    const std::size_t DictionnaireFige::MOTS_PAR_SEAU;
+
+    /**
+     * \fn DictionnaireFige::DictionnaireFige()
+     * \brief Constructeur d'un dictionnaire figé vide
+     */
+    DictionnaireFige::DictionnaireFige() : blocMots(), debutsMots(1, 0), blocTraductions(), debutsTraductions(1, 0),
+                                           premieresTraductions(1, 0), pilotes(), motsParCase() {}
+
+    /**
+     * \fn DictionnaireFige::DictionnaireFige(const Dictionnaire &dictionnaire)
+     * \brief Constructeur qui fige le contenu d'un dictionnaire
+     * \param[in] const Dictionnaire &dictionnaire, le dictionnaire à copier
+     * \exception logic_error si les positions ne tiennent pas sur 32 bits
+     *
+     * Le dictionnaire est parcouru une seule fois en ordre alphabétique pour remplir les blocs ; le hachage parfait est
+     * ensuite construit sur les mots.
+     *
+     */
+    DictionnaireFige::DictionnaireFige(const Dictionnaire &dictionnaire) : DictionnaireFige() {
+        for (Dictionnaire::Iterateur mot = dictionnaire.begin(); mot != dictionnaire.end(); ++mot) {
+            ajouterMotFige(*mot, blocMots, debutsMots, "dictionnaire fige");
+            ajouterTraductionsFigees(mot.traductions(), blocTraductions, debutsTraductions, premieresTraductions,
+                                     "dictionnaire fige");
+        }
+
+        blocMots.shrink_to_fit();
+        debutsMots.shrink_to_fit();
+        blocTraductions.shrink_to_fit();
+        debutsTraductions.shrink_to_fit();
+        premieresTraductions.shrink_to_fit();
+        _construireHachageParfait();
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireFige::traduit(const std::string &mot) const
+     * \brief Permet de retourner les traductions d'un mot
+     * \param[in] const std::string &mot, le mot à traduire
+     * \return std::vector<std::string>, les traductions du mot, vide si le mot est absent
+     */
+    std::vector<std::string> DictionnaireFige::traduit(const std::string &mot) const {
+        vector<string> traductions;
+        const size_t i = _trouver(mot);
+        if (i == taille())
+            return traductions;
+
+        return lireTraductionsFigees(i, blocTraductions, debutsTraductions, premieresTraductions);
+    }
+
+    /**
+     * \fn bool DictionnaireFige::appartient(const std::string &mot) const
+     * \brief Permet de vérifier si un mot appartient au dictionnaire
+     * \param[in] const std::string &mot, le mot à vérifier
+     * \return bool, true si le mot appartient, false sinon
+     */
+    bool DictionnaireFige::appartient(const std::string &mot) const {
+        return _trouver(mot) != taille();
+    }
+
+    /**
+     * \fn bool DictionnaireFige::estVide() const
+     * \brief Permet de vérifier si le dictionnaire est vide
+     * \return bool, true s'il n'y a aucun mot
+     */
+    bool DictionnaireFige::estVide() const {
+        return taille() == 0;
+    }
+
+    /**
+     * \fn std::size_t DictionnaireFige::taille() const
+     * \brief Permet de connaître le nombre de mots
+     * \return std::size_t, le nombre de mots
+     */
+    std::size_t DictionnaireFige::taille() const {
+        return debutsMots.size() - 1;
+    }
+
+    /**
+     * \fn std::string DictionnaireFige::mot(std::size_t i) const
+     * \brief Permet d'obtenir un mot par son rang alphabétique
+     * \param[in] std::size_t i, le rang du mot
+     * \return std::string, le mot
+     * \exception logic_error si le rang est hors des bornes
+     */
+    std::string DictionnaireFige::mot(std::size_t i) const {
+        if (i >= taille())
+            throw logic_error("rang de mot hors des bornes");
+        return blocMots.substr(debutsMots[i], debutsMots[i + 1] - debutsMots[i]);
+    }
+
+    /**
+     * \fn std::size_t DictionnaireFige::rangInferieur(const std::string &mot) const
+     * \brief Permet de trouver le rang du premier mot plus grand ou égal à un mot
+     * \param[in] const std::string &mot, le mot de référence
+     * \return std::size_t, le rang trouvé, taille() s'il n'y en a pas
+     */
+    std::size_t DictionnaireFige::rangInferieur(const std::string &mot) const {
+        size_t debut = 0;
+        size_t fin = taille();
+        while (debut < fin) {
+            const size_t milieu = debut + (fin - debut) / 2;
+            if (_comparer(milieu, mot) < 0)
+                debut = milieu + 1;
+            else
+                fin = milieu;
+        }
+        return debut;
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireFige::motsAvecPrefixe(const std::string &prefixe, std::size_t limite) const
+     * \brief Permet de trouver, en ordre alphabétique, les mots qui commencent par un préfixe
+     * \param[in] const std::string &prefixe, le préfixe
+     * \param[in] std::size_t limite, le nombre maximal de mots retournés
+     * \return std::vector<std::string>, les mots trouvés
+     *
+     * Les mots qui commencent par le préfixe sont contigus dans l'ordre alphabétique, à partir de rangInferieur(prefixe).
+     *
+     */
+    std::vector<std::string> DictionnaireFige::motsAvecPrefixe(const std::string &prefixe, std::size_t limite) const {
+        vector<string> mots;
+        for (size_t i = rangInferieur(prefixe); i < taille() && mots.size() < limite; i++) {
+            if (debutsMots[i + 1] - debutsMots[i] < prefixe.size() || blocMots.compare(debutsMots[i], prefixe.size(), prefixe) != 0)
+                break;
+            mots.push_back(mot(i));
+        }
+        return mots;
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireFige::motsEntre(const std::string &motDebut, const std::string &motFin, std::size_t limite) const
+     * \brief Permet de trouver, en ordre alphabétique, les mots compris entre deux bornes incluses
+     * \param[in] const std::string &motDebut, la borne inférieure
+     * \param[in] const std::string &motFin, la borne supérieure
+     * \param[in] std::size_t limite, le nombre maximal de mots retournés
+     * \return std::vector<std::string>, les mots trouvés
+     */
+    std::vector<std::string> DictionnaireFige::motsEntre(const std::string &motDebut, const std::string &motFin, std::size_t limite) const {
+        vector<string> mots;
+        for (size_t i = rangInferieur(motDebut); i < taille() && mots.size() < limite && _comparer(i, motFin) <= 0; i++)
+            mots.push_back(mot(i));
+        return mots;
+    }
+
+    /**
+     * \fn std::size_t DictionnaireFige::empreinteMemoire() const
+     * \brief Permet de connaître la mémoire occupée
+     * \return std::size_t, les octets alloués pour les blocs et les tableaux
+     */
+    std::size_t DictionnaireFige::empreinteMemoire() const {
+        return sizeof(*this) + blocMots.capacity() + blocTraductions.capacity()
+               + (debutsMots.capacity() + debutsTraductions.capacity() + premieresTraductions.capacity()
+                  + pilotes.capacity() + motsParCase.capacity()) * sizeof(uint32_t);
+    }
+
+    /**
+     * \fn void DictionnaireFige::_construireHachageParfait()
+     * \brief Permet de construire le hachage parfait minimal (CHD : compression, hachage et déplacement)
+     *
+     * Les mots sont répartis en seaux d'environ MOTS_PAR_SEAU mots. Les seaux sont ensuite traités du plus gros au plus
+     * petit : pour chacun, on essaie les pilotes 0, 1, 2... jusqu'à ce que tous ses mots tombent dans des cases libres et
+     * distinctes. Les gros seaux passent en premier, quand la table est presque vide ; les seaux d'un seul mot, traités à la
+     * fin, n'ont besoin que d'une case libre. La table a exactement une case par mot.
+     *
+     */
+    void DictionnaireFige::_construireHachageParfait() {
+        const size_t nbMots = taille();
+        pilotes.clear();
+        motsParCase.clear();
+        if (nbMots == 0)
+            return;
+
+        const size_t nbSeaux = (nbMots + MOTS_PAR_SEAU - 1) / MOTS_PAR_SEAU;
+        pilotes.assign(nbSeaux, 0);
+        motsParCase.assign(nbMots, 0);
+
+        vector<uint64_t> hachages(nbMots);
+        vector<vector<uint32_t> > seaux(nbSeaux);
+        for (size_t i = 0; i < nbMots; i++) {
+            hachages[i] = hash<string>()(mot(i));
+            seaux[_seau(hachages[i])].push_back(static_cast<uint32_t>(i));
+        }
+
+        vector<uint32_t> ordre(nbSeaux);
+        for (size_t s = 0; s < nbSeaux; s++)
+            ordre[s] = static_cast<uint32_t>(s);
+        stable_sort(ordre.begin(), ordre.end(), [&seaux](uint32_t a, uint32_t b) { return seaux[a].size() > seaux[b].size(); });
+
+        vector<bool> caseOccupee(nbMots, false);
+        vector<size_t> cases;
+        for (uint32_t s : ordre) {
+            const vector<uint32_t>& seau = seaux[s];
+            if (seau.empty())
+                break;
+
+            for (uint32_t pilote = 0; ; pilote++) {
+                if (pilote == PILOTE_MAX)
+                    throw logic_error("collision complete de hachage entre deux mots");
+
+                cases.clear();
+                bool libre = true;
+                for (size_t k = 0; k < seau.size() && libre; k++) {
+                    const size_t position = _case(hachages[seau[k]], pilote);
+                    libre = !caseOccupee[position] && find(cases.begin(), cases.end(), position) == cases.end();
+                    cases.push_back(position);
+                }
+                if (!libre)
+                    continue;
+
+                for (size_t k = 0; k < seau.size(); k++) {
+                    caseOccupee[cases[k]] = true;
+                    motsParCase[cases[k]] = seau[k];
+                }
+                pilotes[s] = pilote;
+                break;
+            }
+        }
+        pilotes.shrink_to_fit();
+    }
+
+    /**
+     * \fn std::size_t DictionnaireFige::_trouver(const std::string &mot) const
+     * \brief Permet de trouver le rang d'un mot avec le hachage parfait
+     * \param[in] const std::string &mot, le mot cherché
+     * \return std::size_t, le rang du mot, taille() s'il est absent
+     */
+    std::size_t DictionnaireFige::_trouver(const std::string &mot) const {
+        if (estVide())
+            return taille();
+
+        const uint64_t hachage = hash<string>()(mot);
+        const uint32_t i = motsParCase[_case(hachage, pilotes[_seau(hachage)])];
+        return _comparer(i, mot) == 0 ? i : taille();
+    }
+
+    /**
+     * \fn int DictionnaireFige::_comparer(std::size_t i, const std::string &mot) const
+     * \brief Permet de comparer le mot de rang i à un mot, sans copie
+     * \param[in] std::size_t i, le rang du mot du dictionnaire
+     * \param[in] const std::string &mot, le mot à comparer
+     * \return int, négatif, nul ou positif selon que le mot de rang i est avant, égal ou après 'mot'
+     */
+    int DictionnaireFige::_comparer(std::size_t i, const std::string &mot) const {
+        return blocMots.compare(debutsMots[i], debutsMots[i + 1] - debutsMots[i], mot);
+    }
+
+    /**
+     * \fn std::size_t DictionnaireFige::_seau(std::uint64_t hachage) const
+     * \brief Permet de trouver le seau d'un hachage
+     * \param[in] std::uint64_t hachage, le hachage du mot
+     * \return std::size_t, l'indice du seau
+     */
+    std::size_t DictionnaireFige::_seau(std::uint64_t hachage) const {
+        return static_cast<size_t>(hachage % pilotes.size());
+    }
+
+    /**
+     * \fn std::size_t DictionnaireFige::_case(std::uint64_t hachage, std::uint32_t pilote) const
+     * \brief Permet de trouver la case d'un hachage pour un pilote donné
+     * \param[in] std::uint64_t hachage, le hachage du mot
+     * \param[in] std::uint32_t pilote, le pilote du seau du mot
+     * \return std::size_t, l'indice de la case
+     */
+    std::size_t DictionnaireFige::_case(std::uint64_t hachage, std::uint32_t pilote) const {
+        return static_cast<size_t>(melanger(hachage ^ melanger(pilote)) % motsParCase.size());
+    }
+
+}//Fin du namespace
@@ -0,0 +1,108 @@
+/**
+ * \file DictionnaireFige.h
+ * \brief Ce fichier contient l'interface d'un dictionnaire figé (lecture seule) à hachage parfait minimal.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef DICTIONNAIREFIGE_H_
+#define DICTIONNAIREFIGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Dictionnaire.h"
+
+namespace TP3
+{
+
+/**
+ * \class DictionnaireFige
+ * \brief Copie immuable et compacte d'un Dictionnaire, pour les déploiements où le dictionnaire ne change plus après le chargement
+ *
+ *  Les mots sont gardés en ordre alphabétique, bout à bout dans un seul bloc de caractères, avec un tableau de positions.
+ *  Les traductions sont gardées de la même façon dans un second bloc. Il n'y a ni noeud, ni pointeur, ni allocation par mot.
+ *
+ *  Les recherches exactes utilisent un hachage parfait minimal de type CHD : le hachage d'un mot choisit un seau, le pilote
+ *  de ce seau choisit une case parmi n, et chaque mot du dictionnaire a sa propre case. Une recherche fait donc une seule
+ *  sonde, suivie d'une comparaison avec le mot de la case (un mot absent peut tomber sur la case d'un autre mot).
+ *  Les requêtes ordonnées (préfixe, intervalle) font une recherche dichotomique dans les mots triés.
+ *
+ *  Attributs:
+ *      - std::string blocMots, les mots triés, bout à bout
+ *      - std::vector<std::uint32_t> debutsMots, position du mot i dans blocMots (nbMots + 1 éléments)
+ *      - std::string blocTraductions, toutes les traductions, bout à bout, dans l'ordre des mots
+ *      - std::vector<std::uint32_t> debutsTraductions, position de la traduction j dans blocTraductions
+ *      - std::vector<std::uint32_t> premieresTraductions, indice de la première traduction du mot i (nbMots + 1 éléments)
+ *      - std::vector<std::uint32_t> pilotes, le pilote de chaque seau du hachage parfait
+ *      - std::vector<std::uint32_t> motsParCase, l'indice du mot rangé dans chaque case
+ *
+ */
+class DictionnaireFige
+{
+public:
+
+	//Nombre moyen de mots par seau du hachage parfait
+	static const std::size_t MOTS_PAR_SEAU = 4;
+
+	//Constructeur d'un dictionnaire figé vide
+	DictionnaireFige();
+
+	//Constructeur à partir d'un dictionnaire, qui n'est pas modifié
+	//Exception logic_error si le dictionnaire dépasse 4 Gio de texte ou 2^32 mots
+	explicit DictionnaireFige(const Dictionnaire& dictionnaire);
+
+	//Trouver les traductions possibles d'un mot (vecteur vide si le mot est absent)
+	std::vector<std::string> traduit(const std::string& mot) const;
+
+	//Vérifier si le mot donné appartient au dictionnaire
+	bool appartient(const std::string& mot) const;
+
+	//Vérifier si le dictionnaire est vide
+	bool estVide() const;
+
+	//Nombre de mots
+	std::size_t taille() const;
+
+	//Le mot de rang i en ordre alphabétique (0 <= i < taille())
+	std::string mot(std::size_t i) const;
+
+	//Rang du premier mot plus grand ou égal au mot donné (taille() s'il n'y en a pas)
+	std::size_t rangInferieur(const std::string& mot) const;
+
+	//Trouver, en ordre alphabétique, au plus 'limite' mots qui commencent par le préfixe donné
+	std::vector<std::string> motsAvecPrefixe(const std::string& prefixe, std::size_t limite) const;
+
+	//Trouver, en ordre alphabétique, au plus 'limite' mots compris entre motDebut et motFin inclusivement
+	std::vector<std::string> motsEntre(const std::string& motDebut, const std::string& motFin, std::size_t limite) const;
+
+	//Octets occupés par les blocs et les tableaux
+	std::size_t empreinteMemoire() const;
+
+private:
+
+    std::string blocMots;
+    std::vector<std::uint32_t> debutsMots;
+    std::string blocTraductions;
+    std::vector<std::uint32_t> debutsTraductions;
+    std::vector<std::uint32_t> premieresTraductions;
+    std::vector<std::uint32_t> pilotes;
+    std::vector<std::uint32_t> motsParCase;
+
+    //region private methods
+
+    void _construireHachageParfait();
+    std::size_t _trouver(const std::string& mot) const;
+    int _comparer(std::size_t i, const std::string& mot) const;
+    std::size_t _seau(std::uint64_t hachage) const;
+    std::size_t _case(std::uint64_t hachage, std::uint32_t pilote) const;
+
+    //endregion
+};
+
+}
+
+#endif /* DICTIONNAIREFIGE_H_ */
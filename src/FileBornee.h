@@ -0,0 +1,320 @@
+/**
+ * \file FileBornee.h
+ * \brief Ce fichier contient l'interface et l'implantation d'une file bornée sans verrou à plusieurs producteurs et consommateurs.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef FILEBORNEE_H_
+#define FILEBORNEE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Taille supposée d'une ligne de cache, pour séparer les positions de tête et de queue
+#define TP3_TAILLE_LIGNE_CACHE 64
+
+namespace TP3
+{
+
+/**
+ * \class FileBornee
+ * \brief File FIFO de capacité fixe, sans verrou, utilisable par plusieurs producteurs et plusieurs consommateurs (Vyukov).
+ *
+ *  Chaque case porte un numéro de séquence qui indique si elle est prête à être écrite (séquence == position) ou lue
+ *  (séquence == position + 1). Un producteur réserve une position par compare-and-swap sur 'positionEnfiler', écrit la valeur,
+ *  puis publie la case en avançant sa séquence (ordre release). Le consommateur fait de même sur 'positionDefiler'.
+ *  Les positions de tête et de queue sont sur des lignes de cache distinctes pour éviter le faux partage.
+ *
+ *  enfiler et defiler attendent d'abord activement (ESSAIS_AVANT_YIELD essais), puis en cédant le processeur, puis
+ *  s'endorment sur une variable de condition après ESSAIS_AVANT_ATTENTE essais : un fil inactif ne consomme pas de
+ *  processeur. Le verrou ne sert qu'à s'endormir et à réveiller ; une opération réussie ne le prend que si un fil dort
+ *  de l'autre côté (compteurs producteursEnAttente et consommateursEnAttente).
+ *
+ *  Le type T doit être copiable et constructible par défaut ; on y met typiquement un pointeur.
+ *
+ *  Attributs:
+ *      - std::vector<Case> cases, la table circulaire (taille puissance de 2)
+ *      - std::size_t masque, capacité - 1
+ *      - std::atomic<std::size_t> positionEnfiler, prochaine position à réserver par un producteur
+ *      - std::atomic<std::size_t> positionDefiler, prochaine position à réserver par un consommateur
+ *      - std::mutex verrou, std::condition_variable placeLiberee, elementAjoute, pour les fils endormis
+ *      - std::atomic<int> producteursEnAttente, consommateursEnAttente, le nombre de fils endormis de chaque côté
+ *
+ */
+template<typename T>
+class FileBornee
+{
+public:
+
+	//Constructeur d'une file vide
+	//Exception logic_error si la capacité n'est pas une puissance de 2 plus grande ou égale à 2
+	explicit FileBornee(std::size_t capacite);
+
+	FileBornee(const FileBornee&) = delete;
+	FileBornee& operator=(const FileBornee&) = delete;
+
+	//Ajouter un élément s'il reste de la place. On retourne false si la file est pleine.
+	bool essaieEnfiler(const T& element);
+
+	//Retirer le plus ancien élément s'il y en a un. On retourne false si la file est vide.
+	bool essaieDefiler(T& element);
+
+	//Ajouter un élément, en attendant (attente active, puis yield, puis sommeil) qu'une place se libère
+	void enfiler(const T& element);
+
+	//Retirer le plus ancien élément, en attendant (attente active, puis yield, puis sommeil) qu'il y en ait un
+	T defiler();
+
+	//Nombre maximal d'éléments dans la file
+	std::size_t capacite() const;
+
+private:
+
+    /**
+     * \struct Case
+     * \brief Une case de la file : son numéro de séquence et la valeur qu'elle contient
+     */
+    struct Case
+    {
+        std::atomic<std::size_t> sequence;
+        T valeur;
+    };
+
+    std::vector<Case> cases;
+    const std::size_t masque;
+    char separation1[TP3_TAILLE_LIGNE_CACHE];
+    std::atomic<std::size_t> positionEnfiler;
+    char separation2[TP3_TAILLE_LIGNE_CACHE];
+    std::atomic<std::size_t> positionDefiler;
+    char separation3[TP3_TAILLE_LIGNE_CACHE];
+    std::mutex verrou;
+    std::condition_variable placeLiberee;
+    std::condition_variable elementAjoute;
+    std::atomic<int> producteursEnAttente;
+    std::atomic<int> consommateursEnAttente;
+
+    static const int ESSAIS_AVANT_YIELD = 64;
+    static const int ESSAIS_AVANT_ATTENTE = 128;
+
+    //region private methods
+
+    bool _essaieEnfiler(const T& element);
+    bool _essaieDefiler(T& element);
+    void _reveiller(std::atomic<int>& enAttente, std::condition_variable& condition);
+
+    //endregion
+};
+
+    template<typename T>
+    const int FileBornee<T>::ESSAIS_AVANT_YIELD;
+
+    template<typename T>
+    const int FileBornee<T>::ESSAIS_AVANT_ATTENTE;
+
+    /**
+     * \fn FileBornee<T>::FileBornee(std::size_t capacite)
+     * \brief Constructeur d'une file vide
+     * \param[in] std::size_t capacite, le nombre de cases (puissance de 2)
+     * \exception logic_error si la capacité n'est pas une puissance de 2 plus grande ou égale à 2
+     */
+    template<typename T>
+    FileBornee<T>::FileBornee(std::size_t capacite) : cases(capacite), masque(capacite - 1), positionEnfiler(0), positionDefiler(0),
+                                                       verrou(), placeLiberee(), elementAjoute(), producteursEnAttente(0),
+                                                       consommateursEnAttente(0) {
+        if (capacite < 2 || (capacite & (capacite - 1)) != 0)
+            throw std::logic_error("la capacite de la file doit etre une puissance de 2");
+
+        for (std::size_t i = 0; i < capacite; i++)
+            cases[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /**
+     * \fn bool FileBornee<T>::essaieEnfiler(const T& element)
+     * \brief Permet d'ajouter un élément sans attendre
+     * \param[in] const T& element, l'élément à ajouter
+     * \return bool, true si l'élément a été ajouté (un consommateur endormi est alors réveillé), false si la file est pleine
+     */
+    template<typename T>
+    bool FileBornee<T>::essaieEnfiler(const T& element) {
+        if (!_essaieEnfiler(element))
+            return false;
+        _reveiller(consommateursEnAttente, elementAjoute);
+        return true;
+    }
+
+    /**
+     * \fn bool FileBornee<T>::essaieDefiler(T& element)
+     * \brief Permet de retirer le plus ancien élément sans attendre
+     * \param[out] T& element, l'élément retiré
+     * \return bool, true si un élément a été retiré (un producteur endormi est alors réveillé), false si la file est vide
+     */
+    template<typename T>
+    bool FileBornee<T>::essaieDefiler(T& element) {
+        if (!_essaieDefiler(element))
+            return false;
+        _reveiller(producteursEnAttente, placeLiberee);
+        return true;
+    }
+
+    /**
+     * \fn void FileBornee<T>::enfiler(const T& element)
+     * \brief Permet d'ajouter un élément en attendant qu'une place se libère
+     * \param[in] const T& element, l'élément à ajouter
+     *
+     * On réessaie quelques fois immédiatement, puis en cédant le processeur entre les essais, puis on s'endort jusqu'à
+     * ce qu'un consommateur libère une place. Le compteur des fils endormis est augmenté sous le verrou avant le dernier
+     * essai : un consommateur qui libère une place après cet essai voit le compteur et ne peut notifier qu'une fois le
+     * producteur endormi (il doit prendre le verrou, relâché seulement par wait).
+     *
+     */
+    template<typename T>
+    void FileBornee<T>::enfiler(const T& element) {
+        for (int essais = 0; !_essaieEnfiler(element); essais++) {
+            if (essais < ESSAIS_AVANT_YIELD)
+                continue;
+            if (essais < ESSAIS_AVANT_ATTENTE) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> verrouillage(verrou);
+            producteursEnAttente.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const bool ajoute = _essaieEnfiler(element);
+            if (!ajoute)
+                placeLiberee.wait(verrouillage);
+            producteursEnAttente.fetch_sub(1);
+            if (ajoute)
+                break;
+        }
+        _reveiller(consommateursEnAttente, elementAjoute);
+    }
+
+    /**
+     * \fn T FileBornee<T>::defiler()
+     * \brief Permet de retirer le plus ancien élément en attendant qu'il y en ait un
+     * \return T, l'élément retiré
+     *
+     * Même attente en trois temps que enfiler, du côté des consommateurs.
+     *
+     */
+    template<typename T>
+    T FileBornee<T>::defiler() {
+        T element;
+        for (int essais = 0; !_essaieDefiler(element); essais++) {
+            if (essais < ESSAIS_AVANT_YIELD)
+                continue;
+            if (essais < ESSAIS_AVANT_ATTENTE) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> verrouillage(verrou);
+            consommateursEnAttente.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const bool retire = _essaieDefiler(element);
+            if (!retire)
+                elementAjoute.wait(verrouillage);
+            consommateursEnAttente.fetch_sub(1);
+            if (retire)
+                break;
+        }
+        _reveiller(producteursEnAttente, placeLiberee);
+        return element;
+    }
+
+    /**
+     * \fn std::size_t FileBornee<T>::capacite() const
+     * \brief Permet de connaître la capacité de la file
+     * \return std::size_t, le nombre maximal d'éléments
+     */
+    template<typename T>
+    std::size_t FileBornee<T>::capacite() const {
+        return masque + 1;
+    }
+
+    /**
+     * \fn bool FileBornee<T>::_essaieEnfiler(const T& element)
+     * \brief Permet d'ajouter un élément sans attendre et sans réveiller personne (le chemin sans verrou)
+     * \param[in] const T& element, l'élément à ajouter
+     * \return bool, true si l'élément a été ajouté, false si la file est pleine
+     */
+    template<typename T>
+    bool FileBornee<T>::_essaieEnfiler(const T& element) {
+        std::size_t position = positionEnfiler.load(std::memory_order_relaxed);
+        for (;;) {
+            Case& caseCourante = cases[position & masque];
+            const std::size_t sequence = caseCourante.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (difference == 0) {
+                if (positionEnfiler.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    caseCourante.valeur = element;
+                    caseCourante.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; //la case n'a pas encore été lue : la file est pleine
+            } else {
+                position = positionEnfiler.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * \fn bool FileBornee<T>::_essaieDefiler(T& element)
+     * \brief Permet de retirer le plus ancien élément sans attendre et sans réveiller personne (le chemin sans verrou)
+     * \param[out] T& element, l'élément retiré
+     * \return bool, true si un élément a été retiré, false si la file est vide
+     */
+    template<typename T>
+    bool FileBornee<T>::_essaieDefiler(T& element) {
+        std::size_t position = positionDefiler.load(std::memory_order_relaxed);
+        for (;;) {
+            Case& caseCourante = cases[position & masque];
+            const std::size_t sequence = caseCourante.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+            if (difference == 0) {
+                if (positionDefiler.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    element = caseCourante.valeur;
+                    caseCourante.sequence.store(position + masque + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; //la case n'a pas encore été écrite : la file est vide
+            } else {
+                position = positionDefiler.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * \fn void FileBornee<T>::_reveiller(std::atomic<int>& enAttente, std::condition_variable& condition)
+     * \brief Permet de réveiller les fils endormis d'un côté de la file après une opération réussie
+     * \param[in] std::atomic<int>& enAttente, le nombre de fils endormis de ce côté
+     * \param[in] std::condition_variable& condition, la condition sur laquelle ils dorment
+     *
+     * La barrière ordonne la publication de la case avant la lecture du compteur (elle répond à celle de enfiler et de
+     * defiler) : si le compteur lu est 0, le fil qui s'apprête à dormir verra la case à son dernier essai. Sans fil
+     * endormi, le verrou n'est pas pris.
+     *
+     */
+    template<typename T>
+    void FileBornee<T>::_reveiller(std::atomic<int>& enAttente, std::condition_variable& condition) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (enAttente.load(std::memory_order_relaxed) == 0)
+            return;
+        std::lock_guard<std::mutex> verrouillage(verrou);
+        condition.notify_all();
+    }
+
+}
+
+#endif /* FILEBORNEE_H_ */
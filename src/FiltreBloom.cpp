@@ -0,0 +1,136 @@
+/**
+ * \file FiltreBloom.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe FiltreBloom
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "FiltreBloom.h"
+
+#include <functional>
+#include <utility>
+
+using namespace std;
+
+// Constante multiplicative (partie fractionnaire du nombre d'or) utilisée pour remélanger le hachage avant d'en extraire les bits
+#define MELANGE_HACHAGE 0x9E3779B97F4A7C15ULL
+
+namespace TP3
+{
+
+    const std::size_t FiltreBloom::BITS_PAR_CLE;
+    const int FiltreBloom::BITS_PAR_MOT;
+    const int FiltreBloom::MOTS_PAR_BLOC;
+
+    /**
+     * \fn FiltreBloom::FiltreBloom()
+     * \brief Constructeur d'un filtre vide, sans bloc
+     */
+    FiltreBloom::FiltreBloom() : bits(), nbBlocs(0), capacite(0) {}
+
+    /**
+     * \fn void FiltreBloom::swap(FiltreBloom &autre)
+     * \brief Permet d'échanger le contenu de deux filtres
+     * \param[in] FiltreBloom &autre, l'autre filtre
+     */
+    void FiltreBloom::swap(FiltreBloom &autre) {
+        bits.swap(autre.bits);
+        std::swap(nbBlocs, autre.nbBlocs);
+        std::swap(capacite, autre.capacite);
+    }
+
+    /**
+     * \fn void FiltreBloom::reinitialiser(std::size_t p_capacitePrevue)
+     * \brief Permet de vider le filtre et de le dimensionner pour un nombre de mots
+     * \param[in] std::size_t p_capacitePrevue, le nombre de mots prévu
+     *
+     * Les blocs sont réalloués à la bonne taille : un filtre redimensionné pour moins de mots rend sa mémoire.
+     *
+     */
+    void FiltreBloom::reinitialiser(std::size_t p_capacitePrevue) {
+        const size_t bitsParBloc = MOTS_PAR_BLOC * 64;
+        capacite = p_capacitePrevue;
+        nbBlocs = (capacite * BITS_PAR_CLE + bitsParBloc - 1) / bitsParBloc;
+        if (nbBlocs == 0)
+            nbBlocs = 1;
+        vector<uint64_t>(nbBlocs * MOTS_PAR_BLOC, 0).swap(bits);
+    }
+
+    /**
+     * \fn void FiltreBloom::ajouter(const std::string &mot)
+     * \brief Permet d'ajouter un mot au filtre
+     * \param[in] const std::string &mot, le mot à ajouter
+     * \pre le filtre a été réinitialisé au moins une fois
+     *
+     * Le hachage remélangé fournit 7 positions de 9 bits (0 à 511) dans le bloc choisi.
+     *
+     */
+    void FiltreBloom::ajouter(const std::string &mot) {
+        const uint64_t hachage = hash<string>()(mot);
+        uint64_t* bloc = &bits[_bloc(hachage) * MOTS_PAR_BLOC];
+        uint64_t positions = hachage * MELANGE_HACHAGE;
+        for (int i = 0; i < BITS_PAR_MOT; i++, positions >>= 9)
+            bloc[(positions >> 6) & (MOTS_PAR_BLOC - 1)] |= static_cast<uint64_t>(1) << (positions & 63);
+    }
+
+    /**
+     * \fn bool FiltreBloom::peutContenir(const std::string &mot) const
+     * \brief Permet de vérifier si un mot peut être dans le filtre
+     * \param[in] const std::string &mot, le mot à vérifier
+     * \return bool, false si le mot n'a certainement pas été ajouté, true s'il l'a peut-être été
+     *
+     * On construit le masque des 8 mots du bloc, puis on les compare tous : la boucle ne dépend pas des données,
+     * sans branchement imprévisible.
+     *
+     */
+    bool FiltreBloom::peutContenir(const std::string &mot) const {
+        if (nbBlocs == 0)
+            return false;
+
+        const uint64_t hachage = hash<string>()(mot);
+        const uint64_t* bloc = &bits[_bloc(hachage) * MOTS_PAR_BLOC];
+        uint64_t masque[MOTS_PAR_BLOC] = { 0 };
+        uint64_t positions = hachage * MELANGE_HACHAGE;
+        for (int i = 0; i < BITS_PAR_MOT; i++, positions >>= 9)
+            masque[(positions >> 6) & (MOTS_PAR_BLOC - 1)] |= static_cast<uint64_t>(1) << (positions & 63);
+
+        uint64_t manquants = 0;
+        for (int i = 0; i < MOTS_PAR_BLOC; i++)
+            manquants |= masque[i] & ~bloc[i];
+        return manquants == 0;
+    }
+
+    /**
+     * \fn std::size_t FiltreBloom::capacitePrevue() const
+     * \brief Permet de connaître le nombre de mots pour lequel le filtre a été dimensionné
+     * \return std::size_t, la capacité prévue
+     */
+    std::size_t FiltreBloom::capacitePrevue() const {
+        return capacite;
+    }
+
+    /**
+     * \fn std::size_t FiltreBloom::empreinteMemoire() const
+     * \brief Permet de connaître la mémoire occupée par les blocs
+     * \return std::size_t, le nombre d'octets alloués
+     */
+    std::size_t FiltreBloom::empreinteMemoire() const {
+        return bits.capacity() * sizeof(uint64_t);
+    }
+
+    /**
+     * \fn std::size_t FiltreBloom::_bloc(std::uint64_t hachage) const
+     * \brief Permet de choisir le bloc d'un hachage
+     * \param[in] std::uint64_t hachage, le hachage du mot
+     * \return std::size_t, l'indice du bloc
+     *
+     * On utilise la réduction multiplicative des 32 bits de poids fort (sans division) : nbBlocs n'a pas à être une puissance de 2.
+     *
+     */
+    std::size_t FiltreBloom::_bloc(std::uint64_t hachage) const {
+        return static_cast<size_t>(((hachage >> 32) * static_cast<uint64_t>(nbBlocs)) >> 32);
+    }
+
+}//Fin du namespace
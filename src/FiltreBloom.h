@@ -0,0 +1,83 @@
+/**
+ * \file FiltreBloom.h
+ * \brief Ce fichier contient l'interface d'un filtre de Bloom par blocs (un bloc de 512 bits par mot).
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef FILTREBLOOM_H_
+#define FILTREBLOOM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TP3
+{
+
+/**
+ * \class FiltreBloom
+ * \brief Filtre probabiliste d'appartenance : "absent" est certain, "peut-être présent" peut être un faux positif
+ *
+ *  Le filtre est découpé en blocs de 512 bits (la taille d'une ligne de cache). Le hachage d'un mot choisit un seul
+ *  bloc, puis BITS_PAR_MOT bits dans ce bloc : une consultation ne touche donc qu'un bloc. On vise BITS_PAR_CLE bits
+ *  par mot prévu, ce qui donne environ 1 % de faux positifs.
+ *
+ *  On ne peut pas retirer un mot d'un filtre de Bloom : après des suppressions, il faut le reconstruire.
+ *
+ *  Attributs:
+ *      - std::vector<std::uint64_t> bits, les blocs, MOTS_PAR_BLOC mots de 64 bits par bloc
+ *      - std::size_t nbBlocs, le nombre de blocs
+ *      - std::size_t capacitePrevue, le nombre de mots pour lequel le filtre a été dimensionné
+ *
+ */
+class FiltreBloom
+{
+public:
+
+	//Nombre de bits visés par mot et nombre de bits mis à 1 par mot
+	static const std::size_t BITS_PAR_CLE = 10;
+	static const int BITS_PAR_MOT = 7;
+
+	//Constructeur d'un filtre vide, sans bloc : il ne contient rien
+	FiltreBloom();
+
+	//Échanger le contenu de deux filtres
+	void swap(FiltreBloom& autre);
+
+	//Vider le filtre et le redimensionner pour 'capacitePrevue' mots
+	void reinitialiser(std::size_t p_capacitePrevue);
+
+	//Ajouter un mot
+	void ajouter(const std::string& mot);
+
+	//Vérifier si le mot peut être présent. false garantit que le mot n'a jamais été ajouté depuis la réinitialisation.
+	bool peutContenir(const std::string& mot) const;
+
+	//Nombre de mots pour lequel le filtre a été dimensionné
+	std::size_t capacitePrevue() const;
+
+	//Octets occupés par les blocs
+	std::size_t empreinteMemoire() const;
+
+private:
+
+    static const int MOTS_PAR_BLOC = 8;
+
+    std::vector<std::uint64_t> bits;
+    std::size_t nbBlocs;
+    std::size_t capacite;
+
+    //region private methods
+
+    std::size_t _bloc(std::uint64_t hachage) const;
+
+    //endregion
+};
+
+}
+
+#endif /* FILTREBLOOM_H_ */
@@ -0,0 +1,305 @@
+/**
+ * \file HistogrammeLatence.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe HistogrammeLatence
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "HistogrammeLatence.h"
+
+#include <string>
+#include <utility>
+
+using namespace std;
+
+// Plus petite et plus grande puissance de 2 (en nanosecondes) exportées comme borne 'le' Prometheus
+#define PUISSANCE_MIN_EXPORTEE 7
+#define PUISSANCE_MAX_EXPORTEE 36
+
+namespace TP3
+{
+
+    namespace
+    {
+        std::atomic<unsigned long long> prochainIdentifiant(1);
+
+        /**
+         * \struct Emplacements
+         * \brief Emplacements libres des histogrammes détruits, et nombre d'emplacements déjà donnés
+         */
+        struct Emplacements
+        {
+            std::mutex verrou;
+            std::vector<std::size_t> libres;
+            std::size_t nombre = 0;
+        };
+
+        //Jamais détruit : un histogramme statique peut encore rendre son emplacement pendant la fin du programme
+        Emplacements& emplacements() {
+            static Emplacements* instance = new Emplacements();
+            return *instance;
+        }
+
+        std::size_t prendreEmplacement() {
+            Emplacements& tous = emplacements();
+            lock_guard<mutex> verrouillage(tous.verrou);
+            if (tous.libres.empty())
+                return tous.nombre++;
+            const std::size_t emplacement = tous.libres.back();
+            tous.libres.pop_back();
+            return emplacement;
+        }
+
+        void rendreEmplacement(std::size_t emplacement) {
+            Emplacements& tous = emplacements();
+            lock_guard<mutex> verrouillage(tous.verrou);
+            tous.libres.push_back(emplacement);
+        }
+
+        /**
+         * \fn std::string secondesExactes(std::uint64_t nanosecondes)
+         * \brief Écrit une durée en secondes, en décimal exact (au plus 9 décimales, sans zéros inutiles)
+         *
+         * Le calcul se fait sur les entiers : le texte ne dépend ni de la précision d'un double ni des réglages du flux.
+         *
+         */
+        std::string secondesExactes(std::uint64_t nanosecondes) {
+            std::string texte = to_string(nanosecondes / 1000000000ULL);
+            std::string decimales = to_string(nanosecondes % 1000000000ULL);
+            decimales.insert(0, 9 - decimales.size(), '0');
+            decimales.erase(decimales.find_last_not_of('0') + 1);
+            if (!decimales.empty())
+                texte += '.' + decimales;
+            return texte;
+        }
+    }
+
+    const int HistogrammeLatence::SOUS_CASES_PAR_PUISSANCE;
+    const int HistogrammeLatence::NB_CASES;
+
+    /**
+     * \fn HistogrammeLatence::Fragment::Fragment()
+     * \brief Constructeur d'un fragment dont toutes les cases sont à 0
+     */
+    HistogrammeLatence::Fragment::Fragment() : somme(0), nombre(0) {
+        for (int i = 0; i < NB_CASES; i++)
+            cases[i].store(0, memory_order_relaxed);
+    }
+
+    /**
+     * \fn HistogrammeLatence::HistogrammeLatence()
+     * \brief Constructeur d'un histogramme vide. Aucun fragment n'est alloué avant le premier enregistrement.
+     */
+    HistogrammeLatence::HistogrammeLatence() : identifiant(prochainIdentifiant++), emplacement(prendreEmplacement()), verrou(),
+                                               fragments() {}
+
+    /**
+     * \fn HistogrammeLatence::HistogrammeLatence(const HistogrammeLatence &autre)
+     * \brief Constructeur de copie. La copie est un nouvel histogramme vide avec son propre identifiant.
+     */
+    HistogrammeLatence::HistogrammeLatence(const HistogrammeLatence &) : HistogrammeLatence() {}
+
+    /**
+     * \fn HistogrammeLatence::~HistogrammeLatence()
+     * \brief Destructeur, libère les fragments de tous les fils et rend l'emplacement
+     * \note l'histogramme ne doit plus être utilisé par aucun fil lors de sa destruction
+     *
+     * Les entrées des fils qui désignent ces fragments restent dans leur table, mais portent l'ancien identifiant : le
+     * prochain histogramme du même emplacement les remplace au lieu de les utiliser.
+     *
+     */
+    HistogrammeLatence::~HistogrammeLatence() {
+        for (Fragment* fragment : fragments)
+            delete fragment;
+        rendreEmplacement(emplacement);
+    }
+
+    /**
+     * \fn void HistogrammeLatence::enregistrer(std::uint64_t nanosecondes)
+     * \brief Permet d'enregistrer une durée
+     * \param[in] std::uint64_t nanosecondes, la durée mesurée
+     *
+     * Le fragment du fil courant n'a qu'un écrivain : un chargement suivi d'un stockage relâchés suffit, sans verrou.
+     *
+     */
+    void HistogrammeLatence::enregistrer(std::uint64_t nanosecondes) {
+        Fragment* fragment = _fragmentLocal();
+        std::atomic<std::uint64_t>& compte = fragment->cases[indiceCase(nanosecondes)];
+        compte.store(compte.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        fragment->somme.store(fragment->somme.load(memory_order_relaxed) + nanosecondes, memory_order_relaxed);
+        fragment->nombre.store(fragment->nombre.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    }
+
+    /**
+     * \fn std::uint64_t HistogrammeLatence::nombre() const
+     * \brief Permet de connaître le nombre de durées enregistrées, tous fils confondus
+     * \return std::uint64_t, le nombre de durées
+     */
+    std::uint64_t HistogrammeLatence::nombre() const {
+        lock_guard<mutex> verrouillage(verrou);
+        std::uint64_t total = 0;
+        for (const Fragment* fragment : fragments)
+            total += fragment->nombre.load(memory_order_relaxed);
+        return total;
+    }
+
+    /**
+     * \fn std::uint64_t HistogrammeLatence::somme() const
+     * \brief Permet de connaître la somme des durées enregistrées, tous fils confondus
+     * \return std::uint64_t, la somme en nanosecondes
+     */
+    std::uint64_t HistogrammeLatence::somme() const {
+        lock_guard<mutex> verrouillage(verrou);
+        std::uint64_t total = 0;
+        for (const Fragment* fragment : fragments)
+            total += fragment->somme.load(memory_order_relaxed);
+        return total;
+    }
+
+    /**
+     * \fn std::uint64_t HistogrammeLatence::quantile(double q) const
+     * \brief Permet d'estimer un quantile des durées enregistrées
+     * \param[in] double q, le quantile voulu, entre 0 et 1 (0.99 pour le 99e centile)
+     * \return std::uint64_t, la borne supérieure de la case qui contient le quantile, 0 si l'histogramme est vide
+     */
+    std::uint64_t HistogrammeLatence::quantile(double q) const {
+        vector<std::uint64_t> cases(NB_CASES, 0);
+        _additionnerCases(cases);
+
+        std::uint64_t total = 0;
+        for (std::uint64_t compte : cases)
+            total += compte;
+        if (total == 0)
+            return 0;
+
+        std::uint64_t rang = static_cast<std::uint64_t>(q * total);
+        if (rang >= total)
+            rang = total - 1;
+
+        std::uint64_t cumul = 0;
+        for (int i = 0; i < NB_CASES; i++) {
+            cumul += cases[i];
+            if (cumul > rang)
+                return borneSuperieure(i);
+        }
+        return borneSuperieure(NB_CASES - 1);
+    }
+
+    /**
+     * \fn void HistogrammeLatence::exportePrometheus(std::ostream &sortie, const std::string &nomMetrique, const std::string &etiquettes) const
+     * \brief Permet d'écrire l'histogramme au format d'exposition texte Prometheus
+     * \param[in] std::ostream &sortie, le flux où écrire
+     * \param[in] const std::string &nomMetrique, le nom de la famille (sans suffixe _bucket, _sum, _count)
+     * \param[in] const std::string &etiquettes, les étiquettes à ajouter à chaque ligne, sans accolades
+     *
+     * Les lignes # HELP et # TYPE sont la responsabilité de l'appelant, puisqu'elles ne doivent apparaître qu'une fois par famille.
+     * Les bornes 'le' exportées sont les puissances de 2 de 128 ns à environ 69 s, en secondes, suivies de +Inf.
+     * Comme les cases internes sont plus fines, chaque borne exportée correspond exactement à une frontière de case.
+     * Les bornes et la somme sont écrites en décimal exact (128 ns donne 0.000000128), quels que soient les réglages du flux.
+     *
+     */
+    void HistogrammeLatence::exportePrometheus(std::ostream &sortie, const std::string &nomMetrique, const std::string &etiquettes) const {
+        vector<std::uint64_t> cases(NB_CASES, 0);
+        std::uint64_t sommeNanosecondes = 0;
+        {
+            lock_guard<mutex> verrouillage(verrou);
+            for (const Fragment* fragment : fragments)
+                sommeNanosecondes += fragment->somme.load(memory_order_relaxed);
+        }
+        _additionnerCases(cases);
+
+        const string separateur = etiquettes.empty() ? "" : ",";
+        std::uint64_t cumul = 0;
+        int indice = 0;
+        for (int puissance = PUISSANCE_MIN_EXPORTEE; puissance <= PUISSANCE_MAX_EXPORTEE; puissance++) {
+            const std::uint64_t borne = static_cast<std::uint64_t>(1) << puissance;
+            while (indice < NB_CASES && borneSuperieure(indice) <= borne)
+                cumul += cases[indice++];
+            sortie << nomMetrique << "_bucket{" << etiquettes << separateur << "le=\"" << secondesExactes(borne) << "\"} " << cumul << '\n';
+        }
+        while (indice < NB_CASES)
+            cumul += cases[indice++];
+
+        sortie << nomMetrique << "_bucket{" << etiquettes << separateur << "le=\"+Inf\"} " << cumul << '\n';
+        sortie << nomMetrique << "_sum{" << etiquettes << "} " << secondesExactes(sommeNanosecondes) << '\n';
+        sortie << nomMetrique << "_count{" << etiquettes << "} " << cumul << '\n';
+    }
+
+    /**
+     * \fn int HistogrammeLatence::indiceCase(std::uint64_t nanosecondes)
+     * \brief Permet de trouver la case d'une durée
+     * \param[in] std::uint64_t nanosecondes, la durée
+     * \return int, l'indice de la case
+     *
+     * Les durées de 0 à 7 ns ont chacune leur case. Au-delà, pour une durée dans [2^m, 2^(m+1)[, les 3 bits qui suivent le bit
+     * de poids fort choisissent la sous-case : indice = (m - 2) * 8 + sous-case.
+     *
+     */
+    int HistogrammeLatence::indiceCase(std::uint64_t nanosecondes) {
+        if (nanosecondes < SOUS_CASES_PAR_PUISSANCE)
+            return static_cast<int>(nanosecondes);
+
+        int puissance = 63 - __builtin_clzll(nanosecondes);
+        int sousCase = static_cast<int>((nanosecondes >> (puissance - 3)) & (SOUS_CASES_PAR_PUISSANCE - 1));
+        return (puissance - 2) * SOUS_CASES_PAR_PUISSANCE + sousCase;
+    }
+
+    /**
+     * \fn std::uint64_t HistogrammeLatence::borneSuperieure(int indice)
+     * \brief Permet de connaître la borne supérieure (exclue) d'une case
+     * \param[in] int indice, l'indice de la case
+     * \return std::uint64_t, la plus petite durée, en nanosecondes, qui n'appartient plus à la case
+     */
+    std::uint64_t HistogrammeLatence::borneSuperieure(int indice) {
+        if (indice < SOUS_CASES_PAR_PUISSANCE)
+            return static_cast<std::uint64_t>(indice) + 1;
+
+        int puissance = indice / SOUS_CASES_PAR_PUISSANCE + 2;
+        std::uint64_t sousCase = static_cast<std::uint64_t>(indice % SOUS_CASES_PAR_PUISSANCE);
+        if (puissance == 63 && sousCase == SOUS_CASES_PAR_PUISSANCE - 1)
+            return UINT64_MAX;
+        return (SOUS_CASES_PAR_PUISSANCE + sousCase + 1) << (puissance - 3);
+    }
+
+    /**
+     * \fn HistogrammeLatence::Fragment* HistogrammeLatence::_fragmentLocal()
+     * \brief Permet de trouver (ou de créer au premier appel) le fragment du fil courant
+     * \return HistogrammeLatence::Fragment*, le fragment du fil courant
+     *
+     * Chaque fil garde une table emplacement -> (identifiant, fragment). Les identifiants ne sont jamais réutilisés : une
+     * entrée laissée par un histogramme détruit porte un autre identifiant et est remplacée, sans être lue.
+     *
+     */
+    HistogrammeLatence::Fragment* HistogrammeLatence::_fragmentLocal() {
+        static thread_local vector<pair<unsigned long long, Fragment*> > fragmentsDuFil;
+
+        if (emplacement < fragmentsDuFil.size() && fragmentsDuFil[emplacement].first == identifiant)
+            return fragmentsDuFil[emplacement].second;
+
+        Fragment* fragment = new Fragment();
+        {
+            lock_guard<mutex> verrouillage(verrou);
+            fragments.push_back(fragment);
+        }
+        if (emplacement >= fragmentsDuFil.size())
+            fragmentsDuFil.resize(emplacement + 1, make_pair(0ULL, nullptr));
+        fragmentsDuFil[emplacement] = make_pair(identifiant, fragment);
+        return fragment;
+    }
+
+    /**
+     * \fn void HistogrammeLatence::_additionnerCases(std::vector<std::uint64_t> &cases) const
+     * \brief Permet d'additionner les cases de tous les fragments
+     * \param[out] std::vector<std::uint64_t> &cases, les totaux par case (NB_CASES éléments)
+     */
+    void HistogrammeLatence::_additionnerCases(std::vector<std::uint64_t> &cases) const {
+        lock_guard<mutex> verrouillage(verrou);
+        for (const Fragment* fragment : fragments) {
+            for (int i = 0; i < NB_CASES; i++)
+                cases[i] += fragment->cases[i].load(memory_order_relaxed);
+        }
+    }
+
+}//Fin du namespace
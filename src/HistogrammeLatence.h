@@ -0,0 +1,144 @@
+/**
+ * \file HistogrammeLatence.h
+ * \brief Ce fichier contient l'interface d'un histogramme de latences à précision relative constante (style HDR).
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef HISTOGRAMMELATENCE_H_
+#define HISTOGRAMMELATENCE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifdef TP3_INSTRUMENTATION
+#define TP3_CONCATENER_(a, b) a##b
+#define TP3_CONCATENER(a, b) TP3_CONCATENER_(a, b)
+#define TP3_CHRONOMETRER(histogramme) TP3::ChronometreLatence TP3_CONCATENER(chronometre_, __LINE__)(histogramme)
+#else
+#define TP3_CHRONOMETRER(histogramme) ((void)0)
+#endif
+
+namespace TP3
+{
+
+/**
+ * \class HistogrammeLatence
+ * \brief Histogramme de durées en nanosecondes, avec cases log-linéaires et fragments par fil d'exécution
+ *
+ *  Chaque puissance de 2 est découpée en 8 sous-cases, ce qui garantit une erreur relative d'au plus 12,5 % sur
+ *  toute la plage de 1 ns à 2^64 ns. Chaque fil d'exécution écrit dans son propre fragment (un seul écrivain par
+ *  fragment), l'enregistrement se fait donc sans verrou ni instruction atomique de type lire-modifier-écrire.
+ *  Le verrou n'est pris que la première fois qu'un fil enregistre dans l'histogramme, ou lors d'une lecture.
+ *
+ *  Chaque histogramme vivant a un emplacement, un petit entier rendu à sa destruction et réutilisé par un histogramme
+ *  suivant : un fil retrouve son fragment en O(1) dans sa table indexée par emplacement, dont la taille est bornée par
+ *  le nombre maximal d'histogrammes vivants en même temps (et non par le nombre d'histogrammes créés).
+ *
+ *  Attributs:
+ *      - const unsigned long long identifiant, identifiant unique, qui distingue les histogrammes successifs d'un même emplacement
+ *      - const std::size_t emplacement, indice de l'histogramme dans la table de fragments de chaque fil
+ *      - std::vector<Fragment*> fragments, un fragment par fil ayant enregistré au moins une durée
+ *
+ */
+class HistogrammeLatence
+{
+public:
+
+	static const int SOUS_CASES_PAR_PUISSANCE = 8;
+	static const int NB_CASES = 62 * SOUS_CASES_PAR_PUISSANCE;
+
+	//Constructeur d'un histogramme vide
+	HistogrammeLatence();
+
+	//Une copie est un nouvel histogramme vide : les mesures appartiennent à l'instance mesurée
+	HistogrammeLatence(const HistogrammeLatence& autre);
+	HistogrammeLatence& operator=(const HistogrammeLatence& autre) = delete;
+
+	//Destructeur, libère les fragments de tous les fils
+	~HistogrammeLatence();
+
+	//Enregistrer une durée en nanosecondes
+	void enregistrer(std::uint64_t nanosecondes);
+
+	//Nombre de durées enregistrées
+	std::uint64_t nombre() const;
+
+	//Somme des durées enregistrées, en nanosecondes
+	std::uint64_t somme() const;
+
+	//Borne supérieure (en nanosecondes) de la case qui contient le quantile q (entre 0 et 1). 0 si l'histogramme est vide.
+	std::uint64_t quantile(double q) const;
+
+	//Écrire les lignes _bucket, _sum et _count de l'histogramme au format d'exposition texte Prometheus (en secondes)
+	//Les étiquettes sont données sans accolades, par exemple : operation="traduit"
+	void exportePrometheus(std::ostream& sortie, const std::string& nomMetrique, const std::string& etiquettes) const;
+
+	//Indice de la case d'une durée et borne supérieure exclue d'une case
+	static int indiceCase(std::uint64_t nanosecondes);
+	static std::uint64_t borneSuperieure(int indice);
+
+private:
+
+    /**
+     * \struct Fragment
+     * \brief Cases d'un seul fil d'exécution. Seul ce fil écrit, les lecteurs font des lectures atomiques relâchées.
+     */
+    struct Fragment
+    {
+        std::atomic<std::uint64_t> cases[NB_CASES];
+        std::atomic<std::uint64_t> somme;
+        std::atomic<std::uint64_t> nombre;
+
+        Fragment();
+    };
+
+    const unsigned long long identifiant;
+    const std::size_t emplacement;
+    mutable std::mutex verrou;
+    std::vector<Fragment*> fragments;
+
+    //region private methods
+
+    Fragment* _fragmentLocal();
+    void _additionnerCases(std::vector<std::uint64_t>& cases) const;
+
+    //endregion
+};
+
+/**
+ * \class ChronometreLatence
+ * \brief Mesure la durée de sa propre portée et l'enregistre dans un histogramme à sa destruction
+ */
+class ChronometreLatence
+{
+public:
+
+	explicit ChronometreLatence(HistogrammeLatence& p_histogramme) :
+	        histogramme(p_histogramme), debut(std::chrono::steady_clock::now()) {}
+
+	~ChronometreLatence() {
+	    std::chrono::steady_clock::duration duree = std::chrono::steady_clock::now() - debut;
+	    histogramme.enregistrer(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duree).count()));
+	}
+
+	ChronometreLatence(const ChronometreLatence&) = delete;
+	ChronometreLatence& operator=(const ChronometreLatence&) = delete;
+
+private:
+
+    HistogrammeLatence& histogramme;
+    std::chrono::steady_clock::time_point debut;
+};
+
+}
+
+#endif /* HISTOGRAMMELATENCE_H_ */
@@ -0,0 +1,296 @@
+/**
+ * \file IndexHachage.h
+ * \brief Ce fichier contient l'interface et l'implantation d'un index de hachage à adressage ouvert (Robin Hood).
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef INDEXHACHAGE_H_
+#define INDEXHACHAGE_H_
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <utility>
+#include <cstddef>
+
+namespace TP3
+{
+
+/**
+ * \class IndexHachage
+ * \brief Index de hachage à adressage ouvert (Robin Hood) associant un mot au noeud qui le contient.
+ *
+ *  Le type Noeud doit exposer un attribut public 'mot' de type std::string. L'index ne possède pas les noeuds,
+ *  il ne conserve que leur adresse (poignée) et le hachage de leur mot.
+ *
+ *  Attributs:
+ *      - std::vector<Case> cases, la table (taille puissance de 2)
+ *      - std::size_t nbElements, nombre de poignées dans la table
+ *
+ */
+template<typename Noeud>
+class IndexHachage
+{
+public:
+
+	//Constructeur d'un index vide
+	IndexHachage();
+
+	//Ajouter la poignée d'un noeud, indexée par le mot qu'il contient. Si le mot est déjà indexé, la poignée est remplacée.
+	void inserer(Noeud* noeud);
+
+	//Retirer le mot de l'index. Si le mot n'est pas indexé, on ne fait rien.
+	void retirer(const std::string& mot);
+
+	//Trouver le noeud qui contient le mot. On retourne nullptr si le mot n'est pas indexé.
+	Noeud* trouver(const std::string& mot) const;
+
+	//Vider l'index et libérer la table
+	void vider();
+
+	//Nombre de mots indexés
+	std::size_t taille() const;
+
+	//Nombre de cases allouées dans la table
+	std::size_t capacite() const;
+
+	//Octets occupés par la table
+	std::size_t empreinteMemoire() const;
+
+private:
+
+    /**
+     * \struct Case
+     * \brief Une case de la table : le hachage complet du mot et la poignée du noeud (nullptr si la case est libre)
+     */
+    struct Case
+    {
+        std::size_t hachage;
+        Noeud* noeud;
+    };
+
+    std::vector<Case> cases;
+    std::size_t nbElements;
+
+    static const std::size_t CAPACITE_INITIALE = 16;
+
+    //region private methods
+
+    std::size_t _distance(std::size_t position, std::size_t hachage) const;
+    void _agrandir();
+    void _placer(Case caseAplacer);
+
+    //endregion
+};
+
+    template<typename Noeud>
+    const std::size_t IndexHachage<Noeud>::CAPACITE_INITIALE;
+
+    /**
+     * \fn IndexHachage<Noeud>::IndexHachage()
+     * \brief Constructeur d'un index vide. La table n'est allouée qu'au premier ajout.
+     */
+    template<typename Noeud>
+    IndexHachage<Noeud>::IndexHachage() : cases(), nbElements(0) {}
+
+    /**
+     * \fn void IndexHachage<Noeud>::inserer(Noeud* noeud)
+     * \brief Permet d'ajouter (ou de remplacer) la poignée du noeud qui contient noeud->mot
+     * \param[in] Noeud* noeud, le noeud à indexer
+     *
+     * La table est agrandie (double) quand le facteur de charge dépasserait 7/8.
+     *
+     */
+    template<typename Noeud>
+    void IndexHachage<Noeud>::inserer(Noeud* noeud) {
+        const std::size_t hachage = std::hash<std::string>()(noeud->mot);
+        if (!cases.empty()) {
+            const std::size_t masque = cases.size() - 1;
+            for (std::size_t position = hachage & masque, distance = 0; cases[position].noeud != nullptr; position = (position + 1) & masque, distance++) {
+                if (_distance(position, cases[position].hachage) < distance)
+                    break;
+                if (cases[position].hachage == hachage && cases[position].noeud->mot == noeud->mot) {
+                    cases[position].noeud = noeud; //mot déjà indexé, on remplace la poignée
+                    return;
+                }
+            }
+        }
+
+        if ((nbElements + 1) * 8 > cases.size() * 7)
+            _agrandir();
+
+        Case nouvelleCase = { hachage, noeud };
+        _placer(nouvelleCase);
+        nbElements++;
+    }
+
+    /**
+     * \fn void IndexHachage<Noeud>::retirer(const std::string& mot)
+     * \brief Permet de retirer un mot de l'index
+     * \param[in] const std::string& mot, le mot à retirer
+     *
+     * On utilise la suppression par décalage arrière (backward shift) : les cases qui suivent sont reculées d'une position
+     * jusqu'à la première case libre ou déjà à sa position idéale. Aucune pierre tombale n'est laissée dans la table.
+     *
+     */
+    template<typename Noeud>
+    void IndexHachage<Noeud>::retirer(const std::string& mot) {
+        if (cases.empty())
+            return;
+
+        const std::size_t masque = cases.size() - 1;
+        const std::size_t hachage = std::hash<std::string>()(mot);
+        std::size_t position = hachage & masque;
+
+        for (std::size_t distance = 0; ; position = (position + 1) & masque, distance++) {
+            if (cases[position].noeud == nullptr || _distance(position, cases[position].hachage) < distance)
+                return; //pas dans l'index
+            if (cases[position].hachage == hachage && cases[position].noeud->mot == mot)
+                break;
+        }
+
+        std::size_t suivante = (position + 1) & masque;
+        while (cases[suivante].noeud != nullptr && _distance(suivante, cases[suivante].hachage) > 0) {
+            cases[position] = cases[suivante];
+            position = suivante;
+            suivante = (suivante + 1) & masque;
+        }
+        cases[position].noeud = nullptr;
+        nbElements--;
+    }
+
+    /**
+     * \fn Noeud* IndexHachage<Noeud>::trouver(const std::string& mot) const
+     * \brief Permet de trouver le noeud qui contient un mot
+     * \param[in] const std::string& mot, le mot à trouver
+     * \return Noeud*, la poignée du noeud, nullptr si le mot n'est pas indexé
+     *
+     * Le hachage complet est comparé avant le mot, la comparaison de chaînes n'est donc faite qu'en cas de collision réelle.
+     * La recherche s'arrête dès qu'on croise une case plus proche de sa position idéale que le mot cherché (invariant Robin Hood).
+     *
+     */
+    template<typename Noeud>
+    Noeud* IndexHachage<Noeud>::trouver(const std::string& mot) const {
+        if (cases.empty())
+            return nullptr;
+
+        const std::size_t masque = cases.size() - 1;
+        const std::size_t hachage = std::hash<std::string>()(mot);
+
+        for (std::size_t position = hachage & masque, distance = 0; cases[position].noeud != nullptr; position = (position + 1) & masque, distance++) {
+            if (_distance(position, cases[position].hachage) < distance)
+                return nullptr;
+            if (cases[position].hachage == hachage && cases[position].noeud->mot == mot)
+                return cases[position].noeud;
+        }
+        return nullptr;
+    }
+
+    /**
+     * \fn void IndexHachage<Noeud>::vider()
+     * \brief Permet de vider l'index et de libérer la mémoire de la table
+     */
+    template<typename Noeud>
+    void IndexHachage<Noeud>::vider() {
+        std::vector<Case>().swap(cases);
+        nbElements = 0;
+    }
+
+    /**
+     * \fn std::size_t IndexHachage<Noeud>::taille() const
+     * \brief Permet de connaître le nombre de mots indexés
+     * \return std::size_t, le nombre de mots indexés
+     */
+    template<typename Noeud>
+    std::size_t IndexHachage<Noeud>::taille() const {
+        return nbElements;
+    }
+
+    /**
+     * \fn std::size_t IndexHachage<Noeud>::capacite() const
+     * \brief Permet de connaître le nombre de cases de la table
+     * \return std::size_t, le nombre de cases allouées
+     */
+    template<typename Noeud>
+    std::size_t IndexHachage<Noeud>::capacite() const {
+        return cases.size();
+    }
+
+    /**
+     * \fn std::size_t IndexHachage<Noeud>::empreinteMemoire() const
+     * \brief Permet de connaître la mémoire occupée par la table
+     * \return std::size_t, le nombre d'octets alloués pour les cases
+     */
+    template<typename Noeud>
+    std::size_t IndexHachage<Noeud>::empreinteMemoire() const {
+        return cases.capacity() * sizeof(Case);
+    }
+
+    /**
+     * \fn std::size_t IndexHachage<Noeud>::_distance(std::size_t position, std::size_t hachage) const
+     * \brief Permet de calculer la distance entre une case et la position idéale d'un hachage
+     * \param[in] std::size_t position, la position de la case
+     * \param[in] std::size_t hachage, le hachage de l'élément dans la case
+     * \return std::size_t, le nombre de cases de décalage
+     */
+    template<typename Noeud>
+    std::size_t IndexHachage<Noeud>::_distance(std::size_t position, std::size_t hachage) const {
+        const std::size_t masque = cases.size() - 1;
+        return (position - (hachage & masque)) & masque;
+    }
+
+    /**
+     * \fn void IndexHachage<Noeud>::_agrandir()
+     * \brief Permet de doubler la taille de la table et de replacer toutes les poignées
+     */
+    template<typename Noeud>
+    void IndexHachage<Noeud>::_agrandir() {
+        std::vector<Case> anciennesCases;
+        anciennesCases.swap(cases);
+
+        std::size_t nouvelleCapacite = CAPACITE_INITIALE;
+        if (!anciennesCases.empty())
+            nouvelleCapacite = anciennesCases.size() * 2;
+
+        Case caseLibre = { 0, nullptr };
+        cases.assign(nouvelleCapacite, caseLibre);
+
+        for (const auto & ancienneCase : anciennesCases) {
+            if (ancienneCase.noeud != nullptr)
+                _placer(ancienneCase);
+        }
+    }
+
+    /**
+     * \fn void IndexHachage<Noeud>::_placer(Case caseAplacer)
+     * \brief Permet de placer une case dans la table selon la stratégie Robin Hood
+     * \param[in] Case caseAplacer, la case à placer
+     * \pre la table contient au moins une case libre et le mot n'y est pas déjà
+     *
+     * Quand la case à placer est plus loin de sa position idéale que l'occupant, on prend sa place et on continue avec l'occupant.
+     *
+     */
+    template<typename Noeud>
+    void IndexHachage<Noeud>::_placer(Case caseAplacer) {
+        const std::size_t masque = cases.size() - 1;
+        std::size_t position = caseAplacer.hachage & masque;
+        std::size_t distance = 0;
+
+        while (cases[position].noeud != nullptr) {
+            std::size_t distanceOccupant = _distance(position, cases[position].hachage);
+            if (distanceOccupant < distance) {
+                std::swap(caseAplacer, cases[position]);
+                distance = distanceOccupant;
+            }
+            position = (position + 1) & masque;
+            distance++;
+        }
+        cases[position] = caseAplacer;
+    }
+
+}
+
+#endif /* INDEXHACHAGE_H_ */
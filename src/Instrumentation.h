@@ -0,0 +1,132 @@
+/**
+ * \file Instrumentation.h
+ * \brief Ce fichier contient les compteurs d'opérations et les statistiques de l'arbre du dictionnaire.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ * Les compteurs ne sont incrémentés que si le projet est compilé avec TP3_INSTRUMENTATION (option CMake du même nom).
+ * Sans cette option, la macro TP3_COMPTER ne génère aucun code.
+ *
+ */
+
+#ifndef INSTRUMENTATION_H_
+#define INSTRUMENTATION_H_
+
+#include <atomic>
+#include <cstddef>
+
+#ifdef TP3_INSTRUMENTATION
+#define TP3_COMPTER(compteur, n) ((compteur).fetch_add((n), std::memory_order_relaxed))
+#else
+#define TP3_COMPTER(compteur, n) ((void)0)
+#endif
+
+namespace TP3
+{
+
+/**
+ * \struct CompteursOperations
+ * \brief Compteurs cumulatifs des opérations internes du dictionnaire
+ *
+ *  Les compteurs sont atomiques (ordre relâché) afin de pouvoir être incrémentés par des lectures concurrentes.
+ *
+ *  Attributs:
+ *      - recherches : recherches exactes (appartient, traduit)
+ *      - visitesNoeuds : noeuds visités lors des descentes dans l'arbre
+ *      - appelsLevenshtein : calculs de distance de Levenshtein
+ *      - cellulesLevenshtein : cellules de matrice calculées par Levenshtein
+ *      - rotationsGauche : rotations simples qui font monter un enfant gauche (incluant celles d'une double rotation)
+ *      - rotationsDroite : rotations simples qui font monter un enfant droit (incluant celles d'une double rotation)
+ *      - rotationsDoubles : doubles rotations (zig-zag)
+ *      - allocations : noeuds alloués
+ *      - candidatsSuggestion : candidats évalués par suggereCorrections
+ *      - rejetsFiltreBloom : recherches exactes écartées par le filtre de Bloom, sans descente
+ *
+ */
+struct CompteursOperations
+{
+    std::atomic<unsigned long long> recherches;
+    std::atomic<unsigned long long> visitesNoeuds;
+    std::atomic<unsigned long long> appelsLevenshtein;
+    std::atomic<unsigned long long> cellulesLevenshtein;
+    std::atomic<unsigned long long> rotationsGauche;
+    std::atomic<unsigned long long> rotationsDroite;
+    std::atomic<unsigned long long> rotationsDoubles;
+    std::atomic<unsigned long long> allocations;
+    std::atomic<unsigned long long> candidatsSuggestion;
+    std::atomic<unsigned long long> rejetsFiltreBloom;
+
+    CompteursOperations() {
+        reinitialiser();
+    }
+
+    CompteursOperations(const CompteursOperations& autre) {
+        *this = autre;
+    }
+
+    CompteursOperations& operator=(const CompteursOperations& autre) {
+        recherches.store(autre.recherches.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        visitesNoeuds.store(autre.visitesNoeuds.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        appelsLevenshtein.store(autre.appelsLevenshtein.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        cellulesLevenshtein.store(autre.cellulesLevenshtein.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        rotationsGauche.store(autre.rotationsGauche.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        rotationsDroite.store(autre.rotationsDroite.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        rotationsDoubles.store(autre.rotationsDoubles.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        allocations.store(autre.allocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        candidatsSuggestion.store(autre.candidatsSuggestion.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        rejetsFiltreBloom.store(autre.rejetsFiltreBloom.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    void reinitialiser() {
+        recherches = 0;
+        visitesNoeuds = 0;
+        appelsLevenshtein = 0;
+        cellulesLevenshtein = 0;
+        rotationsGauche = 0;
+        rotationsDroite = 0;
+        rotationsDoubles = 0;
+        allocations = 0;
+        candidatsSuggestion = 0;
+        rejetsFiltreBloom = 0;
+    }
+};
+
+/**
+ * \enum OperationDictionnaire
+ * \brief Opérations publiques du dictionnaire dont la latence est mesurée
+ */
+enum OperationDictionnaire
+{
+    OPERATION_TRADUIT,
+    OPERATION_APPARTIENT,
+    OPERATION_SUGGERE_CORRECTIONS,
+    OPERATION_AJOUTE_MOT,
+    OPERATION_SUPPRIME_MOT,
+    NB_OPERATIONS
+};
+
+/**
+ * \struct StatistiquesArbre
+ * \brief Portrait de la forme et de la taille de l'arbre à un instant donné
+ *
+ *  Attributs:
+ *      - hauteur : hauteur de la racine (-1 si le dictionnaire est vide)
+ *      - nombreMots : nombre de mots (cpt)
+ *      - profondeurMoyenne : profondeur moyenne des noeuds, la racine étant à la profondeur 0
+ *      - empreinteMemoire : octets utilisés par les noeuds, les chaînes et vecteurs hors noeud et les structures facultatives
+ *        (index de hachage, filtre de Bloom, cache de suggestions), soit EmpreinteMemoire::total
+ *
+ */
+struct StatistiquesArbre
+{
+    int hauteur;
+    int nombreMots;
+    double profondeurMoyenne;
+    std::size_t empreinteMemoire;
+};
+
+}
+
+#endif /* INSTRUMENTATION_H_ */
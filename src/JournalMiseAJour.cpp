@@ -0,0 +1,600 @@
+/**
+ * \file JournalMiseAJour.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe JournalMiseAJour
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "JournalMiseAJour.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Taille des blocs lus à la fin du journal pour retrouver la dernière ligne complète, et des blocs écrits dans l'instantané
+#define TAILLE_BLOC_LECTURE 4096
+#define TAILLE_BLOC_INSTANTANE (1 << 20)
+
+using namespace std;
+
+namespace TP3
+{
+
+    /**
+     * \fn JournalMiseAJour::JournalMiseAJour(const std::string &p_chemin, std::chrono::microseconds p_delaiGroupe)
+     * \brief Constructeur d'un journal ouvert en ajout
+     * \param[in] const std::string &p_chemin, le fichier du journal, créé s'il n'existe pas
+     * \param[in] std::chrono::microseconds p_delaiGroupe, l'attente avant chaque synchronisation
+     * \exception runtime_error si le journal ne peut pas être ouvert
+     *
+     * Une dernière ligne incomplète, laissée par un arrêt brutal au milieu d'une écriture, est retirée : les nouveaux
+     * enregistrements ne doivent pas s'y coller.
+     *
+     */
+    JournalMiseAJour::JournalMiseAJour(const std::string &p_chemin, std::chrono::microseconds p_delaiGroupe) :
+            chemin(p_chemin), delaiGroupe(p_delaiGroupe), descripteur(-1), verrou(), conditionTampon(), conditionDurable(),
+            tampon(), sequenceJournalisee(0), sequenceDurable(0), nbSynchronisations(0), erreur(), arretDemande(false),
+            verrouFichier(), filSynchronisation(), filCompaction(), erreurCompaction(), compactionActive(false) {
+        descripteur = open(chemin.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (descripteur < 0)
+            throw runtime_error("impossible d'ouvrir le journal " + chemin + " : " + strerror(errno));
+
+        off_t fin = lseek(descripteur, 0, SEEK_END);
+        off_t finLigne = fin;
+        char bloc[TAILLE_BLOC_LECTURE];
+        while (finLigne > 0) {
+            const off_t debut = finLigne > TAILLE_BLOC_LECTURE ? finLigne - TAILLE_BLOC_LECTURE : 0;
+            const ssize_t lus = pread(descripteur, bloc, static_cast<size_t>(finLigne - debut), debut);
+            if (lus <= 0)
+                break;
+            const void* saut = memrchr(bloc, '\n', static_cast<size_t>(lus));
+            if (saut != nullptr) {
+                finLigne = debut + (static_cast<const char*>(saut) - bloc) + 1;
+                break;
+            }
+            finLigne = debut;
+        }
+        if (finLigne != fin && ftruncate(descripteur, finLigne) != 0) {
+            string message = strerror(errno);
+            close(descripteur);
+            throw runtime_error("impossible de tronquer le journal " + chemin + " : " + message);
+        }
+
+        filSynchronisation = thread(&JournalMiseAJour::_synchroniser, this);
+    }
+
+    /**
+     * \fn JournalMiseAJour::~JournalMiseAJour()
+     * \brief Destructeur : écrit les enregistrements en attente, arrête les fils et ferme le journal
+     */
+    JournalMiseAJour::~JournalMiseAJour() {
+        {
+            lock_guard<mutex> verrouTampon(verrou);
+            arretDemande = true;
+        }
+        conditionTampon.notify_all();
+        filSynchronisation.join();
+        if (filCompaction.joinable())
+            filCompaction.join();
+        close(descripteur);
+    }
+
+    /**
+     * \fn unsigned long long JournalMiseAJour::journaliseAjout(const std::string &mot, const std::string &traduction)
+     * \brief Permet de journaliser l'ajout d'un mot et de l'une de ses traductions
+     * \param[in] const std::string &mot, le mot ajouté
+     * \param[in] const std::string &traduction, la traduction ajoutée
+     * \return unsigned long long, le numéro de séquence, à passer à attendsDurabilite
+     */
+    unsigned long long JournalMiseAJour::journaliseAjout(const std::string &mot, const std::string &traduction) {
+        string enregistrement = "A\t";
+        _echapper(mot, enregistrement);
+        enregistrement += '\t';
+        _echapper(traduction, enregistrement);
+        enregistrement += '\n';
+        return _journaliser(enregistrement);
+    }
+
+    /**
+     * \fn unsigned long long JournalMiseAJour::journaliseSuppression(const std::string &mot)
+     * \brief Permet de journaliser la suppression d'un mot
+     * \param[in] const std::string &mot, le mot supprimé
+     * \return unsigned long long, le numéro de séquence, à passer à attendsDurabilite
+     */
+    unsigned long long JournalMiseAJour::journaliseSuppression(const std::string &mot) {
+        string enregistrement = "S\t";
+        _echapper(mot, enregistrement);
+        enregistrement += '\n';
+        return _journaliser(enregistrement);
+    }
+
+    /**
+     * \fn void JournalMiseAJour::attendsDurabilite(unsigned long long sequence)
+     * \brief Permet d'attendre qu'un enregistrement soit sur disque
+     * \param[in] unsigned long long sequence, le numéro retourné par journaliseAjout ou journaliseSuppression
+     * \exception runtime_error si l'écriture ou la synchronisation du journal a échoué avant d'atteindre ce numéro
+     */
+    void JournalMiseAJour::attendsDurabilite(unsigned long long sequence) {
+        unique_lock<mutex> verrouTampon(verrou);
+        conditionDurable.wait(verrouTampon, [this, sequence]() { return sequenceDurable >= sequence || !erreur.empty(); });
+        if (sequenceDurable < sequence)
+            throw runtime_error(erreur);
+    }
+
+    /**
+     * \fn void JournalMiseAJour::synchronise()
+     * \brief Permet d'attendre que tous les enregistrements déjà journalisés soient sur disque
+     * \exception runtime_error si l'écriture ou la synchronisation du journal a échoué
+     */
+    void JournalMiseAJour::synchronise() {
+        unsigned long long sequence;
+        {
+            lock_guard<mutex> verrouTampon(verrou);
+            sequence = sequenceJournalisee;
+        }
+        attendsDurabilite(sequence);
+    }
+
+    /**
+     * \fn void JournalMiseAJour::compacte(const std::string &cheminSource, const std::string &cheminInstantane)
+     * \brief Permet de démarrer la compaction du journal dans un instantané trié, en arrière-plan
+     * \param[in] const std::string &cheminSource, le fichier source du dictionnaire (lu seulement s'il n'y a pas d'instantané)
+     * \param[in] const std::string &cheminInstantane, le fichier de l'instantané, remplacé de façon atomique
+     * \exception logic_error si une compaction est déjà en cours
+     * \exception runtime_error si le journal ne peut pas être basculé dans le segment de compaction
+     *
+     * Seule la bascule du journal se fait sur le fil appelant. Le fil de compaction reconstruit l'état à la bascule dans
+     * son propre dictionnaire, à partir des fichiers : le dictionnaire en service n'est pas touché et peut être modifié
+     * pendant toute la compaction.
+     *
+     */
+    void JournalMiseAJour::compacte(const std::string &cheminSource, const std::string &cheminInstantane) {
+        {
+            lock_guard<mutex> verrouTampon(verrou);
+            if (compactionActive)
+                throw logic_error("Une compaction du journal est deja en cours");
+        }
+        if (filCompaction.joinable())
+            filCompaction.join();
+        erreurCompaction = nullptr;
+
+        _basculerSegment();
+        {
+            lock_guard<mutex> verrouTampon(verrou);
+            compactionActive = true;
+        }
+        filCompaction = thread(&JournalMiseAJour::_compacter, this, cheminSource, cheminInstantane);
+    }
+
+    /**
+     * \fn bool JournalMiseAJour::compactionEnCours() const
+     * \brief Permet de vérifier si une compaction est en cours
+     * \return bool, true si le fil de compaction n'a pas terminé
+     */
+    bool JournalMiseAJour::compactionEnCours() const {
+        lock_guard<mutex> verrouTampon(verrou);
+        return compactionActive;
+    }
+
+    /**
+     * \fn void JournalMiseAJour::attendsCompaction()
+     * \brief Permet d'attendre la fin de la compaction en cours
+     * \exception runtime_error si la compaction a échoué
+     */
+    void JournalMiseAJour::attendsCompaction() {
+        if (filCompaction.joinable())
+            filCompaction.join();
+        if (erreurCompaction) {
+            exception_ptr erreurCourante = erreurCompaction;
+            erreurCompaction = nullptr;
+            rethrow_exception(erreurCourante);
+        }
+    }
+
+    /**
+     * \fn unsigned long long JournalMiseAJour::nombreEnregistrements() const
+     * \brief Permet de connaître le nombre d'enregistrements journalisés depuis l'ouverture
+     * \return unsigned long long, le nombre d'enregistrements
+     */
+    unsigned long long JournalMiseAJour::nombreEnregistrements() const {
+        lock_guard<mutex> verrouTampon(verrou);
+        return sequenceJournalisee;
+    }
+
+    /**
+     * \fn unsigned long long JournalMiseAJour::nombreSynchronisations() const
+     * \brief Permet de connaître le nombre de synchronisations faites depuis l'ouverture
+     * \return unsigned long long, le nombre de fdatasync réussis ; plus petit que le nombre d'enregistrements si des
+     * enregistrements ont été validés en groupe
+     */
+    unsigned long long JournalMiseAJour::nombreSynchronisations() const {
+        lock_guard<mutex> verrouTampon(verrou);
+        return nbSynchronisations;
+    }
+
+    /**
+     * \fn std::size_t JournalMiseAJour::rejoue(const std::string &cheminJournal, Dictionnaire &dictionnaire)
+     * \brief Permet de rejouer les enregistrements d'un journal (ou d'un instantané) sur un dictionnaire
+     * \param[in] const std::string &cheminJournal, le fichier à rejouer ; s'il n'existe pas, on ne fait rien
+     * \param[in] Dictionnaire &dictionnaire, le dictionnaire modifié
+     * \return std::size_t, le nombre d'enregistrements rejoués
+     * \exception runtime_error si une ligne complète n'est pas un enregistrement valide
+     *
+     * La dernière ligne est ignorée si elle ne se termine pas par '\n' : son écriture a été interrompue et elle n'a donc
+     * jamais été confirmée durable.
+     *
+     */
+    std::size_t JournalMiseAJour::rejoue(const std::string &cheminJournal, Dictionnaire &dictionnaire) {
+        ifstream fichier(cheminJournal.c_str(), ios::binary);
+        if (!fichier)
+            return 0;
+
+        size_t nbEnregistrements = 0;
+        size_t numeroLigne = 0;
+        vector<string> champs;
+        for (string ligne; getline(fichier, ligne); ) {
+            numeroLigne++;
+            if (fichier.eof())
+                break;
+
+            const bool valide = _decouper(ligne, champs);
+            if (valide && champs[0] == "A" && champs.size() >= 3) {
+                for (size_t i = 2; i < champs.size(); i++)
+                    dictionnaire.ajouteMot(champs[1], champs[i]);
+            } else if (valide && champs[0] == "S" && champs.size() == 2) {
+                if (dictionnaire.appartient(champs[1]))
+                    dictionnaire.supprimeMot(champs[1]);
+            } else {
+                throw runtime_error("enregistrement invalide dans " + cheminJournal + ", ligne " + to_string(numeroLigne));
+            }
+            nbEnregistrements++;
+        }
+        return nbEnregistrements;
+    }
+
+    /**
+     * \fn Dictionnaire JournalMiseAJour::restaure(const std::string &cheminSource, const std::string &cheminInstantane, const std::string &cheminJournal)
+     * \brief Permet de reconstruire au démarrage le dictionnaire tel qu'il était au dernier enregistrement durable
+     * \param[in] const std::string &cheminSource, le fichier source du dictionnaire (lu seulement s'il n'y a pas d'instantané)
+     * \param[in] const std::string &cheminInstantane, l'instantané écrit par la dernière compaction
+     * \param[in] const std::string &cheminJournal, le journal
+     * \return Dictionnaire, le dictionnaire reconstruit
+     * \exception runtime_error si ni l'instantané ni le fichier source ne peut être ouvert, ou si un journal est invalide
+     *
+     * L'instantané est au format du journal et en ordre alphabétique : son chargement ne passe pas par l'analyse du
+     * fichier source. Le segment d'une compaction inachevée est rejoué avant le journal, qui le suit dans le temps.
+     *
+     */
+    Dictionnaire JournalMiseAJour::restaure(const std::string &cheminSource, const std::string &cheminInstantane, const std::string &cheminJournal) {
+        Dictionnaire dictionnaire = _chargerBase(cheminSource, cheminInstantane);
+        rejoue(cheminJournal + ".compaction", dictionnaire);
+        rejoue(cheminJournal, dictionnaire);
+        return dictionnaire;
+    }
+
+    /**
+     * \fn unsigned long long JournalMiseAJour::_journaliser(const std::string &enregistrement)
+     * \brief Permet d'ajouter un enregistrement au tampon et de réveiller le fil de synchronisation
+     * \param[in] const std::string &enregistrement, la ligne complète, '\n' compris
+     * \return unsigned long long, le numéro de séquence de l'enregistrement
+     */
+    unsigned long long JournalMiseAJour::_journaliser(const std::string &enregistrement) {
+        unsigned long long sequence;
+        {
+            lock_guard<mutex> verrouTampon(verrou);
+            tampon += enregistrement;
+            sequence = ++sequenceJournalisee;
+        }
+        conditionTampon.notify_one();
+        return sequence;
+    }
+
+    /**
+     * \fn void JournalMiseAJour::_synchroniser()
+     * \brief Boucle du fil de synchronisation : écrit le tampon accumulé et le synchronise, en un seul fdatasync
+     *
+     * Pendant qu'un fdatasync est en cours, les nouveaux enregistrements s'accumulent dans le tampon ; ils partiront tous
+     * ensemble au tour suivant. Plus les écrivains sont nombreux, plus les groupes sont gros. À l'arrêt, le tampon est
+     * vidé avant de quitter.
+     *
+     */
+    void JournalMiseAJour::_synchroniser() {
+        unique_lock<mutex> verrouTampon(verrou);
+        while (true) {
+            conditionTampon.wait(verrouTampon, [this]() { return !tampon.empty() || arretDemande; });
+            if (tampon.empty())
+                return;
+            verrouTampon.unlock();
+            if (delaiGroupe.count() > 0)
+                this_thread::sleep_for(delaiGroupe);
+
+            lock_guard<mutex> verrouEcriture(verrouFichier);
+            verrouTampon.lock();
+            string aEcrire;
+            aEcrire.swap(tampon);
+            const unsigned long long sequence = sequenceJournalisee;
+            verrouTampon.unlock();
+            if (!aEcrire.empty())
+                _ecrireTampon(aEcrire, sequence);
+            verrouTampon.lock();
+        }
+    }
+
+    /**
+     * \fn void JournalMiseAJour::_ecrireTampon(std::string &aEcrire, unsigned long long sequence)
+     * \brief Permet d'écrire et de synchroniser un groupe d'enregistrements, puis de réveiller ceux qui l'attendent
+     * \param[in] std::string &aEcrire, les enregistrements du groupe
+     * \param[in] unsigned long long sequence, le numéro du dernier enregistrement du groupe
+     * \pre verrouFichier est tenu par l'appelant
+     *
+     * Après un échec, le journal n'est plus écrit : un enregistrement partiel au milieu du fichier rendrait les suivants
+     * illisibles. Tous les écrivains en attente reçoivent l'erreur.
+     *
+     */
+    void JournalMiseAJour::_ecrireTampon(std::string &aEcrire, unsigned long long sequence) {
+        {
+            lock_guard<mutex> verrouTampon(verrou);
+            if (!erreur.empty())
+                return;
+        }
+
+        string message;
+        try {
+            _ecrireTout(descripteur, aEcrire.data(), aEcrire.size(), chemin);
+            if (fdatasync(descripteur) != 0)
+                throw runtime_error("impossible de synchroniser le journal " + chemin + " : " + strerror(errno));
+        } catch (const runtime_error& e) {
+            message = e.what();
+        }
+
+        {
+            lock_guard<mutex> verrouTampon(verrou);
+            if (message.empty()) {
+                sequenceDurable = sequence;
+                nbSynchronisations++;
+            } else {
+                erreur = message;
+            }
+        }
+        conditionDurable.notify_all();
+    }
+
+    /**
+     * \fn void JournalMiseAJour::_basculerSegment()
+     * \brief Permet de déplacer les enregistrements déjà journalisés dans le segment de compaction
+     * \exception runtime_error si le journal ne peut pas être écrit, renommé ou recréé
+     *
+     * Le tampon est d'abord rendu durable. S'il n'y a pas de segment, le journal est renommé en segment et un journal
+     * vide le remplace. S'il en reste un (compaction précédente interrompue), le journal y est ajouté puis vidé : un
+     * arrêt entre les 2 fait rejouer ces enregistrements 2 fois, ce qui donne le même dictionnaire.
+     *
+     */
+    void JournalMiseAJour::_basculerSegment() {
+        lock_guard<mutex> verrouEcriture(verrouFichier);
+        string aEcrire;
+        unsigned long long sequence;
+        {
+            lock_guard<mutex> verrouTampon(verrou);
+            aEcrire.swap(tampon);
+            sequence = sequenceJournalisee;
+        }
+        if (!aEcrire.empty())
+            _ecrireTampon(aEcrire, sequence);
+        {
+            lock_guard<mutex> verrouTampon(verrou);
+            if (!erreur.empty())
+                throw runtime_error(erreur);
+        }
+
+        const string cheminSegment = chemin + ".compaction";
+        if (access(cheminSegment.c_str(), F_OK) != 0) {
+            if (rename(chemin.c_str(), cheminSegment.c_str()) != 0)
+                throw runtime_error("impossible de renommer le journal " + chemin + " : " + strerror(errno));
+            const int nouveau = open(chemin.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+            if (nouveau < 0)
+                throw runtime_error("impossible de recreer le journal " + chemin + " : " + strerror(errno));
+            close(descripteur);
+            descripteur = nouveau;
+            _synchroniserRepertoire(chemin);
+            return;
+        }
+
+        const int segment = open(cheminSegment.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+        if (segment < 0)
+            throw runtime_error("impossible d'ouvrir le segment " + cheminSegment + " : " + strerror(errno));
+        try {
+            char bloc[TAILLE_BLOC_LECTURE];
+            off_t position = 0;
+            for (ssize_t lus; (lus = pread(descripteur, bloc, sizeof(bloc), position)) != 0; position += lus) {
+                if (lus < 0)
+                    throw runtime_error("impossible de lire le journal " + chemin + " : " + strerror(errno));
+                _ecrireTout(segment, bloc, static_cast<size_t>(lus), cheminSegment);
+            }
+            if (fdatasync(segment) != 0 || ftruncate(descripteur, 0) != 0 || fdatasync(descripteur) != 0)
+                throw runtime_error("impossible de vider le journal " + chemin + " : " + strerror(errno));
+        } catch (...) {
+            close(segment);
+            throw;
+        }
+        close(segment);
+    }
+
+    /**
+     * \fn void JournalMiseAJour::_compacter(const std::string &cheminSource, const std::string &cheminInstantane)
+     * \brief Corps du fil de compaction : écrit l'instantané précédent plus le segment, puis efface le segment
+     * \param[in] const std::string &cheminSource, le fichier source du dictionnaire (lu seulement s'il n'y a pas d'instantané)
+     * \param[in] const std::string &cheminInstantane, le fichier de l'instantané
+     *
+     * Le segment contient tous les enregistrements qui suivent l'instantané précédent (une compaction interrompue y laisse
+     * les siens) : le dictionnaire reconstruit est donc celui du moment de la bascule. Une erreur est gardée pour
+     * attendsCompaction ; le segment est alors conservé.
+     *
+     */
+    void JournalMiseAJour::_compacter(const std::string &cheminSource, const std::string &cheminInstantane) {
+        try {
+            const string cheminSegment = chemin + ".compaction";
+            Dictionnaire instantane = _chargerBase(cheminSource, cheminInstantane);
+            rejoue(cheminSegment, instantane);
+            _ecrireInstantane(instantane, cheminInstantane, cheminSegment);
+            unlink(cheminSegment.c_str());
+            _synchroniserRepertoire(chemin);
+        } catch (...) {
+            erreurCompaction = current_exception();
+        }
+        lock_guard<mutex> verrouTampon(verrou);
+        compactionActive = false;
+    }
+
+    /**
+     * \fn Dictionnaire JournalMiseAJour::_chargerBase(const std::string &cheminSource, const std::string &cheminInstantane)
+     * \brief Permet de charger le point de départ du rejeu : l'instantané s'il existe, le fichier source sinon
+     * \param[in] const std::string &cheminSource, le fichier source du dictionnaire
+     * \param[in] const std::string &cheminInstantane, l'instantané écrit par la dernière compaction
+     * \return Dictionnaire, le dictionnaire chargé
+     * \exception runtime_error si ni l'instantané ni le fichier source ne peut être ouvert, ou si l'instantané est invalide
+     */
+    Dictionnaire JournalMiseAJour::_chargerBase(const std::string &cheminSource, const std::string &cheminInstantane) {
+        Dictionnaire dictionnaire;
+        if (access(cheminInstantane.c_str(), F_OK) == 0) {
+            rejoue(cheminInstantane, dictionnaire);
+        } else {
+            ifstream source(cheminSource.c_str());
+            if (!source)
+                throw runtime_error("impossible d'ouvrir le dictionnaire " + cheminSource);
+            Dictionnaire charge(source);
+            dictionnaire.swap(charge);
+        }
+        return dictionnaire;
+    }
+
+    /**
+     * \fn void JournalMiseAJour::_ecrireInstantane(const Dictionnaire &dictionnaire, const std::string &cheminInstantane, const std::string &cheminSegment)
+     * \brief Permet d'écrire tous les mots du dictionnaire, en ordre alphabétique, dans un instantané au format du journal
+     * \param[in] const Dictionnaire &dictionnaire, le dictionnaire à écrire
+     * \param[in] const std::string &cheminInstantane, le fichier de l'instantané
+     * \param[in] const std::string &cheminSegment, le segment remplacé (pour les messages d'erreur)
+     * \exception runtime_error si l'instantané ne peut pas être écrit
+     *
+     * On écrit dans cheminInstantane + ".tmp", on le synchronise, puis on renomme : au démarrage, on trouve soit l'ancien
+     * instantané complet, soit le nouveau, jamais un fichier à moitié écrit.
+     *
+     */
+    void JournalMiseAJour::_ecrireInstantane(const Dictionnaire &dictionnaire, const std::string &cheminInstantane, const std::string &cheminSegment) {
+        const string cheminTemporaire = cheminInstantane + ".tmp";
+        const int fichier = open(cheminTemporaire.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fichier < 0)
+            throw runtime_error("impossible de creer l'instantane " + cheminTemporaire + " pour " + cheminSegment + " : " + strerror(errno));
+        try {
+            string bloc;
+            for (Dictionnaire::Iterateur mot = dictionnaire.begin(); mot != dictionnaire.end(); ++mot) {
+                bloc += "A\t";
+                _echapper(*mot, bloc);
+                for (const string& traduction : mot.traductions()) {
+                    bloc += '\t';
+                    _echapper(traduction, bloc);
+                }
+                bloc += '\n';
+                if (bloc.size() >= TAILLE_BLOC_INSTANTANE) {
+                    _ecrireTout(fichier, bloc.data(), bloc.size(), cheminTemporaire);
+                    bloc.clear();
+                }
+            }
+            _ecrireTout(fichier, bloc.data(), bloc.size(), cheminTemporaire);
+            if (fsync(fichier) != 0)
+                throw runtime_error("impossible de synchroniser l'instantane " + cheminTemporaire + " : " + strerror(errno));
+        } catch (...) {
+            close(fichier);
+            unlink(cheminTemporaire.c_str());
+            throw;
+        }
+        close(fichier);
+        if (rename(cheminTemporaire.c_str(), cheminInstantane.c_str()) != 0)
+            throw runtime_error("impossible de remplacer l'instantane " + cheminInstantane + " : " + strerror(errno));
+        _synchroniserRepertoire(cheminInstantane);
+    }
+
+    /**
+     * \fn void JournalMiseAJour::_echapper(const std::string &champ, std::string &sortie)
+     * \brief Permet d'ajouter un champ à un enregistrement en échappant '\\', '\t' et '\n'
+     * \param[in] const std::string &champ, le mot ou la traduction
+     * \param[out] std::string &sortie, l'enregistrement en construction
+     */
+    void JournalMiseAJour::_echapper(const std::string &champ, std::string &sortie) {
+        for (char caractere : champ) {
+            if (caractere == '\\')
+                sortie += "\\\\";
+            else if (caractere == '\t')
+                sortie += "\\t";
+            else if (caractere == '\n')
+                sortie += "\\n";
+            else
+                sortie += caractere;
+        }
+    }
+
+    /**
+     * \fn bool JournalMiseAJour::_decouper(const std::string &ligne, std::vector<std::string> &champs)
+     * \brief Permet de découper une ligne en champs aux tabulations, en retirant l'échappement
+     * \param[in] const std::string &ligne, la ligne sans son '\n'
+     * \param[out] std::vector<std::string> &champs, les champs (au moins 1)
+     * \return bool, false si la ligne contient une séquence d'échappement invalide
+     */
+    bool JournalMiseAJour::_decouper(const std::string &ligne, std::vector<std::string> &champs) {
+        champs.assign(1, string());
+        for (size_t i = 0; i < ligne.size(); i++) {
+            if (ligne[i] == '\t') {
+                champs.push_back(string());
+            } else if (ligne[i] != '\\') {
+                champs.back() += ligne[i];
+            } else if (i + 1 < ligne.size() && (ligne[i + 1] == '\\' || ligne[i + 1] == 't' || ligne[i + 1] == 'n')) {
+                i++;
+                champs.back() += ligne[i] == 't' ? '\t' : ligne[i] == 'n' ? '\n' : '\\';
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * \fn void JournalMiseAJour::_ecrireTout(int descripteur, const char *donnees, std::size_t taille, const std::string &chemin)
+     * \brief Permet d'écrire un bloc au complet, en reprenant après une écriture partielle ou un signal
+     * \exception runtime_error si l'écriture échoue
+     */
+    void JournalMiseAJour::_ecrireTout(int descripteur, const char *donnees, std::size_t taille, const std::string &chemin) {
+        while (taille > 0) {
+            const ssize_t ecrits = write(descripteur, donnees, taille);
+            if (ecrits < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw runtime_error("impossible d'ecrire " + chemin + " : " + strerror(errno));
+            }
+            donnees += ecrits;
+            taille -= static_cast<size_t>(ecrits);
+        }
+    }
+
+    /**
+     * \fn void JournalMiseAJour::_synchroniserRepertoire(const std::string &chemin)
+     * \brief Permet de rendre durable la création ou le renommage d'un fichier en synchronisant son répertoire
+     *
+     * Au mieux : certains systèmes de fichiers refusent fsync sur un répertoire, et le renommage y est déjà durable.
+     *
+     */
+    void JournalMiseAJour::_synchroniserRepertoire(const std::string &chemin) {
+        const size_t separateur = chemin.find_last_of('/');
+        const string repertoire = separateur == string::npos ? "." : separateur == 0 ? "/" : chemin.substr(0, separateur);
+        const int descripteurRepertoire = open(repertoire.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (descripteurRepertoire >= 0) {
+            fsync(descripteurRepertoire);
+            close(descripteurRepertoire);
+        }
+    }
+
+}//Fin du namespace
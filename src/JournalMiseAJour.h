@@ -0,0 +1,155 @@
+/**
+ * \file JournalMiseAJour.h
+ * \brief Ce fichier contient l'interface d'un journal des mises à jour du dictionnaire (ajouts et suppressions).
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef JOURNALMISEAJOUR_H_
+#define JOURNALMISEAJOUR_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Dictionnaire.h"
+
+namespace TP3
+{
+
+/**
+ * \class JournalMiseAJour
+ * \brief Journal en ajout seulement des ajouteMot et supprimeMot, rejoué au démarrage par-dessus le dictionnaire chargé
+ *
+ *  Un enregistrement par ligne, les champs séparés par des tabulations ('\\', '\t' et '\n' sont échappés) :
+ *      - "A\tmot\ttrad1\ttrad2..." : ajout du mot et de ses traductions
+ *      - "S\tmot"                  : suppression du mot
+ *  Une dernière ligne sans '\n' (écriture interrompue par un arrêt brutal) est ignorée au rejeu.
+ *
+ *  Validation groupée : journaliseAjout et journaliseSuppression ajoutent l'enregistrement à un tampon et retournent
+ *  son numéro de séquence sans attendre. Un fil de synchronisation écrit tout le tampon puis fait un seul fdatasync pour
+ *  tous les enregistrements arrivés pendant le précédent ; attendsDurabilite bloque jusqu'à ce que le numéro donné soit
+ *  sur disque. Un écrivain applique donc sa modification et la journalise sous son propre verrou (l'ordre du journal
+ *  est alors celui des modifications), puis relâche ce verrou avant d'attendre la durabilité.
+ *
+ *  Compaction : compacte() bascule les enregistrements déjà journalisés dans un segment (chemin + ".compaction"), puis
+ *  un fil d'arrière-plan charge l'instantané précédent (le fichier source sinon), y rejoue le segment et écrit le
+ *  résultat, en ordre alphabétique, dans un nouvel instantané au format du journal. Le dictionnaire en service n'est ni
+ *  lu ni copié : la compaction ne coûte rien à ses écrivains, hormis la bascule du journal. Une fois l'instantané renommé à sa place, le segment est effacé. restaure() charge l'instantané s'il existe (le
+ *  fichier source sinon), puis rejoue le segment et le journal : rejouer un enregistrement déjà dans l'instantané ne
+ *  change rien.
+ *
+ *  Attributs:
+ *      - std::string chemin, le fichier du journal
+ *      - int descripteur, le fichier du journal ouvert en ajout
+ *      - std::string tampon, les enregistrements pas encore écrits
+ *      - unsigned long long sequenceJournalisee, sequenceDurable, dernier numéro donné et dernier numéro sur disque
+ *      - std::thread filSynchronisation, filCompaction, les fils de validation groupée et de compaction
+ *
+ */
+class JournalMiseAJour
+{
+public:
+
+	//Constructeur. Ouvre (ou crée) le journal en ajout et démarre le fil de synchronisation.
+	//Le délai de groupe retarde chaque synchronisation pour laisser d'autres enregistrements la rejoindre (0 par défaut).
+	//Exception runtime_error si le journal ne peut pas être ouvert
+	explicit JournalMiseAJour(const std::string& p_chemin, std::chrono::microseconds p_delaiGroupe = std::chrono::microseconds(0));
+
+	JournalMiseAJour(const JournalMiseAJour&) = delete;
+	JournalMiseAJour& operator=(const JournalMiseAJour&) = delete;
+
+	//Destructeur. Rend durables les enregistrements en attente, puis attend la fin d'une compaction en cours.
+	~JournalMiseAJour();
+
+	//Journaliser l'ajout d'un mot et de sa traduction. On retourne le numéro de séquence de l'enregistrement.
+	unsigned long long journaliseAjout(const std::string& mot, const std::string& traduction);
+
+	//Journaliser la suppression d'un mot. On retourne le numéro de séquence de l'enregistrement.
+	unsigned long long journaliseSuppression(const std::string& mot);
+
+	//Attendre que l'enregistrement de ce numéro (et tous ceux qui le précèdent) soit sur disque
+	//Exception runtime_error si l'écriture ou la synchronisation du journal a échoué
+	void attendsDurabilite(unsigned long long sequence);
+
+	//Attendre que tous les enregistrements journalisés jusqu'ici soient sur disque
+	//Exception runtime_error si l'écriture ou la synchronisation du journal a échoué
+	void synchronise();
+
+	//Démarrer la compaction du journal dans un instantané trié, en arrière-plan : l'instantané précédent (le fichier
+	//source sinon) plus le segment basculé. Le fichier source doit être celui donné à restaure().
+	//Exception logic_error si une compaction est déjà en cours
+	//Exception runtime_error si le journal ne peut pas être basculé dans le segment de compaction
+	void compacte(const std::string& cheminSource, const std::string& cheminInstantane);
+
+	//Vérifier si une compaction est en cours
+	bool compactionEnCours() const;
+
+	//Attendre la fin de la compaction en cours (s'il y en a une)
+	//Exception runtime_error si la compaction a échoué ; le segment est alors conservé et sera rejoué par restaure()
+	void attendsCompaction();
+
+	//Nombre d'enregistrements journalisés et nombre de synchronisations (fdatasync) faites par ce journal
+	unsigned long long nombreEnregistrements() const;
+	unsigned long long nombreSynchronisations() const;
+
+	//Rejouer un fichier de journal sur un dictionnaire. Un journal absent ne contient aucun enregistrement.
+	//On retourne le nombre d'enregistrements rejoués. Une suppression d'un mot absent est ignorée.
+	//Exception runtime_error si une ligne complète du journal est invalide
+	static std::size_t rejoue(const std::string& cheminJournal, Dictionnaire& dictionnaire);
+
+	//Reconstruire le dictionnaire au démarrage : l'instantané s'il existe (le fichier source sinon), puis le segment de
+	//compaction et le journal
+	//Exception runtime_error si ni l'instantané ni le fichier source ne peut être ouvert, ou si un journal est invalide
+	static Dictionnaire restaure(const std::string& cheminSource, const std::string& cheminInstantane, const std::string& cheminJournal);
+
+private:
+
+    const std::string chemin;
+    const std::chrono::microseconds delaiGroupe;
+    int descripteur;
+
+    mutable std::mutex verrou;
+    std::condition_variable conditionTampon;
+    std::condition_variable conditionDurable;
+    std::string tampon;
+    unsigned long long sequenceJournalisee;
+    unsigned long long sequenceDurable;
+    unsigned long long nbSynchronisations;
+    std::string erreur;
+    bool arretDemande;
+
+    //Tenu par le fil de synchronisation pendant une écriture, et par compacte() pendant la bascule du journal
+    std::mutex verrouFichier;
+
+    std::thread filSynchronisation;
+    std::thread filCompaction;
+    std::exception_ptr erreurCompaction;
+    bool compactionActive;
+
+    //region private methods
+
+    unsigned long long _journaliser(const std::string& enregistrement);
+    void _synchroniser();
+    void _ecrireTampon(std::string& aEcrire, unsigned long long sequence);
+    void _basculerSegment();
+    void _compacter(const std::string& cheminSource, const std::string& cheminInstantane);
+    static Dictionnaire _chargerBase(const std::string& cheminSource, const std::string& cheminInstantane);
+    static void _ecrireInstantane(const Dictionnaire& dictionnaire, const std::string& cheminInstantane, const std::string& cheminSegment);
+    static void _echapper(const std::string& champ, std::string& sortie);
+    static bool _decouper(const std::string& ligne, std::vector<std::string>& champs);
+    static void _ecrireTout(int descripteur, const char* donnees, std::size_t taille, const std::string& chemin);
+    static void _synchroniserRepertoire(const std::string& chemin);
+
+    //endregion
+};
+
+}
+
+#endif /* JOURNALMISEAJOUR_H_ */
@@ -0,0 +1,566 @@
+/**
+ * \file PolitiquesEquilibre.h
+ * \brief Ce fichier contient les politiques d'équilibre de l'arbre du dictionnaire : AVL, rouge-noir, WAVL et treap.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ * Une politique est une classe sans état dont les méthodes statiques sont appelées par l'arbre sur chaque noeud du chemin
+ * de remontée, après un ajout ou une suppression. Le choix se fait à la compilation (voir TP3_POLITIQUE_EQUILIBRE dans
+ * Dictionnaire.h) : les appels sont résolus statiquement et mis en ligne, sans coût à l'exécution.
+ *
+ * Le noeud doit avoir les champs gauche, droite, parent et un entier hauteur, qui porte la métadonnée de la politique :
+ * la hauteur pour l'AVL, le rang pour le rouge-noir et le WAVL, la priorité pour le treap.
+ *
+ * Interface d'une politique :
+ *      - static const char* nom()
+ *      - static void initialiser(Noeud* noeud) : métadonnée d'un nouveau noeud (une feuille)
+ *      - static void apresInsertion(Noeud*& noeud, CompteursOperations& compteurs)
+ *      - static void apresSuppression(Noeud*& noeud, CompteursOperations& compteurs)
+ *      - static Noeud* construireTrie(Noeud* const* noeuds, std::size_t nombre) : arbre valide sur des noeuds triés
+ *      - static Noeud* joindre(Noeud* gauche, Noeud* milieu, Noeud* droite, CompteursOperations& compteurs) : arbre valide
+ *        sur 2 arbres et un noeud dont la clé les sépare
+ * apresInsertion et apresSuppression rattachent les enfants du noeud à leur parent, puis rétablissent l'équilibre localement, par des
+ * rotations qui peuvent remplacer le noeud ; 'noeud' désigne alors la nouvelle racine du sous-arbre.
+ *
+ * L'arbre retire toujours une feuille lors d'une suppression (le mot à retirer est d'abord échangé avec son successeur).
+ * construireTrie sert aux modifications par lot : l'arbre y passe tous ses noeuds en ordre, et la politique leur donne
+ * des liens, des parents et des métadonnées valides en O(n), au lieu d'un rééquilibrage par noeud modifié.
+ * joindre est la base de la scission et des opérations d'ensemble : son coût est proportionnel à la différence de rang
+ * des 2 arbres (O(log n)). Le parent de la racine retournée n'est pas touché.
+ *
+ */
+
+#ifndef POLITIQUESEQUILIBRE_H_
+#define POLITIQUESEQUILIBRE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Instrumentation.h"
+
+namespace TP3
+{
+
+/**
+ * \struct RotationsArbre
+ * \brief Opérations communes aux politiques : rang d'un sous-arbre et rotations simples
+ *
+ *  Un zig-zig gauche fait monter l'enfant gauche du noeud critique, un zig-zig droite fait monter l'enfant droit.
+ *  Les rotations ne touchent pas aux métadonnées : c'est la politique qui les ajuste.
+ *
+ */
+struct RotationsArbre
+{
+    //Métadonnée d'un sous-arbre, -1 pour un sous-arbre vide
+    template<typename Noeud>
+    static int rang(const Noeud* noeud) {
+        return noeud == nullptr ? -1 : noeud->hauteur;
+    }
+
+    //Rattacher les enfants d'un noeud à leur parent
+    template<typename Noeud>
+    static void rattacherEnfants(Noeud* noeud) {
+        if (noeud->gauche != nullptr)
+            noeud->gauche->parent = noeud;
+        if (noeud->droite != nullptr)
+            noeud->droite->parent = noeud;
+    }
+
+    template<typename Noeud>
+    static void zigZigGauche(Noeud*& noeudCritique, CompteursOperations& compteurs) {
+        TP3_COMPTER(compteurs.rotationsGauche, 1);
+        (void)compteurs;
+
+        Noeud* noeudCritiqueSecondaire = noeudCritique->gauche;
+        noeudCritique->gauche = noeudCritiqueSecondaire->droite;
+        noeudCritiqueSecondaire->droite = noeudCritique;
+        rattacherEnfants(noeudCritique);
+        rattacherEnfants(noeudCritiqueSecondaire);
+        noeudCritique = noeudCritiqueSecondaire;
+    }
+
+    template<typename Noeud>
+    static void zigZigDroite(Noeud*& noeudCritique, CompteursOperations& compteurs) {
+        TP3_COMPTER(compteurs.rotationsDroite, 1);
+        (void)compteurs;
+
+        Noeud* noeudCritiqueSecondaire = noeudCritique->droite;
+        noeudCritique->droite = noeudCritiqueSecondaire->gauche;
+        noeudCritiqueSecondaire->gauche = noeudCritique;
+        rattacherEnfants(noeudCritique);
+        rattacherEnfants(noeudCritiqueSecondaire);
+        noeudCritique = noeudCritiqueSecondaire;
+    }
+
+    //Construire un arbre parfaitement équilibré sur des noeuds triés : le noeud du milieu est la racine, et les tailles
+    //des 2 sous-arbres d'un noeud diffèrent d'au plus 1. 'metadonnee' calcule celle d'un noeud à partir des rangs de ses
+    //enfants. Le parent de la racine n'est pas touché.
+    template<typename Noeud, typename Metadonnee>
+    static Noeud* construireMilieu(Noeud* const* noeuds, std::size_t nombre, Metadonnee metadonnee) {
+        if (nombre == 0)
+            return nullptr;
+        const std::size_t milieu = nombre / 2;
+        Noeud* noeud = noeuds[milieu];
+        noeud->gauche = construireMilieu(noeuds, milieu, metadonnee);
+        noeud->droite = construireMilieu(noeuds + milieu + 1, nombre - milieu - 1, metadonnee);
+        rattacherEnfants(noeud);
+        noeud->hauteur = metadonnee(rang(noeud->gauche), rang(noeud->droite));
+        return noeud;
+    }
+
+    //Joindre 2 arbres équilibrés par leur rang et un noeud dont la clé les sépare. On descend le long du bord intérieur du
+    //plus haut des 2 jusqu'à un sous-arbre de rang au plus rang(autre) + ecart ; le noeud y devient la racine de ce
+    //sous-arbre et de l'autre arbre, puis Politique::apresInsertion corrige chaque noeud du chemin en remontant, comme
+    //après un ajout qui aurait fait monter le rang du sous-arbre.
+    template<typename Politique, typename Noeud>
+    static Noeud* joindreParRang(Noeud* gauche, Noeud* milieu, Noeud* droite, int ecart, CompteursOperations& compteurs) {
+        if (rang(gauche) > rang(droite) + ecart) {
+            gauche->droite = joindreParRang<Politique>(gauche->droite, milieu, droite, ecart, compteurs);
+            Politique::apresInsertion(gauche, compteurs);
+            return gauche;
+        }
+        if (rang(droite) > rang(gauche) + ecart) {
+            droite->gauche = joindreParRang<Politique>(gauche, milieu, droite->gauche, ecart, compteurs);
+            Politique::apresInsertion(droite, compteurs);
+            return droite;
+        }
+        milieu->gauche = gauche;
+        milieu->droite = droite;
+        rattacherEnfants(milieu);
+        milieu->hauteur = 1 + std::max(rang(gauche), rang(droite));
+        return milieu;
+    }
+
+    //Double rotation : le petit-enfant gauche-droite monte à la place du noeud critique
+    template<typename Noeud>
+    static void zigZagGauche(Noeud*& noeudCritique, CompteursOperations& compteurs) {
+        TP3_COMPTER(compteurs.rotationsDoubles, 1);
+        zigZigDroite(noeudCritique->gauche, compteurs);
+        zigZigGauche(noeudCritique, compteurs);
+    }
+
+    //Double rotation : le petit-enfant droite-gauche monte à la place du noeud critique
+    template<typename Noeud>
+    static void zigZagDroite(Noeud*& noeudCritique, CompteursOperations& compteurs) {
+        TP3_COMPTER(compteurs.rotationsDoubles, 1);
+        zigZigGauche(noeudCritique->droite, compteurs);
+        zigZigDroite(noeudCritique, compteurs);
+    }
+};
+
+/**
+ * \struct PolitiqueAVL
+ * \brief Arbre AVL : les hauteurs des deux enfants de chaque noeud diffèrent d'au plus 1
+ *
+ *  C'est l'équilibre le plus strict (hauteur <= 1,44 log n), donc les recherches les plus courtes, mais une suppression
+ *  peut faire une rotation à chaque niveau.
+ *
+ */
+struct PolitiqueAVL : RotationsArbre
+{
+    static const char* nom() { return "AVL"; }
+
+    template<typename Noeud>
+    static void initialiser(Noeud* noeud) {
+        noeud->hauteur = 0;
+    }
+
+    template<typename Noeud>
+    static void apresInsertion(Noeud*& noeud, CompteursOperations& compteurs) {
+        balancer(noeud, compteurs);
+    }
+
+    template<typename Noeud>
+    static void apresSuppression(Noeud*& noeud, CompteursOperations& compteurs) {
+        balancer(noeud, compteurs);
+    }
+
+    //Les hauteurs de 2 sous-arbres de tailles presque égales diffèrent d'au plus 1
+    template<typename Noeud>
+    static Noeud* construireTrie(Noeud* const* noeuds, std::size_t nombre) {
+        return construireMilieu(noeuds, nombre, [](int gauche, int droite) { return 1 + std::max(gauche, droite); });
+    }
+
+    //Le noeud est placé sur un sous-arbre de hauteur égale à celle de l'autre arbre, à 1 près ; balancer fait ensuite
+    //au plus une rotation simple ou double par niveau en remontant
+    template<typename Noeud>
+    static Noeud* joindre(Noeud* gauche, Noeud* milieu, Noeud* droite, CompteursOperations& compteurs) {
+        return joindreParRang<PolitiqueAVL>(gauche, milieu, droite, 1, compteurs);
+    }
+
+    //Ajuster la hauteur du noeud, puis faire une rotation simple ou double s'il est débalancé
+    template<typename Noeud>
+    static void balancer(Noeud*& noeud, CompteursOperations& compteurs) {
+        if (noeud == nullptr)
+            return;
+        majHauteur(noeud);
+
+        if (rang(noeud->gauche) - rang(noeud->droite) >= 2) {
+            if (rang(noeud->gauche->droite) > rang(noeud->gauche->gauche)) {
+                TP3_COMPTER(compteurs.rotationsDoubles, 1);
+                zigZigDroiteAVL(noeud->gauche, compteurs);
+            }
+            zigZigGaucheAVL(noeud, compteurs);
+        } else if (rang(noeud->droite) - rang(noeud->gauche) >= 2) {
+            if (rang(noeud->droite->gauche) > rang(noeud->droite->droite)) {
+                TP3_COMPTER(compteurs.rotationsDoubles, 1);
+                zigZigGaucheAVL(noeud->droite, compteurs);
+            }
+            zigZigDroiteAVL(noeud, compteurs);
+        }
+    }
+
+    template<typename Noeud>
+    static void majHauteur(Noeud* noeud) {
+        rattacherEnfants(noeud);
+        noeud->hauteur = 1 + std::max(rang(noeud->gauche), rang(noeud->droite));
+    }
+
+    template<typename Noeud>
+    static void zigZigGaucheAVL(Noeud*& noeudCritique, CompteursOperations& compteurs) {
+        zigZigGauche(noeudCritique, compteurs);
+        majHauteur(noeudCritique->droite);
+        majHauteur(noeudCritique);
+    }
+
+    template<typename Noeud>
+    static void zigZigDroiteAVL(Noeud*& noeudCritique, CompteursOperations& compteurs) {
+        zigZigDroite(noeudCritique, compteurs);
+        majHauteur(noeudCritique->gauche);
+        majHauteur(noeudCritique);
+    }
+};
+
+/**
+ * \struct PolitiqueRougeNoir
+ * \brief Arbre rouge-noir, exprimé par rangs (hauteur noire) plutôt que par couleurs
+ *
+ *  La différence de rang entre un noeud et son parent est 0 (noeud rouge) ou 1 (noeud noir), un sous-arbre vide ayant le
+ *  rang -1, et un noeud de différence 0 n'a pas d'enfant de différence 0 (pas de rouge sous un rouge). Un ajout fait
+ *  au plus 2 rotations et une suppression au plus 3 ; les autres corrections ne changent qu'un rang (recoloration).
+ *
+ */
+struct PolitiqueRougeNoir : RotationsArbre
+{
+    static const char* nom() { return "rouge-noir"; }
+
+    template<typename Noeud>
+    static void initialiser(Noeud* noeud) {
+        noeud->hauteur = 0;
+    }
+
+    //Le noeud est le grand-parent d'une éventuelle violation rouge-rouge : un enfant de différence 0 qui a lui-même un
+    //enfant de différence 0. Si l'oncle est aussi rouge, on promeut le grand-parent ; sinon, une rotation suffit.
+    template<typename Noeud>
+    static void apresInsertion(Noeud*& noeud, CompteursOperations& compteurs) {
+        if (noeud == nullptr)
+            return;
+        rattacherEnfants(noeud);
+
+        const int r = noeud->hauteur;
+        Noeud* gauche = noeud->gauche;
+        Noeud* droite = noeud->droite;
+        const bool gaucheViole = rang(gauche) == r && (rang(gauche->gauche) == r || rang(gauche->droite) == r);
+        const bool droiteViole = rang(droite) == r && (rang(droite->gauche) == r || rang(droite->droite) == r);
+        if (!gaucheViole && !droiteViole)
+            return;
+
+        if (rang(gauche) == r && rang(droite) == r) {
+            noeud->hauteur++;
+        } else if (gaucheViole) {
+            if (rang(gauche->gauche) == r)
+                zigZigGauche(noeud, compteurs);
+            else
+                zigZagGauche(noeud, compteurs);
+        } else {
+            if (rang(droite->droite) == r)
+                zigZigDroite(noeud, compteurs);
+            else
+                zigZagDroite(noeud, compteurs);
+        }
+    }
+
+    //Un enfant de différence 2 a perdu un noeud noir. Si son frère est rouge, une rotation le ramène au cas d'un frère noir.
+    //Avec un frère noir : une rotation s'il a un enfant rouge, sinon le noeud descend d'un rang (le frère devient rouge)
+    //et le déficit remonte au parent si le noeud était noir.
+    template<typename Noeud>
+    static void apresSuppression(Noeud*& noeud, CompteursOperations& compteurs) {
+        if (noeud == nullptr)
+            return;
+        rattacherEnfants(noeud);
+
+        const int r = noeud->hauteur;
+        if (r - rang(noeud->gauche) == 2) {
+            if (rang(noeud->droite) == r) {
+                zigZigDroite(noeud, compteurs);
+                apresSuppression(noeud->gauche, compteurs);
+                rattacherEnfants(noeud);
+                return;
+            }
+            Noeud* frere = noeud->droite;
+            if (rang(frere->droite) == r - 1) {
+                zigZigDroite(noeud, compteurs);
+                noeud->hauteur++;
+                noeud->gauche->hauteur--;
+            } else if (rang(frere->gauche) == r - 1) {
+                zigZagDroite(noeud, compteurs);
+                noeud->hauteur++;
+                noeud->gauche->hauteur--;
+            } else {
+                noeud->hauteur--;
+            }
+        } else if (r - rang(noeud->droite) == 2) {
+            if (rang(noeud->gauche) == r) {
+                zigZigGauche(noeud, compteurs);
+                apresSuppression(noeud->droite, compteurs);
+                rattacherEnfants(noeud);
+                return;
+            }
+            Noeud* frere = noeud->gauche;
+            if (rang(frere->gauche) == r - 1) {
+                zigZigGauche(noeud, compteurs);
+                noeud->hauteur++;
+                noeud->droite->hauteur--;
+            } else if (rang(frere->droite) == r - 1) {
+                zigZagGauche(noeud, compteurs);
+                noeud->hauteur++;
+                noeud->droite->hauteur--;
+            } else {
+                noeud->hauteur--;
+            }
+        }
+    }
+
+    //Rang = hauteur noire : 1 + la plus courte distance à un sous-arbre vide. Les sous-arbres vides d'un arbre construit
+    //par le milieu sont tous sur 2 niveaux consécutifs ; les noeuds rouges sont ceux dont tous les sous-arbres vides sont
+    //au niveau le plus profond, et leurs enfants sont noirs.
+    template<typename Noeud>
+    static Noeud* construireTrie(Noeud* const* noeuds, std::size_t nombre) {
+        return construireMilieu(noeuds, nombre, [](int gauche, int droite) { return 1 + std::min(gauche, droite); });
+    }
+
+    //Le noeud devient rouge au-dessus d'un sous-arbre noir de même hauteur noire que l'autre arbre ; une violation
+    //rouge-rouge avec son parent est corrigée comme après un ajout
+    template<typename Noeud>
+    static Noeud* joindre(Noeud* gauche, Noeud* milieu, Noeud* droite, CompteursOperations& compteurs) {
+        return joindreParRang<PolitiqueRougeNoir>(gauche, milieu, droite, 0, compteurs);
+    }
+};
+
+/**
+ * \struct PolitiqueWAVL
+ * \brief Arbre WAVL (« weak AVL ») : différences de rang de 1 ou 2, et toute feuille a le rang 0
+ *
+ *  Sans suppression, un WAVL est un AVL. Une suppression ne fait jamais plus de 2 rotations (contre O(log n) pour l'AVL),
+ *  et la hauteur reste sous 2 log n, comme un rouge-noir.
+ *
+ */
+struct PolitiqueWAVL : RotationsArbre
+{
+    static const char* nom() { return "WAVL"; }
+
+    template<typename Noeud>
+    static void initialiser(Noeud* noeud) {
+        noeud->hauteur = 0;
+    }
+
+    //Un enfant de différence 0 : on promeut le noeud si l'autre enfant est de différence 1, sinon une rotation
+    //simple ou double termine la correction.
+    template<typename Noeud>
+    static void apresInsertion(Noeud*& noeud, CompteursOperations& compteurs) {
+        if (noeud == nullptr)
+            return;
+        rattacherEnfants(noeud);
+
+        const int r = noeud->hauteur;
+        if (rang(noeud->gauche) == r) {
+            Noeud* enfant = noeud->gauche;
+            if (r - rang(noeud->droite) == 1) {
+                noeud->hauteur++;
+            } else if (enfant->hauteur - rang(enfant->gauche) == 1) {
+                zigZigGauche(noeud, compteurs);
+                noeud->droite->hauteur--;
+            } else {
+                zigZagGauche(noeud, compteurs);
+                noeud->hauteur++;
+                noeud->gauche->hauteur--;
+                noeud->droite->hauteur--;
+            }
+        } else if (rang(noeud->droite) == r) {
+            Noeud* enfant = noeud->droite;
+            if (r - rang(noeud->gauche) == 1) {
+                noeud->hauteur++;
+            } else if (enfant->hauteur - rang(enfant->droite) == 1) {
+                zigZigDroite(noeud, compteurs);
+                noeud->gauche->hauteur--;
+            } else {
+                zigZagDroite(noeud, compteurs);
+                noeud->hauteur++;
+                noeud->gauche->hauteur--;
+                noeud->droite->hauteur--;
+            }
+        }
+    }
+
+    //Une feuille de rang 1 descend au rang 0. Un enfant de différence 3 : le noeud descend si l'autre enfant est de
+    //différence 2 ; sinon, le noeud et son autre enfant descendent si ce dernier est 2,2 ; sinon, une rotation simple ou
+    //double termine la correction.
+    template<typename Noeud>
+    static void apresSuppression(Noeud*& noeud, CompteursOperations& compteurs) {
+        if (noeud == nullptr)
+            return;
+        rattacherEnfants(noeud);
+
+        const int r = noeud->hauteur;
+        if (noeud->gauche == nullptr && noeud->droite == nullptr) {
+            noeud->hauteur = 0;
+        } else if (r - rang(noeud->gauche) == 3) {
+            Noeud* frere = noeud->droite;
+            if (r - rang(frere) == 2) {
+                noeud->hauteur--;
+            } else if (frere->hauteur - rang(frere->gauche) == 2 && frere->hauteur - rang(frere->droite) == 2) {
+                noeud->hauteur--;
+                frere->hauteur--;
+            } else if (frere->hauteur - rang(frere->droite) == 1) {
+                zigZigDroite(noeud, compteurs);
+                noeud->hauteur++;
+                _descendreApresRotation(noeud->gauche);
+            } else {
+                zigZagDroite(noeud, compteurs);
+                noeud->hauteur += 2;
+                noeud->gauche->hauteur -= 2;
+                noeud->droite->hauteur--;
+            }
+        } else if (r - rang(noeud->droite) == 3) {
+            Noeud* frere = noeud->gauche;
+            if (r - rang(frere) == 2) {
+                noeud->hauteur--;
+            } else if (frere->hauteur - rang(frere->gauche) == 2 && frere->hauteur - rang(frere->droite) == 2) {
+                noeud->hauteur--;
+                frere->hauteur--;
+            } else if (frere->hauteur - rang(frere->gauche) == 1) {
+                zigZigGauche(noeud, compteurs);
+                noeud->hauteur++;
+                _descendreApresRotation(noeud->droite);
+            } else {
+                zigZagGauche(noeud, compteurs);
+                noeud->hauteur += 2;
+                noeud->gauche->hauteur--;
+                noeud->droite->hauteur -= 2;
+            }
+        }
+    }
+
+    //Un AVL est un WAVL : les rangs sont les hauteurs
+    template<typename Noeud>
+    static Noeud* construireTrie(Noeud* const* noeuds, std::size_t nombre) {
+        return PolitiqueAVL::construireTrie(noeuds, nombre);
+    }
+
+    //Comme pour l'AVL, sur les rangs : le noeud placé a des enfants de différences 1 et 2 ou 1 et 1, et une différence
+    //de 0 ou 1 avec son parent, la même situation qu'après une promotion lors d'un ajout
+    template<typename Noeud>
+    static Noeud* joindre(Noeud* gauche, Noeud* milieu, Noeud* droite, CompteursOperations& compteurs) {
+        return joindreParRang<PolitiqueWAVL>(gauche, milieu, droite, 1, compteurs);
+    }
+
+    //L'ancien noeud critique d'une rotation simple perd un rang, deux s'il est devenu une feuille
+    template<typename Noeud>
+    static void _descendreApresRotation(Noeud* noeud) {
+        noeud->hauteur--;
+        if (noeud->gauche == nullptr && noeud->droite == nullptr)
+            noeud->hauteur = 0;
+    }
+};
+
+/**
+ * \struct PolitiqueTreap
+ * \brief Treap : arbre de recherche sur les mots et monceau sur une priorité pseudo-aléatoire fixée à la création du noeud
+ *
+ *  La forme de l'arbre est celle d'un arbre construit par insertions dans un ordre aléatoire (profondeur moyenne
+ *  ~ 2 ln n), quel que soit l'ordre réel. Un ajout fait en moyenne moins de 2 rotations. Une suppression n'en fait aucune :
+ *  l'arbre échange les mots mais pas les priorités, puis retire une feuille, ce qui préserve l'ordre du monceau.
+ *
+ */
+struct PolitiqueTreap : RotationsArbre
+{
+    static const char* nom() { return "treap"; }
+
+    //La priorité est dérivée de l'adresse du noeud (mélange splitmix64) : rien à synchroniser entre les fils
+    template<typename Noeud>
+    static void initialiser(Noeud* noeud) {
+        uint64_t x = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(noeud));
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        x ^= x >> 31;
+        noeud->hauteur = static_cast<int>(x >> 33);
+    }
+
+    //Seul l'enfant qui vient de recevoir le mot peut avoir une priorité plus grande que le noeud : on le fait monter
+    template<typename Noeud>
+    static void apresInsertion(Noeud*& noeud, CompteursOperations& compteurs) {
+        if (noeud == nullptr)
+            return;
+        rattacherEnfants(noeud);
+
+        if (noeud->gauche != nullptr && noeud->gauche->hauteur > noeud->hauteur)
+            zigZigGauche(noeud, compteurs);
+        else if (noeud->droite != nullptr && noeud->droite->hauteur > noeud->hauteur)
+            zigZigDroite(noeud, compteurs);
+    }
+
+    template<typename Noeud>
+    static void apresSuppression(Noeud*& noeud, CompteursOperations&) {
+        if (noeud != nullptr)
+            rattacherEnfants(noeud);
+    }
+
+    //La forme d'un treap est fixée par les priorités : on construit l'arbre cartésien des noeuds en O(n) avec une pile,
+    //la branche droite de l'arbre en construction. Chaque noeud y remplace ceux de priorité plus petite, qui deviennent
+    //son sous-arbre gauche.
+    template<typename Noeud>
+    static Noeud* construireTrie(Noeud* const* noeuds, std::size_t nombre) {
+        std::vector<Noeud*> brancheDroite;
+        for (std::size_t i = 0; i < nombre; i++) {
+            Noeud* noeud = noeuds[i];
+            noeud->gauche = nullptr;
+            noeud->droite = nullptr;
+            while (!brancheDroite.empty() && brancheDroite.back()->hauteur < noeud->hauteur) {
+                noeud->gauche = brancheDroite.back();
+                brancheDroite.pop_back();
+            }
+            if (!brancheDroite.empty())
+                brancheDroite.back()->droite = noeud;
+            brancheDroite.push_back(noeud);
+        }
+        for (std::size_t i = 0; i < nombre; i++)
+            rattacherEnfants(noeuds[i]);
+        return nombre == 0 ? nullptr : brancheDroite.front();
+    }
+
+    //Le noeud descend le long du bord intérieur de la racine de plus grande priorité jusqu'à dominer les 2 sous-arbres
+    //restants ; le monceau est respecté sans rotation
+    template<typename Noeud>
+    static Noeud* joindre(Noeud* gauche, Noeud* milieu, Noeud* droite, CompteursOperations& compteurs) {
+        if (milieu->hauteur < rang(gauche) || milieu->hauteur < rang(droite)) {
+            if (rang(gauche) > rang(droite)) {
+                gauche->droite = joindre(gauche->droite, milieu, droite, compteurs);
+                rattacherEnfants(gauche);
+                return gauche;
+            }
+            droite->gauche = joindre(gauche, milieu, droite->gauche, compteurs);
+            rattacherEnfants(droite);
+            return droite;
+        }
+        milieu->gauche = gauche;
+        milieu->droite = droite;
+        rattacherEnfants(milieu);
+        return milieu;
+    }
+};
+
+}
+
+#endif /* POLITIQUESEQUILIBRE_H_ */
@@ -10,16 +10,167 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <vector>
+#include <thread>
+#include <cstdlib>
+#include <csignal>
 #include "Dictionnaire.h"
+#include "TraducteurLot.h"
+#include "TraducteurParallele.h"
+#include "ServeurTraduction.h"
 
-
+// Taille des tampons de lecture et d'écriture du mode lot
+#define TAILLE_TAMPON_LOT (1 << 20)
+// Nombre de mots mal écrits dont les suggestions sont gardées en cache (modes lot et serveur)
+#define CAPACITE_CACHE_SUGGESTIONS 65536
 
 using namespace std;
 using namespace TP3;
 
-int main(int argc, char* argv[])
+// Serveur en cours d'exécution, arrêté par SIGINT ou SIGTERM
+static ServeurTraduction* serveurActif = nullptr;
+
+/**
+ * \fn void afficherUsage(const char* programme)
+ * \brief Affiche la syntaxe des arguments de la ligne de commande
+ */
+void afficherUsage(const char* programme)
 {
-    const std::string NON_TRADUISABLE = "NON-TRADUISABLE";
+	cerr << "Usage : " << programme << " (mode interactif)" << endl;
+	cerr << "        " << programme << " --dict FICHIER [--in ENTREE] [--out SORTIE] [--threads N]" << endl;
+	cerr << "  Sans --in ou --out (ou avec -), on lit l'entree standard et on ecrit sur la sortie standard." << endl;
+	cerr << "  --threads N : nombre de fils de traduction (par defaut, le nombre de coeurs ; 1 pour tout faire sur un seul fil)." << endl;
+	cerr << "        " << programme << " --dict FICHIER --serve SOCKET" << endl;
+	cerr << "  Serveur de traduction sur la socket Unix SOCKET, arrete par SIGINT ou SIGTERM." << endl;
+}
+
+/**
+ * \fn void arreterServeur(int signal)
+ * \brief Gestionnaire de SIGINT et SIGTERM : demande l'arrêt du serveur actif
+ */
+extern "C" void arreterServeur(int)
+{
+	if (serveurActif != nullptr)
+		serveurActif->arrete();
+}
+
+/**
+ * \fn int modeServeur(const string& cheminDictionnaire, const string& cheminSocket)
+ * \brief Charge le dictionnaire une seule fois, puis répond aux requêtes des clients jusqu'à SIGINT ou SIGTERM
+ * \param[in] const string& cheminDictionnaire, le fichier du dictionnaire anglais-français
+ * \param[in] const string& cheminSocket, le chemin de la socket Unix
+ * \return int, le code de sortie du programme
+ */
+int modeServeur(const string& cheminDictionnaire, const string& cheminSocket)
+{
+	ifstream fichierDictionnaire(cheminDictionnaire.c_str());
+	if (!fichierDictionnaire) {
+		cerr << "Fichier '" << cheminDictionnaire << "' introuvable!" << endl;
+		return 1;
+	}
+	Dictionnaire dictEnFr(fichierDictionnaire);
+	fichierDictionnaire.close();
+	dictEnFr.activeFiltreBloom();
+	dictEnFr.activeIndexHachage();
+	dictEnFr.activeCacheSuggestions(CAPACITE_CACHE_SUGGESTIONS);
+
+	ServeurTraduction serveur(dictEnFr, cheminSocket);
+	serveurActif = &serveur;
+	signal(SIGINT, arreterServeur);
+	signal(SIGTERM, arreterServeur);
+
+	cerr << "Serveur pret sur " << cheminSocket << endl;
+	serveur.servir();
+
+	signal(SIGINT, SIG_DFL);
+	signal(SIGTERM, SIG_DFL);
+	serveurActif = nullptr;
+	return 0;
+}
+
+/**
+ * \fn int modeLot(const string& cheminDictionnaire, const string& cheminEntree, const string& cheminSortie, unsigned int nbFils)
+ * \brief Traduit un texte complet sans interaction : aucun affichage de l'arbre, aucune question
+ * \param[in] const string& cheminDictionnaire, le fichier du dictionnaire anglais-français
+ * \param[in] const string& cheminEntree, le texte anglais ("-" pour l'entrée standard)
+ * \param[in] const string& cheminSortie, le fichier du texte français ("-" pour la sortie standard)
+ * \param[in] unsigned int nbFils, le nombre de fils de traduction
+ * \return int, le code de sortie du programme
+ *
+ * L'entrée est lue ligne par ligne et chaque ligne traduite est écrite aussitôt, avec de grands tampons d'entrée/sortie.
+ * Les choix sont faits par la politique déterministe de TraducteurLot. Avec plus d'un fil, la lecture, la traduction et
+ * l'écriture se chevauchent (TraducteurParallele) ; la sortie reste dans l'ordre de l'entrée.
+ *
+ */
+int modeLot(const string& cheminDictionnaire, const string& cheminEntree, const string& cheminSortie, unsigned int nbFils)
+{
+	ios::sync_with_stdio(false);
+
+	ifstream fichierDictionnaire(cheminDictionnaire.c_str());
+	if (!fichierDictionnaire) {
+		cerr << "Fichier '" << cheminDictionnaire << "' introuvable!" << endl;
+		return 1;
+	}
+	Dictionnaire dictEnFr(fichierDictionnaire);
+	fichierDictionnaire.close();
+	dictEnFr.activeFiltreBloom();
+	dictEnFr.activeIndexHachage();
+	dictEnFr.activeCacheSuggestions(CAPACITE_CACHE_SUGGESTIONS);
+
+	vector<char> tamponEntree(TAILLE_TAMPON_LOT);
+	vector<char> tamponSortie(TAILLE_TAMPON_LOT);
+
+	ifstream fichierEntree;
+	ofstream fichierSortie;
+	istream* entree = &cin;
+	ostream* sortie = &cout;
+
+	if (cheminEntree != "-") {
+		fichierEntree.rdbuf()->pubsetbuf(tamponEntree.data(), tamponEntree.size());
+		fichierEntree.open(cheminEntree.c_str(), ios::binary);
+		if (!fichierEntree) {
+			cerr << "Fichier '" << cheminEntree << "' introuvable!" << endl;
+			return 1;
+		}
+		entree = &fichierEntree;
+	}
+	if (cheminSortie != "-") {
+		fichierSortie.rdbuf()->pubsetbuf(tamponSortie.data(), tamponSortie.size());
+		fichierSortie.open(cheminSortie.c_str(), ios::binary | ios::trunc);
+		if (!fichierSortie) {
+			cerr << "Impossible d'ecrire le fichier '" << cheminSortie << "'!" << endl;
+			return 1;
+		}
+		sortie = &fichierSortie;
+	}
+
+	if (nbFils > 1)
+	{
+		TraducteurParallele traducteur(dictEnFr, nbFils);
+		traducteur.traduireFlux(*entree, *sortie);
+	}
+	else
+	{
+		TraducteurLot traducteur(dictEnFr);
+		traducteur.traduireFlux(*entree, *sortie);
+	}
+
+	sortie->flush();
+	if (!*sortie) {
+		cerr << "Erreur d'ecriture de la traduction" << endl;
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * \fn int modeInteractif()
+ * \brief Charge un dictionnaire, l'affiche niveau par niveau et traduit une phrase en demandant les choix à l'utilisateur
+ * \return int, le code de sortie du programme
+ */
+int modeInteractif()
+{
+    const std::string NON_TRADUISABLE = TraducteurLot::NON_TRADUISABLE;
 
 	try
 	{
@@ -169,4 +320,52 @@ int main(int argc, char* argv[])
 	}
 
 	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc == 1)
+		return modeInteractif();
+
+	string cheminDictionnaire, cheminEntree = "-", cheminSortie = "-", cheminSocket;
+	unsigned int nbFils = thread::hardware_concurrency();
+	if (nbFils == 0)
+		nbFils = 1;
+	for (int i = 1; i < argc; i++)
+	{
+		string argument = argv[i];
+		if (i + 1 < argc && argument == "--dict")
+			cheminDictionnaire = argv[++i];
+		else if (i + 1 < argc && argument == "--in")
+			cheminEntree = argv[++i];
+		else if (i + 1 < argc && argument == "--out")
+			cheminSortie = argv[++i];
+		else if (i + 1 < argc && argument == "--threads" && atoi(argv[i + 1]) > 0)
+			nbFils = static_cast<unsigned int>(atoi(argv[++i]));
+		else if (i + 1 < argc && argument == "--serve")
+			cheminSocket = argv[++i];
+		else
+		{
+			afficherUsage(argv[0]);
+			return 2;
+		}
+	}
+
+	if (cheminDictionnaire.empty())
+	{
+		afficherUsage(argv[0]);
+		return 2;
+	}
+
+	try
+	{
+		if (!cheminSocket.empty())
+			return modeServeur(cheminDictionnaire, cheminSocket);
+		return modeLot(cheminDictionnaire, cheminEntree, cheminSortie, nbFils);
+	}
+	catch (exception & e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,316 @@
+/**
+ * \file RechargeurDictionnaire.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe RechargeurDictionnaire
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "RechargeurDictionnaire.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+// Taille du tampon de lecture des événements inotify
+#define TAILLE_TAMPON_EVENEMENTS 4096
+
+using namespace std;
+
+namespace TP3
+{
+
+    const int RechargeurDictionnaire::DELAI_STABILISATION_MS;
+
+    /**
+     * \fn RechargeurDictionnaire::RechargeurDictionnaire(const std::string &p_chemin, Preparation p_preparation, std::size_t p_limiteVersions)
+     * \brief Constructeur : charge, prépare et publie la première version du dictionnaire
+     * \param[in] const std::string &p_chemin, le fichier du dictionnaire
+     * \param[in] Preparation p_preparation, appelée sur chaque version avant sa publication (peut être vide)
+     * \param[in] std::size_t p_limiteVersions, nombre maximal de versions publiées encore en vie
+     * \exception logic_error si p_limiteVersions est plus petit que 2
+     * \exception runtime_error si le fichier ne peut pas être chargé ou ne contient aucun mot
+     */
+    RechargeurDictionnaire::RechargeurDictionnaire(const std::string &p_chemin, Preparation p_preparation, std::size_t p_limiteVersions) :
+            chemin(p_chemin), preparation(p_preparation), limiteVersions(p_limiteVersions), dictionnaire(),
+            versions(make_shared<Versions>()), rechargements(0), verrouErreur(), erreur(), verrouRechargement(),
+            filSurveillance(), descripteurInotify(-1), descripteurArret(-1) {
+        if (limiteVersions < 2)
+            throw logic_error("Il faut pouvoir garder au moins 2 versions en vie : la courante et la suivante");
+        versions->enVie = 0;
+        versions->arretDemande = false;
+
+        dictionnaire = _charger();
+        if (!dictionnaire)
+            throw runtime_error(derniereErreur());
+    }
+
+    /**
+     * \fn RechargeurDictionnaire::~RechargeurDictionnaire()
+     * \brief Destructeur, arrête la surveillance
+     *
+     * Les versions tenues par des lecteurs survivent au rechargeur : leur destructeur ne dépend que du compte partagé.
+     *
+     */
+    RechargeurDictionnaire::~RechargeurDictionnaire() {
+        arreteSurveillance();
+    }
+
+    /**
+     * \fn std::shared_ptr<const Dictionnaire> RechargeurDictionnaire::courant() const
+     * \brief Permet d'obtenir la version courante du dictionnaire
+     * \return std::shared_ptr<const Dictionnaire>, la version courante, valide tant que le pointeur est gardé
+     */
+    std::shared_ptr<const Dictionnaire> RechargeurDictionnaire::courant() const {
+        return atomic_load(&dictionnaire);
+    }
+
+    /**
+     * \fn bool RechargeurDictionnaire::recharge()
+     * \brief Permet de recharger le fichier et de publier la nouvelle version
+     * \return bool, true si une nouvelle version a été publiée
+     *
+     * Un seul rechargement à la fois. La nouvelle version est construite et préparée en entier avant d'être publiée : un
+     * lecteur voit l'ancienne ou la nouvelle, jamais une version partielle. L'ancienne est libérée ici si aucun lecteur
+     * ne la tient, sinon par le dernier lecteur qui la relâche.
+     *
+     */
+    bool RechargeurDictionnaire::recharge() {
+        lock_guard<mutex> verrou(verrouRechargement);
+        {
+            lock_guard<mutex> verrouVersions(versions->verrou);
+            if (versions->enVie >= limiteVersions) {
+                _noterErreur("rechargement refuse : " + to_string(versions->enVie) + " versions encore tenues par des lecteurs");
+                return false;
+            }
+        }
+
+        shared_ptr<const Dictionnaire> nouveau = _charger();
+        if (!nouveau)
+            return false;
+        atomic_store(&dictionnaire, nouveau);
+        rechargements.fetch_add(1, memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * \fn void RechargeurDictionnaire::demarreSurveillance()
+     * \brief Permet de démarrer le fil qui recharge le dictionnaire quand son fichier change
+     * \exception logic_error si la surveillance est déjà démarrée
+     * \exception runtime_error si inotify ou l'eventfd d'arrêt ne peut pas être créé
+     *
+     * On surveille le répertoire plutôt que le fichier : un fichier remplacé par renommage est un nouvel inode, qu'une
+     * surveillance du fichier lui-même ne verrait pas.
+     *
+     */
+    void RechargeurDictionnaire::demarreSurveillance() {
+        if (filSurveillance.joinable())
+            throw logic_error("La surveillance du dictionnaire est deja demarree");
+
+        const size_t separateur = chemin.find_last_of('/');
+        const string repertoire = separateur == string::npos ? "." : separateur == 0 ? "/" : chemin.substr(0, separateur);
+        descripteurInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        descripteurArret = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (descripteurInotify < 0 || descripteurArret < 0
+            || inotify_add_watch(descripteurInotify, repertoire.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            string message = strerror(errno);
+            if (descripteurInotify >= 0)
+                close(descripteurInotify);
+            if (descripteurArret >= 0)
+                close(descripteurArret);
+            descripteurInotify = -1;
+            descripteurArret = -1;
+            throw runtime_error("impossible de surveiller " + repertoire + " : " + message);
+        }
+
+        {
+            lock_guard<mutex> verrouVersions(versions->verrou);
+            versions->arretDemande = false;
+        }
+        filSurveillance = thread(&RechargeurDictionnaire::_surveiller, this);
+    }
+
+    /**
+     * \fn void RechargeurDictionnaire::arreteSurveillance()
+     * \brief Permet d'arrêter le fil de surveillance et d'attendre sa fin
+     *
+     * Le fil peut attendre dans poll (réveillé par l'eventfd) ou attendre qu'une version soit libérée (réveillé par la
+     * condition des versions) : on signale les deux.
+     *
+     */
+    void RechargeurDictionnaire::arreteSurveillance() {
+        if (!filSurveillance.joinable())
+            return;
+        {
+            lock_guard<mutex> verrouVersions(versions->verrou);
+            versions->arretDemande = true;
+        }
+        versions->liberee.notify_all();
+        const uint64_t un = 1;
+        if (write(descripteurArret, &un, sizeof(un)) < 0) {
+            //l'eventfd est déjà signalé, l'arrêt est donc déjà demandé
+        }
+        filSurveillance.join();
+        close(descripteurInotify);
+        close(descripteurArret);
+        descripteurInotify = -1;
+        descripteurArret = -1;
+    }
+
+    /**
+     * \fn unsigned long long RechargeurDictionnaire::nombreRechargements() const
+     * \brief Permet de connaître le nombre de versions publiées depuis la construction
+     * \return unsigned long long, le nombre de rechargements réussis
+     */
+    unsigned long long RechargeurDictionnaire::nombreRechargements() const {
+        return rechargements.load(memory_order_relaxed);
+    }
+
+    /**
+     * \fn std::size_t RechargeurDictionnaire::versionsEnVie() const
+     * \brief Permet de connaître le nombre de versions publiées qui ne sont pas encore libérées
+     * \return std::size_t, 1 si aucun lecteur ne tient une ancienne version
+     */
+    std::size_t RechargeurDictionnaire::versionsEnVie() const {
+        lock_guard<mutex> verrouVersions(versions->verrou);
+        return versions->enVie;
+    }
+
+    /**
+     * \fn std::string RechargeurDictionnaire::derniereErreur() const
+     * \brief Permet de connaître la raison du dernier rechargement refusé
+     * \return std::string, le message, vide si aucun rechargement n'a été refusé
+     */
+    std::string RechargeurDictionnaire::derniereErreur() const {
+        lock_guard<mutex> verrou(verrouErreur);
+        return erreur;
+    }
+
+    /**
+     * \fn std::shared_ptr<const Dictionnaire> RechargeurDictionnaire::_charger()
+     * \brief Permet de construire et de préparer une nouvelle version à partir du fichier
+     * \return std::shared_ptr<const Dictionnaire>, la version, nullptr si elle n'a pas pu être construite
+     *
+     * Un fichier vide est refusé : c'est le plus souvent un fichier tronqué en cours de réécriture, et publier un
+     * dictionnaire vide ferait échouer toutes les recherches. Le destructeur de la version décrémente le compte partagé
+     * et réveille le fil de surveillance qui attendrait qu'une version soit libérée.
+     *
+     */
+    std::shared_ptr<const Dictionnaire> RechargeurDictionnaire::_charger() {
+        ifstream fichier(chemin.c_str());
+        if (!fichier) {
+            _noterErreur("impossible d'ouvrir le dictionnaire " + chemin);
+            return shared_ptr<const Dictionnaire>();
+        }
+
+        Dictionnaire* nouveau = nullptr;
+        try {
+            nouveau = new Dictionnaire(fichier);
+            if (nouveau->estVide())
+                throw runtime_error("le dictionnaire " + chemin + " ne contient aucun mot");
+            if (preparation)
+                preparation(*nouveau);
+        } catch (const exception& e) {
+            delete nouveau;
+            _noterErreur(e.what());
+            return shared_ptr<const Dictionnaire>();
+        }
+
+        shared_ptr<Versions> compte = versions;
+        {
+            lock_guard<mutex> verrouVersions(compte->verrou);
+            compte->enVie++;
+        }
+        return shared_ptr<const Dictionnaire>(nouveau, [compte](const Dictionnaire* version) {
+            delete version;
+            {
+                lock_guard<mutex> verrouVersions(compte->verrou);
+                compte->enVie--;
+            }
+            compte->liberee.notify_all();
+        });
+    }
+
+    /**
+     * \fn void RechargeurDictionnaire::_surveiller()
+     * \brief Boucle du fil de surveillance : attend un changement du fichier, le laisse se stabiliser, puis recharge
+     *
+     * Un éditeur ou un outil de déploiement produit souvent plusieurs événements pour une seule mise à jour : on recharge
+     * une seule fois, quand DELAI_STABILISATION_MS s'est écoulé sans nouvel événement. Si limiteVersions versions sont
+     * en vie, on attend qu'un lecteur en relâche une plutôt que de construire une version de plus.
+     *
+     */
+    void RechargeurDictionnaire::_surveiller() {
+        for (;;) {
+            Evenement evenement = _attendreEvenement(-1);
+            if (evenement == EVENEMENT_ARRET)
+                return;
+            if (evenement == EVENEMENT_AUCUN)
+                continue;
+
+            while ((evenement = _attendreEvenement(DELAI_STABILISATION_MS)) == EVENEMENT_FICHIER) {}
+            if (evenement == EVENEMENT_ARRET)
+                return;
+
+            {
+                unique_lock<mutex> verrouVersions(versions->verrou);
+                versions->liberee.wait(verrouVersions, [this]() { return versions->enVie < limiteVersions || versions->arretDemande; });
+                if (versions->arretDemande)
+                    return;
+            }
+            recharge();
+        }
+    }
+
+    /**
+     * \fn RechargeurDictionnaire::Evenement RechargeurDictionnaire::_attendreEvenement(int delaiMs)
+     * \brief Permet d'attendre un événement inotify qui concerne le fichier, ou une demande d'arrêt
+     * \param[in] int delaiMs, l'attente maximale en millisecondes (-1 pour attendre sans limite)
+     * \return Evenement, EVENEMENT_FICHIER si le fichier a été écrit ou remplacé, EVENEMENT_ARRET si l'arrêt est demandé
+     * (ou si poll échoue), EVENEMENT_AUCUN sinon
+     *
+     * Tous les événements en attente sont lus : ceux des autres fichiers du répertoire sont ignorés. Un débordement de
+     * la file d'inotify peut en cacher un qui concerne le fichier ; il compte donc comme un changement.
+     *
+     */
+    RechargeurDictionnaire::Evenement RechargeurDictionnaire::_attendreEvenement(int delaiMs) {
+        pollfd descripteurs[2] = { { descripteurInotify, POLLIN, 0 }, { descripteurArret, POLLIN, 0 } };
+        const int nbPrets = poll(descripteurs, 2, delaiMs);
+        if (nbPrets < 0)
+            return errno == EINTR ? EVENEMENT_AUCUN : EVENEMENT_ARRET;
+        if (descripteurs[1].revents != 0)
+            return EVENEMENT_ARRET;
+        if (nbPrets == 0)
+            return EVENEMENT_AUCUN;
+
+        const size_t separateur = chemin.find_last_of('/');
+        const string nomFichier = separateur == string::npos ? chemin : chemin.substr(separateur + 1);
+        alignas(inotify_event) char tampon[TAILLE_TAMPON_EVENEMENTS];
+        bool concerneFichier = false;
+        for (ssize_t nbOctets; (nbOctets = read(descripteurInotify, tampon, sizeof(tampon))) > 0; ) {
+            for (const char* position = tampon; position < tampon + nbOctets; ) {
+                const inotify_event* evenement = reinterpret_cast<const inotify_event*>(position);
+                if ((evenement->mask & IN_Q_OVERFLOW) || (evenement->len > 0 && nomFichier == evenement->name))
+                    concerneFichier = true;
+                position += sizeof(inotify_event) + evenement->len;
+            }
+        }
+        return concerneFichier ? EVENEMENT_FICHIER : EVENEMENT_AUCUN;
+    }
+
+    /**
+     * \fn void RechargeurDictionnaire::_noterErreur(const std::string &message)
+     * \brief Permet de garder la raison d'un rechargement refusé
+     */
+    void RechargeurDictionnaire::_noterErreur(const std::string &message) {
+        lock_guard<mutex> verrou(verrouErreur);
+        erreur = message;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,145 @@
+/**
+ * \file RechargeurDictionnaire.h
+ * \brief Ce fichier contient l'interface d'un rechargeur à chaud du dictionnaire, sans interrompre les lectures.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef RECHARGEURDICTIONNAIRE_H_
+#define RECHARGEURDICTIONNAIRE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Dictionnaire.h"
+
+namespace TP3
+{
+
+/**
+ * \class RechargeurDictionnaire
+ * \brief Publie la dernière version du dictionnaire chargée d'un fichier, et la recharge quand le fichier change
+ *
+ *  Un lecteur prend la version courante avec courant() et la garde le temps de ses recherches : il n'est jamais bloqué
+ *  par un rechargement. Le nouveau dictionnaire est construit (et préparé : index, filtre, cache...) par le fil de
+ *  surveillance, puis publié d'un seul coup (std::atomic_store). L'ancienne version est libérée quand le dernier
+ *  lecteur qui la tient la relâche.
+ *
+ *  Le fil de surveillance écoute le répertoire du fichier avec inotify : une écriture terminée (IN_CLOSE_WRITE) ou un
+ *  remplacement par renommage (IN_MOVED_TO) déclenche un rechargement, après DELAI_STABILISATION_MS sans autre
+ *  événement. Il attend qu'il y ait moins de limiteVersions versions en vie avant d'en construire une autre : la
+ *  mémoire est bornée à limiteVersions dictionnaires, plus celui en construction.
+ *
+ *  Attributs:
+ *      - std::string chemin, le fichier du dictionnaire
+ *      - Preparation preparation, appelée sur chaque nouvelle version avant sa publication
+ *      - std::size_t limiteVersions, nombre maximal de versions publiées encore en vie
+ *      - std::shared_ptr<const Dictionnaire> dictionnaire, la version courante (lue et remplacée de façon atomique)
+ *      - std::shared_ptr<Versions> versions, compte des versions en vie, partagé avec leurs destructeurs
+ *
+ */
+class RechargeurDictionnaire
+{
+public:
+
+	//Traitement d'une nouvelle version avant sa publication (par exemple activeIndexHachage)
+	typedef std::function<void(Dictionnaire&)> Preparation;
+
+	//Attente sans nouvel événement avant de recharger, pour ne pas lire un fichier en cours de remplacement
+	static const int DELAI_STABILISATION_MS = 100;
+
+	//Constructeur. Charge et publie la première version. La surveillance ne démarre qu'avec demarreSurveillance().
+	//Exception runtime_error si le fichier ne peut pas être chargé
+	//Exception logic_error si limiteVersions est plus petit que 2 (la version courante et la suivante)
+	explicit RechargeurDictionnaire(const std::string& p_chemin, Preparation p_preparation = Preparation(), std::size_t p_limiteVersions = 2);
+
+	RechargeurDictionnaire(const RechargeurDictionnaire&) = delete;
+	RechargeurDictionnaire& operator=(const RechargeurDictionnaire&) = delete;
+
+	//Destructeur, arrête la surveillance. Les versions tenues par des lecteurs restent valides.
+	~RechargeurDictionnaire();
+
+	//La version courante du dictionnaire, à garder pendant les recherches. Sans verrou pour l'appelant, jamais nullptr.
+	std::shared_ptr<const Dictionnaire> courant() const;
+
+	//Recharger le fichier maintenant et publier la nouvelle version
+	//On retourne false (et la version courante reste publiée) si le fichier ne peut pas être chargé, s'il est vide ou si
+	//limiteVersions versions sont encore en vie ; derniereErreur() en donne la raison.
+	bool recharge();
+
+	//Démarrer le fil de surveillance du fichier
+	//Exception runtime_error si inotify ne peut pas surveiller le répertoire du fichier
+	//Exception logic_error si la surveillance est déjà démarrée
+	void demarreSurveillance();
+
+	//Arrêter le fil de surveillance (sans effet s'il n'est pas démarré)
+	void arreteSurveillance();
+
+	//Nombre de versions publiées par recharge() ou par la surveillance depuis la construction
+	unsigned long long nombreRechargements() const;
+
+	//Nombre de versions publiées encore en vie (la courante et celles tenues par des lecteurs)
+	std::size_t versionsEnVie() const;
+
+	//Raison du dernier rechargement refusé (vide s'il n'y en a pas eu)
+	std::string derniereErreur() const;
+
+private:
+
+    /**
+     * \struct Versions
+     * \brief Compte des versions en vie, partagé avec le destructeur de chaque version pour survivre au rechargeur
+     */
+    struct Versions
+    {
+        std::mutex verrou;
+        std::condition_variable liberee;
+        std::size_t enVie;
+        bool arretDemande;
+    };
+
+    /**
+     * \enum Evenement
+     * \brief Résultat d'une attente du fil de surveillance
+     */
+    enum Evenement
+    {
+        EVENEMENT_AUCUN,
+        EVENEMENT_FICHIER,
+        EVENEMENT_ARRET
+    };
+
+    const std::string chemin;
+    const Preparation preparation;
+    const std::size_t limiteVersions;
+    std::shared_ptr<const Dictionnaire> dictionnaire;
+    std::shared_ptr<Versions> versions;
+    std::atomic<unsigned long long> rechargements;
+    mutable std::mutex verrouErreur;
+    std::string erreur;
+
+    std::mutex verrouRechargement;
+    std::thread filSurveillance;
+    int descripteurInotify;
+    int descripteurArret;
+
+    //region private methods
+
+    std::shared_ptr<const Dictionnaire> _charger();
+    void _surveiller();
+    Evenement _attendreEvenement(int delaiMs);
+    void _noterErreur(const std::string& message);
+
+    //endregion
+};
+
+}
+
+#endif /* RECHARGEURDICTIONNAIRE_H_ */
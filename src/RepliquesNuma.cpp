@@ -0,0 +1,201 @@
+/**
+ * \file RepliquesNuma.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe RepliquesNuma
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "RepliquesNuma.h"
+
+#include <algorithm>
+#include <dirent.h>
+#include <exception>
+#include <fstream>
+#include <sched.h>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+using namespace std;
+
+namespace TP3
+{
+
+    const char* const RepliquesNuma::REPERTOIRE_NOEUDS = "/sys/devices/system/node";
+
+    /**
+     * \fn RepliquesNuma::RepliquesNuma(const Dictionnaire &source, bool grandesPages)
+     * \brief Constructeur, qui copie le dictionnaire sur chaque noeud NUMA
+     * \param[in] const Dictionnaire &source, le dictionnaire à répliquer, qui n'est pas modifié
+     * \param[in] bool grandesPages, true pour allouer les noeuds de chaque réplique en grandes pages
+     * \exception runtime_error si un fil ne peut pas être épinglé sur son noeud
+     *
+     * Les répliques sont construites l'une après l'autre, chacune par un nouveau fil épinglé sur son noeud : toute la
+     * mémoire de la copie (noeuds, arène, mots, index) est touchée en premier par ce fil. Une exception de ce fil est
+     * relancée par le constructeur.
+     *
+     */
+    RepliquesNuma::RepliquesNuma(const Dictionnaire &source, bool grandesPages) :
+            processeursParNoeud(), noeudDuProcesseur(), repliques() {
+        _lireTopologie();
+        repliques.resize(processeursParNoeud.size());
+
+        for (size_t noeud = 0; noeud < processeursParNoeud.size(); noeud++) {
+            exception_ptr erreur;
+            thread constructeur([&]() {
+                try {
+                    epingle(noeud);
+                    unique_ptr<Dictionnaire> copie(new Dictionnaire(source));
+                    if (grandesPages && !copie->grandesPagesSontActives())
+                        copie->activeGrandesPages();
+                    repliques[noeud] = std::move(copie);
+                } catch (...) {
+                    erreur = current_exception();
+                }
+            });
+            constructeur.join();
+            if (erreur)
+                rethrow_exception(erreur);
+        }
+    }
+
+    /**
+     * \fn std::size_t RepliquesNuma::nombreNoeuds() const
+     * \brief Permet de connaître le nombre de répliques
+     * \return std::size_t, le nombre de noeuds NUMA avec des processeurs (au moins 1)
+     */
+    std::size_t RepliquesNuma::nombreNoeuds() const {
+        return repliques.size();
+    }
+
+    /**
+     * \fn const Dictionnaire& RepliquesNuma::replique(std::size_t noeud) const
+     * \brief Permet d'obtenir la réplique d'un noeud
+     * \param[in] std::size_t noeud, l'indice du noeud
+     * \return const Dictionnaire&, la réplique
+     * \exception logic_error si le noeud n'existe pas
+     */
+    const Dictionnaire& RepliquesNuma::replique(std::size_t noeud) const {
+        if (noeud >= repliques.size())
+            throw logic_error("noeud NUMA inexistant");
+        return *repliques[noeud];
+    }
+
+    /**
+     * \fn const Dictionnaire& RepliquesNuma::locale() const
+     * \brief Permet d'obtenir la réplique la plus proche du fil appelant
+     * \return const Dictionnaire&, la réplique du noeud du processeur courant
+     *
+     * Un fil qui n'est pas épinglé peut changer de processeur à tout moment : il vaut mieux reprendre la réplique locale
+     * à chaque lot de recherches que la garder pour toute la vie du fil.
+     *
+     */
+    const Dictionnaire& RepliquesNuma::locale() const {
+        return *repliques[noeudCourant()];
+    }
+
+    /**
+     * \fn std::size_t RepliquesNuma::noeudCourant() const
+     * \brief Permet de connaître le noeud du processeur qui exécute le fil appelant
+     * \return std::size_t, l'indice du noeud, 0 si le processeur est inconnu
+     */
+    std::size_t RepliquesNuma::noeudCourant() const {
+        const int processeur = sched_getcpu();
+        if (processeur < 0 || static_cast<size_t>(processeur) >= noeudDuProcesseur.size())
+            return 0;
+        return noeudDuProcesseur[processeur];
+    }
+
+    /**
+     * \fn void RepliquesNuma::epingle(std::size_t noeud) const
+     * \brief Permet d'épingler le fil appelant sur les processeurs d'un noeud
+     * \param[in] std::size_t noeud, l'indice du noeud
+     * \exception logic_error si le noeud n'existe pas
+     * \exception runtime_error si sched_setaffinity échoue
+     */
+    void RepliquesNuma::epingle(std::size_t noeud) const {
+        if (noeud >= processeursParNoeud.size())
+            throw logic_error("noeud NUMA inexistant");
+        if (processeursParNoeud.size() == 1)
+            return;
+
+        cpu_set_t ensemble;
+        CPU_ZERO(&ensemble);
+        for (int processeur : processeursParNoeud[noeud])
+            if (processeur < CPU_SETSIZE)
+                CPU_SET(processeur, &ensemble);
+        if (sched_setaffinity(0, sizeof(ensemble), &ensemble) != 0)
+            throw runtime_error("impossible d'epingler le fil sur le noeud NUMA " + to_string(noeud));
+    }
+
+    /**
+     * \fn void RepliquesNuma::_lireTopologie()
+     * \brief Permet de lire les processeurs de chaque noeud NUMA dans REPERTOIRE_NOEUDS
+     *
+     * Chaque sous-répertoire nodeN contient la liste de ses processeurs (cpulist, par exemple "0-3,8-11"). Les noeuds
+     * sont gardés dans l'ordre de leur numéro, sans trou. Sans noeud lisible, il y a un seul noeud, sans épinglage.
+     *
+     */
+    void RepliquesNuma::_lireTopologie() {
+        vector<pair<int, vector<int> > > noeuds;
+        DIR* repertoire = opendir(REPERTOIRE_NOEUDS);
+        if (repertoire != nullptr) {
+            for (dirent* entree = readdir(repertoire); entree != nullptr; entree = readdir(repertoire)) {
+                const string nom = entree->d_name;
+                if (nom.size() <= 4 || nom.compare(0, 4, "node") != 0 || nom.find_first_not_of("0123456789", 4) != string::npos)
+                    continue;
+                ifstream fichier(string(REPERTOIRE_NOEUDS) + "/" + nom + "/cpulist");
+                string liste;
+                if (!getline(fichier, liste))
+                    continue;
+                vector<int> processeurs = _lireListeProcesseurs(liste);
+                if (!processeurs.empty())
+                    noeuds.push_back(make_pair(stoi(nom.substr(4)), processeurs));
+            }
+            closedir(repertoire);
+        }
+        sort(noeuds.begin(), noeuds.end());
+
+        for (const auto & noeud : noeuds) {
+            for (int processeur : noeud.second) {
+                if (static_cast<size_t>(processeur) >= noeudDuProcesseur.size())
+                    noeudDuProcesseur.resize(processeur + 1, 0);
+                noeudDuProcesseur[processeur] = processeursParNoeud.size();
+            }
+            processeursParNoeud.push_back(noeud.second);
+        }
+        if (processeursParNoeud.empty())
+            processeursParNoeud.push_back(vector<int>());
+    }
+
+    /**
+     * \fn std::vector<int> RepliquesNuma::_lireListeProcesseurs(const std::string &liste)
+     * \brief Permet de décoder une liste de processeurs du noyau
+     * \param[in] const std::string &liste, des numéros et des intervalles séparés par des virgules ("0-3,8,10-11")
+     * \return std::vector<int>, les numéros des processeurs, vide si la liste est vide ou mal formée
+     */
+    std::vector<int> RepliquesNuma::_lireListeProcesseurs(const std::string &liste) {
+        vector<int> processeurs;
+        istringstream flux(liste);
+        string morceau;
+        while (getline(flux, morceau, ',')) {
+            int premier = 0, dernier = 0;
+            char tiret = 0;
+            istringstream intervalle(morceau);
+            if (!(intervalle >> premier))
+                return vector<int>();
+            dernier = premier;
+            if (intervalle >> tiret && (tiret != '-' || !(intervalle >> dernier)))
+                return vector<int>();
+            if (premier < 0 || dernier < premier)
+                return vector<int>();
+            for (int processeur = premier; processeur <= dernier; processeur++)
+                processeurs.push_back(processeur);
+        }
+        return processeurs;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,92 @@
+/**
+ * \file RepliquesNuma.h
+ * \brief Ce fichier contient l'interface d'un ensemble de répliques en lecture seule du dictionnaire, une par noeud NUMA.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef REPLIQUESNUMA_H_
+#define REPLIQUESNUMA_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Dictionnaire.h"
+
+namespace TP3
+{
+
+/**
+ * \class RepliquesNuma
+ * \brief Une copie du dictionnaire par noeud NUMA, et l'aiguillage de chaque fil vers la copie de son noeud
+ *
+ *  Sur une machine à plusieurs sockets, un fil qui descend un arbre placé dans la mémoire d'un autre socket paie un
+ *  accès distant à chaque noeud. Chaque réplique est construite par un fil épinglé sur les processeurs de son noeud
+ *  NUMA : le noyau place les pages sur le noeud du fil qui les touche en premier, donc sur le bon noeud, sans libnuma.
+ *  locale() retourne la réplique du noeud du processeur qui exécute le fil appelant ; un fil épinglé avec epingle()
+ *  reste près de sa réplique.
+ *
+ *  La topologie est lue dans /sys/devices/system/node. Sans elle (autre système, conteneur restreint), ou avec un seul
+ *  noeud, il n'y a qu'une réplique. Les noeuds sans processeur (mémoire seulement) n'ont pas de réplique.
+ *
+ *  Les répliques sont en lecture seule : elles ne doivent pas être modifiées après la construction.
+ *
+ *  Attributs:
+ *      - std::vector<std::vector<int> > processeursParNoeud, les processeurs de chaque noeud qui a une réplique
+ *      - std::vector<std::size_t> noeudDuProcesseur, la réplique de chaque processeur (indice = numéro du processeur)
+ *      - std::vector<std::unique_ptr<Dictionnaire> > repliques, une copie du dictionnaire par noeud
+ *
+ */
+class RepliquesNuma
+{
+public:
+
+	//Répertoire de la topologie NUMA du noyau
+	static const char* const REPERTOIRE_NOEUDS;
+
+	//Constructeur : une copie de 'source' par noeud NUMA (voir le constructeur de copie de Dictionnaire), construite
+	//par un fil épinglé sur le noeud. Avec grandesPages, les noeuds de chaque copie sont alloués en grandes pages.
+	//Exception runtime_error si un fil ne peut pas être épinglé sur son noeud
+	explicit RepliquesNuma(const Dictionnaire& source, bool grandesPages = false);
+
+	RepliquesNuma(const RepliquesNuma&) = delete;
+	RepliquesNuma& operator=(const RepliquesNuma&) = delete;
+
+	//Nombre de répliques (au moins 1)
+	std::size_t nombreNoeuds() const;
+
+	//La réplique d'un noeud (un indice de 0 à nombreNoeuds() - 1)
+	//Exception logic_error si noeud >= nombreNoeuds()
+	const Dictionnaire& replique(std::size_t noeud) const;
+
+	//La réplique du noeud du processeur qui exécute le fil appelant
+	const Dictionnaire& locale() const;
+
+	//Indice du noeud du processeur qui exécute le fil appelant (0 s'il est inconnu)
+	std::size_t noeudCourant() const;
+
+	//Épingler le fil appelant sur les processeurs d'un noeud (sans effet s'il n'y a qu'un noeud)
+	//Exception logic_error si noeud >= nombreNoeuds()
+	//Exception runtime_error si le système refuse l'épinglage
+	void epingle(std::size_t noeud) const;
+
+private:
+
+    std::vector<std::vector<int> > processeursParNoeud;
+    std::vector<std::size_t> noeudDuProcesseur;
+    std::vector<std::unique_ptr<Dictionnaire> > repliques;
+
+    //region private methods
+
+    void _lireTopologie();
+    static std::vector<int> _lireListeProcesseurs(const std::string& liste);
+
+    //endregion
+};
+
+}
+
+#endif /* REPLIQUESNUMA_H_ */
@@ -0,0 +1,429 @@
+/**
+ * \file ServeurTraduction.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe ServeurTraduction
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "ServeurTraduction.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Nombre maximal d'événements traités par appel à epoll_wait, et taille du tampon de lecture
+#define NB_EVENEMENTS 64
+#define TAILLE_TAMPON_LECTURE 16384
+
+using namespace std;
+
+namespace TP3
+{
+
+    const std::size_t ServeurTraduction::TAILLE_MAX_REQUETE;
+    const std::size_t ServeurTraduction::REQUETES_MAX_PAR_CONNEXION;
+    const std::size_t ServeurTraduction::REQUETES_MAX_PAR_LOT;
+
+    /**
+     * \fn ServeurTraduction::ServeurTraduction(const Dictionnaire &p_dictionnaire, const std::string &p_cheminSocket)
+     * \brief Constructeur d'un serveur qui écoute sur une socket Unix
+     * \param[in] const Dictionnaire &p_dictionnaire, le dictionnaire déjà chargé, qui doit survivre au serveur
+     * \param[in] const std::string &p_cheminSocket, le chemin du fichier de socket
+     * \exception runtime_error si la socket, epoll ou l'eventfd d'arrêt ne peut pas être créé
+     *
+     * La socket écoute dès la construction : un client peut se connecter avant même l'appel de servir().
+     *
+     */
+    ServeurTraduction::ServeurTraduction(const Dictionnaire &p_dictionnaire, const std::string &p_cheminSocket) :
+            traducteur(p_dictionnaire), dictionnaire(p_dictionnaire), cheminSocket(p_cheminSocket),
+            descripteurEcoute(-1), descripteurEpoll(-1), descripteurArret(-1), connexions(), enAttente(), requetes(0), calculs(0),
+            lots(0) {
+        sockaddr_un adresse;
+        memset(&adresse, 0, sizeof(adresse));
+        adresse.sun_family = AF_UNIX;
+        if (cheminSocket.empty() || cheminSocket.size() >= sizeof(adresse.sun_path))
+            throw runtime_error("chemin de socket invalide : " + cheminSocket);
+        memcpy(adresse.sun_path, cheminSocket.c_str(), cheminSocket.size());
+
+        descripteurEcoute = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        unlink(cheminSocket.c_str());
+        if (descripteurEcoute < 0
+            || bind(descripteurEcoute, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)) < 0
+            || listen(descripteurEcoute, SOMAXCONN) < 0) {
+            string erreur = strerror(errno);
+            _fermerDescripteurs();
+            throw runtime_error("impossible d'ecouter sur " + cheminSocket + " : " + erreur);
+        }
+
+        descripteurEpoll = epoll_create1(EPOLL_CLOEXEC);
+        descripteurArret = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event evenementEcoute = {};
+        evenementEcoute.events = EPOLLIN;
+        evenementEcoute.data.fd = descripteurEcoute;
+        epoll_event evenementArret = {};
+        evenementArret.events = EPOLLIN;
+        evenementArret.data.fd = descripteurArret;
+        if (descripteurEpoll < 0 || descripteurArret < 0
+            || epoll_ctl(descripteurEpoll, EPOLL_CTL_ADD, descripteurEcoute, &evenementEcoute) < 0
+            || epoll_ctl(descripteurEpoll, EPOLL_CTL_ADD, descripteurArret, &evenementArret) < 0) {
+            string erreur = strerror(errno);
+            _fermerDescripteurs();
+            unlink(cheminSocket.c_str());
+            throw runtime_error("impossible de creer la boucle d'evenements : " + erreur);
+        }
+    }
+
+    /**
+     * \fn ServeurTraduction::~ServeurTraduction()
+     * \brief Destructeur, ferme les connexions restantes et retire le fichier de socket
+     */
+    ServeurTraduction::~ServeurTraduction() {
+        for (const auto & connexion : connexions)
+            close(connexion.first);
+        connexions.clear();
+        _fermerDescripteurs();
+        unlink(cheminSocket.c_str());
+    }
+
+    /**
+     * \fn void ServeurTraduction::servir()
+     * \brief Boucle d'événements : accepte les clients, lit leurs requêtes, les traite par lots et envoie les réponses
+     * \exception runtime_error si epoll_wait échoue
+     *
+     * Un tour de boucle lit ce qui est disponible sur les connexions prêtes avant de traiter quoi que ce soit : plus la
+     * charge est forte, plus les lots sont gros et plus les doublons sont fréquents. Les connexions en attente du tour
+     * précédent sont découpées en premier ; tant qu'il y en a, epoll_wait ne bloque pas. Une connexion fermée par le
+     * client (fin de fichier) reçoit quand même les réponses à ses dernières requêtes avant d'être fermée.
+     *
+     */
+    void ServeurTraduction::servir() {
+        epoll_event evenements[NB_EVENEMENTS];
+        vector<Requete> lot;
+        vector<int> descripteursActifs;
+        bool arretDemande = false;
+
+        while (!arretDemande) {
+            int nbEvenements = epoll_wait(descripteurEpoll, evenements, NB_EVENEMENTS, enAttente.empty() ? -1 : 0);
+            if (nbEvenements < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw runtime_error(string("epoll_wait : ") + strerror(errno));
+            }
+
+            lot.clear();
+            descripteursActifs.clear();
+            descripteursActifs.swap(enAttente);
+            for (int i = 0; i < nbEvenements; i++) {
+                const int descripteur = evenements[i].data.fd;
+                if (descripteur == descripteurArret) {
+                    uint64_t valeur;
+                    if (read(descripteurArret, &valeur, sizeof(valeur)) >= 0)
+                        arretDemande = true;
+                } else if (descripteur == descripteurEcoute) {
+                    _accepter();
+                } else {
+                    auto connexion = connexions.find(descripteur);
+                    if (connexion == connexions.end())
+                        continue;
+                    if (((evenements[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !_lire(descripteur, connexion->second))
+                        || ((evenements[i].events & EPOLLOUT) && !_ecrire(descripteur, connexion->second))) {
+                        _fermer(descripteur);
+                        continue;
+                    }
+                    if (!connexion->second.enAttente) {
+                        connexion->second.enAttente = true;
+                        descripteursActifs.push_back(descripteur);
+                    }
+                }
+            }
+
+            for (int descripteur : descripteursActifs) {
+                auto connexion = connexions.find(descripteur);
+                if (connexion == connexions.end())
+                    continue;
+                connexion->second.enAttente = _decouper(descripteur, connexion->second, lot);
+                if (connexion->second.enAttente)
+                    enAttente.push_back(descripteur);
+            }
+
+            if (!lot.empty())
+                _traiterLot(lot);
+
+            for (int descripteur : descripteursActifs) {
+                auto connexion = connexions.find(descripteur);
+                if (connexion == connexions.end())
+                    continue;
+                if (!_ecrire(descripteur, connexion->second)
+                    || (connexion->second.fermetureDemandee && connexion->second.sortie.empty() && !connexion->second.enAttente))
+                    _fermer(descripteur);
+            }
+        }
+    }
+
+    /**
+     * \fn void ServeurTraduction::arrete()
+     * \brief Permet de demander l'arrêt de la boucle d'événements
+     *
+     * On se contente d'écrire dans l'eventfd surveillé par epoll : c'est sûr depuis un autre fil et depuis un gestionnaire de signal.
+     *
+     */
+    void ServeurTraduction::arrete() {
+        const uint64_t un = 1;
+        if (write(descripteurArret, &un, sizeof(un)) < 0) {
+            //l'eventfd est déjà signalé, l'arrêt est donc déjà demandé
+        }
+    }
+
+    /**
+     * \fn unsigned long long ServeurTraduction::nombreRequetes() const
+     * \brief Permet de connaître le nombre de requêtes reçues
+     * \return unsigned long long, le nombre de requêtes
+     */
+    unsigned long long ServeurTraduction::nombreRequetes() const {
+        return requetes.load(memory_order_relaxed);
+    }
+
+    /**
+     * \fn unsigned long long ServeurTraduction::nombreCalculs() const
+     * \brief Permet de connaître le nombre de requêtes distinctes réellement calculées
+     * \return unsigned long long, le nombre de calculs
+     */
+    unsigned long long ServeurTraduction::nombreCalculs() const {
+        return calculs.load(memory_order_relaxed);
+    }
+
+    /**
+     * \fn unsigned long long ServeurTraduction::nombreLots() const
+     * \brief Permet de connaître le nombre de lots traités
+     * \return unsigned long long, le nombre de lots
+     */
+    unsigned long long ServeurTraduction::nombreLots() const {
+        return lots.load(memory_order_relaxed);
+    }
+
+    /**
+     * \fn void ServeurTraduction::_accepter()
+     * \brief Permet d'accepter toutes les connexions en attente et de les ajouter à epoll
+     */
+    void ServeurTraduction::_accepter() {
+        for (;;) {
+            int descripteur = accept4(descripteurEcoute, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (descripteur < 0)
+                return; //EAGAIN : plus de connexion en attente. Une autre erreur ne concerne que ce client.
+
+            epoll_event evenement = {};
+            evenement.events = EPOLLIN;
+            evenement.data.fd = descripteur;
+            if (epoll_ctl(descripteurEpoll, EPOLL_CTL_ADD, descripteur, &evenement) < 0) {
+                close(descripteur);
+                continue;
+            }
+            Connexion connexion = { string(), string(), false, false, false };
+            connexions[descripteur] = connexion;
+        }
+    }
+
+    /**
+     * \fn bool ServeurTraduction::_lire(int descripteur, Connexion &connexion)
+     * \brief Permet de lire ce qu'un client a envoyé, jusqu'à remplir son tampon d'entrée
+     * \param[in] int descripteur, la socket du client
+     * \param[in] Connexion &connexion, l'état de la connexion
+     * \return bool, false si la connexion doit être fermée immédiatement (erreur ou requête trop longue)
+     *
+     * On cesse de lire dès que le tampon d'entrée dépasse TAILLE_MAX_REQUETE : un tour ne prend pas plus de
+     * TAILLE_MAX_REQUETE + TAILLE_TAMPON_LECTURE octets à un client, et le reste attend dans la socket (epoll nous
+     * réveillera encore). La requête incomplète à la fin du tampon est vérifiée après chaque lecture.
+     *
+     */
+    bool ServeurTraduction::_lire(int descripteur, Connexion &connexion) {
+        char tampon[TAILLE_TAMPON_LECTURE];
+        while (connexion.entree.size() <= TAILLE_MAX_REQUETE) {
+            ssize_t nbOctets = read(descripteur, tampon, sizeof(tampon));
+            if (nbOctets > 0) {
+                connexion.entree.append(tampon, static_cast<size_t>(nbOctets));
+                const size_t derniereFin = connexion.entree.rfind('\n');
+                const size_t incomplete = derniereFin == string::npos ? connexion.entree.size()
+                                                                      : connexion.entree.size() - derniereFin - 1;
+                if (incomplete > TAILLE_MAX_REQUETE)
+                    return false;
+                continue;
+            }
+            if (nbOctets == 0) {
+                connexion.fermetureDemandee = true;
+                break;
+            }
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * \fn bool ServeurTraduction::_decouper(int descripteur, Connexion &connexion, std::vector<Requete> &lot)
+     * \brief Permet d'ajouter au lot les premières requêtes complètes d'un client
+     * \param[in] int descripteur, la socket du client
+     * \param[in] Connexion &connexion, l'état de la connexion
+     * \param[out] std::vector<Requete> &lot, le lot courant
+     * \return bool, true s'il reste des requêtes complètes pour un prochain lot
+     *
+     * On prend au plus REQUETES_MAX_PAR_CONNEXION requêtes, et aucune si le lot a déjà REQUETES_MAX_PAR_LOT requêtes.
+     *
+     */
+    bool ServeurTraduction::_decouper(int descripteur, Connexion &connexion, std::vector<Requete> &lot) {
+        size_t debut = 0;
+        size_t fin = connexion.entree.find('\n');
+        for (size_t nbRequetes = 0; fin != string::npos && nbRequetes < REQUETES_MAX_PAR_CONNEXION
+                                    && lot.size() < REQUETES_MAX_PAR_LOT; nbRequetes++) {
+            size_t longueur = fin - debut;
+            if (longueur > 0 && connexion.entree[fin - 1] == '\r')
+                longueur--;
+            Requete requete = { descripteur, connexion.entree.substr(debut, longueur) };
+            lot.push_back(requete);
+            debut = fin + 1;
+            fin = connexion.entree.find('\n', debut);
+        }
+        connexion.entree.erase(0, debut);
+        return fin != string::npos;
+    }
+
+    /**
+     * \fn bool ServeurTraduction::_ecrire(int descripteur, Connexion &connexion)
+     * \brief Permet d'envoyer au client autant de réponses que la socket en accepte
+     * \param[in] int descripteur, la socket du client
+     * \param[in] Connexion &connexion, l'état de la connexion
+     * \return bool, false si la connexion doit être fermée (erreur d'écriture)
+     *
+     * Si la socket est pleine, on demande à epoll de nous réveiller quand elle redevient disponible (EPOLLOUT) ; on cesse
+     * de surveiller la lecture d'un client qui a fini d'envoyer, pour ne pas être réveillé en boucle par sa fin de fichier.
+     *
+     */
+    bool ServeurTraduction::_ecrire(int descripteur, Connexion &connexion) {
+        size_t envoye = 0;
+        while (envoye < connexion.sortie.size()) {
+            ssize_t nbOctets = send(descripteur, connexion.sortie.data() + envoye, connexion.sortie.size() - envoye, MSG_NOSIGNAL);
+            if (nbOctets >= 0) {
+                envoye += static_cast<size_t>(nbOctets);
+                continue;
+            }
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            return false;
+        }
+        connexion.sortie.erase(0, envoye);
+
+        const bool doitAttendre = !connexion.sortie.empty();
+        if (doitAttendre != connexion.attendEcriture) {
+            epoll_event evenement = {};
+            evenement.events = (connexion.fermetureDemandee ? 0u : static_cast<uint32_t>(EPOLLIN))
+                               | (doitAttendre ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+            evenement.data.fd = descripteur;
+            if (epoll_ctl(descripteurEpoll, EPOLL_CTL_MOD, descripteur, &evenement) < 0)
+                return false;
+            connexion.attendEcriture = doitAttendre;
+        }
+        return true;
+    }
+
+    /**
+     * \fn void ServeurTraduction::_traiterLot(const std::vector<Requete> &lot)
+     * \brief Permet de calculer les réponses d'un lot et de les ajouter aux tampons de sortie, dans l'ordre des requêtes
+     * \param[in] const std::vector<Requete> &lot, les requêtes reçues pendant ce tour de boucle
+     */
+    void ServeurTraduction::_traiterLot(const std::vector<Requete> &lot) {
+        unordered_map<string, string> reponses;
+        reponses.reserve(lot.size());
+
+        for (const auto & requete : lot) {
+            auto reponse = reponses.emplace(requete.commande, string());
+            if (reponse.second) {
+                reponse.first->second = _repondre(requete.commande);
+                calculs.fetch_add(1, memory_order_relaxed);
+            }
+
+            auto connexion = connexions.find(requete.descripteur);
+            if (connexion != connexions.end()) {
+                connexion->second.sortie += reponse.first->second;
+                connexion->second.sortie += '\n';
+            }
+        }
+
+        requetes.fetch_add(lot.size(), memory_order_relaxed);
+        lots.fetch_add(1, memory_order_relaxed);
+    }
+
+    /**
+     * \fn std::string ServeurTraduction::_repondre(const std::string &commande) const
+     * \brief Permet de calculer la réponse à une requête
+     * \param[in] const std::string &commande, la ligne de requête, sans le '\n'
+     * \return std::string, la ligne de réponse, sans le '\n'
+     */
+    std::string ServeurTraduction::_repondre(const std::string &commande) const {
+        if (commande.size() < 2 || commande[1] != ' ')
+            return "ERREUR\trequete invalide";
+
+        const string argument = commande.substr(2);
+        string reponse = "OK";
+        switch (commande[0]) {
+            case 'T': {
+                vector<string> traductions = dictionnaire.traduit(argument);
+                if (traductions.empty())
+                    return "ABSENT";
+                for (const auto & traduction : traductions)
+                    reponse += '\t' + traduction;
+                return reponse;
+            }
+            case 'S': {
+                if (dictionnaire.estVide())
+                    return reponse;
+                for (const auto & suggestion : dictionnaire.suggereCorrections(argument))
+                    reponse += '\t' + suggestion;
+                return reponse;
+            }
+            case 'L':
+                reponse += '\t';
+                traducteur.traduireLigne(argument, reponse);
+                return reponse;
+            default:
+                return "ERREUR\tcommande inconnue";
+        }
+    }
+
+    /**
+     * \fn void ServeurTraduction::_fermer(int descripteur)
+     * \brief Permet de fermer la connexion d'un client et d'oublier son état
+     * \param[in] int descripteur, la socket du client
+     */
+    void ServeurTraduction::_fermer(int descripteur) {
+        epoll_ctl(descripteurEpoll, EPOLL_CTL_DEL, descripteur, nullptr);
+        close(descripteur);
+        connexions.erase(descripteur);
+    }
+
+    /**
+     * \fn void ServeurTraduction::_fermerDescripteurs()
+     * \brief Permet de fermer la socket d'écoute, epoll et l'eventfd d'arrêt
+     */
+    void ServeurTraduction::_fermerDescripteurs() {
+        if (descripteurArret >= 0)
+            close(descripteurArret);
+        if (descripteurEpoll >= 0)
+            close(descripteurEpoll);
+        if (descripteurEcoute >= 0)
+            close(descripteurEcoute);
+        descripteurArret = descripteurEpoll = descripteurEcoute = -1;
+    }
+
+}//Fin du namespace
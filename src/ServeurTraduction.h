@@ -0,0 +1,146 @@
+/**
+ * \file ServeurTraduction.h
+ * \brief Ce fichier contient l'interface d'un serveur de traduction local (socket Unix, boucle epoll).
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef SERVEURTRADUCTION_H_
+#define SERVEURTRADUCTION_H_
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Dictionnaire.h"
+#include "TraducteurLot.h"
+
+namespace TP3
+{
+
+/**
+ * \class ServeurTraduction
+ * \brief Serveur de longue durée qui charge le dictionnaire une seule fois et répond aux requêtes de clients locaux
+ *
+ *  Protocole texte, une requête par ligne (terminée par '\n'), une réponse par ligne, dans l'ordre des requêtes :
+ *      - "T mot"    : traductions du mot          -> "OK\ttrad1\ttrad2..." ou "ABSENT"
+ *      - "S mot"    : suggestions de correction   -> "OK\tsugg1\tsugg2..."
+ *      - "L phrase" : traduction d'une phrase     -> "OK\tphrase traduite" (politique de TraducteurLot)
+ *      - autre      :                             -> "ERREUR\tmessage"
+ *  Un client peut envoyer plusieurs requêtes sans attendre les réponses (pipelining).
+ *
+ *  Une seule boucle epoll gère toutes les connexions sur un seul fil. À chaque tour, les requêtes complètes reçues de
+ *  toutes les connexions prêtes forment un lot : chaque requête distincte du lot n'est calculée qu'une fois, puis les
+ *  réponses sont écrites dans les tampons de sortie des connexions.
+ *
+ *  Le travail d'un tour est borné, pour qu'un client qui envoie un gros lot de suggestions ne bloque pas les autres :
+ *  une connexion fournit au plus REQUETES_MAX_PAR_CONNEXION requêtes à un lot, et un lot compte au plus
+ *  REQUETES_MAX_PAR_LOT requêtes. On ne lit plus sur une connexion dont le tampon d'entrée dépasse TAILLE_MAX_REQUETE.
+ *  Les requêtes complètes qui restent sont gardées pour les tours suivants (connexions en attente, servies en premier,
+ *  sans attendre de nouvel événement).
+ *
+ *  Attributs:
+ *      - TraducteurLot traducteur, la politique de traduction des phrases
+ *      - const Dictionnaire & dictionnaire, le dictionnaire (lu seulement)
+ *      - std::string cheminSocket, le chemin de la socket Unix
+ *      - int descripteurEcoute, descripteurEpoll, descripteurArret, les descripteurs de la socket d'écoute, d'epoll et de l'eventfd d'arrêt
+ *      - std::unordered_map<int, Connexion> connexions, les clients connectés, par descripteur
+ *      - std::vector<int> enAttente, les connexions qui ont encore des requêtes complètes à traiter, dans l'ordre
+ *
+ */
+class ServeurTraduction
+{
+public:
+
+	//Taille maximale d'une requête. Un client qui dépasse cette taille est déconnecté.
+	static const std::size_t TAILLE_MAX_REQUETE = 64 * 1024;
+
+	//Nombre maximal de requêtes d'une même connexion dans un lot
+	static const std::size_t REQUETES_MAX_PAR_CONNEXION = 128;
+
+	//Nombre maximal de requêtes dans un lot (un tour de boucle)
+	static const std::size_t REQUETES_MAX_PAR_LOT = 512;
+
+	//Constructeur. Crée la socket Unix (en remplaçant un fichier de socket existant), puis commence à écouter.
+	//Exception runtime_error si la socket ne peut pas être créée
+	ServeurTraduction(const Dictionnaire& p_dictionnaire, const std::string& p_cheminSocket);
+
+	ServeurTraduction(const ServeurTraduction&) = delete;
+	ServeurTraduction& operator=(const ServeurTraduction&) = delete;
+
+	//Destructeur, ferme les connexions et retire le fichier de socket
+	~ServeurTraduction();
+
+	//Servir les clients jusqu'à l'appel de arrete()
+	//Exception runtime_error si epoll échoue
+	void servir();
+
+	//Demander l'arrêt de servir(). Peut être appelé par un autre fil ou par un gestionnaire de signal.
+	void arrete();
+
+	//Nombre de requêtes reçues
+	unsigned long long nombreRequetes() const;
+
+	//Nombre de requêtes distinctes calculées (les doublons d'un même lot ne sont calculés qu'une fois)
+	unsigned long long nombreCalculs() const;
+
+	//Nombre de lots traités
+	unsigned long long nombreLots() const;
+
+private:
+
+    /**
+     * \struct Connexion
+     * \brief Un client : ce qui reste à découper en requêtes et ce qui reste à lui envoyer
+     */
+    struct Connexion
+    {
+        std::string entree;
+        std::string sortie;
+        bool fermetureDemandee;
+        bool attendEcriture;
+        bool enAttente;
+    };
+
+    /**
+     * \struct Requete
+     * \brief Une requête complète du lot courant : le client, la commande et son argument
+     */
+    struct Requete
+    {
+        int descripteur;
+        std::string commande;
+    };
+
+    TraducteurLot traducteur;
+    const Dictionnaire& dictionnaire;
+    const std::string cheminSocket;
+    int descripteurEcoute;
+    int descripteurEpoll;
+    int descripteurArret;
+    std::unordered_map<int, Connexion> connexions;
+    std::vector<int> enAttente;
+    std::atomic<unsigned long long> requetes;
+    std::atomic<unsigned long long> calculs;
+    std::atomic<unsigned long long> lots;
+
+    //region private methods
+
+    void _accepter();
+    bool _lire(int descripteur, Connexion& connexion);
+    bool _decouper(int descripteur, Connexion& connexion, std::vector<Requete>& lot);
+    bool _ecrire(int descripteur, Connexion& connexion);
+    void _traiterLot(const std::vector<Requete>& lot);
+    std::string _repondre(const std::string& commande) const;
+    void _fermer(int descripteur);
+    void _fermerDescripteurs();
+
+    //endregion
+};
+
+}
+
+#endif /* SERVEURTRADUCTION_H_ */
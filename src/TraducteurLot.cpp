@@ -0,0 +1,108 @@
+/**
+ * \file TraducteurLot.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe TraducteurLot
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "TraducteurLot.h"
+
+using namespace std;
+
+namespace TP3
+{
+
+    const std::string TraducteurLot::NON_TRADUISABLE = "NON-TRADUISABLE";
+
+    /**
+     * \fn TraducteurLot::TraducteurLot(const Dictionnaire &p_dictionnaire)
+     * \brief Constructeur d'un traducteur qui utilise un dictionnaire déjà chargé
+     * \param[in] const Dictionnaire &p_dictionnaire, le dictionnaire anglais-français
+     */
+    TraducteurLot::TraducteurLot(const Dictionnaire &p_dictionnaire) : dictionnaire(p_dictionnaire) {}
+
+    /**
+     * \fn std::string TraducteurLot::traduireMot(const std::string &motAnglais) const
+     * \brief Permet de traduire un mot sans demander de choix à l'utilisateur
+     * \param[in] const std::string &motAnglais, le mot à traduire
+     * \return std::string, la traduction choisie, ou NON_TRADUISABLE
+     *
+     * On appelle directement 'traduit' (un vecteur vide signifie que le mot est absent), ce qui évite la recherche
+     * supplémentaire de 'appartient'. Les suggestions ne sont calculées que pour un mot absent.
+     *
+     */
+    std::string TraducteurLot::traduireMot(const std::string &motAnglais) const {
+        vector<string> traductions = dictionnaire.traduit(motAnglais);
+        if (!traductions.empty())
+            return traductions[0];
+
+        if (dictionnaire.estVide())
+            return NON_TRADUISABLE;
+
+        vector<string> suggestions = dictionnaire.suggereCorrections(motAnglais);
+        if (suggestions.empty())
+            return NON_TRADUISABLE;
+
+        traductions = dictionnaire.traduit(suggestions[0]);
+        if (traductions.empty())
+            return NON_TRADUISABLE;
+        return traductions[0];
+    }
+
+    /**
+     * \fn void TraducteurLot::traduireLigne(const std::string &ligne, std::string &sortie) const
+     * \brief Permet de traduire les mots d'une ligne
+     * \param[in] const std::string &ligne, la ligne à traduire
+     * \param[out] std::string &sortie, la chaîne à laquelle on ajoute les traductions, séparées par une espace
+     *
+     * Les mots sont délimités directement dans la ligne, sans stringstream, afin de réutiliser les tampons de l'appelant.
+     *
+     */
+    void TraducteurLot::traduireLigne(const std::string &ligne, std::string &sortie) const {
+        const char* const SEPARATEURS = " \t\r";
+        bool premierMot = true;
+        string mot;
+
+        size_t debut = ligne.find_first_not_of(SEPARATEURS);
+        while (debut != string::npos) {
+            size_t fin = ligne.find_first_of(SEPARATEURS, debut);
+            mot.assign(ligne, debut, fin == string::npos ? string::npos : fin - debut);
+
+            if (!premierMot)
+                sortie += ' ';
+            sortie += traduireMot(mot);
+            premierMot = false;
+
+            debut = fin == string::npos ? fin : ligne.find_first_not_of(SEPARATEURS, fin);
+        }
+    }
+
+    /**
+     * \fn unsigned long long TraducteurLot::traduireFlux(std::istream &entree, std::ostream &sortie) const
+     * \brief Permet de traduire un flux complet ligne par ligne
+     * \param[in] std::istream &entree, le texte anglais
+     * \param[in] std::ostream &sortie, le flux où écrire le texte français
+     * \return unsigned long long, le nombre de lignes traduites
+     *
+     * Une seule ligne est gardée en mémoire à la fois, la taille de l'entrée n'est donc pas limitée. On écrit '\n' plutôt
+     * que std::endl pour laisser le tampon du flux de sortie regrouper les écritures.
+     *
+     */
+    unsigned long long TraducteurLot::traduireFlux(std::istream &entree, std::ostream &sortie) const {
+        unsigned long long nbLignes = 0;
+        string ligne;
+        string ligneTraduite;
+
+        while (getline(entree, ligne)) {
+            ligneTraduite.clear();
+            traduireLigne(ligne, ligneTraduite);
+            ligneTraduite += '\n';
+            sortie.write(ligneTraduite.data(), static_cast<streamsize>(ligneTraduite.size()));
+            nbLignes++;
+        }
+        return nbLignes;
+    }
+
+}//Fin du namespace
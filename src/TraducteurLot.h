@@ -0,0 +1,60 @@
+/**
+ * \file TraducteurLot.h
+ * \brief Ce fichier contient l'interface d'un traducteur non interactif de flux de texte.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef TRADUCTEURLOT_H_
+#define TRADUCTEURLOT_H_
+
+#include <iostream>
+#include <string>
+#include "Dictionnaire.h"
+
+namespace TP3
+{
+
+/**
+ * \class TraducteurLot
+ * \brief Traduit un texte mot à mot sans intervention de l'utilisateur
+ *
+ *  Là où l'interface interactive demande un choix, on applique une politique déterministe :
+ *      - mot connu : sa première traduction
+ *      - mot inconnu : la première traduction de la première suggestion de correction
+ *      - aucune suggestion ni traduction : NON_TRADUISABLE
+ *
+ *  Attributs:
+ *      - const Dictionnaire & dictionnaire, le dictionnaire anglais-français utilisé
+ *
+ */
+class TraducteurLot
+{
+public:
+
+	//Mot écrit à la place d'un mot qui ne peut pas être traduit
+	static const std::string NON_TRADUISABLE;
+
+	//Constructeur, le dictionnaire doit survivre au traducteur
+	explicit TraducteurLot(const Dictionnaire& p_dictionnaire);
+
+	//Traduire un seul mot selon la politique déterministe
+	std::string traduireMot(const std::string& motAnglais) const;
+
+	//Traduire une ligne (mots séparés par des espaces ou tabulations) et ajouter le résultat à 'sortie', mots séparés par une espace
+	void traduireLigne(const std::string& ligne, std::string& sortie) const;
+
+	//Traduire un flux ligne par ligne jusqu'à sa fin. Retourne le nombre de lignes traduites.
+	//Une ligne traduite est écrite pour chaque ligne lue ; le flux de sortie n'est pas vidé (flush) après chaque ligne.
+	unsigned long long traduireFlux(std::istream& entree, std::ostream& sortie) const;
+
+private:
+
+    const Dictionnaire& dictionnaire;
+};
+
+}
+
+#endif /* TRADUCTEURLOT_H_ */
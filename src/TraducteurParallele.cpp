@@ -0,0 +1,182 @@
+/**
+ * \file TraducteurParallele.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe TraducteurParallele
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#include "TraducteurParallele.h"
+
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+namespace TP3
+{
+
+    /**
+     * \fn TraducteurParallele::TraducteurParallele(const Dictionnaire &dictionnaire, unsigned int p_nbTraducteurs, std::size_t p_lignesParLot, std::size_t p_nbLots)
+     * \brief Constructeur d'un traducteur en pipeline
+     * \param[in] const Dictionnaire &dictionnaire, le dictionnaire anglais-français, partagé en lecture seule par les fils
+     * \param[in] unsigned int p_nbTraducteurs, le nombre de fils de traduction
+     * \param[in] std::size_t p_lignesParLot, le nombre de lignes par lot
+     * \param[in] std::size_t p_nbLots, le nombre de lots en circulation (puissance de 2)
+     * \exception logic_error si un paramètre est invalide
+     */
+    TraducteurParallele::TraducteurParallele(const Dictionnaire &dictionnaire, unsigned int p_nbTraducteurs, std::size_t p_lignesParLot, std::size_t p_nbLots) :
+            traducteur(dictionnaire), nbTraducteurs(p_nbTraducteurs), lignesParLot(p_lignesParLot), nbLots(p_nbLots),
+            repliques(nullptr) {
+        if (nbTraducteurs == 0)
+            throw logic_error("il faut au moins un traducteur");
+        if (lignesParLot == 0)
+            throw logic_error("un lot doit contenir au moins une ligne");
+        if (nbLots < 2 || (nbLots & (nbLots - 1)) != 0)
+            throw logic_error("le nombre de lots doit etre une puissance de 2");
+    }
+
+    /**
+     * \fn TraducteurParallele::TraducteurParallele(const RepliquesNuma &p_repliques, unsigned int p_nbTraducteurs, std::size_t p_lignesParLot, std::size_t p_nbLots)
+     * \brief Constructeur d'un traducteur en pipeline dont chaque traducteur lit la réplique de son noeud NUMA
+     * \param[in] const RepliquesNuma &p_repliques, les répliques du dictionnaire anglais-français
+     * \param[in] unsigned int p_nbTraducteurs, le nombre de fils de traduction
+     * \param[in] std::size_t p_lignesParLot, le nombre de lignes par lot
+     * \param[in] std::size_t p_nbLots, le nombre de lots en circulation (puissance de 2)
+     * \exception logic_error si un paramètre est invalide
+     */
+    TraducteurParallele::TraducteurParallele(const RepliquesNuma &p_repliques, unsigned int p_nbTraducteurs, std::size_t p_lignesParLot, std::size_t p_nbLots) :
+            TraducteurParallele(p_repliques.replique(0), p_nbTraducteurs, p_lignesParLot, p_nbLots) {
+        repliques = &p_repliques;
+    }
+
+    /**
+     * \fn unsigned long long TraducteurParallele::traduireFlux(std::istream &entree, std::ostream &sortie) const
+     * \brief Permet de traduire un flux complet en pipeline
+     * \param[in] std::istream &entree, le texte anglais
+     * \param[in] std::ostream &sortie, le flux où écrire le texte français
+     * \return unsigned long long, le nombre de lignes traduites
+     *
+     * Le fil appelant est l'étage de lecture. Il prend un lot libre (en attendant au besoin que l'écrivain en rende un),
+     * le remplit d'au plus 'lignesParLot' lignes et le passe aux traducteurs. À la fin de l'entrée, il envoie un lot nul
+     * par traducteur ; chaque traducteur le relaie à l'écrivain, qui s'arrête après les avoir tous reçus.
+     *
+     */
+    unsigned long long TraducteurParallele::traduireFlux(std::istream &entree, std::ostream &sortie) const {
+        vector<Lot> lots(nbLots);
+        FileBornee<Lot*> lotsLibres(nbLots);
+        FileBornee<Lot*> lotsLus(nbLots);
+        FileBornee<Lot*> lotsTraduits(nbLots);
+
+        for (auto & lot : lots) {
+            lot.lignes.resize(lignesParLot);
+            lotsLibres.enfiler(&lot);
+        }
+
+        vector<thread> traducteurs;
+        for (unsigned int i = 0; i < nbTraducteurs; i++)
+            traducteurs.push_back(thread(&TraducteurParallele::_traduire, this, i, ref(lotsLus), ref(lotsTraduits)));
+        thread ecrivain(&TraducteurParallele::_ecrire, this, ref(lotsTraduits), ref(lotsLibres), ref(sortie));
+
+        unsigned long long nbLignes = 0;
+        for (unsigned long long sequence = 0; entree; sequence++) {
+            Lot* lot = lotsLibres.defiler();
+            lot->sequence = sequence;
+            lot->nbLignes = 0;
+            while (lot->nbLignes < lignesParLot && getline(entree, lot->lignes[lot->nbLignes]))
+                lot->nbLignes++;
+
+            if (lot->nbLignes == 0) {
+                lotsLibres.enfiler(lot);
+                break;
+            }
+            nbLignes += lot->nbLignes;
+            lotsLus.enfiler(lot);
+        }
+
+        for (unsigned int i = 0; i < nbTraducteurs; i++)
+            lotsLus.enfiler(nullptr);
+
+        for (auto & fil : traducteurs)
+            fil.join();
+        ecrivain.join();
+
+        return nbLignes;
+    }
+
+    /**
+     * \fn unsigned int TraducteurParallele::nombreTraducteurs() const
+     * \brief Permet de connaître le nombre de fils de traduction
+     * \return unsigned int, le nombre de traducteurs
+     */
+    unsigned int TraducteurParallele::nombreTraducteurs() const {
+        return nbTraducteurs;
+    }
+
+    /**
+     * \fn void TraducteurParallele::_traduire(unsigned int rang, FileBornee<Lot*> &lotsLus, FileBornee<Lot*> &lotsTraduits) const
+     * \brief Boucle d'un fil de traduction : traduit les lots lus jusqu'à la réception d'un lot nul
+     * \param[in] unsigned int rang, le numéro du traducteur, qui choisit son noeud NUMA
+     * \param[in] FileBornee<Lot*> &lotsLus, les lots à traduire
+     * \param[out] FileBornee<Lot*> &lotsTraduits, les lots traduits, dans l'ordre où ils sont terminés
+     */
+    void TraducteurParallele::_traduire(unsigned int rang, FileBornee<Lot*> &lotsLus, FileBornee<Lot*> &lotsTraduits) const {
+        const size_t noeud = repliques == nullptr ? 0 : rang % repliques->nombreNoeuds();
+        const TraducteurLot traducteurLocal = repliques == nullptr ? traducteur : TraducteurLot(repliques->replique(noeud));
+        if (repliques != nullptr) {
+            try {
+                repliques->epingle(noeud);
+            } catch (const runtime_error&) {
+                //Sans épinglage, la traduction reste correcte : seules les lectures peuvent devenir distantes
+            }
+        }
+
+        for (Lot* lot = lotsLus.defiler(); lot != nullptr; lot = lotsLus.defiler()) {
+            lot->traduction.clear();
+            for (size_t i = 0; i < lot->nbLignes; i++) {
+                traducteurLocal.traduireLigne(lot->lignes[i], lot->traduction);
+                lot->traduction += '\n';
+            }
+            lotsTraduits.enfiler(lot);
+        }
+        lotsTraduits.enfiler(nullptr);
+    }
+
+    /**
+     * \fn void TraducteurParallele::_ecrire(FileBornee<Lot*> &lotsTraduits, FileBornee<Lot*> &lotsLibres, std::ostream &sortie) const
+     * \brief Boucle du fil d'écriture : remet les lots dans l'ordre, les écrit et les rend à la lecture
+     * \param[in] FileBornee<Lot*> &lotsTraduits, les lots traduits, dans le désordre
+     * \param[out] FileBornee<Lot*> &lotsLibres, les lots écrits, réutilisables par la lecture
+     * \param[in] std::ostream &sortie, le flux où écrire
+     *
+     * Les lots en circulation ont toujours des numéros consécutifs à partir du prochain lot à écrire, et il y en a au plus
+     * 'nbLots'. Le numéro modulo nbLots est donc une place unique dans le tampon de réordonnancement, sans recherche.
+     * Chaque traducteur envoie son lot nul après tous ses lots : quand tous les lots nuls sont reçus, tout a été écrit.
+     *
+     */
+    void TraducteurParallele::_ecrire(FileBornee<Lot*> &lotsTraduits, FileBornee<Lot*> &lotsLibres, std::ostream &sortie) const {
+        const size_t masque = nbLots - 1;
+        vector<Lot*> enAttente(nbLots, nullptr);
+        unsigned long long prochain = 0;
+        unsigned int traducteursTermines = 0;
+
+        while (traducteursTermines < nbTraducteurs) {
+            Lot* lot = lotsTraduits.defiler();
+            if (lot == nullptr) {
+                traducteursTermines++;
+                continue;
+            }
+
+            enAttente[lot->sequence & masque] = lot;
+            while (enAttente[prochain & masque] != nullptr) {
+                Lot* lotAecrire = enAttente[prochain & masque];
+                enAttente[prochain & masque] = nullptr;
+                sortie.write(lotAecrire->traduction.data(), static_cast<streamsize>(lotAecrire->traduction.size()));
+                lotsLibres.enfiler(lotAecrire);
+                prochain++;
+            }
+        }
+    }
+
+}//Fin du namespace
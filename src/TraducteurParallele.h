@@ -0,0 +1,95 @@
+/**
+ * \file TraducteurParallele.h
+ * \brief Ce fichier contient l'interface d'un traducteur de flux en pipeline sur plusieurs fils d'exécution.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef TRADUCTEURPARALLELE_H_
+#define TRADUCTEURPARALLELE_H_
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Dictionnaire.h"
+#include "FileBornee.h"
+#include "RepliquesNuma.h"
+#include "TraducteurLot.h"
+
+namespace TP3
+{
+
+/**
+ * \class TraducteurParallele
+ * \brief Traduit un flux avec un pipeline à trois étages : lecture, traduction (plusieurs fils), écriture ordonnée
+ *
+ *  Le fil appelant lit l'entrée et la découpe en lots de lignes numérotés. Les traducteurs se partagent le dictionnaire
+ *  en lecture seule et traduisent les lots dans n'importe quel ordre. Un fil d'écriture remet les lots dans l'ordre de
+ *  leur numéro avant de les écrire. Les étages sont reliés par des files bornées sans verrou, et les lots sont recyclés
+ *  par une file de lots libres : le nombre de lots en circulation (donc la mémoire) est borné.
+ *
+ *  La traduction de chaque mot suit la politique de TraducteurLot ; la sortie est identique à celle de TraducteurLot::traduireFlux.
+ *
+ *  Avec des RepliquesNuma, le traducteur i est épinglé sur le noeud NUMA i modulo le nombre de noeuds et ne lit que la
+ *  réplique de ce noeud : aucune descente ne traverse le lien entre les sockets.
+ *
+ *  Attributs:
+ *      - TraducteurLot traducteur, la politique de traduction (sans état, partagée par les fils)
+ *      - unsigned int nbTraducteurs, nombre de fils de traduction
+ *      - std::size_t lignesParLot, nombre de lignes regroupées dans un lot
+ *      - std::size_t nbLots, nombre de lots en circulation (puissance de 2)
+ *      - const RepliquesNuma * repliques, les répliques par noeud NUMA (nullptr pour un seul dictionnaire partagé)
+ *
+ */
+class TraducteurParallele
+{
+public:
+
+	//Constructeur. Le dictionnaire doit survivre au traducteur et ne pas être modifié pendant une traduction.
+	//Exception logic_error si nbTraducteurs ou lignesParLot est 0, ou si nbLots n'est pas une puissance de 2 plus grande ou égale à 2
+	TraducteurParallele(const Dictionnaire& dictionnaire, unsigned int p_nbTraducteurs, std::size_t p_lignesParLot = 256, std::size_t p_nbLots = 64);
+
+	//Constructeur dont chaque traducteur est épinglé sur un noeud NUMA et lit la réplique de ce noeud
+	//Les répliques doivent survivre au traducteur. Mêmes exceptions que le constructeur précédent.
+	TraducteurParallele(const RepliquesNuma& p_repliques, unsigned int p_nbTraducteurs, std::size_t p_lignesParLot = 256, std::size_t p_nbLots = 64);
+
+	//Traduire un flux ligne par ligne jusqu'à sa fin, dans l'ordre. Retourne le nombre de lignes traduites.
+	unsigned long long traduireFlux(std::istream& entree, std::ostream& sortie) const;
+
+	//Nombre de fils de traduction
+	unsigned int nombreTraducteurs() const;
+
+private:
+
+    /**
+     * \struct Lot
+     * \brief Un groupe de lignes consécutives de l'entrée et leur traduction
+     */
+    struct Lot
+    {
+        unsigned long long sequence;
+        std::size_t nbLignes;
+        std::vector<std::string> lignes;
+        std::string traduction;
+    };
+
+    TraducteurLot traducteur;
+    const unsigned int nbTraducteurs;
+    const std::size_t lignesParLot;
+    const std::size_t nbLots;
+    const RepliquesNuma* repliques;
+
+    //region private methods
+
+    void _traduire(unsigned int rang, FileBornee<Lot*>& lotsLus, FileBornee<Lot*>& lotsTraduits) const;
+    void _ecrire(FileBornee<Lot*>& lotsTraduits, FileBornee<Lot*>& lotsLibres, std::ostream& sortie) const;
+
+    //endregion
+};
+
+}
+
+#endif /* TRADUCTEURPARALLELE_H_ */
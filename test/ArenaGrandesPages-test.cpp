@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "ArenaGrandesPages.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace TP3;
+using namespace std;
+
+TEST(ArenaGrandesPages, givenManyBlocks_whenAllocate_thenBlocksAreAlignedDisjointAndInAlignedRegions) {
+    ArenaGrandesPages areneSubject(1);
+    vector<char*> blocs;
+
+    for (int i = 0; i < 100000; i++) {
+        char* bloc = static_cast<char*>(areneSubject.allouer(40));
+        ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(bloc) % ArenaGrandesPages::ALIGNEMENT);
+        memset(bloc, i & 0xFF, 40);
+        blocs.push_back(bloc);
+    }
+
+    for (int i = 0; i < 100000; i++)
+        ASSERT_EQ(static_cast<char>(i & 0xFF), blocs[i][39]);
+    ASSERT_EQ(ArenaGrandesPages::TAILLE_GRANDE_PAGE, areneSubject.tailleRegion());
+    ASSERT_EQ(0u, areneSubject.octetsReserves() % ArenaGrandesPages::TAILLE_GRANDE_PAGE);
+    ASSERT_EQ(100000u * 48, areneSubject.octetsUtilises());
+    ASSERT_THROW(areneSubject.allouer(8, 64), logic_error);
+    ASSERT_THROW(ArenaGrandesPages(0), logic_error);
+}
+
+TEST(ArenaGrandesPages, givenFreedBlock_whenAllocateSameSize_thenBlockIsReusedWithoutNewRegion) {
+    ArenaGrandesPages areneSubject;
+    void* premier = areneSubject.allouer(100);
+    areneSubject.allouer(100);
+    const size_t reserves = areneSubject.octetsReserves();
+
+    areneSubject.liberer(premier, 100);
+
+    ASSERT_EQ(112u, areneSubject.octetsUtilises());
+    ASSERT_NE(premier, areneSubject.allouer(30));
+    ASSERT_EQ(premier, areneSubject.allouer(100));
+    ASSERT_EQ(reserves, areneSubject.octetsReserves());
+}
+
+TEST(ArenaGrandesPages, givenBlockLargerThanARegion_whenAllocate_thenALargerRegionIsReserved) {
+    ArenaGrandesPages areneSubject(ArenaGrandesPages::TAILLE_GRANDE_PAGE);
+
+    char* bloc = static_cast<char*>(areneSubject.allouer(3 * ArenaGrandesPages::TAILLE_GRANDE_PAGE));
+    bloc[3 * ArenaGrandesPages::TAILLE_GRANDE_PAGE - 1] = 'x';
+
+    ASSERT_EQ(3 * ArenaGrandesPages::TAILLE_GRANDE_PAGE, areneSubject.octetsReserves());
+}
+
+TEST(ArenaGrandesPages, givenAllocatorCopies_whenCopyContainer_thenCopiesShareTheArenaButNotTheContainerCopy) {
+    AllocateurArene<int> ordinaire;
+    AllocateurArene<int> allocateurSubject(make_shared<ArenaGrandesPages>());
+    AllocateurArene<double> relie(allocateurSubject);
+
+    vector<int, AllocateurArene<int> > nombres(allocateurSubject);
+    for (int i = 0; i < 1000; i++)
+        nombres.push_back(i);
+    vector<int, AllocateurArene<int> > copie(nombres);
+
+    ASSERT_TRUE(relie == allocateurSubject);
+    ASSERT_TRUE(ordinaire != allocateurSubject);
+    ASSERT_TRUE(copie.get_allocator() != allocateurSubject);
+    ASSERT_NE(nullptr, copie.get_allocator().areneUtilisee());
+    ASSERT_EQ(nombres, copie);
+    ASSERT_LE(1000 * sizeof(int), allocateurSubject.areneUtilisee()->octetsUtilises());
+}
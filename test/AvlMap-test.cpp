@@ -0,0 +1,285 @@
+#include "gtest/gtest.h"
+#include "AvlMap.h"
+#include <functional>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace TP3;
+using namespace std;
+
+/**
+ * Allocateur minimal qui compte les noeuds alloués et libérés, pour vérifier qu'AvlMap passe par l'allocateur fourni
+ */
+template<typename T>
+struct AllocateurCompteur
+{
+    typedef T value_type;
+
+    static int alloues;
+    static int liberes;
+
+    AllocateurCompteur() {}
+    template<typename U>
+    AllocateurCompteur(const AllocateurCompteur<U>&) {}
+
+    T* allocate(size_t n) {
+        alloues += static_cast<int>(n);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        liberes += static_cast<int>(n);
+        ::operator delete(p);
+    }
+};
+
+template<typename T> int AllocateurCompteur<T>::alloues = 0;
+template<typename T> int AllocateurCompteur<T>::liberes = 0;
+
+template<typename T, typename U>
+bool operator==(const AllocateurCompteur<T>&, const AllocateurCompteur<U>&) { return true; }
+template<typename T, typename U>
+bool operator!=(const AllocateurCompteur<T>&, const AllocateurCompteur<U>&) { return false; }
+
+TEST(AvlMap, givenIntegerKeysAndGreaterComparator_whenTraversed_thenKeysAreInDescendingOrder) {
+    AvlMap<int, string, greater<int> > mapSubject;
+    for (int cle : { 5, 1, 9, 3, 7 })
+        mapSubject.inserer(cle, to_string(cle));
+
+    ASSERT_FALSE(mapSubject.inserer(5, "autre").second);
+    ASSERT_EQ("5", mapSubject.trouver(5)->valeur());
+    ASSERT_EQ(nullptr, mapSubject.trouver(4));
+    ASSERT_EQ(3, mapSubject.borneInferieure(4)->cle());
+    ASSERT_EQ(1, mapSubject.borneSuperieure(3)->cle());
+
+    vector<int> cles;
+    for (auto noeud = mapSubject.premier(); noeud != nullptr; noeud = decltype(mapSubject)::suivant(noeud))
+        cles.push_back(noeud->cle());
+    ASSERT_EQ(vector<int>({ 9, 7, 5, 3, 1 }), cles);
+}
+
+TEST(AvlMap, givenCustomAllocator_whenMapIsCopiedAndDestroyed_thenEveryNodeIsReturnedToIt) {
+    typedef AllocateurCompteur<pair<const int, int> > Allocateur;
+    typedef AllocateurCompteur<NoeudAvlMap<int, int> > AllocateurNoeuds;
+    AllocateurNoeuds::alloues = 0;
+    AllocateurNoeuds::liberes = 0;
+    {
+        AvlMap<int, int, less<int>, Allocateur> mapSubject;
+        for (int cle = 0; cle < 100; cle++)
+            mapSubject.inserer(cle, cle * cle);
+        mapSubject.supprimer(50);
+
+        AvlMap<int, int, less<int>, Allocateur> copie(mapSubject);
+        mapSubject.vider();
+
+        ASSERT_EQ(99, copie.taille());
+        ASSERT_EQ(49 * 49, copie.trouver(49)->valeur());
+        ASSERT_EQ(nullptr, copie.trouver(50));
+        ASSERT_EQ(199, AllocateurNoeuds::alloues);
+    }
+    ASSERT_EQ(AllocateurNoeuds::alloues, AllocateurNoeuds::liberes);
+}
+
+TEST(AvlMap, givenRandomAddsAndDeletesWithWavlPolicy_whenQueried_thenContentMatchesAReferenceMap) {
+    AvlMap<int, int, less<int>, allocator<pair<const int, int> >, PolitiqueWAVL> mapSubject;
+    map<int, int> reference;
+    mt19937 generateur(2020);
+    uniform_int_distribution<int> choix(0, 999);
+
+    for (int operation = 0; operation < 20000; operation++) {
+        const int cle = choix(generateur);
+        if (operation % 3 == 2) {
+            ASSERT_EQ(reference.erase(cle) == 1, mapSubject.supprimer(cle));
+        } else {
+            ASSERT_EQ(reference.insert(make_pair(cle, operation)).second, mapSubject.inserer(cle, operation).second);
+        }
+    }
+
+    ASSERT_EQ(reference.size(), mapSubject.taille());
+    auto noeud = mapSubject.premier();
+    for (const auto & entree : reference) {
+        ASSERT_EQ(entree.first, noeud->cle());
+        ASSERT_EQ(entree.second, noeud->valeur());
+        noeud = decltype(mapSubject)::suivant(noeud);
+    }
+    ASSERT_EQ(nullptr, noeud);
+}
+
+TEST(AvlMap, givenCopy_whenOriginalIsModified_thenCopyIsUnchanged) {
+    AvlMap<string, int> mapSubject;
+    mapSubject.inserer("bird", 1);
+    mapSubject.inserer("cat", 2);
+
+    AvlMap<string, int> copie;
+    copie.inserer("dog", 3);
+    copie = mapSubject;
+    mapSubject.supprimer("bird");
+    mapSubject.trouver("cat")->valeur() = 20;
+
+    ASSERT_EQ(2, copie.taille());
+    ASSERT_EQ(nullptr, copie.trouver("dog"));
+    ASSERT_EQ(1, copie.trouver("bird")->valeur());
+    ASSERT_EQ(2, copie.trouver("cat")->valeur());
+    ASSERT_EQ("cat", copie.dernier()->cle());
+    ASSERT_EQ("bird", decltype(copie)::precedent(copie.dernier())->cle());
+}
+
+TEST(AvlMap, givenDeferredCopy_whenEitherIsModified_thenNodesAreCopiedOnceAndBothStayIndependent) {
+    typedef AllocateurCompteur<pair<const int, int> > Allocateur;
+    typedef AllocateurCompteur<NoeudAvlMap<int, int> > AllocateurNoeuds;
+    AllocateurNoeuds::alloues = 0;
+    AllocateurNoeuds::liberes = 0;
+    {
+        AvlMap<int, int, less<int>, Allocateur> mapSubject;
+        for (int cle = 0; cle < 100; cle++)
+            mapSubject.inserer(cle, cle);
+
+        AvlMap<int, int, less<int>, Allocateur> clone = mapSubject.copieDifferee();
+        ASSERT_EQ(100, AllocateurNoeuds::alloues);
+        ASSERT_TRUE(clone.estPartage());
+        ASSERT_EQ(mapSubject.trouver(42), clone.trouver(42));
+
+        clone.supprimer(42);
+        ASSERT_EQ(200, AllocateurNoeuds::alloues);
+        ASSERT_FALSE(clone.estPartage());
+        ASSERT_EQ(99, clone.taille());
+        ASSERT_EQ(100, mapSubject.taille());
+        ASSERT_EQ(42, mapSubject.trouver(42)->valeur());
+
+        mapSubject.inserer(100, 100);
+        ASSERT_EQ(201, AllocateurNoeuds::alloues);
+        ASSERT_FALSE(mapSubject.estPartage());
+
+        AvlMap<int, int, less<int>, Allocateur> deplace(std::move(clone));
+        ASSERT_EQ(99, deplace.taille());
+        ASSERT_TRUE(clone.estVide());
+        ASSERT_EQ(201, AllocateurNoeuds::alloues);
+    }
+    ASSERT_EQ(AllocateurNoeuds::alloues, AllocateurNoeuds::liberes);
+}
+
+TEST(AvlMap, givenNodeHandles_whenOtherKeysAreDeleted_thenHandlesKeepTheirKeyAndValue) {
+    AvlMap<int, string, less<int>, allocator<pair<const int, string> >, PolitiqueTreap> mapSubject;
+    vector<NoeudAvlMap<int, string>*> noeuds;
+    for (int cle = 0; cle < 200; cle++)
+        noeuds.push_back(mapSubject.inserer(cle, to_string(cle)).first);
+
+    for (int cle = 0; cle < 200; cle += 2)
+        ASSERT_TRUE(mapSubject.supprimer(cle));
+
+    for (int cle = 1; cle < 200; cle += 2) {
+        ASSERT_EQ(noeuds[cle], mapSubject.trouver(cle));
+        ASSERT_EQ(cle, noeuds[cle]->cle());
+        ASSERT_EQ(to_string(cle), noeuds[cle]->valeur());
+    }
+    auto noeud = mapSubject.premier();
+    for (int cle = 1; cle < 200; cle += 2, noeud = decltype(mapSubject)::suivant(noeud))
+        ASSERT_EQ(cle, noeud->cle());
+    ASSERT_EQ(nullptr, noeud);
+}
+
+TEST(AvlMap, givenLargeAndSmallBatches_whenInsertedAndDeleted_thenContentMatchesAReferenceMapWithoutLeak) {
+    typedef AllocateurCompteur<pair<const int, int> > Allocateur;
+    typedef AllocateurCompteur<NoeudAvlMap<int, int> > AllocateurNoeuds;
+    AllocateurNoeuds::alloues = 0;
+    AllocateurNoeuds::liberes = 0;
+    {
+        AvlMap<int, int, less<int>, Allocateur, PolitiqueRougeNoir> mapSubject;
+        map<int, int> reference;
+        for (int cle = 0; cle < 1000; cle += 3)
+            reference[cle] = mapSubject.inserer(cle, cle).first->valeur();
+        NoeudAvlMap<int, int>* noeudGarde = mapSubject.trouver(9);
+
+        vector<pair<int, int> > ajouts;
+        for (int cle = 0; cle < 1000; cle += 2)
+            ajouts.push_back(make_pair(cle, -cle));
+        auto resultats = mapSubject.insererLot(ajouts);
+        ASSERT_EQ(ajouts.size(), resultats.size());
+        for (size_t i = 0; i < ajouts.size(); i++) {
+            ASSERT_EQ(reference.count(ajouts[i].first) == 0, resultats[i].second);
+            ASSERT_EQ(ajouts[i].first, resultats[i].first->cle());
+            reference.insert(ajouts[i]);
+        }
+
+        vector<int> suppressions;
+        for (int cle = 0; cle < 1200; cle += 5)
+            suppressions.push_back(cle);
+        size_t presentes = 0;
+        for (int cle : suppressions)
+            presentes += reference.erase(cle);
+        ASSERT_EQ(presentes, mapSubject.supprimerLot(suppressions));
+        ASSERT_EQ(1u, mapSubject.supprimerLot({ 303 }));
+        reference.erase(303);
+        ASSERT_EQ(1u, mapSubject.insererLot({ make_pair(5, 5) }).size());
+        reference.insert(make_pair(5, 5));
+
+        ASSERT_EQ(noeudGarde, mapSubject.trouver(9));
+        ASSERT_EQ(reference.size(), mapSubject.taille());
+        auto noeud = mapSubject.premier();
+        for (const pair<const int, int>& element : reference) {
+            ASSERT_EQ(element.first, noeud->cle());
+            ASSERT_EQ(element.second, noeud->valeur());
+            noeud = decltype(mapSubject)::suivant(noeud);
+        }
+        ASSERT_EQ(nullptr, noeud);
+        ASSERT_THROW(mapSubject.supprimerLot({ 3, 3 }), logic_error);
+        ASSERT_EQ(static_cast<int>(reference.size()), AllocateurNoeuds::alloues - AllocateurNoeuds::liberes);
+    }
+    ASSERT_EQ(AllocateurNoeuds::alloues, AllocateurNoeuds::liberes);
+}
+
+TEST(AvlMap, givenLargeMaps_whenUnitedIntersectedAndSubtracted_thenContentMatchesReferenceSetOperations) {
+    typedef AvlMap<int, int> Map;
+    mt19937 generateur(46);
+    uniform_int_distribution<int> cles(0, 60000);
+    map<int, int> referenceA, referenceB;
+    Map a, b;
+    for (int i = 0; i < 20000; i++) {
+        const int cleA = cles(generateur), cleB = cles(generateur);
+        referenceA.insert(make_pair(cleA, 1));
+        a.inserer(cleA, 1);
+        referenceB.insert(make_pair(cleB, 2));
+        b.inserer(cleB, 2);
+    }
+    ASSERT_GE(a.taille() + b.taille(), Map::SEUIL_PARALLELE);
+
+    auto verifier = [](const Map& arbre, const map<int, int>& reference) {
+        ASSERT_EQ(reference.size(), arbre.taille());
+        auto noeud = arbre.premier();
+        for (const pair<const int, int>& element : reference) {
+            ASSERT_EQ(element.first, noeud->cle());
+            ASSERT_EQ(element.second, noeud->valeur());
+            ASSERT_TRUE(noeud->parent == nullptr || noeud->parent->gauche == noeud || noeud->parent->droite == noeud);
+            noeud = Map::suivant(noeud);
+        }
+        ASSERT_EQ(nullptr, noeud);
+    };
+
+    Map unionAB = a, intersectionAB = a, differenceAB = a;
+    Map copieB = b;
+    unionAB.unir(copieB, [](int& ici, int& autre) { ici += autre; });
+    ASSERT_TRUE(copieB.estVide());
+    copieB = b;
+    intersectionAB.intersecter(copieB);
+    copieB = b;
+    differenceAB.retrancher(copieB);
+
+    map<int, int> referenceUnion = referenceA, referenceIntersection, referenceDifference;
+    for (const pair<const int, int>& element : referenceB)
+        referenceUnion[element.first] += element.second;
+    for (const pair<const int, int>& element : referenceA)
+        (referenceB.count(element.first) != 0 ? referenceIntersection : referenceDifference).insert(element);
+    verifier(unionAB, referenceUnion);
+    verifier(intersectionAB, referenceIntersection);
+    verifier(differenceAB, referenceDifference);
+
+    Map superieurs = unionAB.scinder(30000);
+    verifier(unionAB, map<int, int>(referenceUnion.begin(), referenceUnion.lower_bound(30000)));
+    verifier(superieurs, map<int, int>(referenceUnion.lower_bound(30000), referenceUnion.end()));
+    ASSERT_THROW(superieurs.concatener(unionAB), logic_error);
+    unionAB.concatener(superieurs);
+    ASSERT_TRUE(superieurs.estVide());
+    verifier(unionAB, referenceUnion);
+}
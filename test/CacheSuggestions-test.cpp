@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include "CacheSuggestions.h"
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace TP3;
+using namespace std;
+
+TEST(CacheSuggestions, givenZeroCapacity_whenConstruct_thenThrowLogicError) {
+    ASSERT_THROW(CacheSuggestions cacheSubject(0), logic_error);
+}
+
+TEST(CacheSuggestions, givenInsertedWord_whenFindWithSameOrOtherGeneration_thenOnlySameGenerationHits) {
+    CacheSuggestions cacheSubject(8, 1);
+    vector<string> suggestions;
+    cacheSubject.inserer("brid", 3, vector<string>({ "bird", "bread" }));
+
+    ASSERT_TRUE(cacheSubject.trouver("brid", 3, suggestions));
+    ASSERT_EQ(vector<string>({ "bird", "bread" }), suggestions);
+    ASSERT_FALSE(cacheSubject.trouver("brid", 4, suggestions));
+    ASSERT_FALSE(cacheSubject.trouver("teh", 3, suggestions));
+    ASSERT_EQ(1, cacheSubject.succes());
+    ASSERT_EQ(2, cacheSubject.echecs());
+}
+
+TEST(CacheSuggestions, givenFullShard_whenInserting_thenRecentlyReadEntrySurvivesEviction) {
+    CacheSuggestions cacheSubject(2, 1);
+    vector<string> suggestions;
+    cacheSubject.inserer("a", 0, vector<string>({ "1" }));
+    cacheSubject.inserer("b", 0, vector<string>({ "2" }));
+    cacheSubject.trouver("a", 0, suggestions);
+
+    cacheSubject.inserer("c", 0, vector<string>({ "3" }));
+
+    ASSERT_EQ(2, cacheSubject.taille());
+    ASSERT_TRUE(cacheSubject.trouver("a", 0, suggestions));
+    ASSERT_FALSE(cacheSubject.trouver("b", 0, suggestions));
+    ASSERT_TRUE(cacheSubject.trouver("c", 0, suggestions));
+}
+
+TEST(CacheSuggestions, givenManyThreads_whenInsertingAndFinding_thenSizeStaysBoundedAndEveryLookupIsCounted) {
+    CacheSuggestions cacheSubject(64, 8);
+    vector<thread> fils;
+    for (int f = 0; f < 4; f++) {
+        fils.push_back(thread([&cacheSubject, f]() {
+            vector<string> suggestions;
+            for (int i = 0; i < 2000; i++) {
+                const string mot = to_string((i * 7 + f) % 200);
+                if (!cacheSubject.trouver(mot, 0, suggestions))
+                    cacheSubject.inserer(mot, 0, vector<string>(1, mot));
+                else
+                    ASSERT_EQ(mot, suggestions[0]);
+            }
+        }));
+    }
+    for (auto & fil : fils)
+        fil.join();
+
+    ASSERT_LE(cacheSubject.taille(), cacheSubject.capacite());
+    ASSERT_EQ(8000, cacheSubject.succes() + cacheSubject.echecs());
+}
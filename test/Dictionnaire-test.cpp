@@ -1,6 +1,9 @@
 #include "gtest/gtest.h"
 #include "Dictionnaire.h"
 #include <algorithm>
+#include <iterator>
+#include <set>
+#include <sstream>
 
 using namespace TP3;
 using namespace std;
@@ -115,3 +118,664 @@ TEST(Dictionnaire, givenSimilarWords_whenGetSuggestionItReturnsAllSimilarWordsIn
     ASSERT_TRUE(find(suggestions.begin(), suggestions.end(), "bed") != suggestions.end());
 }
 
+
+TEST(Dictionnaire, givenWordWithTwoChildren_whenDeleteWord_thenItDeletesOnlyThatWord) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.ajouteMot("mot", "word");
+    dictSubject.ajouteMot("bird", "oiseau");
+    dictSubject.ajouteMot("test", "essaie");
+
+    dictSubject.supprimeMot("mot");
+    dictSubject.supprimeMot("test");
+
+    ASSERT_FALSE(dictSubject.appartient("mot"));
+    ASSERT_FALSE(dictSubject.appartient("test"));
+    ASSERT_TRUE(dictSubject.appartient("bird"));
+}
+
+TEST(Dictionnaire, givenHashIndexActive_whenAddAndDeleteWords_thenLookupsMatchTree) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.ajouteMot("mot", "word");
+    dictSubject.ajouteMot("bird", "oiseau");
+    dictSubject.activeIndexHachage();
+    dictSubject.ajouteMot("test", "essaie");
+    dictSubject.ajouteMot("bird", "aigle");
+    dictSubject.ajouteMot("truck", "camion");
+
+    dictSubject.supprimeMot("mot");
+
+    ASSERT_TRUE(dictSubject.indexHachageEstActif());
+    ASSERT_FALSE(dictSubject.appartient("mot"));
+    ASSERT_TRUE(dictSubject.traduit("mot").empty());
+    ASSERT_EQ(2, dictSubject.traduit("bird").size());
+    ASSERT_EQ("camion", dictSubject.traduit("truck")[0]);
+    ASSERT_EQ("essaie", dictSubject.traduit("test")[0]);
+}
+
+TEST(Dictionnaire, givenHashIndexDisabled_whenLookupWord_thenItFallsBackOnTree) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.activeIndexHachage();
+    dictSubject.ajouteMot("bird", "oiseau");
+
+    dictSubject.desactiveIndexHachage();
+
+    ASSERT_FALSE(dictSubject.indexHachageEstActif());
+    ASSERT_TRUE(dictSubject.appartient("bird"));
+}
+
+TEST(Dictionnaire, givenWordsSharingPrefix_whenGetWordsWithPrefix_thenItReturnsThemInOrderUpToLimit) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.ajouteMot("bread", "pain");
+    dictSubject.ajouteMot("bird", "oiseau");
+    dictSubject.ajouteMot("abacus", "abaque");
+    dictSubject.ajouteMot("bed", "lit");
+    dictSubject.ajouteMot("beard", "barbe");
+    dictSubject.ajouteMot("be", "etre");
+    dictSubject.ajouteMot("cat", "chat");
+
+    vector<string> tousLesMots = dictSubject.motsAvecPrefixe("be", 10);
+    vector<string> deuxMots = dictSubject.motsAvecPrefixe("be", 2);
+
+    ASSERT_EQ(vector<string>({"be", "beard", "bed"}), tousLesMots);
+    ASSERT_EQ(vector<string>({"be", "beard"}), deuxMots);
+    ASSERT_TRUE(dictSubject.motsAvecPrefixe("z", 10).empty());
+}
+
+TEST(Dictionnaire, givenWords_whenGetWordsBetween_thenItReturnsInclusiveRangeInOrder) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    for (const char* mot : {"truck", "mot", "bird", "bread", "test", "cat", "apple"})
+        dictSubject.ajouteMot(mot, "x");
+
+    vector<string> mots = dictSubject.motsEntre("bird", "mot", 10);
+
+    ASSERT_EQ(vector<string>({"bird", "bread", "cat", "mot"}), mots);
+    ASSERT_TRUE(dictSubject.motsEntre("mot", "bird", 10).empty());
+}
+
+TEST(Dictionnaire, givenVisitorStopping_whenVisitRange_thenTraversalStops) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    for (const char* mot : {"truck", "mot", "bird", "bread", "test", "cat", "apple"})
+        dictSubject.ajouteMot(mot, "x");
+    int visites = 0;
+
+    dictSubject.parcoursEntre("a", "z", [&visites](const string&, const vector<string>& traductions) {
+        visites++;
+        return traductions.size() == 1 && visites < 3;
+    });
+
+    ASSERT_EQ(3, visites);
+}
+
+TEST(Dictionnaire, givenWords_whenIterate_thenWordsComeInAlphabeticalOrder) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.ajouteMot("truck", "camion");
+    dictSubject.ajouteMot("bird", "oiseau");
+    dictSubject.ajouteMot("mot", "word");
+    dictSubject.ajouteMot("bird", "aigle");
+
+    vector<string> mots(dictSubject.begin(), dictSubject.end());
+    Dictionnaire::Iterateur dernier = --dictSubject.end();
+
+    ASSERT_EQ(vector<string>({"bird", "mot", "truck"}), mots);
+    ASSERT_EQ(2, dictSubject.begin().traductions().size());
+    ASSERT_EQ("truck", *dernier);
+    ASSERT_TRUE(Dictionnaire().begin() == Dictionnaire().end());
+}
+
+TEST(Dictionnaire, givenManyAddsAndDeletes_whenIterateBothWays_thenOrderMatchesSortedSet) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    set<string> attendus;
+    for (int i = 0; i < 500; i++) {
+        string mot = "mot" + to_string((i * 7919) % 1000);
+        dictSubject.ajouteMot(mot, "x");
+        attendus.insert(mot);
+    }
+    for (int i = 0; i < 1000; i += 3) {
+        string mot = "mot" + to_string(i);
+        if (attendus.erase(mot) == 1)
+            dictSubject.supprimeMot(mot);
+    }
+
+    vector<string> avant(dictSubject.begin(), dictSubject.end());
+    vector<string> arriere;
+    for (Dictionnaire::Iterateur it = dictSubject.end(); it != dictSubject.begin(); )
+        arriere.push_back(*--it);
+
+    ASSERT_EQ(vector<string>(attendus.begin(), attendus.end()), avant);
+    ASSERT_EQ(vector<string>(attendus.rbegin(), attendus.rend()), arriere);
+}
+
+TEST(Dictionnaire, givenWords_whenGetBounds_thenTheyPointToExpectedWords) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    for (const char* mot : {"bed", "bird", "bread", "cat"})
+        dictSubject.ajouteMot(mot, "x");
+
+    ASSERT_EQ("bird", *dictSubject.lower_bound("bird"));
+    ASSERT_EQ("bread", *dictSubject.upper_bound("bird"));
+    ASSERT_EQ("bird", *dictSubject.lower_bound("bf"));
+    ASSERT_TRUE(dictSubject.lower_bound("dog") == dictSubject.end());
+    ASSERT_EQ(2, distance(dictSubject.lower_bound("bird"), dictSubject.upper_bound("bread")));
+}
+
+TEST(Dictionnaire, givenWords_whenGetStatistics_thenShapeAndCountAreReported) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    ASSERT_EQ(-1, dictSubject.statistiques().hauteur);
+    for (const char* mot : {"d", "b", "f", "a", "c", "e", "g"})
+        dictSubject.ajouteMot(mot, "x");
+
+    StatistiquesArbre stats = dictSubject.statistiques();
+
+    ASSERT_EQ(7, stats.nombreMots);
+    //La forme d'un treap dépend des priorités tirées : seules les politiques déterministes donnent l'arbre parfait
+    if (string(Dictionnaire::PolitiqueEquilibre::nom()) != "treap") {
+        ASSERT_EQ(2, stats.hauteur);
+        ASSERT_DOUBLE_EQ(10.0 / 7, stats.profondeurMoyenne);
+    }
+    ASSERT_TRUE(stats.empreinteMemoire >= 7 * sizeof(string));
+}
+
+#ifdef TP3_INSTRUMENTATION
+TEST(Dictionnaire, givenInstrumentation_whenAddAndLookupWords_thenOperationsAreCounted) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.ajouteMot("a", "x");
+    dictSubject.ajouteMot("b", "x");
+    dictSubject.ajouteMot("c", "x");
+    ASSERT_EQ(3, dictSubject.compteurs().allocations.load());
+    ASSERT_EQ(1, dictSubject.compteurs().rotationsDroite.load());
+    dictSubject.reinitialiseCompteurs();
+
+    dictSubject.appartient("c");
+
+    ASSERT_EQ(1, dictSubject.compteurs().recherches.load());
+    ASSERT_EQ(2, dictSubject.compteurs().visitesNoeuds.load());
+    ASSERT_EQ(0, dictSubject.compteurs().appelsLevenshtein.load());
+}
+#endif
+
+TEST(Dictionnaire, givenWords_whenExportPrometheusMetrics_thenAllFamiliesAreWritten) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.ajouteMot("bird", "oiseau");
+    dictSubject.traduit("bird");
+    ostringstream sortie;
+
+    dictSubject.exporteMetriquesPrometheus(sortie);
+
+    string texte = sortie.str();
+    ASSERT_NE(string::npos, texte.find("# TYPE tp3_dictionnaire_latence_secondes histogram\n"));
+    ASSERT_NE(string::npos, texte.find("tp3_dictionnaire_latence_secondes_count{operation=\"supprimeMot\"} 0\n"));
+    ASSERT_NE(string::npos, texte.find("# TYPE tp3_dictionnaire_operations_total counter\n"));
+    ASSERT_NE(string::npos, texte.find("tp3_dictionnaire_mots 1\n"));
+#ifdef TP3_INSTRUMENTATION
+    ASSERT_EQ(1, dictSubject.latence(OPERATION_TRADUIT).nombre());
+    ASSERT_NE(string::npos, texte.find("tp3_dictionnaire_latence_secondes_count{operation=\"traduit\"} 1\n"));
+#else
+    TP3::Dictionnaire autre = Dictionnaire();
+    ASSERT_EQ(&autre.latence(OPERATION_TRADUIT), &dictSubject.latence(OPERATION_APPARTIENT));
+    ASSERT_EQ(0, dictSubject.latence(OPERATION_TRADUIT).nombre());
+#endif
+}
+
+TEST(Dictionnaire, givenSuggestionCache_whenSameMisspellingIsRequestedTwice_thenSecondCallHitsWithSameResult) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.ajouteMot("bird", "oiseau");
+    dictSubject.ajouteMot("bread", "pain");
+    dictSubject.ajouteMot("bead", "perle");
+    vector<string> sansCache = dictSubject.suggereCorrections("brid");
+    dictSubject.activeCacheSuggestions(16);
+
+    vector<string> premier = dictSubject.suggereCorrections("brid");
+    vector<string> second = dictSubject.suggereCorrections("brid");
+
+    ASSERT_EQ(sansCache, premier);
+    ASSERT_EQ(sansCache, second);
+    ASSERT_EQ(1, dictSubject.succesCacheSuggestions());
+    ASSERT_EQ(1, dictSubject.echecsCacheSuggestions());
+}
+
+TEST(Dictionnaire, givenSuggestionCache_whenWordSetChanges_thenCachedSuggestionsAreRecomputed) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.ajouteMot("bird", "oiseau");
+    dictSubject.activeCacheSuggestions(16);
+    dictSubject.suggereCorrections("brid");
+
+    dictSubject.ajouteMot("bird", "aigle");
+    dictSubject.suggereCorrections("brid");
+    ASSERT_EQ(1, dictSubject.succesCacheSuggestions());
+
+    dictSubject.ajouteMot("brie", "brie");
+    vector<string> apresAjout = dictSubject.suggereCorrections("brid");
+    ASSERT_EQ(2, dictSubject.echecsCacheSuggestions());
+    ASSERT_TRUE(find(apresAjout.begin(), apresAjout.end(), "brie") != apresAjout.end());
+
+    dictSubject.supprimeMot("brie");
+    vector<string> apresSuppression = dictSubject.suggereCorrections("brid");
+    ASSERT_EQ(3, dictSubject.echecsCacheSuggestions());
+    ASSERT_TRUE(find(apresSuppression.begin(), apresSuppression.end(), "brie") == apresSuppression.end());
+}
+
+TEST(Dictionnaire, givenBloomFilterAndTombstones_whenMostWordsAreDeleted_thenFilterIsResizedForLiveWords) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    for (int i = 0; i < 1000; i++)
+        dictSubject.ajouteMot("mot" + to_string(i), "t");
+    dictSubject.activeSuppressionDifferee(1.0);
+    dictSubject.activeFiltreBloom();
+    const size_t octetsAvant = dictSubject.empreinteMemoire().filtreBloom;
+
+    for (int i = 0; i < 800; i++)
+        dictSubject.supprimeMot("mot" + to_string(i));
+
+    ASSERT_EQ(800u, dictSubject.nombrePierresTombales());
+    ASSERT_LT(dictSubject.empreinteMemoire().filtreBloom, octetsAvant / 2);
+    for (int i = 800; i < 1000; i++)
+        ASSERT_TRUE(dictSubject.appartient("mot" + to_string(i)));
+}
+
+TEST(Dictionnaire, givenBloomFilter_whenAddAndDeleteManyWords_thenMembershipMatchesTheTree) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.ajouteMot("bird", "oiseau");
+    dictSubject.activeFiltreBloom();
+    for (int i = 0; i < 300; i++)
+        dictSubject.ajouteMot("mot" + to_string(i), "t");
+    for (int i = 0; i < 300; i += 2)
+        dictSubject.supprimeMot("mot" + to_string(i));
+
+    ASSERT_TRUE(dictSubject.filtreBloomEstActif());
+    ASSERT_TRUE(dictSubject.appartient("bird"));
+    ASSERT_EQ(vector<string>({ "oiseau" }), dictSubject.traduit("bird"));
+    for (int i = 0; i < 300; i++)
+        ASSERT_EQ(i % 2 == 1, dictSubject.appartient("mot" + to_string(i)));
+    ASSERT_FALSE(dictSubject.appartient("absent"));
+
+    dictSubject.desactiveFiltreBloom();
+    ASSERT_FALSE(dictSubject.filtreBloomEstActif());
+    ASSERT_TRUE(dictSubject.appartient("mot1"));
+}
+
+TEST(Dictionnaire, givenDeferredCopyOfIndexedDictionary_whenBothAreModified_thenEachKeepsItsOwnWords) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    for (int i = 0; i < 200; i++)
+        dictSubject.ajouteMot("mot" + to_string(i), "t" + to_string(i));
+    dictSubject.activeIndexHachage();
+    dictSubject.activeFiltreBloom();
+
+    TP3::Dictionnaire clone = dictSubject.copieDifferee();
+    ASSERT_TRUE(clone.indexHachageEstActif());
+    ASSERT_TRUE(clone.appartient("mot7"));
+
+    clone.ajouteMot("nouveau", "new");
+    clone.supprimeMot("mot7");
+    clone.ajouteMot("mot8", "huit");
+    dictSubject.supprimeMot("mot9");
+
+    ASSERT_TRUE(dictSubject.appartient("mot7"));
+    ASSERT_FALSE(dictSubject.appartient("nouveau"));
+    ASSERT_EQ(vector<string>({ "t8" }), dictSubject.traduit("mot8"));
+    ASSERT_FALSE(clone.appartient("mot7"));
+    ASSERT_TRUE(clone.appartient("mot9"));
+    ASSERT_EQ(vector<string>({ "t8", "huit" }), clone.traduit("mot8"));
+    ASSERT_EQ(vector<string>({ "new" }), clone.traduit("nouveau"));
+    for (int i = 10; i < 200; i++)
+        ASSERT_EQ(vector<string>({ "t" + to_string(i) }), clone.traduit("mot" + to_string(i)));
+}
+
+TEST(Dictionnaire, givenDictionaryWithIndexAndCache_whenMovedAndSwapped_thenOwnershipFollowsWithoutCopy) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.ajouteMot("bird", "oiseau");
+    dictSubject.ajouteMot("cat", "chat");
+    dictSubject.activeIndexHachage();
+    dictSubject.activeCacheSuggestions(16);
+    const string* adresseMot = &*dictSubject.begin();
+
+    TP3::Dictionnaire deplace(std::move(dictSubject));
+    ASSERT_TRUE(dictSubject.estVide());
+    ASSERT_FALSE(dictSubject.indexHachageEstActif());
+    ASSERT_FALSE(dictSubject.cacheSuggestionsEstActif());
+    ASSERT_EQ(adresseMot, &*deplace.begin());
+    ASSERT_TRUE(deplace.indexHachageEstActif());
+    ASSERT_TRUE(deplace.cacheSuggestionsEstActif());
+    ASSERT_EQ(vector<string>({ "chat" }), deplace.traduit("cat"));
+
+    TP3::Dictionnaire autre = Dictionnaire();
+    autre.ajouteMot("dog", "chien");
+    autre.swap(deplace);
+    ASSERT_EQ(adresseMot, &*autre.begin());
+    ASSERT_TRUE(deplace.appartient("dog"));
+    ASSERT_FALSE(deplace.appartient("cat"));
+
+    deplace = autre;
+    autre.supprimeMot("bird");
+    ASSERT_TRUE(deplace.appartient("bird"));
+    ASSERT_TRUE(deplace.indexHachageEstActif());
+    ASSERT_NE(adresseMot, &*deplace.begin());
+}
+
+TEST(Dictionnaire, givenTwoFileVersions_whenApplyDiff_thenOnlyChangedWordsAreTouchedAndCounted) {
+    istringstream vide("");
+    istringstream ancien("# en-tete\ncat\tchat\ndog\tchien\nbird\toiseau\nfish\tpoisson\n");
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.appliquerDiff(vide, ancien);
+    dictSubject.activeIndexHachage();
+    const string* adresseChat = &*dictSubject.lower_bound("cat");
+
+    istringstream ancienBis("# en-tete\ncat\tchat\ndog\tchien\nbird\toiseau\nfish\tpoisson\n");
+    istringstream nouveau("bird\toiseau\ncat\tchat\nfish\tpoisson\nfish\tpêcher\ndog\tcabot\nowl\thibou\n");
+    RapportDiff rapport = dictSubject.appliquerDiff(ancienBis, nouveau);
+
+    ASSERT_EQ(1u, rapport.motsAjoutes);
+    ASSERT_EQ(0u, rapport.motsSupprimes);
+    ASSERT_EQ(2u, rapport.motsModifies);
+    ASSERT_EQ(2u, rapport.motsInchanges);
+    ASSERT_EQ(3u, rapport.traductionsAjoutees);
+    ASSERT_EQ(1u, rapport.traductionsRetirees);
+    ASSERT_EQ(adresseChat, &*dictSubject.lower_bound("cat"));
+    ASSERT_EQ(vector<string>({ "cabot" }), dictSubject.traduit("dog"));
+    ASSERT_EQ(vector<string>({ "poisson", "pêcher" }), dictSubject.traduit("fish"));
+    ASSERT_EQ(vector<string>({ "hibou" }), dictSubject.traduit("owl"));
+}
+
+TEST(Dictionnaire, givenDiffDeletingWordAlreadyAbsent_whenApplyDiff_thenOnlyActualRemovalsAreCounted) {
+    istringstream vide("");
+    istringstream ancien("cat\tchat\ndog\tchien\nbird\toiseau\n");
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.appliquerDiff(vide, ancien);
+    dictSubject.supprimeMot("dog");
+
+    istringstream ancienBis("cat\tchat\ndog\tchien\nbird\toiseau\n");
+    istringstream nouveau("cat\tchat\n");
+    RapportDiff rapport = dictSubject.appliquerDiff(ancienBis, nouveau);
+
+    ASSERT_EQ(1u, rapport.motsSupprimes);
+    ASSERT_EQ(1u, rapport.traductionsRetirees);
+    ASSERT_EQ(1u, rapport.motsInchanges);
+    ASSERT_EQ(1u, dictSubject.statistiques().nombreMots);
+    ASSERT_TRUE(dictSubject.appartient("cat"));
+}
+
+TEST(Dictionnaire, givenManyRandomEdits_whenApplyDiff_thenDictionaryMatchesFullLoadOfNewVersion) {
+    ostringstream ancien, nouveau;
+    unsigned int graine = 7;
+    for (int i = 0; i < 2000; i++) {
+        graine = graine * 1103515245u + 12345u;
+        const string mot = "mot" + to_string(i);
+        ancien << mot << "\t" << "t" << i % 7 << "\n";
+        switch ((graine >> 16) % 5) {
+            case 0: break; //supprimé
+            case 1: nouveau << mot << "\tautre\n"; break;
+            case 2: nouveau << mot << "\tt" << i % 7 << "\n" << mot << "\tplus\n"; break;
+            default: nouveau << mot << "\tt" << i % 7 << "\n"; break;
+        }
+        if ((graine >> 20) % 10 == 0) nouveau << "neuf" << i << "\tn\n";
+    }
+
+    istringstream vide(""), ancienFlux(ancien.str()), ancienBis(ancien.str()), nouveauFlux(nouveau.str()), videBis(""),
+            nouveauBis(nouveau.str());
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.appliquerDiff(vide, ancienFlux);
+    dictSubject.activeFiltreBloom();
+    RapportDiff rapport = dictSubject.appliquerDiff(ancienBis, nouveauFlux);
+    TP3::Dictionnaire attendu = Dictionnaire();
+    attendu.appliquerDiff(videBis, nouveauBis);
+
+    ASSERT_GT(rapport.motsInchanges, 0u);
+    ASSERT_GT(rapport.motsSupprimes, 0u);
+    ASSERT_EQ(attendu.statistiques().nombreMots, dictSubject.statistiques().nombreMots);
+    ASSERT_TRUE(std::equal(attendu.begin(), attendu.end(), dictSubject.begin()));
+    for (Dictionnaire::Iterateur it = attendu.begin(); it != attendu.end(); ++it) {
+        ASSERT_TRUE(dictSubject.appartient(*it));
+        ASSERT_EQ(it.traductions(), dictSubject.traduit(*it));
+    }
+}
+
+TEST(Dictionnaire, givenIndexedDictionary_whenSplitAndConcatenated_thenWordsMoveWithoutCopy) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    for (int i = 100; i < 400; i++)
+        dictSubject.ajouteMot("mot" + to_string(i), "t" + to_string(i));
+    dictSubject.activeIndexHachage();
+    dictSubject.activeFiltreBloom();
+    const string* adresseMot = &*dictSubject.lower_bound("mot300");
+
+    TP3::Dictionnaire superieurs = dictSubject.scinde("mot250");
+    ASSERT_EQ(150, dictSubject.statistiques().nombreMots);
+    ASSERT_EQ(150, superieurs.statistiques().nombreMots);
+    ASSERT_FALSE(dictSubject.appartient("mot300"));
+    ASSERT_TRUE(dictSubject.appartient("mot249"));
+    ASSERT_EQ(vector<string>({ "t250" }), superieurs.traduit("mot250"));
+    ASSERT_EQ(adresseMot, &*superieurs.lower_bound("mot300"));
+
+    ASSERT_THROW(superieurs.concatene(dictSubject.copieDifferee()), logic_error);
+    dictSubject.concatene(std::move(superieurs));
+    ASSERT_EQ(300, dictSubject.statistiques().nombreMots);
+    ASSERT_EQ(adresseMot, &*dictSubject.lower_bound("mot300"));
+    ASSERT_EQ(vector<string>({ "t300" }), dictSubject.traduit("mot300"));
+}
+
+TEST(Dictionnaire, givenTwoDictionaries_whenSetOperationsAreApplied_thenWordsAndTranslationsFollowTheOperation) {
+    TP3::Dictionnaire general = Dictionnaire();
+    TP3::Dictionnaire glossaire = Dictionnaire();
+    general.ajouteMot("bank", "banque");
+    general.ajouteMot("cat", "chat");
+    general.ajouteMot("dog", "chien");
+    glossaire.ajouteMot("bank", "rive");
+    glossaire.ajouteMot("bank", "banque");
+    glossaire.ajouteMot("kernel", "noyau");
+    general.activeIndexHachage();
+
+    TP3::Dictionnaire intersection = general.copieDifferee();
+    intersection.intersecte(glossaire.copieDifferee());
+    ASSERT_EQ(vector<string>({ "bank" }), vector<string>(intersection.begin(), intersection.end()));
+    ASSERT_EQ(vector<string>({ "banque" }), intersection.traduit("bank"));
+
+    TP3::Dictionnaire difference = general.copieDifferee();
+    difference.retranche(glossaire.copieDifferee());
+    ASSERT_EQ(vector<string>({ "cat", "dog" }), vector<string>(difference.begin(), difference.end()));
+    ASSERT_FALSE(difference.appartient("bank"));
+
+    general.fusionne(std::move(glossaire));
+    ASSERT_TRUE(glossaire.estVide());
+    ASSERT_EQ(vector<string>({ "bank", "cat", "dog", "kernel" }), vector<string>(general.begin(), general.end()));
+    ASSERT_EQ(vector<string>({ "banque", "rive" }), general.traduit("bank"));
+    ASSERT_EQ(vector<string>({ "noyau" }), general.traduit("kernel"));
+    ASSERT_TRUE(general.indexHachageEstActif());
+}
+
+TEST(Dictionnaire, givenLazyDeletion_whenWordsAreDeleted_thenTreeIsUnchangedAndReadersAndPrintingSkipTombstones) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    for (const char* mot : { "bank", "bark", "bird", "cat", "dog", "door", "kernel" })
+        dictSubject.ajouteMot(mot, string(mot) + "_fr");
+    dictSubject.activeSuppressionDifferee(1.0);
+    ostringstream avant;
+    avant << dictSubject;
+
+    dictSubject.supprimeMot("bird");
+    dictSubject.supprimeMot("dog");
+    ostringstream apres;
+    apres << dictSubject;
+    istringstream lignesAvant(avant.str());
+    string attendu;
+    for (string ligne; getline(lignesAvant, ligne); )
+        if (ligne.compare(0, 5, "bird,") != 0 && ligne.compare(0, 4, "dog,") != 0)
+            attendu += ligne + "\n";
+    ASSERT_EQ(attendu, apres.str());
+    ASSERT_EQ(string::npos, apres.str().find("dog"));
+    ASSERT_EQ(2u, dictSubject.nombrePierresTombales());
+    ASSERT_EQ(5, dictSubject.statistiques().nombreMots);
+    ASSERT_FALSE(dictSubject.appartient("bird"));
+    ASSERT_TRUE(dictSubject.traduit("dog").empty());
+    ASSERT_THROW(dictSubject.supprimeMot("dog"), logic_error);
+    ASSERT_EQ(vector<string>({ "bank", "bark", "cat", "door", "kernel" }), vector<string>(dictSubject.begin(), dictSubject.end()));
+    ASSERT_EQ("cat", *--dictSubject.lower_bound("dog"));
+    ASSERT_EQ(vector<string>({ "door" }), dictSubject.motsAvecPrefixe("do", 10));
+    vector<string> suggestions = dictSubject.suggereCorrections("dog");
+    ASSERT_EQ(suggestions.end(), find(suggestions.begin(), suggestions.end(), "dog"));
+
+    TP3::Dictionnaire clone = dictSubject.copieDifferee();
+    dictSubject.ajouteMot("dog", "chien");
+    ASSERT_EQ(1u, dictSubject.nombrePierresTombales());
+    ASSERT_EQ(vector<string>({ "chien" }), dictSubject.traduit("dog"));
+    ASSERT_FALSE(clone.appartient("dog"));
+    ASSERT_EQ(2u, clone.nombrePierresTombales());
+
+    dictSubject.activeIndexHachage();
+    dictSubject.compacte();
+    ASSERT_EQ(0u, dictSubject.nombrePierresTombales());
+    ASSERT_EQ(6, dictSubject.statistiques().nombreMots);
+    ASSERT_FALSE(dictSubject.appartient("bird"));
+    ASSERT_EQ(vector<string>({ "chien" }), dictSubject.traduit("dog"));
+}
+
+TEST(Dictionnaire, givenLazyDeletionBound_whenTombstoneRatioExceedsIt_thenTreeIsCompacted) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    for (int i = 0; i < 100; i++)
+        dictSubject.ajouteMot("mot" + to_string(i), "t" + to_string(i));
+    dictSubject.activeFiltreBloom();
+    ASSERT_THROW(dictSubject.activeSuppressionDifferee(0), logic_error);
+    ASSERT_THROW(dictSubject.activeSuppressionDifferee(1.5), logic_error);
+    ASSERT_FALSE(dictSubject.suppressionDiffereeEstActive());
+
+    dictSubject.activeSuppressionDifferee(0.25);
+    for (int i = 0; i < 25; i++)
+        dictSubject.supprimeMot("mot" + to_string(i));
+    ASSERT_EQ(25u, dictSubject.nombrePierresTombales());
+    ASSERT_EQ(100, dictSubject.statistiques().nombreMots + 25);
+
+    dictSubject.supprimeMot("mot25");
+    ASSERT_EQ(0u, dictSubject.nombrePierresTombales());
+    ASSERT_EQ(74, dictSubject.statistiques().nombreMots);
+
+    ASSERT_EQ(10u, dictSubject.supprimeMots({ "mot30", "mot31", "mot32", "mot33", "mot34", "mot35", "mot36", "mot37",
+                                               "mot38", "mot39", "mot39", "absent" }));
+    ASSERT_EQ(10u, dictSubject.nombrePierresTombales());
+    dictSubject.desactiveSuppressionDifferee();
+    ASSERT_EQ(0u, dictSubject.nombrePierresTombales());
+    ASSERT_EQ(64, dictSubject.statistiques().nombreMots);
+    for (int i = 0; i < 100; i++)
+        ASSERT_EQ(i >= 40 || (i > 25 && i < 30), dictSubject.appartient("mot" + to_string(i)));
+}
+
+TEST(Dictionnaire, givenShortAndLongWords_whenMemoryIsMeasured_thenEachPartIsAccountedInTheTotal) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    dictSubject.ajouteMot("cat", "chat");
+    dictSubject.ajouteMot("antidisestablishmentarianism", "antidésétablissementarisme");
+
+    EmpreinteMemoire empreinte = dictSubject.empreinteMemoire();
+    ASSERT_EQ(2 * sizeof(NoeudDictionnaire), empreinte.noeuds);
+    ASSERT_EQ(1u, empreinte.motsEnLigne);
+    ASSERT_EQ(1u, empreinte.motsSurMonceau);
+    ASSERT_GT(empreinte.octetsMots, string("antidisestablishmentarianism").size());
+    ASSERT_GT(empreinte.octetsTraductions, 2 * sizeof(string) + string("antidésétablissementarisme").size());
+    ASSERT_EQ(0u, empreinte.indexHachage + empreinte.filtreBloom + empreinte.cacheSuggestions);
+    ASSERT_EQ(empreinte.noeuds + empreinte.octetsMots + empreinte.octetsTraductions, empreinte.total);
+
+    dictSubject.activeIndexHachage();
+    dictSubject.activeFiltreBloom();
+    dictSubject.activeCacheSuggestions(64);
+    dictSubject.suggereCorrections("kat");
+    empreinte = dictSubject.empreinteMemoire();
+    ASSERT_GT(empreinte.indexHachage, 0u);
+    ASSERT_GT(empreinte.filtreBloom, 0u);
+    ASSERT_GT(empreinte.cacheSuggestions, 0u);
+    ASSERT_EQ(empreinte.noeuds + empreinte.octetsMots + empreinte.octetsTraductions + empreinte.indexHachage
+              + empreinte.filtreBloom + empreinte.cacheSuggestions, empreinte.total);
+    ASSERT_EQ(empreinte.total, dictSubject.statistiques().empreinteMemoire);
+}
+
+TEST(Dictionnaire, givenMemoryBudget_whenExceeded_thenOptionalStructuresDegradeInsteadOfWords) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    for (int i = 0; i < 2000; i++)
+        dictSubject.ajouteMot("mot" + to_string(i), "t" + to_string(i));
+    dictSubject.activeIndexHachage();
+    dictSubject.activeFiltreBloom();
+    dictSubject.activeCacheSuggestions(4096);
+    const EmpreinteMemoire complete = dictSubject.empreinteMemoire();
+    const size_t donnees = complete.total - complete.indexHachage - complete.filtreBloom - complete.cacheSuggestions;
+
+    dictSubject.fixeBudgetMemoire(donnees + complete.indexHachage);
+    ASSERT_FALSE(dictSubject.cacheSuggestionsEstActif());
+    ASSERT_FALSE(dictSubject.filtreBloomEstActif());
+    ASSERT_TRUE(dictSubject.indexHachageEstActif());
+    ASSERT_LE(dictSubject.empreinteMemoire().total, dictSubject.budgetMemoire());
+    ASSERT_GE(dictSubject.degradationsBudgetMemoire(), 2u);
+
+    dictSubject.activeCacheSuggestions(1024);
+    ASSERT_FALSE(dictSubject.cacheSuggestionsEstActif());
+    ASSERT_TRUE(dictSubject.indexHachageEstActif());
+
+    for (int i = 2000; i < 2300; i++)
+        dictSubject.ajouteMot("mot" + to_string(i), "t" + to_string(i));
+    ASSERT_FALSE(dictSubject.indexHachageEstActif());
+    ASSERT_EQ(2300, dictSubject.statistiques().nombreMots);
+    ASSERT_EQ(vector<string>({ "t2299" }), dictSubject.traduit("mot2299"));
+
+    dictSubject.fixeBudgetMemoire(0);
+    dictSubject.activeIndexHachage();
+    ASSERT_TRUE(dictSubject.indexHachageEstActif());
+}
+
+TEST(Dictionnaire, givenHugePagesMode_whenModifyAndSearch_thenResultsMatchTheOrdinaryMode) {
+    Dictionnaire dictSubject;
+    Dictionnaire reference;
+    for (int i = 0; i < 2000; i++) {
+        dictSubject.ajouteMot("mot" + to_string(i), "t" + to_string(i));
+        reference.ajouteMot("mot" + to_string(i), "t" + to_string(i));
+    }
+    dictSubject.activeIndexHachage();
+
+    dictSubject.activeGrandesPages(1);
+    for (int i = 0; i < 2000; i += 3) {
+        dictSubject.supprimeMot("mot" + to_string(i));
+        reference.supprimeMot("mot" + to_string(i));
+    }
+    dictSubject.ajouteMot("oiseau", "bird");
+    reference.ajouteMot("oiseau", "bird");
+
+    ASSERT_TRUE(dictSubject.grandesPagesSontActives());
+    ASSERT_EQ(ArenaGrandesPages::TAILLE_GRANDE_PAGE, dictSubject.octetsGrandesPages());
+    ASSERT_EQ(reference.statistiques().nombreMots, dictSubject.statistiques().nombreMots);
+    for (Dictionnaire::Iterateur mot = reference.begin(); mot != reference.end(); ++mot)
+        ASSERT_EQ(mot.traductions(), dictSubject.traduit(*mot));
+    ASSERT_FALSE(dictSubject.appartient("mot0"));
+
+    Dictionnaire copie(dictSubject);
+    dictSubject.desactiveGrandesPages();
+
+    ASSERT_FALSE(dictSubject.grandesPagesSontActives());
+    ASSERT_EQ(0u, dictSubject.octetsGrandesPages());
+    ASSERT_TRUE(copie.grandesPagesSontActives());
+    ASSERT_EQ(vector<string>({ "bird" }), copie.traduit("oiseau"));
+    ASSERT_EQ(vector<string>({ "bird" }), dictSubject.traduit("oiseau"));
+}
+
+TEST(Dictionnaire, givenOnlyOneDictionaryInHugePagesMode_whenMergeOrConcatenate_thenNodesAreCopiedIntoItsArena) {
+    Dictionnaire dictSubject;
+    dictSubject.ajouteMot("a", "un");
+    dictSubject.activeGrandesPages();
+    Dictionnaire autre;
+    autre.ajouteMot("b", "deux");
+    Dictionnaire superieurs;
+    superieurs.ajouteMot("c", "trois");
+
+    dictSubject.fusionne(autre);
+    dictSubject.concatene(superieurs);
+    Dictionnaire partie = dictSubject.scinde("b");
+
+    ASSERT_TRUE(dictSubject.grandesPagesSontActives());
+    ASSERT_TRUE(partie.grandesPagesSontActives());
+    ASSERT_EQ(1, dictSubject.statistiques().nombreMots);
+    ASSERT_EQ(vector<string>({ "deux" }), partie.traduit("b"));
+    ASSERT_EQ(vector<string>({ "trois" }), partie.traduit("c"));
+}
+
+#ifdef TP3_INSTRUMENTATION
+TEST(Dictionnaire, givenBloomFilterAndInstrumentation_whenLookupAbsentWords_thenMostAreRejectedWithoutDescent) {
+    TP3::Dictionnaire dictSubject = Dictionnaire();
+    for (int i = 0; i < 1000; i++)
+        dictSubject.ajouteMot("mot" + to_string(i), "t");
+    dictSubject.activeFiltreBloom();
+    dictSubject.reinitialiseCompteurs();
+
+    for (int i = 0; i < 1000; i++)
+        dictSubject.appartient("absent" + to_string(i));
+
+    ASSERT_GT(dictSubject.compteurs().rejetsFiltreBloom.load(), 950);
+}
+#endif
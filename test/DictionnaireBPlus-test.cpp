@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+#include "DictionnaireBPlus.h"
+#include "Dictionnaire.h"
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace TP3;
+using namespace std;
+
+TEST(DictionnaireBPlus, givenEmptyDictionary_whenDeleteWord_thenThrowsLogicError) {
+    DictionnaireBPlus bplusSubject;
+
+    ASSERT_TRUE(bplusSubject.estVide());
+    ASSERT_FALSE(bplusSubject.appartient("bird"));
+    ASSERT_THROW(bplusSubject.supprimeMot("bird"), logic_error);
+    bplusSubject.ajouteMot("cat", "chat");
+    ASSERT_THROW(bplusSubject.supprimeMot("bird"), logic_error);
+}
+
+TEST(DictionnaireBPlus, givenSameWordTwice_whenAddWord_thenTranslationsAreMergedWithoutDuplicate) {
+    DictionnaireBPlus bplusSubject;
+
+    bplusSubject.ajouteMot("contemplate", "contempler");
+    bplusSubject.ajouteMot("contemplate", "envisager");
+    bplusSubject.ajouteMot("contemplate", "contempler");
+
+    ASSERT_EQ(1, bplusSubject.taille());
+    ASSERT_EQ(vector<string>({ "contempler", "envisager" }), bplusSubject.traduit("contemplate"));
+}
+
+TEST(DictionnaireBPlus, givenRandomAddsAndDeletes_whenQueried_thenContentMatchesAReferenceMap) {
+    DictionnaireBPlus bplusSubject;
+    map<string, string> reference;
+    mt19937 generateur(2020);
+    uniform_int_distribution<int> choixMot(0, 4999);
+
+    for (int operation = 0; operation < 30000; operation++) {
+        const string mot = "internationalisation" + to_string(choixMot(generateur));
+        if (operation % 3 == 2 && reference.count(mot) != 0) {
+            bplusSubject.supprimeMot(mot);
+            reference.erase(mot);
+        } else if (reference.count(mot) == 0) {
+            bplusSubject.ajouteMot(mot, "t" + mot);
+            reference[mot] = "t" + mot;
+        }
+    }
+    ASSERT_EQ(reference.size(), bplusSubject.taille());
+    ASSERT_LE(bplusSubject.hauteur(), 4);
+    for (const auto & entree : reference)
+        ASSERT_EQ(vector<string>(1, entree.second), bplusSubject.traduit(entree.first));
+
+    vector<string> tousLesMots = bplusSubject.motsEntre("", "~", reference.size() + 1);
+    ASSERT_EQ(reference.size(), tousLesMots.size());
+    auto entree = reference.begin();
+    for (const auto & mot : tousLesMots)
+        ASSERT_EQ((entree++)->first, mot);
+
+    for (const auto & restant : reference)
+        bplusSubject.supprimeMot(restant.first);
+    ASSERT_TRUE(bplusSubject.estVide());
+    ASSERT_EQ(1, bplusSubject.hauteur());
+}
+
+TEST(DictionnaireBPlus, givenWords_whenOrderedQueries_thenResultsMatchTheAvl) {
+    Dictionnaire dictionnaire;
+    DictionnaireBPlus bplusSubject;
+    for (int i = 0; i < 500; i++) {
+        dictionnaire.ajouteMot("mot" + to_string(i), "t");
+        bplusSubject.ajouteMot("mot" + to_string(i), "t");
+    }
+
+    ASSERT_EQ(dictionnaire.motsAvecPrefixe("mot1", 1000), bplusSubject.motsAvecPrefixe("mot1", 1000));
+    ASSERT_EQ(dictionnaire.motsAvecPrefixe("mot4", 3), bplusSubject.motsAvecPrefixe("mot4", 3));
+    ASSERT_EQ(dictionnaire.motsEntre("mot25", "mot3", 1000), bplusSubject.motsEntre("mot25", "mot3", 1000));
+    ASSERT_TRUE(bplusSubject.motsEntre("mot3", "mot25", 1000).empty());
+}
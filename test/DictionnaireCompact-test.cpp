@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+#include "DictionnaireCompact.h"
+#include <stdexcept>
+#include <string>
+
+using namespace TP3;
+using namespace std;
+
+TEST(DictionnaireCompact, givenWordsSharingLongPrefixesAndAnyRestartInterval_whenSearch_thenResultsMatchTheTree) {
+    Dictionnaire dictionnaire;
+    const char* mots[] = { "a", "bat", "internation", "international", "internationalisation", "internationalisations",
+                           "internet", "internets", "zz", "\xC3\xA9t\xC3\xA9" };
+    for (const char* mot : mots)
+        dictionnaire.ajouteMot(mot, "t");
+    const char* requetes[] = { "", "a", "b", "internat", "internationa", "internationalise", "internationaux", "zzz", "\xC3\xA9" };
+
+    for (size_t intervalle = 1; intervalle <= 11; intervalle++) {
+        DictionnaireCompact compactSubject(dictionnaire, intervalle);
+
+        for (const char* requete : requetes) {
+            Dictionnaire::Iterateur attendu = dictionnaire.lower_bound(requete);
+            const size_t rang = compactSubject.rangInferieur(requete);
+            if (attendu == dictionnaire.end())
+                ASSERT_EQ(compactSubject.taille(), rang) << requete;
+            else
+                ASSERT_EQ(*attendu, compactSubject.mot(rang)) << requete;
+        }
+        ASSERT_TRUE(compactSubject.appartient("internation"));
+        ASSERT_FALSE(compactSubject.appartient("internationa"));
+        ASSERT_EQ(vector<string>({ "internation", "international", "internationalisation" }),
+                  compactSubject.motsAvecPrefixe("internation", 3));
+        ASSERT_EQ(vector<string>({ "internet", "internets", "zz" }), compactSubject.motsEntre("interne", "zz", 10));
+    }
+    ASSERT_THROW(DictionnaireCompact(dictionnaire, 0), logic_error);
+    ASSERT_TRUE(DictionnaireCompact(Dictionnaire()).estVide());
+    ASSERT_TRUE(DictionnaireCompact(Dictionnaire()).motsAvecPrefixe("b", 10).empty());
+}
+
+TEST(DictionnaireCompact, givenWordsSharingPrefixes_whenBuild_thenKeysTakeAtLeastTwiceLessMemory) {
+    Dictionnaire dictionnaire;
+    size_t octetsNonCompresses = 0;
+    for (int i = 0; i < 5000; i++) {
+        const string mot = "anticonstitutionnellement" + to_string(i);
+        dictionnaire.ajouteMot(mot, "t");
+        octetsNonCompresses += mot.size() + sizeof(uint32_t);
+    }
+
+    DictionnaireCompact compactSubject(dictionnaire);
+
+    ASSERT_LE(2 * compactSubject.empreinteMots(), octetsNonCompresses);
+    ASSERT_LT(compactSubject.empreinteMots(), compactSubject.empreinteMemoire());
+}
@@ -0,0 +1,21 @@
+#include "gtest/gtest.h"
+#include "DictionnaireEytzinger.h"
+#include <string>
+
+using namespace TP3;
+using namespace std;
+
+TEST(DictionnaireEytzinger, givenEveryTreeSize_whenLowerBound_thenEachWordIsFoundAtItsRank) {
+    for (int n = 1; n <= 40; n++) {
+        Dictionnaire dictionnaire;
+        for (int i = 0; i < n; i++)
+            dictionnaire.ajouteMot(string(1, static_cast<char>('A' + 2 * i)), "t");
+
+        DictionnaireEytzinger eytzingerSubject(dictionnaire);
+
+        for (int i = 0; i < n; i++) {
+            ASSERT_EQ(static_cast<size_t>(i), eytzingerSubject.rangInferieur(string(1, static_cast<char>('A' + 2 * i))));
+            ASSERT_EQ(static_cast<size_t>(i + 1), eytzingerSubject.rangInferieur(string(1, static_cast<char>('A' + 2 * i + 1))));
+        }
+    }
+}
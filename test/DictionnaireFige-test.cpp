@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include "DictionnaireFige.h"
+#include <stdexcept>
+#include <string>
+
+using namespace TP3;
+using namespace std;
+
+TEST(DictionnaireFige, givenWords_whenOrderedQueries_thenResultsMatchTheTree) {
+    Dictionnaire dictionnaire;
+    const char* mots[] = { "bat", "bird", "bread", "breed", "cat", "dog", "a", "brie" };
+    for (const char* mot : mots)
+        dictionnaire.ajouteMot(mot, "t");
+
+    DictionnaireFige figeSubject = dictionnaire.fige();
+
+    ASSERT_EQ(dictionnaire.motsAvecPrefixe("br", 10), figeSubject.motsAvecPrefixe("br", 10));
+    ASSERT_EQ(dictionnaire.motsAvecPrefixe("br", 2), figeSubject.motsAvecPrefixe("br", 2));
+    ASSERT_EQ(dictionnaire.motsEntre("bird", "cat", 10), figeSubject.motsEntre("bird", "cat", 10));
+    ASSERT_EQ(dictionnaire.motsEntre("c", "b", 10), figeSubject.motsEntre("c", "b", 10));
+    ASSERT_EQ("a", figeSubject.mot(0));
+    ASSERT_EQ(figeSubject.taille(), figeSubject.rangInferieur("zzz"));
+    ASSERT_THROW(figeSubject.mot(figeSubject.taille()), logic_error);
+    ASSERT_TRUE(Dictionnaire().fige().estVide());
+    ASSERT_TRUE(Dictionnaire().fige().motsAvecPrefixe("b", 10).empty());
+}
+
+TEST(DictionnaireFige, givenManyWords_whenFreeze_thenMemoryIsSmallerThanTheTree) {
+    Dictionnaire dictionnaire;
+    for (int i = 0; i < 2000; i++)
+        dictionnaire.ajouteMot("mot" + to_string(i), "traduction");
+
+    DictionnaireFige figeSubject = dictionnaire.fige();
+
+    ASSERT_LT(figeSubject.empreinteMemoire() * 3, dictionnaire.statistiques().empreinteMemoire);
+}
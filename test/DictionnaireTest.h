@@ -0,0 +1,30 @@
+/**
+ * \file DictionnaireTest.h
+ * \brief Ce fichier contient le petit dictionnaire anglais-français partagé par les tests des traducteurs et du serveur.
+ * \author IFT-2008, Guillaume Doucet
+ * \version 0.1
+ * \date juillet 2020
+ *
+ */
+
+#ifndef DICTIONNAIRETEST_H_
+#define DICTIONNAIRETEST_H_
+
+#include "Dictionnaire.h"
+
+namespace TP3
+{
+
+	//Ajouter les mots des tests : the, bird (2 traductions), bread, eats, small
+	inline void remplirDictionnaire(Dictionnaire& dictionnaire) {
+		dictionnaire.ajouteMot("the", "le");
+		dictionnaire.ajouteMot("bird", "oiseau");
+		dictionnaire.ajouteMot("bird", "aigle");
+		dictionnaire.ajouteMot("bread", "pain");
+		dictionnaire.ajouteMot("eats", "mange");
+		dictionnaire.ajouteMot("small", "petit");
+	}
+
+}
+
+#endif /* DICTIONNAIRETEST_H_ */
@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include "DictionnaireCompact.h"
+#include "DictionnaireEytzinger.h"
+#include "DictionnaireFige.h"
+#include <stdexcept>
+#include <string>
+
+using namespace TP3;
+using namespace std;
+
+/**
+ * Cas communs aux copies en lecture seule du dictionnaire (DictionnaireFige, DictionnaireEytzinger, DictionnaireCompact) :
+ * chacune est construite à partir d'un Dictionnaire et doit donner les mêmes réponses que l'arbre. Les vérifications
+ * propres à une représentation restent dans son fichier de tests.
+ */
+template<typename DictionnaireLecture>
+class DictionnairesLectureSeule : public ::testing::Test {};
+
+typedef ::testing::Types<DictionnaireFige, DictionnaireEytzinger, DictionnaireCompact> DictionnairesLecture;
+TYPED_TEST_SUITE(DictionnairesLectureSeule, DictionnairesLecture);
+
+TYPED_TEST(DictionnairesLectureSeule, givenEmptyDictionary_whenBuild_thenNothingBelongs) {
+    Dictionnaire dictionnaire;
+
+    TypeParam lectureSubject(dictionnaire);
+
+    ASSERT_EQ(0, lectureSubject.taille());
+    ASSERT_FALSE(lectureSubject.appartient("bird"));
+    ASSERT_TRUE(lectureSubject.traduit("bird").empty());
+    ASSERT_EQ(0, lectureSubject.rangInferieur("bird"));
+    ASSERT_THROW(lectureSubject.mot(0), logic_error);
+}
+
+TYPED_TEST(DictionnairesLectureSeule, givenManyWords_whenBuild_thenEveryWordHasTheSameTranslationsAndRank) {
+    Dictionnaire dictionnaire;
+    for (int i = 0; i < 1000; i++) {
+        dictionnaire.ajouteMot("mot" + to_string(i), "traduction" + to_string(i));
+        if (i % 3 == 0)
+            dictionnaire.ajouteMot("mot" + to_string(i), "autre" + to_string(i));
+    }
+
+    TypeParam lectureSubject(dictionnaire);
+
+    ASSERT_EQ(1000, lectureSubject.taille());
+    size_t rang = 0;
+    for (Dictionnaire::Iterateur mot = dictionnaire.begin(); mot != dictionnaire.end(); ++mot, ++rang) {
+        ASSERT_EQ(*mot, lectureSubject.mot(rang));
+        ASSERT_EQ(rang, lectureSubject.rangInferieur(*mot));
+        ASSERT_TRUE(lectureSubject.appartient(*mot));
+        ASSERT_EQ(mot.traductions(), lectureSubject.traduit(*mot));
+    }
+    for (int i = 1000; i < 2000; i++)
+        ASSERT_FALSE(lectureSubject.appartient("mot" + to_string(i)));
+    ASSERT_THROW(lectureSubject.mot(lectureSubject.taille()), logic_error);
+}
+
+TYPED_TEST(DictionnairesLectureSeule, givenWordsSharingLongPrefixes_whenLowerBound_thenResultMatchesTheTree) {
+    Dictionnaire dictionnaire;
+    const char* mots[] = { "a", "bat", "internation", "international", "internationalisation", "internationalisations",
+                           "internet", "internets", "zz", "\xC3\xA9t\xC3\xA9" };
+    for (const char* mot : mots)
+        dictionnaire.ajouteMot(mot, "t");
+    const char* requetes[] = { "", "a", "b", "internat", "internationa", "internationalise", "internationaux", "zzz", "\xC3\xA9" };
+
+    TypeParam lectureSubject(dictionnaire);
+
+    for (const char* requete : requetes) {
+        Dictionnaire::Iterateur attendu = dictionnaire.lower_bound(requete);
+        const size_t rang = lectureSubject.rangInferieur(requete);
+        if (attendu == dictionnaire.end())
+            ASSERT_EQ(lectureSubject.taille(), rang) << requete;
+        else
+            ASSERT_EQ(*attendu, lectureSubject.mot(rang)) << requete;
+    }
+    ASSERT_TRUE(lectureSubject.appartient("internation"));
+    ASSERT_FALSE(lectureSubject.appartient("internationa"));
+}
@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+#include "FileBornee.h"
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace TP3;
+using namespace std;
+
+TEST(FileBornee, givenCapacityNotPowerOfTwo_whenConstruct_thenThrowLogicError) {
+    ASSERT_THROW(FileBornee<int> fileSubject(12), logic_error);
+    ASSERT_THROW(FileBornee<int> fileSubject(1), logic_error);
+}
+
+TEST(FileBornee, givenElementsEnqueued_whenDequeue_thenTheyComeOutInFifoOrder) {
+    FileBornee<int> fileSubject(4);
+    fileSubject.enfiler(1);
+    fileSubject.enfiler(2);
+    fileSubject.enfiler(3);
+
+    ASSERT_EQ(1, fileSubject.defiler());
+    ASSERT_EQ(2, fileSubject.defiler());
+    ASSERT_EQ(3, fileSubject.defiler());
+}
+
+TEST(FileBornee, givenFullOrEmptyQueue_whenTryWithoutWaiting_thenItFails) {
+    FileBornee<int> fileSubject(2);
+    int element = 0;
+
+    ASSERT_FALSE(fileSubject.essaieDefiler(element));
+    ASSERT_TRUE(fileSubject.essaieEnfiler(1));
+    ASSERT_TRUE(fileSubject.essaieEnfiler(2));
+    ASSERT_FALSE(fileSubject.essaieEnfiler(3));
+    ASSERT_TRUE(fileSubject.essaieDefiler(element));
+    ASSERT_EQ(1, element);
+    ASSERT_TRUE(fileSubject.essaieEnfiler(3));
+}
+
+TEST(FileBornee, givenManyProducersAndConsumers_whenTransferring_thenEveryElementIsReceivedOnce) {
+    const int NB_FILS = 4;
+    const int ELEMENTS_PAR_FIL = 20000;
+    FileBornee<int> fileSubject(64);
+    vector<long long> sommes(NB_FILS, 0);
+    vector<thread> fils;
+
+    for (int f = 0; f < NB_FILS; f++) {
+        fils.push_back(thread([&fileSubject, f, ELEMENTS_PAR_FIL]() {
+            for (int i = 1; i <= ELEMENTS_PAR_FIL; i++)
+                fileSubject.enfiler(f * ELEMENTS_PAR_FIL + i);
+        }));
+        fils.push_back(thread([&fileSubject, &sommes, f, ELEMENTS_PAR_FIL]() {
+            for (int i = 0; i < ELEMENTS_PAR_FIL; i++)
+                sommes[f] += fileSubject.defiler();
+        }));
+    }
+    for (auto & fil : fils)
+        fil.join();
+
+    long long total = 0;
+    for (long long somme : sommes)
+        total += somme;
+    const long long n = static_cast<long long>(NB_FILS) * ELEMENTS_PAR_FIL;
+    ASSERT_EQ(n * (n + 1) / 2, total);
+}
+
+TEST(FileBornee, givenThreadsAsleepOnEmptyAndFullQueues_whenOtherSideArrivesLater_thenTheyWakeUp) {
+    FileBornee<int> videSubject(2);
+    FileBornee<int> pleineSubject(2);
+    ASSERT_TRUE(pleineSubject.essaieEnfiler(1));
+    ASSERT_TRUE(pleineSubject.essaieEnfiler(2));
+    int recu = 0;
+
+    thread consommateur([&videSubject, &recu]() { recu = videSubject.defiler(); });
+    thread producteur([&pleineSubject]() { pleineSubject.enfiler(3); });
+    this_thread::sleep_for(chrono::milliseconds(50));
+    int element = 0;
+    ASSERT_TRUE(pleineSubject.essaieDefiler(element));
+    ASSERT_TRUE(videSubject.essaieEnfiler(42));
+    consommateur.join();
+    producteur.join();
+
+    ASSERT_EQ(42, recu);
+    ASSERT_EQ(1, element);
+    ASSERT_TRUE(pleineSubject.essaieDefiler(element));
+    ASSERT_EQ(2, element);
+    ASSERT_TRUE(pleineSubject.essaieDefiler(element));
+    ASSERT_EQ(3, element);
+}
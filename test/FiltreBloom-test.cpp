@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include "FiltreBloom.h"
+#include <string>
+
+using namespace TP3;
+using namespace std;
+
+TEST(FiltreBloom, givenEmptyFilter_whenCheckWord_thenItCannotContainIt) {
+    FiltreBloom filtreSubject;
+
+    ASSERT_FALSE(filtreSubject.peutContenir("bird"));
+}
+
+TEST(FiltreBloom, givenAddedWords_whenCheckThem_thenThereIsNoFalseNegative) {
+    FiltreBloom filtreSubject;
+    filtreSubject.reinitialiser(5000);
+    for (int i = 0; i < 5000; i++)
+        filtreSubject.ajouter("mot" + to_string(i));
+
+    for (int i = 0; i < 5000; i++)
+        ASSERT_TRUE(filtreSubject.peutContenir("mot" + to_string(i)));
+}
+
+TEST(FiltreBloom, givenFilterSizedForItsWords_whenCheckAbsentWords_thenFalsePositiveRateIsLow) {
+    FiltreBloom filtreSubject;
+    filtreSubject.reinitialiser(10000);
+    for (int i = 0; i < 10000; i++)
+        filtreSubject.ajouter("present" + to_string(i));
+
+    int fauxPositifs = 0;
+    for (int i = 0; i < 100000; i++)
+        if (filtreSubject.peutContenir("absent" + to_string(i)))
+            fauxPositifs++;
+
+    ASSERT_LT(fauxPositifs, 3000);
+}
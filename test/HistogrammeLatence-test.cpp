@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "HistogrammeLatence.h"
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace TP3;
+using namespace std;
+
+TEST(HistogrammeLatence, givenAnyDuration_whenGetBucket_thenDurationIsWithinBucketBounds) {
+    for (uint64_t duree : vector<uint64_t>({0, 1, 7, 8, 9, 100, 1000, 123456789, 1ULL << 40, UINT64_MAX})) {
+        int indice = HistogrammeLatence::indiceCase(duree);
+
+        ASSERT_LT(indice, HistogrammeLatence::NB_CASES);
+        ASSERT_TRUE(duree < HistogrammeLatence::borneSuperieure(indice) || duree == UINT64_MAX);
+        if (indice > 0) {
+            ASSERT_GE(duree, HistogrammeLatence::borneSuperieure(indice - 1));
+        }
+    }
+}
+
+TEST(HistogrammeLatence, givenDurations_whenGetQuantile_thenItIsWithinRelativePrecision) {
+    HistogrammeLatence histogrammeSubject;
+    for (uint64_t duree = 1; duree <= 1000; duree++)
+        histogrammeSubject.enregistrer(duree * 1000);
+
+    uint64_t mediane = histogrammeSubject.quantile(0.5);
+
+    ASSERT_EQ(1000, histogrammeSubject.nombre());
+    ASSERT_EQ(500500000ULL, histogrammeSubject.somme());
+    ASSERT_GE(mediane, 500000ULL);
+    ASSERT_LE(mediane, 500000ULL * 9 / 8);
+}
+
+TEST(HistogrammeLatence, givenManyThreads_whenRecord_thenNoDurationIsLost) {
+    HistogrammeLatence histogrammeSubject;
+    vector<thread> fils;
+    for (int i = 0; i < 4; i++) {
+        fils.push_back(thread([&histogrammeSubject]() {
+            for (int j = 0; j < 10000; j++)
+                histogrammeSubject.enregistrer(j);
+        }));
+    }
+    for (thread& fil : fils)
+        fil.join();
+
+    ASSERT_EQ(40000, histogrammeSubject.nombre());
+}
+
+TEST(HistogrammeLatence, givenManyShortLivedHistograms_whenRecordFromSameThread_thenEachOneOnlyCountsItsOwnDurations) {
+    HistogrammeLatence permanent;
+    permanent.enregistrer(5);
+
+    for (int i = 0; i < 1000; i++) {
+        HistogrammeLatence histogrammeSubject;
+        histogrammeSubject.enregistrer(100);
+        histogrammeSubject.enregistrer(200);
+
+        ASSERT_EQ(2, histogrammeSubject.nombre());
+        ASSERT_EQ(300, histogrammeSubject.somme());
+    }
+    permanent.enregistrer(5);
+
+    ASSERT_EQ(2, permanent.nombre());
+    ASSERT_EQ(10, permanent.somme());
+}
+
+TEST(HistogrammeLatence, givenDurations_whenExportPrometheus_thenBucketsAreCumulative) {
+    HistogrammeLatence histogrammeSubject;
+    histogrammeSubject.enregistrer(100);
+    histogrammeSubject.enregistrer(1000000);
+    ostringstream sortie;
+
+    histogrammeSubject.exportePrometheus(sortie, "latence", "operation=\"traduit\"");
+
+    string texte = sortie.str();
+    ASSERT_NE(string::npos, texte.find("latence_bucket{operation=\"traduit\",le=\"0.000000128\"} 1\n"));
+    ASSERT_NE(string::npos, texte.find("latence_bucket{operation=\"traduit\",le=\"+Inf\"} 2\n"));
+    ASSERT_NE(string::npos, texte.find("latence_count{operation=\"traduit\"} 2\n"));
+    ASSERT_NE(string::npos, texte.find("latence_sum{operation=\"traduit\"} 0.0010001\n"));
+}
+
+TEST(HistogrammeLatence, givenLargeDurationsAndScientificStream_whenExportPrometheus_thenBoundsAndSumAreExactDecimals) {
+    HistogrammeLatence histogrammeSubject;
+    histogrammeSubject.enregistrer(1000000);
+    histogrammeSubject.enregistrer(12345678901ULL);
+    ostringstream sortie;
+    sortie << scientific;
+
+    histogrammeSubject.exportePrometheus(sortie, "latence", "");
+
+    string texte = sortie.str();
+    ASSERT_NE(string::npos, texte.find("latence_bucket{le=\"0.001048576\"} 1\n"));
+    ASSERT_NE(string::npos, texte.find("latence_bucket{le=\"17.179869184\"} 2\n"));
+    ASSERT_NE(string::npos, texte.find("latence_sum{} 12.346678901\n"));
+}
@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+#include "IndexHachage.h"
+#include <string>
+#include <vector>
+
+using namespace TP3;
+using namespace std;
+
+namespace {
+    struct NoeudTest {
+        string mot;
+    };
+}
+
+TEST(IndexHachage, givenEmptyIndex_whenFindWord_thenItReturnsNull) {
+    IndexHachage<NoeudTest> indexSubject;
+
+    ASSERT_EQ(nullptr, indexSubject.trouver("mot"));
+    ASSERT_EQ(0, indexSubject.taille());
+}
+
+TEST(IndexHachage, givenManyWords_whenInsertAndRemoveHalf_thenOnlyRemainingWordsAreFound) {
+    IndexHachage<NoeudTest> indexSubject;
+    vector<NoeudTest> noeuds(1000);
+    for (size_t i = 0; i < noeuds.size(); i++) {
+        noeuds[i].mot = "mot" + to_string(i);
+        indexSubject.inserer(&noeuds[i]);
+    }
+
+    for (size_t i = 0; i < noeuds.size(); i += 2)
+        indexSubject.retirer(noeuds[i].mot);
+
+    ASSERT_EQ(500, indexSubject.taille());
+    for (size_t i = 0; i < noeuds.size(); i++) {
+        if (i % 2 == 0)
+            ASSERT_EQ(nullptr, indexSubject.trouver(noeuds[i].mot));
+        else
+            ASSERT_EQ(&noeuds[i], indexSubject.trouver(noeuds[i].mot));
+    }
+}
+
+TEST(IndexHachage, givenIndexedWord_whenInsertOtherNodeWithSameWord_thenHandleIsReplaced) {
+    IndexHachage<NoeudTest> indexSubject;
+    NoeudTest premier = { "bird" };
+    NoeudTest second = { "bird" };
+    indexSubject.inserer(&premier);
+
+    indexSubject.inserer(&second);
+
+    ASSERT_EQ(1, indexSubject.taille());
+    ASSERT_EQ(&second, indexSubject.trouver("bird"));
+}
@@ -0,0 +1,185 @@
+#include "gtest/gtest.h"
+#include "JournalMiseAJour.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace TP3;
+using namespace std;
+
+namespace {
+    const string PREFIXE = "/tmp/tp3-journal-test-" + to_string(getpid());
+    const string CHEMIN_JOURNAL = PREFIXE + ".journal";
+    const string CHEMIN_INSTANTANE = PREFIXE + ".instantane";
+    const string CHEMIN_SOURCE = PREFIXE + ".source";
+
+    void effacerFichiers() {
+        for (const string& chemin : { CHEMIN_JOURNAL, CHEMIN_JOURNAL + ".compaction", CHEMIN_INSTANTANE, CHEMIN_SOURCE })
+            remove(chemin.c_str());
+    }
+
+    vector<string> mots(const Dictionnaire& dictionnaire) {
+        return vector<string>(dictionnaire.begin(), dictionnaire.end());
+    }
+}
+
+TEST(JournalMiseAJour, givenLoggedAddsAndDeletes_whenReplayedOnAFreshDictionary_thenSameWordsAndTranslations) {
+    effacerFichiers();
+    Dictionnaire dictSubject;
+    {
+        JournalMiseAJour journal(CHEMIN_JOURNAL);
+        dictSubject.ajouteMot("bird", "oiseau");
+        journal.journaliseAjout("bird", "oiseau");
+        dictSubject.ajouteMot("bird", "aigle");
+        journal.journaliseAjout("bird", "aigle");
+        dictSubject.ajouteMot("tab\tword", "ligne\nbris\\ee");
+        journal.journaliseAjout("tab\tword", "ligne\nbris\\ee");
+        dictSubject.ajouteMot("cat", "chat");
+        journal.journaliseAjout("cat", "chat");
+        dictSubject.supprimeMot("cat");
+        journal.attendsDurabilite(journal.journaliseSuppression("cat"));
+    }
+
+    Dictionnaire rejoue;
+    ASSERT_EQ(5, JournalMiseAJour::rejoue(CHEMIN_JOURNAL, rejoue));
+    ASSERT_EQ(mots(dictSubject), mots(rejoue));
+    ASSERT_EQ(vector<string>({ "oiseau", "aigle" }), rejoue.traduit("bird"));
+    ASSERT_EQ(vector<string>({ "ligne\nbris\\ee" }), rejoue.traduit("tab\tword"));
+    effacerFichiers();
+}
+
+TEST(JournalMiseAJour, givenManyConcurrentWriters_whenEachWaitsForDurability_thenRecordsShareSynchronisations) {
+    effacerFichiers();
+    const int NB_ECRIVAINS = 8;
+    const int NB_MOTS = 50;
+    Dictionnaire dictSubject;
+    mutex verrouDictionnaire;
+    {
+        JournalMiseAJour journal(CHEMIN_JOURNAL, chrono::microseconds(2000));
+        vector<thread> ecrivains;
+        for (int e = 0; e < NB_ECRIVAINS; e++) {
+            ecrivains.push_back(thread([&, e]() {
+                for (int i = 0; i < NB_MOTS; i++) {
+                    const string mot = "mot" + to_string(e) + "-" + to_string(i);
+                    unsigned long long sequence;
+                    {
+                        lock_guard<mutex> verrou(verrouDictionnaire);
+                        dictSubject.ajouteMot(mot, "t");
+                        sequence = journal.journaliseAjout(mot, "t");
+                    }
+                    journal.attendsDurabilite(sequence);
+                }
+            }));
+        }
+        for (thread& ecrivain : ecrivains)
+            ecrivain.join();
+
+        ASSERT_EQ(NB_ECRIVAINS * NB_MOTS, journal.nombreEnregistrements());
+        ASSERT_LT(journal.nombreSynchronisations(), journal.nombreEnregistrements() / 2);
+    }
+
+    Dictionnaire rejoue;
+    JournalMiseAJour::rejoue(CHEMIN_JOURNAL, rejoue);
+    ASSERT_EQ(mots(dictSubject), mots(rejoue));
+    effacerFichiers();
+}
+
+TEST(JournalMiseAJour, givenTornLastRecord_whenReplayedAndReopened_thenPartialLineIsDropped) {
+    effacerFichiers();
+    {
+        ofstream fichier(CHEMIN_JOURNAL.c_str());
+        fichier << "A\tbird\toiseau\nS\tbird\nA\tcat\tch";
+    }
+
+    Dictionnaire rejoue;
+    ASSERT_EQ(2, JournalMiseAJour::rejoue(CHEMIN_JOURNAL, rejoue));
+    ASSERT_TRUE(rejoue.estVide());
+
+    {
+        JournalMiseAJour journal(CHEMIN_JOURNAL);
+        journal.attendsDurabilite(journal.journaliseAjout("dog", "chien"));
+    }
+    ASSERT_EQ(3, JournalMiseAJour::rejoue(CHEMIN_JOURNAL, rejoue));
+    ASSERT_EQ(vector<string>({ "dog" }), mots(rejoue));
+
+    {
+        ofstream fichier(CHEMIN_JOURNAL.c_str(), ios::app);
+        fichier << "X\tinconnu\n";
+    }
+    ASSERT_THROW(JournalMiseAJour::rejoue(CHEMIN_JOURNAL, rejoue), runtime_error);
+    effacerFichiers();
+}
+
+TEST(JournalMiseAJour, givenCompaction_whenRestoredWithoutSource_thenSnapshotAndLaterRecordsAreLoaded) {
+    effacerFichiers();
+    {
+        ofstream source(CHEMIN_SOURCE.c_str());
+        source << "# en-tete\nbird\toiseau\ncat\tchat\n";
+    }
+    Dictionnaire dictSubject = JournalMiseAJour::restaure(CHEMIN_SOURCE, CHEMIN_INSTANTANE, CHEMIN_JOURNAL);
+    ASSERT_EQ(vector<string>({ "bird", "cat" }), mots(dictSubject));
+    {
+        JournalMiseAJour journal(CHEMIN_JOURNAL);
+        dictSubject.ajouteMot("dog", "chien");
+        journal.journaliseAjout("dog", "chien");
+        dictSubject.supprimeMot("cat");
+        journal.journaliseSuppression("cat");
+
+        journal.compacte(CHEMIN_SOURCE, CHEMIN_INSTANTANE);
+        dictSubject.ajouteMot("eel", "anguille");
+        journal.attendsDurabilite(journal.journaliseAjout("eel", "anguille"));
+        journal.attendsCompaction();
+        ASSERT_FALSE(journal.compactionEnCours());
+    }
+    remove(CHEMIN_SOURCE.c_str());
+    ASSERT_NE(0, access((CHEMIN_JOURNAL + ".compaction").c_str(), F_OK));
+
+    Dictionnaire instantane;
+    ASSERT_EQ(2, JournalMiseAJour::rejoue(CHEMIN_INSTANTANE, instantane));
+    ASSERT_EQ(vector<string>({ "bird", "dog" }), mots(instantane));
+
+    Dictionnaire restaure = JournalMiseAJour::restaure(CHEMIN_SOURCE, CHEMIN_INSTANTANE, CHEMIN_JOURNAL);
+    ASSERT_EQ(mots(dictSubject), mots(restaure));
+    ASSERT_EQ(vector<string>({ "anguille" }), restaure.traduit("eel"));
+    effacerFichiers();
+}
+
+TEST(JournalMiseAJour, givenPreviousSnapshot_whenCompactedAgainWithoutSource_thenSnapshotIsPreviousOnePlusSegment) {
+    effacerFichiers();
+    {
+        ofstream source(CHEMIN_SOURCE.c_str());
+        source << "# en-tete\nbird\toiseau\ncat\tchat\n";
+    }
+    Dictionnaire dictSubject = JournalMiseAJour::restaure(CHEMIN_SOURCE, CHEMIN_INSTANTANE, CHEMIN_JOURNAL);
+    {
+        JournalMiseAJour journal(CHEMIN_JOURNAL);
+        dictSubject.ajouteMot("dog", "chien");
+        journal.journaliseAjout("dog", "chien");
+        journal.compacte(CHEMIN_SOURCE, CHEMIN_INSTANTANE);
+        journal.attendsCompaction();
+        remove(CHEMIN_SOURCE.c_str());
+
+        dictSubject.supprimeMot("bird");
+        journal.journaliseSuppression("bird");
+        dictSubject.ajouteMot("dog", "toutou");
+        journal.journaliseAjout("dog", "toutou");
+        journal.compacte(CHEMIN_SOURCE, CHEMIN_INSTANTANE);
+        dictSubject.supprimeMot("cat");
+        journal.attendsDurabilite(journal.journaliseSuppression("cat"));
+        journal.attendsCompaction();
+    }
+
+    Dictionnaire instantane;
+    ASSERT_EQ(2, JournalMiseAJour::rejoue(CHEMIN_INSTANTANE, instantane));
+    ASSERT_EQ(vector<string>({ "cat", "dog" }), mots(instantane));
+    ASSERT_EQ(vector<string>({ "chien", "toutou" }), instantane.traduit("dog"));
+
+    Dictionnaire restaure = JournalMiseAJour::restaure(CHEMIN_SOURCE, CHEMIN_INSTANTANE, CHEMIN_JOURNAL);
+    ASSERT_EQ(mots(dictSubject), mots(restaure));
+    effacerFichiers();
+}
@@ -0,0 +1,243 @@
+#include "gtest/gtest.h"
+#include "PolitiquesEquilibre.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace TP3;
+using namespace std;
+
+/**
+ * Arbre minimal qui ajoute et supprime comme Dictionnaire (le mot retiré descend jusqu'à une feuille), afin de vérifier
+ * les invariants de chaque politique, quelle que soit celle choisie pour Dictionnaire à la compilation.
+ */
+struct NoeudTest
+{
+    int cle;
+    NoeudTest *gauche, *droite, *parent;
+    int hauteur;
+
+    explicit NoeudTest(int p_cle) : cle(p_cle), gauche(nullptr), droite(nullptr), parent(nullptr), hauteur(0) {}
+};
+
+template<typename Politique>
+struct ArbreTest
+{
+    NoeudTest* racine = nullptr;
+    CompteursOperations compteurs;
+
+    ~ArbreTest() { detruire(racine); }
+
+    void detruire(NoeudTest* noeud) {
+        if (noeud == nullptr)
+            return;
+        detruire(noeud->gauche);
+        detruire(noeud->droite);
+        delete noeud;
+    }
+
+    void ajouter(NoeudTest*& noeud, int cle) {
+        if (noeud == nullptr) {
+            noeud = new NoeudTest(cle);
+            Politique::initialiser(noeud);
+            return;
+        }
+        if (cle < noeud->cle)
+            ajouter(noeud->gauche, cle);
+        else if (cle > noeud->cle)
+            ajouter(noeud->droite, cle);
+        Politique::apresInsertion(noeud, compteurs);
+    }
+
+    void supprimer(NoeudTest*& noeud, int cle) {
+        if (cle < noeud->cle) {
+            supprimer(noeud->gauche, cle);
+        } else if (cle > noeud->cle) {
+            supprimer(noeud->droite, cle);
+        } else if (noeud->gauche == nullptr && noeud->droite == nullptr) {
+            delete noeud;
+            noeud = nullptr;
+        } else if (noeud->droite == nullptr) {
+            NoeudTest* maximum = noeud->gauche;
+            while (maximum->droite != nullptr)
+                maximum = maximum->droite;
+            swap(noeud->cle, maximum->cle);
+            supprimer(noeud->gauche, cle);
+        } else {
+            NoeudTest* minimum = noeud->droite;
+            while (minimum->gauche != nullptr)
+                minimum = minimum->gauche;
+            swap(noeud->cle, minimum->cle);
+            supprimer(noeud->droite, cle);
+        }
+        Politique::apresSuppression(noeud, compteurs);
+    }
+};
+
+int rangTest(const NoeudTest* noeud) {
+    return noeud == nullptr ? -1 : noeud->hauteur;
+}
+
+//Invariant propre à chaque politique, vérifié sur un noeud
+bool invariantLocal(PolitiqueAVL, const NoeudTest* noeud) {
+    return abs(rangTest(noeud->gauche) - rangTest(noeud->droite)) <= 1
+           && noeud->hauteur == 1 + max(rangTest(noeud->gauche), rangTest(noeud->droite));
+}
+
+bool invariantLocal(PolitiqueRougeNoir, const NoeudTest* noeud) {
+    for (const NoeudTest* enfant : { noeud->gauche, noeud->droite }) {
+        const int difference = noeud->hauteur - rangTest(enfant);
+        if (difference != 0 && difference != 1)
+            return false;
+        if (difference == 0 && (rangTest(enfant->gauche) == enfant->hauteur || rangTest(enfant->droite) == enfant->hauteur))
+            return false;
+    }
+    return true;
+}
+
+bool invariantLocal(PolitiqueWAVL, const NoeudTest* noeud) {
+    if (noeud->gauche == nullptr && noeud->droite == nullptr)
+        return noeud->hauteur == 0;
+    for (const NoeudTest* enfant : { noeud->gauche, noeud->droite }) {
+        const int difference = noeud->hauteur - rangTest(enfant);
+        if (difference != 1 && difference != 2)
+            return false;
+    }
+    return true;
+}
+
+bool invariantLocal(PolitiqueTreap, const NoeudTest* noeud) {
+    return rangTest(noeud->gauche) <= noeud->hauteur && rangTest(noeud->droite) <= noeud->hauteur;
+}
+
+//Vérifie l'ordre, les parents et l'invariant de la politique ; retourne la hauteur du sous-arbre
+template<typename Politique>
+int verifier(const NoeudTest* noeud, const NoeudTest* parent, vector<int>& cles) {
+    if (noeud == nullptr)
+        return -1;
+    EXPECT_EQ(parent, noeud->parent);
+    EXPECT_TRUE(invariantLocal(Politique(), noeud)) << Politique::nom() << ", cle " << noeud->cle;
+    const int hauteurGauche = verifier<Politique>(noeud->gauche, noeud, cles);
+    cles.push_back(noeud->cle);
+    const int hauteurDroite = verifier<Politique>(noeud->droite, noeud, cles);
+    return 1 + max(hauteurGauche, hauteurDroite);
+}
+
+template<typename Politique>
+class PolitiquesEquilibre : public ::testing::Test {};
+
+typedef ::testing::Types<PolitiqueAVL, PolitiqueRougeNoir, PolitiqueWAVL, PolitiqueTreap> Politiques;
+TYPED_TEST_CASE(PolitiquesEquilibre, Politiques);
+
+TYPED_TEST(PolitiquesEquilibre, givenSortedInsertions_whenBalanced_thenHeightIsLogarithmic) {
+    ArbreTest<TypeParam> arbre;
+
+    for (int cle = 0; cle < 4096; cle++) {
+        arbre.ajouter(arbre.racine, cle);
+        arbre.racine->parent = nullptr;
+    }
+
+    vector<int> cles;
+    const int hauteur = verifier<TypeParam>(arbre.racine, nullptr, cles);
+    ASSERT_EQ(4096, cles.size());
+    ASSERT_TRUE(is_sorted(cles.begin(), cles.end()));
+    ASSERT_LE(hauteur, 3 * 12) << TypeParam::nom();
+}
+
+TYPED_TEST(PolitiquesEquilibre, givenRandomAddsAndDeletes_whenBalanced_thenInvariantsHoldAfterEveryOperation) {
+    ArbreTest<TypeParam> arbre;
+    set<int> reference;
+    mt19937 generateur(2020);
+    uniform_int_distribution<int> choix(0, 299);
+
+    for (int operation = 0; operation < 3000; operation++) {
+        const int cle = choix(generateur);
+        if (reference.count(cle) != 0 && operation % 2 == 0) {
+            arbre.supprimer(arbre.racine, cle);
+            reference.erase(cle);
+        } else {
+            arbre.ajouter(arbre.racine, cle);
+            reference.insert(cle);
+        }
+        if (arbre.racine != nullptr)
+            arbre.racine->parent = nullptr;
+
+        vector<int> cles;
+        const int hauteur = verifier<TypeParam>(arbre.racine, nullptr, cles);
+        ASSERT_EQ(vector<int>(reference.begin(), reference.end()), cles);
+        if (!reference.empty() && TypeParam::nom() != string("treap")) {
+            ASSERT_LE(hauteur, 2 * log2(reference.size() + 1) + 1) << TypeParam::nom();
+        }
+    }
+}
+
+TYPED_TEST(PolitiquesEquilibre, givenSortedNodes_whenBuiltInOnePass_thenInvariantsHoldBeforeAndAfterUpdates) {
+    for (int nombre = 0; nombre <= 300; nombre++) {
+        ArbreTest<TypeParam> arbre;
+        vector<NoeudTest*> noeuds;
+        for (int cle = 0; cle < nombre; cle++) {
+            noeuds.push_back(new NoeudTest(2 * cle));
+            TypeParam::initialiser(noeuds.back());
+        }
+        arbre.racine = TypeParam::construireTrie(noeuds.data(), noeuds.size());
+        if (arbre.racine != nullptr)
+            arbre.racine->parent = nullptr;
+
+        vector<int> cles;
+        const int hauteur = verifier<TypeParam>(arbre.racine, nullptr, cles);
+        ASSERT_EQ(static_cast<size_t>(nombre), cles.size());
+        ASSERT_TRUE(is_sorted(cles.begin(), cles.end()));
+        if (TypeParam::nom() != string("treap")) {
+            ASSERT_LE(hauteur, log2(nombre + 1)) << TypeParam::nom();
+        }
+
+        for (int cle = 1; cle < 2 * nombre; cle += 6) {
+            arbre.ajouter(arbre.racine, cle);
+            arbre.supprimer(arbre.racine, cle - 1);
+            arbre.racine->parent = nullptr;
+        }
+        cles.clear();
+        verifier<TypeParam>(arbre.racine, nullptr, cles);
+        ASSERT_TRUE(is_sorted(cles.begin(), cles.end()));
+    }
+}
+
+TYPED_TEST(PolitiquesEquilibre, givenTreesOfVeryDifferentSizes_whenJoinedAroundAMiddleKey_thenInvariantsHold) {
+    mt19937 generateur(46);
+    for (int tailleGauche : { 0, 1, 2, 7, 40, 300 }) {
+        for (int tailleDroite : { 0, 1, 3, 12, 90, 500 }) {
+            ArbreTest<TypeParam> gauche, droite;
+            vector<int> clesGauche, clesDroite;
+            for (int cle = 0; cle < 2 * tailleGauche; cle++)
+                clesGauche.push_back(cle);
+            for (int cle = 2 * tailleGauche + 1; cle < 2 * tailleGauche + 1 + 2 * tailleDroite; cle++)
+                clesDroite.push_back(cle);
+            for (auto arbreCles : { make_pair(&gauche, &clesGauche), make_pair(&droite, &clesDroite) }) {
+                shuffle(arbreCles.second->begin(), arbreCles.second->end(), generateur);
+                for (int cle : *arbreCles.second) {
+                    arbreCles.first->ajouter(arbreCles.first->racine, cle);
+                    arbreCles.first->racine->parent = nullptr;
+                }
+                //La moitié des clés est retirée pour obtenir des rangs qui ne sont pas ceux d'un arbre construit par ajouts
+                for (size_t i = 0; i < arbreCles.second->size() / 2; i++) {
+                    arbreCles.first->supprimer(arbreCles.first->racine, (*arbreCles.second)[i]);
+                    if (arbreCles.first->racine != nullptr)
+                        arbreCles.first->racine->parent = nullptr;
+                }
+            }
+
+            NoeudTest* milieu = new NoeudTest(2 * tailleGauche);
+            TypeParam::initialiser(milieu);
+            gauche.racine = TypeParam::joindre(gauche.racine, milieu, droite.racine, gauche.compteurs);
+            gauche.racine->parent = nullptr;
+            droite.racine = nullptr;
+
+            vector<int> cles;
+            verifier<TypeParam>(gauche.racine, nullptr, cles);
+            ASSERT_EQ(static_cast<size_t>(tailleGauche + tailleDroite + 1), cles.size()) << TypeParam::nom();
+            ASSERT_TRUE(is_sorted(cles.begin(), cles.end()));
+        }
+    }
+}
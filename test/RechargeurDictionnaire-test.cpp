@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+#include "RechargeurDictionnaire.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace TP3;
+using namespace std;
+
+namespace {
+    const string CHEMIN_DICTIONNAIRE = "/tmp/tp3-rechargeur-test-" + to_string(getpid()) + ".txt";
+
+    //Remplace le fichier par renommage, comme un outil de déploiement
+    void ecrireDictionnaire(const string& contenu) {
+        const string temporaire = CHEMIN_DICTIONNAIRE + ".tmp";
+        {
+            ofstream fichier(temporaire.c_str());
+            fichier << contenu;
+        }
+        rename(temporaire.c_str(), CHEMIN_DICTIONNAIRE.c_str());
+    }
+
+    template<typename Condition>
+    bool attendre(Condition condition) {
+        for (int essai = 0; essai < 500 && !condition(); essai++)
+            this_thread::sleep_for(chrono::milliseconds(10));
+        return condition();
+    }
+}
+
+TEST(RechargeurDictionnaire, givenReaderHoldingOldVersion_whenReloaded_thenBothVersionsLiveUntilReaderReleasesIt) {
+    ecrireDictionnaire("bird\toiseau\n");
+    RechargeurDictionnaire rechargeur(CHEMIN_DICTIONNAIRE);
+    shared_ptr<const Dictionnaire> ancienne = rechargeur.courant();
+
+    ecrireDictionnaire("bird\toiseau\ncat\tchat\n");
+    ASSERT_TRUE(rechargeur.recharge());
+
+    ASSERT_TRUE(rechargeur.courant()->appartient("cat"));
+    ASSERT_FALSE(ancienne->appartient("cat"));
+    ASSERT_EQ(2, rechargeur.versionsEnVie());
+
+    ecrireDictionnaire("dog\tchien\n");
+    ASSERT_FALSE(rechargeur.recharge());
+    ASSERT_FALSE(rechargeur.derniereErreur().empty());
+    ASSERT_TRUE(rechargeur.courant()->appartient("cat"));
+
+    ancienne.reset();
+    ASSERT_EQ(1, rechargeur.versionsEnVie());
+    ASSERT_TRUE(rechargeur.recharge());
+    ASSERT_TRUE(rechargeur.courant()->appartient("dog"));
+    ASSERT_EQ(2, rechargeur.nombreRechargements());
+    remove(CHEMIN_DICTIONNAIRE.c_str());
+}
+
+TEST(RechargeurDictionnaire, givenMissingOrEmptyFile_whenReloaded_thenCurrentVersionStaysPublished) {
+    remove(CHEMIN_DICTIONNAIRE.c_str());
+    ASSERT_THROW(RechargeurDictionnaire rechargeur(CHEMIN_DICTIONNAIRE), runtime_error);
+
+    ecrireDictionnaire("bird\toiseau\n");
+    ASSERT_THROW(RechargeurDictionnaire rechargeur(CHEMIN_DICTIONNAIRE, RechargeurDictionnaire::Preparation(), 1), logic_error);
+    RechargeurDictionnaire rechargeur(CHEMIN_DICTIONNAIRE);
+
+    ecrireDictionnaire("");
+    ASSERT_FALSE(rechargeur.recharge());
+    remove(CHEMIN_DICTIONNAIRE.c_str());
+    ASSERT_FALSE(rechargeur.recharge());
+
+    ASSERT_FALSE(rechargeur.derniereErreur().empty());
+    ASSERT_TRUE(rechargeur.courant()->appartient("bird"));
+    ASSERT_EQ(0, rechargeur.nombreRechargements());
+}
+
+TEST(RechargeurDictionnaire, givenWatchedFile_whenReplaced_thenPreparedNewVersionIsPublished) {
+    ecrireDictionnaire("bird\toiseau\n");
+    RechargeurDictionnaire rechargeur(CHEMIN_DICTIONNAIRE, [](Dictionnaire& dictionnaire) { dictionnaire.activeIndexHachage(); });
+    rechargeur.demarreSurveillance();
+    ASSERT_THROW(rechargeur.demarreSurveillance(), logic_error);
+
+    ecrireDictionnaire("bird\toiseau\ncat\tchat\n");
+    ASSERT_TRUE(attendre([&]() { return rechargeur.nombreRechargements() == 1; }));
+
+    shared_ptr<const Dictionnaire> courant = rechargeur.courant();
+    ASSERT_TRUE(courant->indexHachageEstActif());
+    ASSERT_EQ(vector<string>({ "chat" }), courant->traduit("cat"));
+
+    rechargeur.arreteSurveillance();
+    ecrireDictionnaire("dog\tchien\n");
+    this_thread::sleep_for(chrono::milliseconds(2 * RechargeurDictionnaire::DELAI_STABILISATION_MS));
+    ASSERT_EQ(1, rechargeur.nombreRechargements());
+    remove(CHEMIN_DICTIONNAIRE.c_str());
+}
+
+TEST(RechargeurDictionnaire, givenConcurrentReaders_whenReloadedRepeatedly_thenEveryLookupSeesACompleteVersion) {
+    ecrireDictionnaire("bird\toiseau\n");
+    RechargeurDictionnaire rechargeur(CHEMIN_DICTIONNAIRE, RechargeurDictionnaire::Preparation(), 8);
+    atomic<bool> arret(false);
+    atomic<int> incoherences(0);
+
+    vector<thread> lecteurs;
+    for (int i = 0; i < 4; i++) {
+        lecteurs.push_back(thread([&]() {
+            while (!arret.load()) {
+                shared_ptr<const Dictionnaire> version = rechargeur.courant();
+                const vector<string> traductions = version->traduit("bird");
+                if (traductions.size() != 1 || (traductions[0] != "oiseau" && traductions[0] != "aigle"))
+                    incoherences++;
+            }
+        }));
+    }
+
+    for (int rechargement = 0; rechargement < 20; rechargement++) {
+        ecrireDictionnaire(rechargement % 2 == 0 ? "bird\taigle\ncat\tchat\n" : "bird\toiseau\n");
+        rechargeur.recharge();
+    }
+    arret = true;
+    for (thread& lecteur : lecteurs)
+        lecteur.join();
+
+    ASSERT_EQ(0, incoherences.load());
+    ASSERT_GE(rechargeur.nombreRechargements(), 1);
+    ASSERT_TRUE(attendre([&]() { return rechargeur.versionsEnVie() == 1; }));
+    remove(CHEMIN_DICTIONNAIRE.c_str());
+}
@@ -0,0 +1,44 @@
+#include "gtest/gtest.h"
+#include "RepliquesNuma.h"
+#include <stdexcept>
+#include <string>
+
+using namespace TP3;
+using namespace std;
+
+TEST(RepliquesNuma, givenDictionary_whenReplicate_thenEveryReplicaIsAnIndependentCopy) {
+    Dictionnaire dictionnaire;
+    for (int i = 0; i < 1000; i++)
+        dictionnaire.ajouteMot("mot" + to_string(i), "traduction" + to_string(i));
+    dictionnaire.activeIndexHachage();
+
+    RepliquesNuma repliquesSubject(dictionnaire);
+    dictionnaire.supprimeMot("mot0");
+
+    ASSERT_LE(1u, repliquesSubject.nombreNoeuds());
+    ASSERT_LT(repliquesSubject.noeudCourant(), repliquesSubject.nombreNoeuds());
+    for (size_t noeud = 0; noeud < repliquesSubject.nombreNoeuds(); noeud++) {
+        const Dictionnaire& replique = repliquesSubject.replique(noeud);
+        ASSERT_NE(&dictionnaire, &replique);
+        ASSERT_EQ(1000, replique.statistiques().nombreMots);
+        ASSERT_TRUE(replique.indexHachageEstActif());
+        ASSERT_EQ(vector<string>({ "traduction0" }), replique.traduit("mot0"));
+    }
+    ASSERT_EQ(vector<string>({ "traduction999" }), repliquesSubject.locale().traduit("mot999"));
+    ASSERT_THROW(repliquesSubject.replique(repliquesSubject.nombreNoeuds()), logic_error);
+    ASSERT_THROW(repliquesSubject.epingle(repliquesSubject.nombreNoeuds()), logic_error);
+}
+
+TEST(RepliquesNuma, givenHugePagesRequested_whenReplicate_thenEveryReplicaHasItsOwnArena) {
+    Dictionnaire dictionnaire;
+    dictionnaire.ajouteMot("bird", "oiseau");
+
+    RepliquesNuma repliquesSubject(dictionnaire, true);
+
+    ASSERT_FALSE(dictionnaire.grandesPagesSontActives());
+    for (size_t noeud = 0; noeud < repliquesSubject.nombreNoeuds(); noeud++) {
+        ASSERT_TRUE(repliquesSubject.replique(noeud).grandesPagesSontActives());
+        ASSERT_LT(0u, repliquesSubject.replique(noeud).octetsGrandesPages());
+        ASSERT_EQ(vector<string>({ "oiseau" }), repliquesSubject.replique(noeud).traduit("bird"));
+    }
+}
@@ -0,0 +1,151 @@
+#include "gtest/gtest.h"
+#include "DictionnaireTest.h"
+#include "ServeurTraduction.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace TP3;
+using namespace std;
+
+namespace {
+    const string CHEMIN_SOCKET = "/tmp/tp3-serveur-test-" + to_string(getpid()) + ".sock";
+
+    int connecter(const string& chemin) {
+        int descripteur = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un adresse;
+        memset(&adresse, 0, sizeof(adresse));
+        adresse.sun_family = AF_UNIX;
+        strncpy(adresse.sun_path, chemin.c_str(), sizeof(adresse.sun_path) - 1);
+        if (connect(descripteur, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)) < 0) {
+            close(descripteur);
+            return -1;
+        }
+        return descripteur;
+    }
+
+    string lireLignes(int descripteur, int nbLignes) {
+        string recu;
+        char tampon[1024];
+        while (nbLignes > 0) {
+            ssize_t nbOctets = read(descripteur, tampon, sizeof(tampon));
+            if (nbOctets <= 0)
+                break;
+            for (ssize_t i = 0; i < nbOctets; i++)
+                if (tampon[i] == '\n')
+                    nbLignes--;
+            recu.append(tampon, static_cast<size_t>(nbOctets));
+        }
+        return recu;
+    }
+}
+
+TEST(ServeurTraduction, givenInvalidSocketPath_whenConstruct_thenThrowRuntimeError) {
+    Dictionnaire dictionnaire;
+
+    ASSERT_THROW(ServeurTraduction(dictionnaire, "/repertoire/inexistant/tp3.sock"), runtime_error);
+}
+
+TEST(ServeurTraduction, givenPipelinedRequests_whenServing_thenAnswersComeBackInOrder) {
+    Dictionnaire dictionnaire;
+    remplirDictionnaire(dictionnaire);
+    ServeurTraduction serveurSubject(dictionnaire, CHEMIN_SOCKET);
+    thread fil(&ServeurTraduction::servir, &serveurSubject);
+
+    int client = connecter(CHEMIN_SOCKET);
+    ASSERT_GE(client, 0);
+    const string requetes = "T bird\nT cat\nL the bread\r\nX bird\n";
+    ASSERT_EQ(static_cast<ssize_t>(requetes.size()), write(client, requetes.data(), requetes.size()));
+    string reponses = lireLignes(client, 4);
+    close(client);
+
+    serveurSubject.arrete();
+    fil.join();
+
+    ASSERT_EQ("OK\toiseau\taigle\nABSENT\nOK\tle pain\nERREUR\tcommande inconnue\n", reponses);
+}
+
+TEST(ServeurTraduction, givenDuplicateRequestsInOneBatch_whenServing_thenEachDistinctRequestIsComputedOnce) {
+    Dictionnaire dictionnaire;
+    remplirDictionnaire(dictionnaire);
+    ServeurTraduction serveurSubject(dictionnaire, CHEMIN_SOCKET);
+
+    int client = connecter(CHEMIN_SOCKET);
+    ASSERT_GE(client, 0);
+    string requetes;
+    for (int i = 0; i < 50; i++)
+        requetes += "S brid\nT the\n";
+    ASSERT_EQ(static_cast<ssize_t>(requetes.size()), write(client, requetes.data(), requetes.size()));
+    shutdown(client, SHUT_WR);
+
+    thread fil(&ServeurTraduction::servir, &serveurSubject);
+    string reponses = lireLignes(client, 100);
+    close(client);
+    serveurSubject.arrete();
+    fil.join();
+
+    ASSERT_EQ(100, serveurSubject.nombreRequetes());
+    ASSERT_EQ(2, serveurSubject.nombreCalculs());
+    const string reponseSuggestion = reponses.substr(0, reponses.find('\n') + 1);
+    string attendu;
+    for (int i = 0; i < 50; i++)
+        attendu += reponseSuggestion + "OK\tle\n";
+    ASSERT_EQ(0, reponseSuggestion.find("OK\t"));
+    ASSERT_EQ(attendu, reponses);
+}
+
+TEST(ServeurTraduction, givenMoreRequestsThanOneBatchAllows_whenServing_thenTheyAreSplitAcrossBatchesInOrder) {
+    Dictionnaire dictionnaire;
+    remplirDictionnaire(dictionnaire);
+    ServeurTraduction serveurSubject(dictionnaire, CHEMIN_SOCKET);
+
+    int client = connecter(CHEMIN_SOCKET);
+    ASSERT_GE(client, 0);
+    const int NB_REQUETES = 3 * static_cast<int>(ServeurTraduction::REQUETES_MAX_PAR_CONNEXION) + 1;
+    string requetes, attendu;
+    for (int i = 0; i < NB_REQUETES; i++) {
+        requetes += i % 2 == 0 ? "T bird\n" : "T cat\n";
+        attendu += i % 2 == 0 ? "OK\toiseau\taigle\n" : "ABSENT\n";
+    }
+    ASSERT_EQ(static_cast<ssize_t>(requetes.size()), write(client, requetes.data(), requetes.size()));
+    shutdown(client, SHUT_WR);
+
+    thread fil(&ServeurTraduction::servir, &serveurSubject);
+    string reponses = lireLignes(client, NB_REQUETES);
+    close(client);
+    serveurSubject.arrete();
+    fil.join();
+
+    ASSERT_EQ(attendu, reponses);
+    ASSERT_EQ(NB_REQUETES, serveurSubject.nombreRequetes());
+    ASSERT_LE(4, serveurSubject.nombreLots());
+}
+
+TEST(ServeurTraduction, givenRequestLongerThanMaximum_whenServing_thenConnectionIsClosed) {
+    Dictionnaire dictionnaire;
+    ServeurTraduction serveurSubject(dictionnaire, CHEMIN_SOCKET);
+    thread fil(&ServeurTraduction::servir, &serveurSubject);
+
+    int client = connecter(CHEMIN_SOCKET);
+    ASSERT_GE(client, 0);
+    const string requete = "T " + string(ServeurTraduction::TAILLE_MAX_REQUETE + 1, 'a');
+    size_t envoye = 0;
+    while (envoye < requete.size()) {
+        ssize_t nbOctets = send(client, requete.data() + envoye, requete.size() - envoye, MSG_NOSIGNAL);
+        if (nbOctets <= 0)
+            break;
+        envoye += static_cast<size_t>(nbOctets);
+    }
+    char tampon[16];
+    ssize_t nbOctets = read(client, tampon, sizeof(tampon));
+    close(client);
+    serveurSubject.arrete();
+    fil.join();
+
+    ASSERT_GE(0, nbOctets);
+    ASSERT_EQ(0, serveurSubject.nombreRequetes());
+}
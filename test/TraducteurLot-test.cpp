@@ -0,0 +1,44 @@
+#include "gtest/gtest.h"
+#include "DictionnaireTest.h"
+#include "TraducteurLot.h"
+#include <sstream>
+
+using namespace TP3;
+using namespace std;
+
+TEST(TraducteurLot, givenKnownWordWithManyTraductions_whenTranslateWord_thenItPicksTheFirstOne) {
+    Dictionnaire dictionnaire;
+    remplirDictionnaire(dictionnaire);
+    TraducteurLot traducteurSubject(dictionnaire);
+
+    ASSERT_EQ("oiseau", traducteurSubject.traduireMot("bird"));
+}
+
+TEST(TraducteurLot, givenMisspelledWord_whenTranslateWord_thenItTranslatesTheFirstSuggestion) {
+    Dictionnaire dictionnaire;
+    remplirDictionnaire(dictionnaire);
+    TraducteurLot traducteurSubject(dictionnaire);
+    string suggestion = dictionnaire.suggereCorrections("brid")[0];
+
+    ASSERT_EQ(dictionnaire.traduit(suggestion)[0], traducteurSubject.traduireMot("brid"));
+}
+
+TEST(TraducteurLot, givenEmptyDictionary_whenTranslateWord_thenItIsNotTranslatable) {
+    Dictionnaire dictionnaire;
+    TraducteurLot traducteurSubject(dictionnaire);
+
+    ASSERT_EQ(TraducteurLot::NON_TRADUISABLE, traducteurSubject.traduireMot("bird"));
+}
+
+TEST(TraducteurLot, givenMultilineStream_whenTranslateStream_thenEachLineIsTranslatedInOrder) {
+    Dictionnaire dictionnaire;
+    remplirDictionnaire(dictionnaire);
+    TraducteurLot traducteurSubject(dictionnaire);
+    istringstream entree("the bird\n\n  the\tbread  \n");
+    ostringstream sortie;
+
+    unsigned long long nbLignes = traducteurSubject.traduireFlux(entree, sortie);
+
+    ASSERT_EQ(3, nbLignes);
+    ASSERT_EQ("le oiseau\n\nle pain\n", sortie.str());
+}
@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "DictionnaireTest.h"
+#include "TraducteurParallele.h"
+#include <sstream>
+#include <stdexcept>
+
+using namespace TP3;
+using namespace std;
+
+TEST(TraducteurParallele, givenInvalidParameters_whenConstruct_thenThrowLogicError) {
+    Dictionnaire dictionnaire;
+
+    ASSERT_THROW(TraducteurParallele(dictionnaire, 0), logic_error);
+    ASSERT_THROW(TraducteurParallele(dictionnaire, 2, 0), logic_error);
+    ASSERT_THROW(TraducteurParallele(dictionnaire, 2, 16, 12), logic_error);
+}
+
+TEST(TraducteurParallele, givenManyLinesAndThreads_whenTranslateStream_thenOutputMatchesSequentialTranslation) {
+    Dictionnaire dictionnaire;
+    remplirDictionnaire(dictionnaire);
+    dictionnaire.activeIndexHachage();
+    const char* phrases[] = { "the small bird eats bread", "", "teh brid", "the bread\tsmall", "unknown eats" };
+    ostringstream texte;
+    for (int i = 0; i < 5000; i++)
+        texte << phrases[i % 5] << '\n';
+
+    istringstream entreeSequentielle(texte.str());
+    ostringstream sortieSequentielle;
+    TraducteurLot(dictionnaire).traduireFlux(entreeSequentielle, sortieSequentielle);
+
+    TraducteurParallele traducteurSubject(dictionnaire, 4, 7, 8);
+    istringstream entree(texte.str());
+    ostringstream sortie;
+    unsigned long long nbLignes = traducteurSubject.traduireFlux(entree, sortie);
+
+    ASSERT_EQ(5000, nbLignes);
+    ASSERT_EQ(sortieSequentielle.str(), sortie.str());
+}
+
+TEST(TraducteurParallele, givenNumaReplicas_whenTranslateStream_thenOutputMatchesSequentialTranslation) {
+    Dictionnaire dictionnaire;
+    remplirDictionnaire(dictionnaire);
+    const char* phrases[] = { "the small bird eats bread", "teh brid", "unknown eats" };
+    ostringstream texte;
+    for (int i = 0; i < 3000; i++)
+        texte << phrases[i % 3] << '\n';
+
+    istringstream entreeSequentielle(texte.str());
+    ostringstream sortieSequentielle;
+    TraducteurLot(dictionnaire).traduireFlux(entreeSequentielle, sortieSequentielle);
+
+    RepliquesNuma repliques(dictionnaire, true);
+    TraducteurParallele traducteurSubject(repliques, 3, 5, 8);
+    istringstream entree(texte.str());
+    ostringstream sortie;
+
+    ASSERT_EQ(3000, traducteurSubject.traduireFlux(entree, sortie));
+    ASSERT_EQ(sortieSequentielle.str(), sortie.str());
+}
+
+TEST(TraducteurParallele, givenEmptyInput_whenTranslateStream_thenNothingIsWritten) {
+    Dictionnaire dictionnaire;
+    remplirDictionnaire(dictionnaire);
+    TraducteurParallele traducteurSubject(dictionnaire, 3);
+    istringstream entree("");
+    ostringstream sortie;
+
+    ASSERT_EQ(0, traducteurSubject.traduireFlux(entree, sortie));
+    ASSERT_EQ("", sortie.str());
+}